@@ -11,7 +11,7 @@
 
 MODULE_NAME := main
 
-SOURCES := utils/List.c utils/Parser.c utils/Task.c Main.c
+SOURCES := utils/Converter.c utils/JpegError.c utils/List.c utils/Motion.c utils/Parser.c utils/Pattern.c utils/Reactor.c utils/Ring.c utils/Scaler.c utils/Task.c Main.c
 
 #################################################################
 #                             Include                           #
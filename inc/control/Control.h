@@ -96,6 +96,8 @@ typedef enum control_error_e (*control_handle_click_f)(struct control_s *obj,
                                                        struct gfx_event_s *gfxEvent);
 typedef enum control_error_e (*control_handle_command_f)(struct control_s *obj,
                                                          struct controllers_command_s *command);
+typedef enum control_error_e (*control_handle_motion_f)(struct control_s *obj, char *videoName,
+                                                        uint32_t score, uint8_t isMoving);
 
 /* -------------------------------------------------------------------------------------------- */
 /* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
@@ -170,6 +172,7 @@ struct control_s {
 
     control_handle_click_f            handleClick;
     control_handle_command_f          handleCommand;
+    control_handle_motion_f           handleMotion;
 
     void *pData;
 };
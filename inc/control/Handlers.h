@@ -69,6 +69,7 @@ extern "C" {
 #define HANDLERS_COMMAND_UPDATE_IMAGE       "updateImage"
 #define HANDLERS_COMMAND_UPDATE_NAV         "updateNav"
 #define HANDLERS_COMMAND_SEND_GFX_EVENT     "sendGfxEvent"
+#define HANDLERS_COMMAND_DUMP_VIDEO_CLIP    "dumpVideoClip"
 
 /* -------------------------------------------------------------------------------------------- */
 /* //////////////////////////////////// TYPES DECLARATION ///////////////////////////////////// */
@@ -39,11 +39,13 @@ extern "C" {
 #include "graphics/Graphics.h"
 #include "network/Client.h"
 #include "network/Server.h"
+#include "video/Recorder.h"
 #include "video/Video.h"
 
 #include "utils/Common.h"
 #include "utils/Log.h"
 #include "utils/Parser.h"
+#include "utils/Scaler.h"
 
 /* -------------------------------------------------------------------------------------------- */
 /* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
@@ -70,6 +72,23 @@ struct graphics_infos_s {
     struct graphics_params_s graphicsParams;
 };
 
+struct video_variant_s {
+    char                    *name;
+    uint32_t                width;
+    uint32_t                height;
+    enum scaler_filter_e    filter;
+    uint8_t                 jpegQuality;
+
+    char                    *graphicsDest;
+    int32_t                 graphicsIndex;
+
+    char                    *serverDest;
+    int32_t                 serverIndex;
+
+    enum video_delivery_e   delivery;
+    uint32_t                maxFps;
+};
+
 struct video_device_s {
     enum module_state_e     state;
 
@@ -79,9 +98,28 @@ struct video_device_s {
 
     char                    *graphicsDest;
     int32_t                 graphicsIndex;
+    enum video_delivery_e   graphicsDelivery;
+    uint32_t                graphicsMaxFps;
+    uint32_t                graphicsEveryNthFrame;
+
+    /* Draws matched frames on graphicsDest instead of the graphics listener when
+     * videoParams.syncGroup is set. NULL otherwise */
+    struct video_sync_listener_s *syncListener;
 
     char                    *serverDest;
     int32_t                 serverIndex;
+    enum video_delivery_e   serverDelivery;
+    uint32_t                serverMaxFps;
+    uint32_t                serverEveryNthFrame;
+    uint8_t                 serverJpegQuality;
+    uint8_t                 serverJpegSlices;
+
+    /* directory[0] == '\0' <=> Not recorded. Frame properties are set once capture started */
+    struct recorder_params_s recorderParams;
+    uint32_t                 recorderMaxFps;
+
+    uint8_t                 nbVariants;
+    struct video_variant_s  *variants;
 };
 
 struct videos_infos_s {
@@ -99,15 +137,30 @@ struct servers_infos_s {
     struct server_infos_s **serverInfos;
 };
 
+struct client_pattern_stats_s {
+    uint8_t  started;
+    uint32_t lastCounter;
+
+    uint32_t nbFrames;
+    uint32_t nbDropped;
+    uint64_t latencySum_us;
+    uint64_t latencyMax_us;
+
+    uint64_t nextReport_us;
+};
+
 struct client_infos_s {
-    enum module_state_e    state;
-    struct client_params_s clientParams;
+    enum module_state_e           state;
+    struct client_params_s        clientParams;
     
-    char                   *graphicsDest;
-    int32_t                graphicsIndex;
+    char                          *graphicsDest;
+    int32_t                       graphicsIndex;
     
-    char                   *serverDest;
-    int32_t                serverIndex;
+    char                          *serverDest;
+    int32_t                       serverIndex;
+
+    uint8_t                       checkPattern;
+    struct client_pattern_stats_s patternStats;
 };
 
 struct clients_infos_s {
@@ -161,6 +214,9 @@ struct input_s {
     struct module_config_s videosConfig;
     struct module_config_s serversConfig;
     struct module_config_s clientsConfig;
+
+    uint32_t               videosCaptureThreads;
+    uint8_t                videosPinCaptureThreads;
 };
 
 struct context_s {
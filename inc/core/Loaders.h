@@ -122,11 +122,33 @@ struct xml_video_area_s {
     uint32_t height;
 };
 
+struct xml_variant_s {
+    char                    *name;
+    uint32_t                width;
+    uint32_t                height;
+    uint8_t                 filter;
+    uint8_t                 jpegQuality;
+
+    char                    *graphicsDest;
+    char                    *serverDest;
+    uint8_t                 delivery;
+    uint8_t                 maxFps;
+};
+
 struct xml_video_s {
     uint8_t                 priority;
     uint32_t                configChoice;
     char                    *graphicsDest;
     char                    *serverDest;
+    uint8_t                 graphicsDelivery;
+    uint8_t                 serverDelivery;
+    uint8_t                 graphicsMaxFps;
+    uint8_t                 serverMaxFps;
+    uint8_t                 graphicsEveryNthFrame;
+    uint8_t                 serverEveryNthFrame;
+    uint8_t                 serverJpegQuality;
+    uint8_t                 serverJpegSlices;
+    char                    *recorderDest;
 
     char                    *deviceName;
     char                    *deviceSrc;
@@ -137,6 +159,30 @@ struct xml_video_s {
     
     uint8_t                 nbBuffers;
     uint8_t                 desiredFps;
+    uint8_t                 nbSlots;
+    uint8_t                 overflowPolicy;
+
+    uint16_t                motionThreshold;
+    uint8_t                 motionGridStep;
+    uint32_t                keepAliveMs;
+
+    uint8_t                 recorderContainer;
+    uint32_t                recorderMaxSegmentMb;
+    uint32_t                recorderMaxSegmentSec;
+    uint32_t                recorderBufferKb;
+    uint8_t                 recorderNbBuffers;
+    uint8_t                 recorderDirectIo;
+    uint8_t                 recorderMaxFps;
+
+    uint32_t                clipPreEventSec;
+    uint32_t                clipPostEventSec;
+    uint32_t                clipMemoryMb;
+
+    char                    *syncGroup;
+    uint32_t                syncToleranceMs;
+
+    uint8_t                 nbVariants;
+    struct xml_variant_s    *variants;
 };
 
 struct xml_videos_s {
@@ -332,6 +378,8 @@ struct xml_server_s {
     uint8_t  acceptMode;
     uint8_t  priority;
     uint32_t maxClients;
+    uint8_t  senderThreads;
+    uint8_t  pinSenderThreads;
     char     *mime;
     
     char     *host;
@@ -358,6 +406,7 @@ struct xml_client_s {
     uint8_t priority;
     char    *graphicsDest;
     char    *serverDest;
+    uint8_t checkPattern;
     
     char    *serverHost;
     char    *serverService;
@@ -72,6 +72,8 @@ extern "C" {
 #define XML_TAG_COLORSPACE               "Colorspace"
 #define XML_TAG_MEMORY                   "Memory"
 #define XML_TAG_AWAIT_MODE               "AwaitMode"
+#define XML_TAG_VARIANTS                 "Variants"
+#define XML_TAG_VARIANT                  "Variant"
 #define XML_TAG_TEXT                     "Text"
 #define XML_TAG_NAV                      "Nav"
 #define XML_TAG_ON_CLICK                 "OnClick"
@@ -83,6 +85,10 @@ extern "C" {
 #define XML_TAG_CROPPING_AREA            "CroppingArea"
 #define XML_TAG_COMPOSING_AREA           "ComposingArea"
 #define XML_TAG_BUFFER                   "Buffer"
+#define XML_TAG_CHANGE_DETECTION         "ChangeDetection"
+#define XML_TAG_RECORDER                 "Recorder"
+#define XML_TAG_CLIP                     "Clip"
+#define XML_TAG_SYNC                     "Sync"
 #define XML_TAG_INET                     "Inet"
 #define XML_TAG_UNIX                     "Unix"
 
@@ -103,6 +109,8 @@ extern "C" {
 #define XML_ATTR_ENABLE                  "enable"
 #define XML_ATTR_XML_FILE                "xmlFile"
 #define XML_ATTR_AUTO_START              "autoStart"
+#define XML_ATTR_CAPTURE_THREADS         "captureThreads"
+#define XML_ATTR_PIN_CAPTURE_THREADS     "pinCaptureThreads"
 #define XML_ATTR_RED                     "red"
 #define XML_ATTR_GREEN                   "green"
 #define XML_ATTR_BLUE                    "blue"
@@ -146,11 +154,40 @@ extern "C" {
 #define XML_ATTR_CONFIG_CHOICE           "configChoice"
 #define XML_ATTR_GFX_DEST                "gfxDest"
 #define XML_ATTR_SERVER_DEST             "serverDest"
+#define XML_ATTR_GFX_DELIVERY            "gfxDelivery"
+#define XML_ATTR_SERVER_DELIVERY         "serverDelivery"
+#define XML_ATTR_GFX_MAX_FPS             "gfxMaxFps"
+#define XML_ATTR_SERVER_MAX_FPS          "serverMaxFps"
+#define XML_ATTR_GFX_EVERY_NTH_FRAME     "gfxEveryNthFrame"
+#define XML_ATTR_SERVER_EVERY_NTH_FRAME  "serverEveryNthFrame"
+#define XML_ATTR_SERVER_JPEG_QUALITY     "serverJpegQuality"
+#define XML_ATTR_SERVER_JPEG_SLICES      "serverJpegSlices"
+#define XML_ATTR_RECORDER_DEST           "recorderDest"
+#define XML_ATTR_CONTAINER               "container"
+#define XML_ATTR_MAX_SEGMENT_MB          "maxSegmentMb"
+#define XML_ATTR_MAX_SEGMENT_SEC         "maxSegmentSec"
+#define XML_ATTR_BUFFER_KB               "bufferKb"
+#define XML_ATTR_DIRECT_IO               "directIo"
+#define XML_ATTR_PRE_EVENT_SEC           "preEventSec"
+#define XML_ATTR_POST_EVENT_SEC          "postEventSec"
+#define XML_ATTR_MEMORY_MB               "memoryMb"
+#define XML_ATTR_TOLERANCE_MS            "toleranceMs"
+#define XML_ATTR_FILTER                  "filter"
+#define XML_ATTR_JPEG_QUALITY            "jpegQuality"
+#define XML_ATTR_DELIVERY                "delivery"
+#define XML_ATTR_MAX_FPS                 "maxFps"
 #define XML_ATTR_SRC                     "src"
 #define XML_ATTR_NB_BUFFERS              "nbBuffers"
 #define XML_ATTR_DESIRED_FPS             "desiredFps"
+#define XML_ATTR_NB_SLOTS                "nbSlots"
+#define XML_ATTR_OVERFLOW_POLICY         "overflowPolicy"
+#define XML_ATTR_THRESHOLD               "threshold"
+#define XML_ATTR_GRID_STEP               "gridStep"
+#define XML_ATTR_KEEP_ALIVE_MS           "keepAliveMs"
 #define XML_ATTR_VALUE                   "value"
 #define XML_ATTR_MAX_CLIENTS             "maxClients"
+#define XML_ATTR_SENDER_THREADS          "senderThreads"
+#define XML_ATTR_PIN_SENDER_THREADS      "pinSenderThreads"
 #define XML_ATTR_TYPE                    "type"
 #define XML_ATTR_LINK                    "link"
 #define XML_ATTR_MODE                    "mode"
@@ -162,6 +199,7 @@ extern "C" {
 #define XML_ATTR_PATH                    "path"
 #define XML_ATTR_SOCKET_NAME             "socketName"
 #define XML_ATTR_SERVER_SOCKET_NAME      "serverSocketName"
+#define XML_ATTR_CHECK_PATTERN           "checkPattern"
 
 #ifdef __cplusplus
 }
@@ -46,6 +46,8 @@
 *       - Ask "libmmcontroller-audio-1.0" to play audio, record audio, ...
 *       - Start "libmmcontroller-motion-1.5" for motion detection based on screenshots you can
 *         regularly ask mmstreamer engine to take
+*       The engine only provides a basic change detection (See CONTROLLER_EVENT_MOTION) which
+*       such a controller can use to know when taking screenshots is worth it
 *
 * \see controller_init_f
 * \see controller_uninit_f
@@ -206,6 +208,24 @@ extern "C" {
  */
 #define CONTROLLER_FORMAT_GFX "%u;%u;%u"
 
+/*!
+ * \def CONTROLLER_FORMAT_CLIP
+ * \brief Expected format when sending commands to mmstreamer engine to save the last seconds
+ *        captured by a video device (Cf. see section)
+ *
+ * Format is "videoName;postEventSec" where "videoName" is the name of the video device
+ * (Cf. Videos.xml) and "postEventSec" the number of seconds to save after the command is
+ * received. "postEventSec" can be omitted or set to 0 to use the one defined in Videos.xml
+ *
+ * The clip is written to appDataDir (Cf. Main.xml) by a background thread. Sending the
+ * command again while a clip is being written only extends it
+ *
+ * \note Pre-event clip must be enabled for the video device (Cf. Clip tag in Videos.xml)
+ *
+ * \see CONTROLLER_COMMAND_DUMP_VIDEO_CLIP
+ */
+#define CONTROLLER_FORMAT_CLIP "%s;%u"
+
 /* -------------------------------------------------------------------------------------------- */
 /* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
@@ -263,7 +283,9 @@ enum controller_command_e {
     CONTROLLER_COMMAND_UPDATE_IMAGE,       /**< See CONTROLLER_FORMAT_IMAGE */
     CONTROLLER_COMMAND_UPDATE_NAV,         /**< See CONTROLLER_FORMAT_NAV */
 
-    CONTROLLER_COMMAND_SEND_GFX_EVENT      /**< See CONTROLLER_FORMAT_GFX */
+    CONTROLLER_COMMAND_SEND_GFX_EVENT,     /**< See CONTROLLER_FORMAT_GFX */
+
+    CONTROLLER_COMMAND_DUMP_VIDEO_CLIP     /**< See CONTROLLER_FORMAT_CLIP */
 };
 
 /*!
@@ -302,6 +324,8 @@ enum controller_event_e {
     CONTROLLER_EVENT_STARTED   = 1 << 1, /**< Component (video, graphics, ...) started */
     CONTROLLER_EVENT_SUSPENDED = 1 << 2, /**< Server is suspended */
     CONTROLLER_EVENT_CLICKED   = 1 << 3, /**< A click occurred on a graphics element */
+    CONTROLLER_EVENT_MOTION    = 1 << 4, /**< Scene seen by a video device started changing */
+    CONTROLLER_EVENT_STILL     = 1 << 5, /**< Scene seen by a video device stopped changing */
 
     CONTROLLER_EVENT_ALL       = 0xFF
 };
@@ -311,8 +335,14 @@ enum controller_event_e {
  * \brief Used to notify your controller when event with "id" occurred
  *
  * According to "id", "name" can represent the name of the module whose
- * state has changed (STOPPED, STARTED, SUSPENDED) or the one of the graphics
- * element on which the user has clicked
+ * state has changed (STOPPED, STARTED, SUSPENDED), the one of the graphics
+ * element on which the user has clicked or the one of the video device whose
+ * scene has changed (MOTION, STILL)
+ *
+ * "value" is only set for MOTION and STILL events. It is the motion score
+ * (0 - 1000) i.e the mean absolute difference of luma samples between the
+ * current frame and the last changed one, 1000 meaning that every sample
+ * changed by 255
  *
  * \note See xml config files fr more details about modules and graphics
  *       elements defined name
@@ -320,6 +350,7 @@ enum controller_event_e {
 struct controller_event_s {
     enum controller_event_e id;
     char                    *name;
+    unsigned int            value;
 };
 
 /*!
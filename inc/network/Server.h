@@ -47,6 +47,7 @@ enum server_accept_mode_e;
 enum server_error_e;
 
 struct server_params_s;
+struct server_client_stats_s;
 struct server_s;
 
 /* -------------------------------------------------------------------------------------------- */
@@ -85,10 +86,17 @@ typedef enum server_error_e (*server_disconnect_client_f)(struct server_s *obj,
                                                           struct server_params_s *params,
                                                           struct link_s *client);
 
+/* Data is copied so buffer can be reused as soon as this returns. A client still sending a
+ * previous frame gets the newest one once done, the ones in between are dropped */
 typedef enum server_error_e (*server_send_data_f)(struct server_s *obj,
                                                   struct server_params_s *params,
                                                   struct buffer_s *buffer);
 
+typedef enum server_error_e (*server_get_client_stats_f)(struct server_s *obj,
+                                                         struct server_params_s *params,
+                                                         struct link_s *client,
+                                                         struct server_client_stats_s *stats);
+
 /* -------------------------------------------------------------------------------------------- */
 /* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
@@ -128,12 +136,21 @@ struct server_params_s {
     enum priority_e                   priority;
     uint32_t                          maxClients;
     size_t                            maxBufferSize;
+
+    uint8_t                           senderThreads;    /* 0 <=> 1. Clients are shared out */
+    uint8_t                           pinSenderThreads; /* Sender thread i runs on cpu
+                                                           (i % nb online cpus) */
     
     server_on_client_state_changed_cb onClientStateChangedCb;
     
     void                              *userData;
 };
 
+struct server_client_stats_s {
+    uint64_t nbSentFrames;
+    uint64_t nbDroppedFrames; /* Newer frames available before the previous one was sent */
+};
+
 /* -------------------------------------------------------------------------------------------- */
 /* /////////////////////////////////////// MAIN CONTEXT /////////////////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
@@ -152,6 +169,8 @@ struct server_s {
 
     server_send_data_f         sendData;
 
+    server_get_client_stats_f  getClientStats;
+
     void *pData;
 };
 
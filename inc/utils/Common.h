@@ -44,6 +44,7 @@ extern "C" {
 #include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
+#include <time.h>
 #include <unistd.h>
 
 /* -------------------------------------------------------------------------------------------- */
@@ -94,10 +95,44 @@ enum priority_e {
 };
 
 struct buffer_s {
-    void   *data;
-    size_t length;
+    void     *data;
+    size_t   length;
+
+    uint64_t captureTime_us; /* CLOCK_MONOTONIC time data was captured at - 0 if unknown */
 };
 
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////////////////// HELPERS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static inline uint64_t getMonotonicTime_us(void)
+{
+    struct timespec now;
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+}
+
+/* Retry interrupted and partial writes - Return 0 with errno set on error */
+static inline uint8_t writeAll(int fd, const uint8_t *data, size_t size)
+{
+    ssize_t written;
+
+    while (size > 0) {
+        if ((written = write(fd, data, size)) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return 0;
+        }
+
+        data += written;
+        size -= (size_t)written;
+    }
+
+    return 1;
+}
+
 #ifdef __cplusplus
 }
 #endif
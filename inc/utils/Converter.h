@@ -0,0 +1,152 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file Converter.h
+* \author Boubacar DIENE
+*/
+
+#ifndef __CONVERTER_H__
+#define __CONVERTER_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include "utils/Common.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#define CONVERTER_MAX_PLANES 3
+
+/* -------------------------------------------------------------------------------------------- */
+/* //////////////////////////////////// TYPES DECLARATION ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum converter_error_e;
+enum converter_format_e;
+enum converter_kernel_e;
+
+struct converter_frame_s;
+struct converter_s;
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////////////// PUBLIC FUNCTIONS ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/** getFrameSize: Number of bytes needed to store a contiguous frame
+ * setFrame    : Describe a contiguous frame i.e set planes and strides from data */
+typedef enum converter_error_e (*converter_get_frame_size_f)(struct converter_s *obj,
+                                                             enum converter_format_e format,
+                                                             uint32_t width, uint32_t height,
+                                                             size_t *size);
+typedef enum converter_error_e (*converter_set_frame_f)(struct converter_s *obj,
+                                                        enum converter_format_e format,
+                                                        uint32_t width, uint32_t height,
+                                                        void *data,
+                                                        struct converter_frame_s *frame);
+
+/** convert: src and dst must have the same dimensions. Can be called concurrently */
+typedef enum converter_error_e (*converter_convert_f)(struct converter_s *obj,
+                                                     struct converter_frame_s *src,
+                                                     struct converter_frame_s *dst);
+
+typedef enum converter_error_e (*converter_get_kernel_f)(struct converter_s *obj,
+                                                        enum converter_kernel_e *kernel);
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum converter_error_e {
+    CONVERTER_ERROR_NONE,
+    CONVERTER_ERROR_INIT,
+    CONVERTER_ERROR_UNINIT,
+    CONVERTER_ERROR_PARAMS,
+    CONVERTER_ERROR_FORMAT
+};
+
+/* YUV formats are BT.601 limited range. Chroma is always subsampled horizontally */
+enum converter_format_e {
+    CONVERTER_FORMAT_YUYV,     /* Packed 4:2:2 - Y0 U Y1 V         */
+    CONVERTER_FORMAT_YVYU,     /* Packed 4:2:2 - Y0 V Y1 U         */
+    CONVERTER_FORMAT_UYVY,     /* Packed 4:2:2 - U Y0 V Y1         */
+    CONVERTER_FORMAT_NV12,     /* 4:2:0 - Y plane + UV plane       */
+    CONVERTER_FORMAT_I420,     /* 4:2:0 - Y plane + U and V planes */
+    CONVERTER_FORMAT_RGB24,    /* R G B                            */
+    CONVERTER_FORMAT_ARGB8888, /* 0xAARRGGBB in native byte order  */
+    CONVERTER_FORMAT_MAX
+};
+
+enum converter_kernel_e {
+    CONVERTER_KERNEL_AUTO,     /* Best kernel supported by the running cpu */
+    CONVERTER_KERNEL_SCALAR,
+    CONVERTER_KERNEL_SSE2,
+    CONVERTER_KERNEL_AVX2,
+    CONVERTER_KERNEL_NEON,
+    CONVERTER_KERNEL_MAX
+};
+
+struct converter_frame_s {
+    enum converter_format_e format;
+    uint32_t                width;
+    uint32_t                height;
+
+    uint8_t                 *planes[CONVERTER_MAX_PLANES];
+    uint32_t                strides[CONVERTER_MAX_PLANES]; /* In bytes */
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// MAIN CONTEXT /////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+struct converter_s {
+    converter_get_frame_size_f getFrameSize;
+    converter_set_frame_f      setFrame;
+
+    converter_convert_f        convert;
+
+    converter_get_kernel_f     getKernel;
+
+    void                       *pData;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/* Return CONVERTER_ERROR_PARAMS if kernel is not supported by the running cpu */
+enum converter_error_e Converter_Init(struct converter_s **obj, enum converter_kernel_e kernel);
+enum converter_error_e Converter_UnInit(struct converter_s **obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__CONVERTER_H__
@@ -0,0 +1,77 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file JpegError.h
+* \author Boubacar DIENE
+*/
+
+#ifndef __JPEG_ERROR_H__
+#define __JPEG_ERROR_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include <setjmp.h>
+#include <stdio.h>
+
+#include <jpeglib.h>
+
+#include "utils/Common.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* //////////////////////////////////// TYPES DECLARATION ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+struct jpeg_error_s;
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/* libjpeg's errors longjmp() to jmpBuf instead of exiting the process so it has to be set using
+ * setjmp() before calling libjpeg */
+struct jpeg_error_s {
+    struct jpeg_error_mgr mgr;
+    jmp_buf               jmpBuf;
+
+    uint8_t               isQuiet; /* 1 <=> libjpeg's messages are not logged */
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/** Returns the manager to give to cinfo->err */
+struct jpeg_error_mgr *JpegError_Init(struct jpeg_error_s *err, uint8_t isQuiet);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__JPEG_ERROR_H__
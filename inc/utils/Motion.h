@@ -0,0 +1,117 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file Motion.h
+* \author Boubacar DIENE
+*/
+
+#ifndef __MOTION_H__
+#define __MOTION_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include "utils/Common.h"
+#include "utils/Converter.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/* Score of frames whose every sampled luma value has changed by 255 */
+#define MOTION_MAX_SCORE         1000
+
+#define MOTION_DEFAULT_GRID_STEP 8
+
+/* -------------------------------------------------------------------------------------------- */
+/* //////////////////////////////////// TYPES DECLARATION ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum motion_error_e;
+
+struct motion_s;
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////////////// PUBLIC FUNCTIONS ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/** getScore    : Mean absolute luma difference between frame and the reference, scaled to
+ *                0 - MOTION_MAX_SCORE. MOTION_MAX_SCORE if there is no compatible reference
+ *  setReference: Keep a copy of the sampled rows of frame to compare next frames with
+ *
+ *  Only YUV frames are supported. Not reentrant */
+typedef enum motion_error_e (*motion_get_score_f)(struct motion_s *obj,
+                                                  struct converter_frame_s *frame,
+                                                  uint32_t *score);
+typedef enum motion_error_e (*motion_set_reference_f)(struct motion_s *obj,
+                                                      struct converter_frame_s *frame);
+
+typedef enum motion_error_e (*motion_get_kernel_f)(struct motion_s *obj,
+                                                   enum converter_kernel_e *kernel);
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum motion_error_e {
+    MOTION_ERROR_NONE,
+    MOTION_ERROR_INIT,
+    MOTION_ERROR_UNINIT,
+    MOTION_ERROR_PARAMS,
+    MOTION_ERROR_FORMAT
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// MAIN CONTEXT /////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+struct motion_s {
+    motion_get_score_f     getScore;
+    motion_set_reference_f setReference;
+
+    motion_get_kernel_f    getKernel;
+
+    void                   *pData;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/* Only one row out of gridStep is compared. 0 <=> MOTION_DEFAULT_GRID_STEP
+ * Return MOTION_ERROR_PARAMS if kernel is not supported by the running cpu */
+enum motion_error_e Motion_Init(struct motion_s **obj, enum converter_kernel_e kernel,
+                                uint32_t gridStep);
+enum motion_error_e Motion_UnInit(struct motion_s **obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__MOTION_H__
@@ -0,0 +1,124 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file Pattern.h
+* \author Boubacar DIENE
+*/
+
+#ifndef __PATTERN_H__
+#define __PATTERN_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include "utils/Common.h"
+#include "utils/Converter.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/* Stamps are drawn in the top-left corner as squares of PATTERN_STAMP_BLOCK_SIZE pixels, one
+ * per bit, so that they survive JPEG compression. Frames too small to hold the
+ * PATTERN_STAMP_NB_BITS squares are not stamped */
+#define PATTERN_STAMP_BLOCK_SIZE 8
+#define PATTERN_STAMP_NB_BITS    112
+
+/* -------------------------------------------------------------------------------------------- */
+/* //////////////////////////////////// TYPES DECLARATION ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum pattern_error_e;
+enum pattern_type_e;
+
+struct pattern_stamp_s;
+struct pattern_s;
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////////////// PUBLIC FUNCTIONS ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/** generate : Draw the pattern for frame number stamp->counter then the stamp itself
+ *  readStamp: Read back a stamp drawn by generate(). PATTERN_ERROR_NOT_FOUND if there is none
+ *
+ *  All converter formats are supported. Not reentrant */
+typedef enum pattern_error_e (*pattern_generate_f)(struct pattern_s *obj,
+                                                   struct converter_frame_s *frame,
+                                                   struct pattern_stamp_s *stamp);
+typedef enum pattern_error_e (*pattern_read_stamp_f)(struct pattern_s *obj,
+                                                     struct converter_frame_s *frame,
+                                                     struct pattern_stamp_s *stamp);
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum pattern_error_e {
+    PATTERN_ERROR_NONE,
+    PATTERN_ERROR_INIT,
+    PATTERN_ERROR_UNINIT,
+    PATTERN_ERROR_PARAMS,
+    PATTERN_ERROR_FORMAT,
+    PATTERN_ERROR_NOT_FOUND
+};
+
+enum pattern_type_e {
+    PATTERN_TYPE_BARS,  /* Colour bars moving to the left */
+    PATTERN_TYPE_NOISE, /* Random bytes i.e worst case for JPEG encoders */
+    PATTERN_TYPE_MAX
+};
+
+struct pattern_stamp_s {
+    uint32_t counter;
+    uint64_t timestamp_us;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// MAIN CONTEXT /////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+struct pattern_s {
+    pattern_generate_f   generate;
+    pattern_read_stamp_f readStamp;
+
+    void                 *pData;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum pattern_error_e Pattern_Init(struct pattern_s **obj, enum pattern_type_e type);
+enum pattern_error_e Pattern_UnInit(struct pattern_s **obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__PATTERN_H__
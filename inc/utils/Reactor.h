@@ -0,0 +1,122 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file Reactor.h
+* \author Boubacar DIENE
+*/
+
+#ifndef __REACTOR_H__
+#define __REACTOR_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include "utils/Common.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* //////////////////////////////////// TYPES DECLARATION ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum reactor_error_e;
+
+struct reactor_params_s;
+struct reactor_s;
+
+/* -------------------------------------------------------------------------------------------- */
+/* //////////////////////////////////////// CALLBACKS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/** Called from one of the reactor's threads each time fd is readable or in error. Callbacks of
+ * fds handled by the same thread are serialized so they must not block */
+typedef void (*reactor_on_event_cb)(struct reactor_s *obj, int32_t fd, uint32_t events,
+                                    void *userData);
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////////////// PUBLIC FUNCTIONS ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/** add    : fd is handled by the thread currently watching the fewest fds
+ * remove : Once it returns, onEventCb is not running and will not be called anymore for fd.
+ *          Must not be called from onEventCb
+ * suspend: Stop watching fd until resume() is called. Can be called from onEventCb */
+typedef enum reactor_error_e (*reactor_add_f)(struct reactor_s *obj, int32_t fd,
+                                              reactor_on_event_cb onEventCb, void *userData);
+typedef enum reactor_error_e (*reactor_remove_f)(struct reactor_s *obj, int32_t fd);
+
+typedef enum reactor_error_e (*reactor_suspend_f)(struct reactor_s *obj, int32_t fd);
+typedef enum reactor_error_e (*reactor_resume_f)(struct reactor_s *obj, int32_t fd);
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum reactor_error_e {
+    REACTOR_ERROR_NONE,
+    REACTOR_ERROR_INIT,
+    REACTOR_ERROR_UNINIT,
+    REACTOR_ERROR_LOCK,
+    REACTOR_ERROR_LIST,
+    REACTOR_ERROR_IO,
+    REACTOR_ERROR_PARAMS
+};
+
+struct reactor_params_s {
+    char            name[MAX_NAME_SIZE];
+    enum priority_e priority;
+
+    uint32_t        nbThreads;
+    uint8_t         pinThreads; /* Thread i runs on cpu (i % nb online cpus) */
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// MAIN CONTEXT /////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+struct reactor_s {
+    reactor_add_f     add;
+    reactor_remove_f  remove;
+
+    reactor_suspend_f suspend;
+    reactor_resume_f  resume;
+
+    void              *pData;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum reactor_error_e Reactor_Init(struct reactor_s **obj, struct reactor_params_s *params);
+enum reactor_error_e Reactor_UnInit(struct reactor_s **obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__REACTOR_H__
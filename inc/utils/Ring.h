@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file Ring.h
+* \author Boubacar DIENE
+*/
+
+#ifndef __RING_H__
+#define __RING_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include "utils/Common.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* //////////////////////////////////// TYPES DECLARATION ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum ring_error_e;
+
+struct ring_s;
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////////////// PUBLIC FUNCTIONS ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/** push: Must only be called by a single producer
+ * pop : Can be called concurrently by the consumer and by the producer (E.g. to drop the oldest
+ *       element when the ring is full) */
+typedef enum ring_error_e (*ring_push_f)(struct ring_s *obj, void *element);
+typedef enum ring_error_e (*ring_pop_f)(struct ring_s *obj, void **element);
+
+typedef enum ring_error_e (*ring_get_nb_elements_f)(struct ring_s *obj, uint32_t *nbElements);
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum ring_error_e {
+    RING_ERROR_NONE,
+    RING_ERROR_INIT,
+    RING_ERROR_UNINIT,
+    RING_ERROR_PARAMS,
+    RING_ERROR_FULL,
+    RING_ERROR_EMPTY
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// MAIN CONTEXT /////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+struct ring_s {
+    ring_push_f            push;
+    ring_pop_f             pop;
+
+    ring_get_nb_elements_f getNbElements;
+
+    void                   *pData;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum ring_error_e Ring_Init(struct ring_s **obj, uint32_t nbSlots);
+enum ring_error_e Ring_UnInit(struct ring_s **obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__RING_H__
@@ -0,0 +1,115 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/*!
+* \file Scaler.h
+* \author Boubacar DIENE
+*/
+
+#ifndef __SCALER_H__
+#define __SCALER_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include "utils/Common.h"
+#include "utils/Converter.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/* Higher downscale factors are refused */
+#define SCALER_MAX_RATIO 64
+
+/* -------------------------------------------------------------------------------------------- */
+/* //////////////////////////////////// TYPES DECLARATION ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum scaler_error_e;
+enum scaler_filter_e;
+
+struct scaler_s;
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////////////// PUBLIC FUNCTIONS ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/** scale: src and dst must have the same YUV format. Can be called concurrently */
+typedef enum scaler_error_e (*scaler_scale_f)(struct scaler_s *obj,
+                                              struct converter_frame_s *src,
+                                              struct converter_frame_s *dst,
+                                              enum scaler_filter_e filter);
+
+typedef enum scaler_error_e (*scaler_get_kernel_f)(struct scaler_s *obj,
+                                                   enum converter_kernel_e *kernel);
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum scaler_error_e {
+    SCALER_ERROR_NONE,
+    SCALER_ERROR_INIT,
+    SCALER_ERROR_UNINIT,
+    SCALER_ERROR_PARAMS,
+    SCALER_ERROR_FORMAT
+};
+
+enum scaler_filter_e {
+    SCALER_FILTER_BOX,      /* Average of covered pixels - Best for large downscale factors */
+    SCALER_FILTER_BILINEAR, /* Interpolation of the 4 nearest pixels                        */
+    SCALER_FILTER_MAX
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// MAIN CONTEXT /////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+struct scaler_s {
+    scaler_scale_f      scale;
+
+    scaler_get_kernel_f getKernel;
+
+    void                *pData;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/* Return SCALER_ERROR_PARAMS if kernel is not supported by the running cpu */
+enum scaler_error_e Scaler_Init(struct scaler_s **obj, enum converter_kernel_e kernel);
+enum scaler_error_e Scaler_UnInit(struct scaler_s **obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__SCALER_H__
@@ -0,0 +1,135 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file Clip.h
+* \author Boubacar DIENE
+*/
+
+#ifndef __CLIP_H__
+#define __CLIP_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include "utils/Common.h"
+#include "video/Video.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#define CLIP_DEFAULT_MEMORY_SIZE (32 * 1024 * 1024)
+
+/* Used to size the frames table: smaller frames only make the ring shorter than preEvent_s */
+#define CLIP_MIN_FRAME_SIZE      4096
+
+/* -------------------------------------------------------------------------------------------- */
+/* //////////////////////////////////// TYPES DECLARATION ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum clip_error_e;
+
+struct clip_params_s;
+struct clip_stats_s;
+struct clip_s;
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////////////// PUBLIC FUNCTIONS ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/** push    : Copy frame (all planes, one after the other) to the ring, evicting the oldest
+ *            frames not being dumped. Never blocks nor allocates memory. CLIP_ERROR_FULL is
+ *            returned and the frame dropped when the frames still to be dumped leave no room
+ *            for it. Not reentrant
+ *  dump    : Write the ring's content followed by the frames captured during the next
+ *            postEvent_s seconds (0 <=> params.postEvent_s) to <pathPrefix>.mjpeg (or .raw if
+ *            frames are not compressed) and index them in <pathPrefix>.idx. Files are written by
+ *            a background task. A dump requested while another one is running only extends it
+ *  getStats: Can be called from any thread */
+typedef enum clip_error_e (*clip_push_f)(struct clip_s *obj, struct video_buffer_s *videoBuffer);
+typedef enum clip_error_e (*clip_dump_f)(struct clip_s *obj, const char *pathPrefix,
+                                         uint32_t postEvent_s);
+typedef enum clip_error_e (*clip_get_stats_f)(struct clip_s *obj, struct clip_stats_s *stats);
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum clip_error_e {
+    CLIP_ERROR_NONE,
+    CLIP_ERROR_INIT,
+    CLIP_ERROR_UNINIT,
+    CLIP_ERROR_PARAMS,
+    CLIP_ERROR_FULL,
+    CLIP_ERROR_IO
+};
+
+struct clip_params_s {
+    char            name[MAX_NAME_SIZE];
+    enum priority_e priority;
+
+    uint32_t        pixelformat;
+    uint32_t        preEvent_s;  /* Frames older than that are evicted */
+    uint32_t        postEvent_s;
+    size_t          memorySize;  /* 0 <=> CLIP_DEFAULT_MEMORY_SIZE */
+};
+
+struct clip_stats_s {
+    uint64_t nbBufferedFrames;
+    uint64_t nbDroppedFrames;  /* No room left because of a running dump */
+    uint32_t nbDumps;
+    uint32_t nbWriteErrors;
+    uint32_t bufferedDuration_ms;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// MAIN CONTEXT /////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+struct clip_s {
+    clip_push_f      push;
+    clip_dump_f      dump;
+    clip_get_stats_f getStats;
+
+    void             *pData;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/* All memory is allocated here. Clip_UnInit() waits for the running dump to be written */
+enum clip_error_e Clip_Init(struct clip_s **obj, struct clip_params_s *params);
+enum clip_error_e Clip_UnInit(struct clip_s **obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__CLIP_H__
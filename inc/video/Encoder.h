@@ -0,0 +1,113 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file Encoder.h
+* \author Boubacar DIENE
+*/
+
+#ifndef __ENCODER_H__
+#define __ENCODER_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include "utils/Common.h"
+#include "utils/Converter.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#define ENCODER_DEFAULT_QUALITY 80
+#define ENCODER_MAX_SLICES      16
+
+/* -------------------------------------------------------------------------------------------- */
+/* //////////////////////////////////// TYPES DECLARATION ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum encoder_error_e;
+
+struct encoder_params_s;
+struct encoder_s;
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////////////// PUBLIC FUNCTIONS ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/** encode: Encode a whole frame to JPEG. out->data belongs to the encoder and remains valid
+ *          until the next call. Not reentrant */
+typedef enum encoder_error_e (*encoder_encode_f)(struct encoder_s *obj,
+                                                 struct converter_frame_s *in,
+                                                 struct buffer_s *out);
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum encoder_error_e {
+    ENCODER_ERROR_NONE,
+    ENCODER_ERROR_INIT,
+    ENCODER_ERROR_UNINIT,
+    ENCODER_ERROR_PARAMS,
+    ENCODER_ERROR_ENCODE
+};
+
+struct encoder_params_s {
+    char            name[MAX_NAME_SIZE];
+    enum priority_e priority;
+
+    uint32_t        width;
+    uint32_t        height;
+
+    uint8_t         quality;  /* 1 - 100. 0 <=> ENCODER_DEFAULT_QUALITY */
+    uint8_t         nbSlices; /* Horizontal bands encoded in parallel. 0 or 1 <=> No thread */
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// MAIN CONTEXT /////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+struct encoder_s {
+    encoder_encode_f encode;
+
+    void             *pData;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum encoder_error_e Encoder_Init(struct encoder_s **obj, struct encoder_params_s *params);
+enum encoder_error_e Encoder_UnInit(struct encoder_s **obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__ENCODER_H__
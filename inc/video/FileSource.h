@@ -0,0 +1,70 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file FileSource.h
+* \author Boubacar DIENE
+*/
+
+#ifndef __FILE_SOURCE_H__
+#define __FILE_SOURCE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include "video/V4l2.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/* Prefix of device paths to replay from a file e.g. "file:///tmp/capture.mjpeg" */
+#define FILE_SOURCE_SCHEME "file://"
+
+/* Prefix of device paths to generate a test pattern in memory i.e "pattern://bars" or
+ * "pattern://noise" */
+#define PATTERN_SOURCE_SCHEME "pattern://"
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/* Same interface as V4l2_Init() but frames are read from a MJPEG or raw YUV file, looped when
+ * its end is reached, at desiredFps (0 <=> As fast as buffers are queued back).
+ * Width and height of MJPEG files are the ones of their first frame. Those of patterns are the
+ * requested ones, width being rounded down to an even value. Patterns carry their sequence and
+ * capture time in pixels (See Pattern.h). Selection API is not supported: cropping and composing
+ * areas are always the full frame */
+enum v4l2_error_e FileSource_Init(struct v4l2_s **obj);
+enum v4l2_error_e FileSource_UnInit(struct v4l2_s **obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__FILE_SOURCE_H__
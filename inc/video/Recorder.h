@@ -0,0 +1,147 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file Recorder.h
+* \author Boubacar DIENE
+*/
+
+#ifndef __RECORDER_H__
+#define __RECORDER_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include "utils/Common.h"
+#include "video/Video.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#define RECORDER_DEFAULT_BUFFER_SIZE  (4 * 1024 * 1024)
+#define RECORDER_DEFAULT_NB_BUFFERS   4
+
+/* AVI 1.0 offsets are 32 bits long */
+#define RECORDER_MAX_SEGMENT_SIZE     (1024 * 1024 * 1024ULL)
+
+/* -------------------------------------------------------------------------------------------- */
+/* //////////////////////////////////// TYPES DECLARATION ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum recorder_error_e;
+enum recorder_container_e;
+
+struct recorder_params_s;
+struct recorder_stats_s;
+struct recorder_s;
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////////////// PUBLIC FUNCTIONS ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/** record  : Copy frame (all planes, one after the other) to the write-behind buffers. Never
+ *            blocks: RECORDER_ERROR_FULL is returned and the frame dropped when the disk is too
+ *            slow to free enough buffers. Not reentrant
+ *  getStats: Can be called from any thread */
+typedef enum recorder_error_e (*recorder_record_f)(struct recorder_s *obj,
+                                                   struct video_buffer_s *videoBuffer);
+typedef enum recorder_error_e (*recorder_get_stats_f)(struct recorder_s *obj,
+                                                      struct recorder_stats_s *stats);
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum recorder_error_e {
+    RECORDER_ERROR_NONE,
+    RECORDER_ERROR_INIT,
+    RECORDER_ERROR_UNINIT,
+    RECORDER_ERROR_PARAMS,
+    RECORDER_ERROR_FULL
+};
+
+enum recorder_container_e {
+    RECORDER_CONTAINER_AVI, /* RIFF AVI 1.0 with an idx1 index */
+    RECORDER_CONTAINER_RAW  /* Frames one after the other, indexed by a ".idx" text file */
+};
+
+/* Segments are named <directory>/<name>-<YYYYMMDD-HHMMSS>-<number>.<avi|raw> */
+struct recorder_params_s {
+    char                      name[MAX_NAME_SIZE];
+    enum priority_e           priority;
+
+    char                      directory[MAX_PATH_SIZE];
+    enum recorder_container_e container;
+
+    uint32_t                  pixelformat;
+    uint32_t                  width;
+    uint32_t                  height;
+    uint32_t                  fps;             /* Only used until the real rate is known */
+
+    uint64_t                  maxSegmentSize;  /* In bytes. 0 <=> RECORDER_MAX_SEGMENT_SIZE */
+    uint32_t                  maxSegmentDuration_s; /* 0 <=> No limit */
+
+    size_t                    bufferSize;      /* 0 <=> RECORDER_DEFAULT_BUFFER_SIZE */
+    uint32_t                  nbBuffers;       /* 0 <=> RECORDER_DEFAULT_NB_BUFFERS */
+    uint8_t                   directIo;        /* Bypass page cache (O_DIRECT) if supported */
+};
+
+struct recorder_stats_s {
+    uint64_t nbRecordedFrames;
+    uint64_t nbDroppedFrames;
+    uint64_t nbWrittenBytes;
+    uint32_t nbSegments;
+    uint32_t nbWriteErrors;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// MAIN CONTEXT /////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+struct recorder_s {
+    recorder_record_f    record;
+    recorder_get_stats_f getStats;
+
+    void                 *pData;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/* Frames are written by a dedicated task. Recorder_UnInit() flushes pending buffers and closes
+ * the current segment */
+enum recorder_error_e Recorder_Init(struct recorder_s **obj, struct recorder_params_s *params);
+enum recorder_error_e Recorder_UnInit(struct recorder_s **obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__RECORDER_H__
@@ -0,0 +1,116 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/*!
+* \file Resizer.h
+* \author Boubacar DIENE
+*/
+
+#ifndef __RESIZER_H__
+#define __RESIZER_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include "utils/Common.h"
+#include "utils/Scaler.h"
+
+#include "video/Video.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* //////////////////////////////////// TYPES DECLARATION ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum resizer_error_e;
+
+struct resizer_params_s;
+struct resizer_s;
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////////////// PUBLIC FUNCTIONS ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/** resize: Resize a captured frame. out->data belongs to the resizer and remains valid until the
+ *          next call. Not reentrant */
+typedef enum resizer_error_e (*resizer_resize_f)(struct resizer_s *obj,
+                                                 struct video_buffer_s *in,
+                                                 struct buffer_s *out);
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum resizer_error_e {
+    RESIZER_ERROR_NONE,
+    RESIZER_ERROR_INIT,
+    RESIZER_ERROR_UNINIT,
+    RESIZER_ERROR_PARAMS,
+    RESIZER_ERROR_RESIZE
+};
+
+/* Output frames are JPEG when captured ones are MJPEG or jpegQuality is set. Otherwise they have
+ * the captured format except that NV12M planes are made contiguous (i.e NV12) */
+struct resizer_params_s {
+    char                 name[MAX_NAME_SIZE];
+    enum priority_e      priority;
+
+    uint32_t             pixelformat; /* V4L2_PIX_FMT_MJPEG, _YUYV, _YVYU, _UYVY,
+                                         _NV12 or _NV12M */
+    uint32_t             srcWidth;
+    uint32_t             srcHeight;
+
+    uint32_t             dstWidth;
+    uint32_t             dstHeight;
+    enum scaler_filter_e filter;
+
+    uint8_t              jpegQuality; /* 0 <=> Raw output or ENCODER_DEFAULT_QUALITY with MJPEG */
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// MAIN CONTEXT /////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+struct resizer_s {
+    resizer_resize_f resize;
+
+    void             *pData;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum resizer_error_e Resizer_Init(struct resizer_s **obj, struct resizer_params_s *params);
+enum resizer_error_e Resizer_UnInit(struct resizer_s **obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__RESIZER_H__
@@ -0,0 +1,141 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file Sync.h
+* \author Boubacar DIENE
+*/
+
+#ifndef __SYNC_H__
+#define __SYNC_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include "utils/Common.h"
+#include "video/Video.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/* Frames of one member waiting for the others. Each of them holds a driver's buffer */
+#define SYNC_MAX_PENDING_FRAMES 2
+
+/* -------------------------------------------------------------------------------------------- */
+/* //////////////////////////////////// TYPES DECLARATION ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum sync_error_e;
+
+struct sync_params_s;
+struct sync_s;
+
+/* -------------------------------------------------------------------------------------------- */
+/* //////////////////////////////////////// CALLBACKS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/** Called when a pushed buffer is not needed anymore i.e after it has been delivered in a set or
+ * dropped because unmatched */
+typedef void (*sync_on_release_cb)(struct video_buffer_s *videoBuffer, void *userData);
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////////////// PUBLIC FUNCTIONS ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/** join          : Add a device to the group. SYNC_ERROR_FULL if it has VIDEO_MAX_SYNC_MEMBERS
+ *  leave         : Drop member's pending frames. nbMembersOut tells whether group is now empty
+ *  push          : Hand a retained buffer over. Sets are delivered to listeners from the caller's
+ *                  thread as soon as each member has a frame close enough to the others
+ *  addListener   : Listener is copied
+ *  removeListener: Must not be called from onFrameSetAvailableCb() */
+typedef enum sync_error_e (*sync_join_f)(struct sync_s *obj, const char *memberName,
+                                         uint32_t *memberOut);
+typedef enum sync_error_e (*sync_leave_f)(struct sync_s *obj, uint32_t member,
+                                          uint32_t *nbMembersOut);
+typedef enum sync_error_e (*sync_push_f)(struct sync_s *obj, uint32_t member,
+                                         struct video_buffer_s *videoBuffer);
+typedef enum sync_error_e (*sync_add_listener_f)(struct sync_s *obj,
+                                                 struct video_sync_listener_s *listener);
+typedef enum sync_error_e (*sync_remove_listener_f)(struct sync_s *obj,
+                                                    struct video_sync_listener_s *listener);
+typedef enum sync_error_e (*sync_get_stats_f)(struct sync_s *obj,
+                                              struct video_sync_stats_s *stats);
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+enum sync_error_e {
+    SYNC_ERROR_NONE,
+    SYNC_ERROR_INIT,
+    SYNC_ERROR_UNINIT,
+    SYNC_ERROR_LOCK,
+    SYNC_ERROR_LIST,
+    SYNC_ERROR_PARAMS,
+    SYNC_ERROR_FULL
+};
+
+struct sync_params_s {
+    char               name[MAX_NAME_SIZE];
+    uint64_t           tolerance_us;  /* Max difference between capture times of a set */
+
+    sync_on_release_cb onReleaseCb;
+    void               *userData;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// MAIN CONTEXT /////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+struct sync_s {
+    sync_join_f            join;
+    sync_leave_f           leave;
+    sync_push_f            push;
+
+    sync_add_listener_f    addListener;
+    sync_remove_listener_f removeListener;
+
+    sync_get_stats_f       getStats;
+
+    void                   *pData;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/* All members must have left before Sync_UnInit() is called */
+enum sync_error_e Sync_Init(struct sync_s **obj, struct sync_params_s *params);
+enum sync_error_e Sync_UnInit(struct sync_s **obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__SYNC_H__
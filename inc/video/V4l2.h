@@ -52,7 +52,9 @@ struct v4l2_open_device_params_s;
 struct v4l2_configure_device_params_s;
 struct v4l2_selection_params_s;
 struct v4l2_request_buffers_params_s;
+struct v4l2_mapping_plane_s;
 struct v4l2_mapping_buffer_s;
+struct v4l2_dequeued_buffer_s;
 struct v4l2_s;
 
 /* -------------------------------------------------------------------------------------------- */
@@ -81,7 +83,16 @@ typedef enum v4l2_error_e (*v4l2_await_data_f)(struct v4l2_s *obj, int32_t timeo
 typedef enum v4l2_error_e (*v4l2_stop_awaiting_data_f)(struct v4l2_s *obj);
 
 typedef enum v4l2_error_e (*v4l2_queue_buffer_f)(struct v4l2_s *obj, uint32_t index);
-typedef enum v4l2_error_e (*v4l2_dequeue_buffer_f)(struct v4l2_s *obj);
+typedef enum v4l2_error_e (*v4l2_dequeue_buffer_f)(struct v4l2_s *obj,
+                                                   struct v4l2_dequeued_buffer_s *bufferOut);
+
+/** disconnectDevice: Close a device which has gone away. Buffers, negotiated format and selection
+ *                    are kept. quitFd remains usable
+ *  reconnectDevice : Reopen path then reapply cached format, framerate, selection and buffers
+ *                    without any probing. MMAP buffers are mapped again at the same addresses.
+ *                    V4L2_ERROR_UNKNOWN_DEVICE while path does not exist */
+typedef enum v4l2_error_e (*v4l2_disconnect_device_f)(struct v4l2_s *obj);
+typedef enum v4l2_error_e (*v4l2_reconnect_device_f)(struct v4l2_s *obj);
 
 /* -------------------------------------------------------------------------------------------- */
 /* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
@@ -94,7 +105,8 @@ enum v4l2_error_e {
     V4L2_ERROR_CAPTURE,
     V4L2_ERROR_TIMEOUT,
     V4L2_ERROR_UNKNOWN_DEVICE,
-    V4L2_ERROR_BAD_CAPS
+    V4L2_ERROR_BAD_CAPS,
+    V4L2_ERROR_DISCONNECTED
 };
 
 enum v4l2_pipe_e {
@@ -129,11 +141,26 @@ struct v4l2_request_buffers_params_s {
     enum v4l2_memory memory;
 };
 
-struct v4l2_mapping_buffer_s {
-    uint32_t index;
+struct v4l2_mapping_plane_s {
     size_t   length;
     uint32_t offset;
     void     *start;
+    int32_t  dmabufFd; /* Exported (MMAP) or imported (DMABUF) dma-buf, -1 if none */
+};
+
+/* Single-planar buffers only use planes[0] */
+struct v4l2_mapping_buffer_s {
+    uint32_t                    index;
+    uint32_t                    nbPlanes;
+    struct v4l2_mapping_plane_s planes[VIDEO_MAX_PLANES];
+};
+
+struct v4l2_dequeued_buffer_s {
+    uint32_t       index;                       /* Index in map */
+    size_t         bytesused[VIDEO_MAX_PLANES]; /* Size of the payload e.g. of a JPEG frame */
+    struct timeval timestamp;
+    uint8_t        isMonotonic;                 /* timestamp taken from CLOCK_MONOTONIC */
+    uint32_t       sequence;
 };
 
 /* -------------------------------------------------------------------------------------------- */
@@ -160,18 +187,31 @@ struct v4l2_s {
     v4l2_queue_buffer_f       queueBuffer;
     v4l2_dequeue_buffer_f     dequeueBuffer;
 
+    v4l2_disconnect_device_f  disconnectDevice;
+    v4l2_reconnect_device_f   reconnectDevice;
+
     char                         path[MAX_PATH_SIZE];
     int32_t                      deviceFd;
     int32_t                      quitFd[V4L2_PIPE_COUNT];
 
     struct v4l2_capability       caps;
     struct v4l2_format           format;
+    uint8_t                      isMplane;
+    uint32_t                     width;
+    uint32_t                     height;
     enum   v4l2_memory           memory;
+
+    /* Applied settings, replayed by reconnectDevice() - type = 0 <=> not set */
+    struct v4l2_streamparm       streamparm;
+    struct v4l2_selection        cropSelection;
+    struct v4l2_selection        composeSelection;
     
     uint32_t                     nbBuffers;
     size_t                       maxBufferSize;
     
     struct v4l2_mapping_buffer_s *map;
+
+    void                         *pData; /* Private data of non-v4l2 backends e.g. FileSource */
 };
 
 /* -------------------------------------------------------------------------------------------- */
@@ -38,19 +38,34 @@ extern "C" {
 /* -------------------------------------------------------------------------------------------- */
 
 #include "utils/Common.h"
+#include "utils/Motion.h"
 #include "video/V4l2.h"
 
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#define VIDEO_MAX_SYNC_MEMBERS 4
+
 /* -------------------------------------------------------------------------------------------- */
 /* //////////////////////////////////// TYPES DECLARATION ///////////////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
 
 enum video_error_e;
 enum video_await_mode_e;
+enum video_overflow_policy_e;
+enum video_delivery_e;
 
+struct video_init_params_s;
+struct video_plane_s;
 struct video_buffer_s;
 struct video_listener_s;
+struct video_frame_set_s;
+struct video_sync_listener_s;
+struct video_sync_stats_s;
 struct video_area_s;
 struct video_params_s;
+struct video_stats_s;
 struct video_s;
 
 /* -------------------------------------------------------------------------------------------- */
@@ -59,6 +74,14 @@ struct video_s;
 
 typedef void (*video_on_buffer_available_cb)(struct video_buffer_s *videoBuffer, void *userData);
 
+/** Called from the notification task of the device whose frame completed the set */
+typedef void (*video_on_frame_set_available_cb)(struct video_frame_set_s *frameSet,
+                                                void *userData);
+
+/** Called from the notification task when the scene starts (isMoving = 1) or stops changing */
+typedef void (*video_on_motion_cb)(char *videoName, uint32_t score, uint8_t isMoving,
+                                   void *userData);
+
 /* -------------------------------------------------------------------------------------------- */
 /* ///////////////////////////////////// PUBLIC FUNCTIONS ///////////////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
@@ -70,12 +93,39 @@ typedef enum video_error_e (*video_unregister_listener_f)(struct video_s *obj,
                                                           struct video_params_s *params,
                                                           struct video_listener_s *listener);
 
+/** registerSyncListener: Receive the matched frames of the devices started with the same
+ *                       syncGroup. Group must have at least one started device */
+typedef enum video_error_e (*video_register_sync_listener_f)(struct video_s *obj,
+                                                             const char *syncGroup,
+                                                             struct video_sync_listener_s *listener);
+typedef enum video_error_e (*video_unregister_sync_listener_f)(struct video_s *obj,
+                                                               const char *syncGroup,
+                                                               struct video_sync_listener_s *listener);
+typedef enum video_error_e (*video_get_sync_stats_f)(struct video_s *obj, const char *syncGroup,
+                                                     struct video_sync_stats_s *stats);
+
 typedef enum video_error_e (*video_get_final_area_f)(struct video_s *obj,
                                                      struct video_params_s *params,
                                                      struct video_area_s *videoArea);
 typedef enum video_error_e (*video_get_max_buffer_size_f)(struct video_s *obj,
                                                           struct video_params_s *params,
                                                           size_t *size);
+typedef enum video_error_e (*video_get_stats_f)(struct video_s *obj,
+                                                struct video_params_s *params,
+                                                struct video_stats_s *stats);
+
+/** retainBuffer : Keep videoBuffer's content valid after onVideoBufferAvailableCb() returns
+ * releaseBuffer: Give buffer back to the driver once the last reference is dropped */
+typedef enum video_error_e (*video_retain_buffer_f)(struct video_s *obj,
+                                                    struct video_buffer_s *videoBuffer);
+typedef enum video_error_e (*video_release_buffer_f)(struct video_s *obj,
+                                                     struct video_buffer_s *videoBuffer);
+
+/** dumpClip: Save the frames kept in memory (See clipPreEvent_s) followed by those captured
+ *            during the next postEvent_s seconds (0 <=> params->clipPostEvent_s). Files are
+ *            written by a background task */
+typedef enum video_error_e (*video_dump_clip_f)(struct video_s *obj, struct video_params_s *params,
+                                                const char *pathPrefix, uint32_t postEvent_s);
 
 typedef enum video_error_e (*video_start_device_capture_f)(struct video_s *obj,
                                                            struct video_params_s *params);
@@ -94,7 +144,9 @@ enum video_error_e {
     VIDEO_ERROR_LIST,
     VIDEO_ERROR_START,
     VIDEO_ERROR_STOP,
-    VIDEO_ERROR_PARAMS
+    VIDEO_ERROR_PARAMS,
+    VIDEO_ERROR_CLIP,
+    VIDEO_ERROR_SYNC
 };
 
 enum video_await_mode_e {
@@ -102,18 +154,99 @@ enum video_await_mode_e {
     VIDEO_AWAIT_MODE_NON_BLOCKING
 };
 
-struct video_buffer_s {
-    uint32_t index;
-    uint32_t offset;
+enum video_overflow_policy_e {
+    VIDEO_OVERFLOW_POLICY_DROP_OLDEST, /* Replace the oldest frame not notified yet */
+    VIDEO_OVERFLOW_POLICY_DROP_NEWEST, /* Drop the frame that has just been captured */
+    VIDEO_OVERFLOW_POLICY_BLOCK        /* Wait until the notification task frees a slot */
+};
+
+enum video_delivery_e {
+    VIDEO_DELIVERY_SYNC,         /* Called from the notification task (default) */
+    VIDEO_DELIVERY_ASYNC,        /* Called from listener's own task - New frames dropped if late */
+    VIDEO_DELIVERY_ASYNC_LATEST  /* Called from listener's own task - Only latest frames kept */
+};
+
+/* nbCaptureThreads = 0 => Each device is handled by its own capture and notification tasks
+ * nbCaptureThreads > 0 => All devices are handled by a shared pool of epoll-based threads */
+struct video_init_params_s {
+    uint32_t nbCaptureThreads;
+    uint8_t  pinCaptureThreads; /* Capture thread i runs on cpu (i % nb online cpus) */
+};
+
+struct video_plane_s {
     void     *data;
-    size_t   length;
+    size_t   length;       /* Size of the payload i.e bytesused */
+    int32_t  dmabufFd;     /* dma-buf to share plane without copy, -1 if not available */
+    uint32_t bytesPerLine; /* Negotiated with the driver, 0 if unknown */
+};
+
+/* data, length and dmabufFd describe the first plane. Listeners handling multi-planar formats
+ * (e.g. NV12 with V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE) have to use planes[] */
+struct video_buffer_s {
+    uint32_t             index;
+    uint32_t             offset;
+    void                 *data;
+    size_t               length;
+    int32_t              dmabufFd;
+
+    uint32_t             nbPlanes;
+    struct video_plane_s planes[VIDEO_MAX_PLANES];
+
+    struct timeval       timestamp;      /* Set by the driver */
+    uint32_t             sequence;       /* Set by the driver - Gaps <=> frames lost by driver */
+
+    /* CLOCK_MONOTONIC stamps to measure latency */
+    uint64_t             captureTime_us; /* timestamp if monotonic, dequeueTime_us otherwise */
+    uint64_t             dequeueTime_us;
+    uint64_t             notifyTime_us;
+
+    uint32_t             motionScore;    /* 0 - MOTION_MAX_SCORE if change detection is enabled */
+
+    void                 *reserved; /* Frame handle - Do not modify */
 };
 
+/* The buffer given to onVideoBufferAvailableCb() points to the driver's memory. It remains valid
+ * until the next frame is delivered to the same listener or until the listener is unregistered.
+ * Use retainBuffer()/releaseBuffer() to keep it longer.
+ *
+ * If the device is unplugged, listeners stay registered and frames are delivered again once it is
+ * back. Buffers retained across the reconnection stay mapped but their content is undefined.
+ *
+ * With asynchronous delivery, a slow listener only delays itself: up to queueSize frames wait for
+ * its task and the others are dropped according to delivery mode.
+ *
+ * Frames skipped because of maxFps / everyNthFrame are neither retained nor given to listener */
 struct video_listener_s {
     char                         name[MAX_NAME_SIZE];
 
     video_on_buffer_available_cb onVideoBufferAvailableCb;
     void                         *userData;
+
+    uint32_t                     maxFps;        /* 0 <=> No limit */
+    uint32_t                     everyNthFrame; /* 0 or 1 <=> All frames */
+
+    enum video_delivery_e        delivery;
+    uint32_t                     queueSize; /* Async delivery only - 0 means 1 */
+};
+
+/* One frame per started member of the group, in the order members joined it. Capture times of
+ * the frames differ by at most the group's tolerance. Buffers are only valid during the callback
+ * unless retained using retainBuffer() */
+struct video_frame_set_s {
+    char                  syncGroup[MAX_NAME_SIZE];
+
+    uint32_t              nbBuffers;
+    char                  names[VIDEO_MAX_SYNC_MEMBERS][MAX_NAME_SIZE];
+    struct video_buffer_s *buffers[VIDEO_MAX_SYNC_MEMBERS];
+
+    uint64_t              skew_us; /* Newest - oldest capture time */
+};
+
+struct video_sync_listener_s {
+    char                            name[MAX_NAME_SIZE];
+
+    video_on_frame_set_available_cb onFrameSetAvailableCb;
+    void                            *userData;
 };
 
 struct video_area_s {
@@ -124,30 +257,76 @@ struct video_area_s {
 };
 
 struct video_params_s {
-    char                    name[MAX_NAME_SIZE];
+    char                         name[MAX_NAME_SIZE];
 
     /* Open device */
-    char                    path[MAX_PATH_SIZE];
-    uint32_t                caps;
+    char                         path[MAX_PATH_SIZE];
+    uint32_t                     caps;
     
     /* Configure device */
-    enum v4l2_buf_type      type;
-    uint32_t                pixelformat;
-    enum v4l2_colorspace    colorspace;
+    enum v4l2_buf_type           type;
+    uint32_t                     pixelformat;
+    enum v4l2_colorspace         colorspace;
     
-    enum priority_e         priority;
-    uint32_t                desiredFps;
+    enum priority_e              priority;
+    uint32_t                     desiredFps;
     
-    struct video_area_s     captureArea;
-    struct video_area_s     croppingArea;
-    struct video_area_s     composingArea;
+    struct video_area_s          captureArea;
+    struct video_area_s          croppingArea;
+    struct video_area_s          composingArea;
     
     /* Request buffers */
-    uint32_t                count;
-    enum v4l2_memory        memory;
+    uint32_t                     count;
+    enum v4l2_memory             memory;
     
     /* Await data */
-    enum video_await_mode_e awaitMode;
+    enum video_await_mode_e      awaitMode;
+
+    /* Frames waiting to be notified */
+    uint32_t                     nbSlots;
+    enum video_overflow_policy_e overflowPolicy;
+
+    /* Change detection - YUV formats only. Frames whose motion score is below motionThreshold
+     * are not given to listeners except one per keepAliveInterval_ms */
+    uint32_t                     motionThreshold;      /* 0 <=> Disabled */
+    uint32_t                     motionGridStep;       /* 0 <=> MOTION_DEFAULT_GRID_STEP */
+    uint32_t                     keepAliveInterval_ms; /* 0 <=> Unchanged frames always skipped */
+    video_on_motion_cb           onMotionCb;
+    void                         *userData;
+
+    /* Pre-event clip - Frames of the last clipPreEvent_s seconds are kept in a ring allocated
+     * when capture starts so that dumpClip() can save what happened before an incident */
+    uint32_t                     clipPreEvent_s;  /* 0 <=> Disabled */
+    uint32_t                     clipPostEvent_s;
+    size_t                       clipMemorySize;  /* 0 <=> CLIP_DEFAULT_MEMORY_SIZE */
+
+    /* Sync group - Frames of devices sharing the same syncGroup are matched by capture time and
+     * given together to sync listeners. Tolerance is set by the first started device */
+    char                         syncGroup[MAX_NAME_SIZE]; /* "" <=> Not synchronized */
+    uint32_t                     syncTolerance_us;         /* 0 <=> Half a frame period */
+};
+
+struct video_stats_s {
+    uint64_t nbCapturedFrames;
+    uint64_t nbNotifiedFrames;
+    uint64_t nbDroppedFrames;
+    uint64_t nbLostFrames;          /* Never dequeued i.e dropped by the driver */
+    uint64_t nbStillFrames;         /* Not notified because unchanged */
+
+    uint64_t lastDequeueLatency_us; /* Capture -> dequeue */
+    uint64_t lastNotifyLatency_us;  /* Capture -> notification */
+    uint64_t maxNotifyLatency_us;
+
+    uint64_t nbReconnections;          /* Device unplugged then plugged again */
+    uint64_t lastReconnectDuration_us; /* Reopen -> capture restarted */
+};
+
+struct video_sync_stats_s {
+    uint32_t nbMembers;
+    uint64_t nbFrameSets;
+    uint64_t nbUnmatchedFrames; /* Dropped because no frame of another member was close enough */
+    uint64_t lastSkew_us;
+    uint64_t maxSkew_us;
 };
 
 /* -------------------------------------------------------------------------------------------- */
@@ -155,24 +334,33 @@ struct video_params_s {
 /* -------------------------------------------------------------------------------------------- */
 
 struct video_s {
-    video_register_listener_f    registerListener;
-    video_unregister_listener_f  unregisterListener;
+    video_register_listener_f        registerListener;
+    video_unregister_listener_f      unregisterListener;
+
+    video_register_sync_listener_f   registerSyncListener;
+    video_unregister_sync_listener_f unregisterSyncListener;
+    video_get_sync_stats_f           getSyncStats;
+
+    video_get_final_area_f           getFinalVideoArea;
+    video_get_max_buffer_size_f      getMaxBufferSize;
+    video_get_stats_f                getStats;
+
+    video_retain_buffer_f            retainBuffer;
+    video_release_buffer_f           releaseBuffer;
 
-    video_get_final_area_f       getFinalVideoArea;
-    video_get_max_buffer_size_f  getMaxBufferSize;
+    video_dump_clip_f                dumpClip;
 
-    video_start_device_capture_f startDeviceCapture;
-    video_stop_device_capture_f  stopDeviceCapture;
+    video_start_device_capture_f     startDeviceCapture;
+    video_stop_device_capture_f      stopDeviceCapture;
 
-    struct video_buffer_s buffer;
-    void                  *pData;
+    void                             *pData;
 };
 
 /* -------------------------------------------------------------------------------------------- */
 /* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
 
-enum video_error_e Video_Init(struct video_s **obj);
+enum video_error_e Video_Init(struct video_s **obj, struct video_init_params_s *params);
 enum video_error_e Video_UnInit(struct video_s **obj);
 
 #ifdef __cplusplus
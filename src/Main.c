@@ -153,8 +153,13 @@ int main(int argc, char **argv)
         goto graphicsInitExit;
     }
     
+    struct video_init_params_s videoInitParams = {
+        .nbCaptureThreads  = input->videosCaptureThreads,
+        .pinCaptureThreads = input->videosPinCaptureThreads
+    };
+
     if (input->videosConfig.enable
-        && (Video_Init(&modules->videoObj) != VIDEO_ERROR_NONE)) {
+        && (Video_Init(&modules->videoObj, &videoInitParams) != VIDEO_ERROR_NONE)) {
         Loge("Video_Init() failed");
         goto videoInitExit;
     }
@@ -371,6 +376,15 @@ int main(int argc, char **argv)
                     goto registerVideoListenersExit;
                 }
             }
+
+            if (videoDevice->syncListener
+                && (modules->videoObj->registerSyncListener(modules->videoObj,
+                                                            videoDevice->videoParams.syncGroup,
+                                                            videoDevice->syncListener)
+                                                            != VIDEO_ERROR_NONE)) {
+                Loge("Failed to register listener \"%s\"", videoDevice->syncListener->name);
+                goto registerVideoListenersExit;
+            }
         }
     }
     
@@ -402,6 +416,13 @@ registerVideoListenersExit:
                                                                 &videoDevice->videoParams,
                                                                 videoListeners[index]);
                 }
+
+                if (videoDevice->syncListener) {
+                    (void)modules->videoObj->unregisterSyncListener(
+                                                    modules->videoObj,
+                                                    videoDevice->videoParams.syncGroup,
+                                                    videoDevice->syncListener);
+                }
             }
         }
     }
@@ -850,6 +871,18 @@ static void onVideosCb(void *userData, const char **attrs)
     	    .attrValue.vector  = (void**)&input->videosConfig.xml,
     	    .attrGetter.vector = parserObj->getString
         },
+    	{
+    	    .attrName          = XML_ATTR_CAPTURE_THREADS,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&input->videosCaptureThreads,
+    	    .attrGetter.scalar = parserObj->getUint32
+        },
+    	{
+    	    .attrName          = XML_ATTR_PIN_CAPTURE_THREADS,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&input->videosPinCaptureThreads,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
     	{
     	    NULL,
     	    PARSER_ATTR_TYPE_NONE,
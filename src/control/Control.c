@@ -91,6 +91,8 @@ static enum control_error_e handleClick_f(struct control_s *obj,
                                           struct gfx_event_s *gfxEvent);
 static enum control_error_e handleCommand_f(struct control_s *obj,
                                             struct controllers_command_s *command);
+static enum control_error_e handleMotion_f(struct control_s *obj, char *videoName,
+                                           uint32_t score, uint8_t isMoving);
 
 /* -------------------------------------------------------------------------------------------- */
 /* //////////////////////////////////////// CALLBACKS ///////////////////////////////////////// */
@@ -128,7 +130,8 @@ static struct control_commands_list_s gCommandsList[] = {
     { CONTROLLER_COMMAND_UPDATE_TEXT,         HANDLERS_COMMAND_UPDATE_TEXT,         1,  1 },
     { CONTROLLER_COMMAND_UPDATE_IMAGE,        HANDLERS_COMMAND_UPDATE_IMAGE,        1,  1 },
     { CONTROLLER_COMMAND_UPDATE_NAV,          HANDLERS_COMMAND_UPDATE_NAV,          1,  1 },
-    { CONTROLLER_COMMAND_SEND_GFX_EVENT,      HANDLERS_COMMAND_SEND_GFX_EVENT,      0,  0 }
+    { CONTROLLER_COMMAND_SEND_GFX_EVENT,      HANDLERS_COMMAND_SEND_GFX_EVENT,      0,  0 },
+    { CONTROLLER_COMMAND_DUMP_VIDEO_CLIP,     HANDLERS_COMMAND_DUMP_VIDEO_CLIP,     0,  0 }
 };
 
 uint32_t gNbCommands = (uint32_t)(sizeof(gCommandsList) / sizeof(gCommandsList[0]));
@@ -194,6 +197,7 @@ enum control_error_e Control_Init(struct control_s **obj, struct context_s *ctx)
 
     (*obj)->handleClick          = handleClick_f;
     (*obj)->handleCommand        = handleCommand_f;
+    (*obj)->handleMotion         = handleMotion_f;
 
     pData->ctx = ctx;
 
@@ -608,6 +612,29 @@ static enum control_error_e handleCommand_f(struct control_s *obj,
     return ret;
 }
 
+/*!
+ *
+ */
+static enum control_error_e handleMotion_f(struct control_s *obj, char *videoName,
+                                           uint32_t score, uint8_t isMoving)
+{
+    ASSERT(obj && obj->pData && videoName);
+
+    struct control_private_data_s *pData = (struct control_private_data_s*)(obj->pData);
+    struct controllers_s *controllersObj = pData->controllersObj;
+
+    struct controller_event_s event = {0};
+    event.id    = (isMoving ? CONTROLLER_EVENT_MOTION : CONTROLLER_EVENT_STILL);
+    event.name  = videoName;
+    event.value = score;
+
+    if (controllersObj->notify(controllersObj, &event) != CONTROLLERS_ERROR_NONE) {
+        return CONTROL_ERROR_UNKNOWN;
+    }
+
+    return CONTROL_ERROR_NONE;
+}
+
 /* -------------------------------------------------------------------------------------------- */
 /* //////////////////////////////////////// CALLBACKS ///////////////////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
@@ -704,7 +731,7 @@ static void onModuleStateChangedCb(void *userData, char *name, enum module_state
     struct control_private_data_s *pData = (struct control_private_data_s*)(obj->pData);
     struct controllers_s *controllersObj = pData->controllersObj;
 
-    struct controller_event_s event;
+    struct controller_event_s event = {0};
     event.id   = state;
     event.name = name;
 
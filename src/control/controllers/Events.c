@@ -271,9 +271,10 @@ enum controllers_error_e notify_f(struct controllers_s *obj, struct controller_e
     Logd("Notify contoller - event id : \"%u\"", event->id);
 
     ASSERT((element = calloc(1, sizeof(struct events_list_element_s))));
-    element->seconds    = time(NULL);
-    element->event.id   = event->id;
-    element->event.name = strdup(event->name);
+    element->seconds     = time(NULL);
+    element->event.id    = event->id;
+    element->event.name  = strdup(event->name);
+    element->event.value = event->value;
 
     (void)evtsList->add(evtsList, (void*)element);
 
@@ -79,6 +79,8 @@ static enum handlers_error_e stopVideo(struct handlers_s *obj, char *gfxElementN
                                        void *gfxElementData, char *handlerData);
 static enum handlers_error_e startVideo(struct handlers_s *obj, char *gfxElementName,
                                         void *gfxElementData, char *handlerData);
+static enum handlers_error_e dumpVideoClip(struct handlers_s *obj, char *gfxElementName,
+                                           void *gfxElementData, char *handlerData);
 
 static enum handlers_error_e stopServer(struct handlers_s *obj, char *gfxElementName,
                                         void *gfxElementData, char *handlerData);
@@ -117,6 +119,7 @@ struct handlers_commands_s gSingleInputHandlers[] = {
 	{ HANDLERS_COMMAND_START_GRAPHICS,      NULL,  startGraphics    },
 	{ HANDLERS_COMMAND_STOP_VIDEO,          NULL,  stopVideo        },
 	{ HANDLERS_COMMAND_START_VIDEO,         NULL,  startVideo       },
+	{ HANDLERS_COMMAND_DUMP_VIDEO_CLIP,     NULL,  dumpVideoClip    },
 	{ HANDLERS_COMMAND_STOP_SERVER,         NULL,  stopServer       },
 	{ HANDLERS_COMMAND_START_SERVER,        NULL,  startServer      },
 	{ HANDLERS_COMMAND_SUSPEND_SERVER,      NULL,  suspendServer    },
@@ -753,6 +756,15 @@ static enum handlers_error_e stopVideo(struct handlers_s *obj, char *gfxElementN
                 }
             }
 
+            if (videoDevice->syncListener
+                && (videoObj->unregisterSyncListener(videoObj, videoDevice->videoParams.syncGroup,
+                                                     videoDevice->syncListener)
+                                                     != VIDEO_ERROR_NONE)) {
+                Loge("unregisterSyncListener() failed - \"%s\"",
+                        videoDevice->syncListener->name);
+                ret = HANDLERS_ERROR_COMMAND;
+            }
+
             if (videoObj->stopDeviceCapture(videoObj,
                                             &videoDevice->videoParams) != VIDEO_ERROR_NONE) {
                 Loge("stopDeviceCapture() failed - \"%s\"", videoDevice->videoParams.name);
@@ -850,6 +862,14 @@ static enum handlers_error_e startVideo(struct handlers_s *obj, char *gfxElement
                 }
             }
 
+            if (videoDevice->syncListener
+                && (videoObj->registerSyncListener(videoObj, videoDevice->videoParams.syncGroup,
+                                                   videoDevice->syncListener)
+                                                   != VIDEO_ERROR_NONE)) {
+                Loge("Failed to register listener \"%s\"", videoDevice->syncListener->name);
+                ret = HANDLERS_ERROR_COMMAND;
+            }
+
             if (hParams->onModuleStateChangedCb) {
                 hParams->onModuleStateChangedCb(hParams->userData,
                                                 videoDevice->videoParams.name,
@@ -862,6 +882,83 @@ static enum handlers_error_e startVideo(struct handlers_s *obj, char *gfxElement
     return ret;
 }
 
+/*!
+ *
+ */
+static enum handlers_error_e dumpVideoClip(struct handlers_s *obj, char *gfxElementName,
+                                           void *gfxElementData, char *handlerData)
+{
+    ASSERT(obj && obj->pData);
+
+    (void)gfxElementName;
+    (void)gfxElementData;
+
+    if (!handlerData) {
+        Loge("Handler data is expected");
+        return HANDLERS_ERROR_PARAMS;
+    }
+
+    Logd("Dumping clip - data : \"%s\"", handlerData);
+
+    struct handlers_private_data_s *pData = (struct handlers_private_data_s*)(obj->pData);
+    struct context_s *ctx                 = pData->handlersParams.ctx;
+    struct video_s *videoObj              = ctx->modules.videoObj;
+    struct videos_infos_s *videosInfos    = &ctx->params.videosInfos;
+    struct input_s *input                 = &ctx->input;
+    struct video_device_s *videoDevice    = NULL;
+
+    uint32_t offset                  = 0;
+    uint32_t postEvent_s             = 0;
+    char videoName[MAX_NAME_SIZE]    = {0};
+    char pathPrefix[MAX_PATH_SIZE]   = {0};
+    struct stat st;
+
+    /* postEventSec is optional */
+    if (obj->getSubstring(obj, handlerData, ";", videoName, &offset) == HANDLERS_ERROR_NONE) {
+        postEvent_s = (uint32_t)atoi(handlerData + offset);
+    }
+    else {
+        snprintf(videoName, sizeof(videoName), "%s", handlerData);
+    }
+
+    uint32_t videoIndex;
+    for (videoIndex = 0; videoIndex < videosInfos->nbDevices; videoIndex++) {
+        if (strcmp(videosInfos->devices[videoIndex]->videoParams.name, videoName) == 0) {
+            videoDevice = videosInfos->devices[videoIndex];
+            break;
+        }
+    }
+
+    if (!videoDevice) {
+        Loge("Video device \"%s\" not found", videoName);
+        return HANDLERS_ERROR_PARAMS;
+    }
+
+    if (videoDevice->state != MODULE_STATE_STARTED) {
+        Logw("Video device \"%s\" is not started", videoName);
+        return HANDLERS_ERROR_STATE;
+    }
+
+    if (stat(input->appDataDir, &st) < 0) {
+        Logd("Creating direcory : \"%s\"", input->appDataDir);
+        if (mkdir(input->appDataDir, S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH) != 0) {
+            Loge("%s", strerror(errno));
+            return HANDLERS_ERROR_IO;
+        }
+    }
+
+    snprintf(pathPrefix, sizeof(pathPrefix), "%s/clip_%s_%ld", input->appDataDir, videoName,
+             time(NULL));
+
+    if (videoObj->dumpClip(videoObj, &videoDevice->videoParams, pathPrefix,
+                           postEvent_s) != VIDEO_ERROR_NONE) {
+        Loge("dumpClip() failed - \"%s\"", videoName);
+        return HANDLERS_ERROR_COMMAND;
+    }
+
+    return HANDLERS_ERROR_NONE;
+}
+
 /*!
  *
  */
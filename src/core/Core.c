@@ -89,6 +89,10 @@ static void getFont_f(void *userData, uint32_t fontId, char *ttfFontOut);
 static void getImage_f(void *userData, uint32_t imageId, struct gfx_image_s *imageOut);
 static void getLanguage_f(void *userData, char *currentIn, char *nextOut);
 
+static void setVideoVariants_f(struct video_device_s *videoDevice, struct xml_video_s *xmlVideo);
+static void releaseVideoVariants_f(struct video_device_s *videoDevice);
+static void setVideoRecorder_f(struct video_device_s *videoDevice, struct xml_video_s *xmlVideo);
+
 /* -------------------------------------------------------------------------------------------- */
 /* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
@@ -717,6 +721,24 @@ static enum core_error_e loadVideosParams_f(struct core_s *obj)
         videoDevice->videoParams.desiredFps  = xmlVideos->videos[index].desiredFps;
         videoDevice->videoParams.count       = xmlVideos->videos[index].nbBuffers;
 
+        videoDevice->videoParams.nbSlots        = xmlVideos->videos[index].nbSlots;
+        videoDevice->videoParams.overflowPolicy = xmlVideos->videos[index].overflowPolicy;
+
+        videoDevice->videoParams.motionThreshold      = xmlVideos->videos[index].motionThreshold;
+        videoDevice->videoParams.motionGridStep       = xmlVideos->videos[index].motionGridStep;
+        videoDevice->videoParams.keepAliveInterval_ms = xmlVideos->videos[index].keepAliveMs;
+
+        videoDevice->videoParams.clipPreEvent_s  = xmlVideos->videos[index].clipPreEventSec;
+        videoDevice->videoParams.clipPostEvent_s = xmlVideos->videos[index].clipPostEventSec;
+        videoDevice->videoParams.clipMemorySize  = (size_t)xmlVideos->videos[index].clipMemoryMb
+                                                   * 1024 * 1024;
+
+        if (xmlVideos->videos[index].syncGroup) {
+            snprintf(videoDevice->videoParams.syncGroup, sizeof(videoDevice->videoParams.syncGroup),
+                     "%s", xmlVideos->videos[index].syncGroup);
+        }
+        videoDevice->videoParams.syncTolerance_us = xmlVideos->videos[index].syncToleranceMs * 1000;
+
         memcpy(&videoDevice->videoParams.captureArea,
                     &xmlVideos->videos[index].deviceArea,
                     sizeof(videoDevice->videoParams.captureArea));
@@ -729,17 +751,29 @@ static enum core_error_e loadVideosParams_f(struct core_s *obj)
                     &xmlVideos->videos[index].composingArea,
                     sizeof(videoDevice->videoParams.composingArea));
 
-        videoDevice->graphicsDest  = NULL;
-        videoDevice->graphicsIndex = -1;
+        videoDevice->graphicsDest          = NULL;
+        videoDevice->graphicsIndex         = -1;
+        videoDevice->graphicsDelivery      = xmlVideos->videos[index].graphicsDelivery;
+        videoDevice->graphicsMaxFps        = xmlVideos->videos[index].graphicsMaxFps;
+        videoDevice->graphicsEveryNthFrame = xmlVideos->videos[index].graphicsEveryNthFrame;
         if (xmlVideos->videos[index].graphicsDest) {
             videoDevice->graphicsDest = strdup(xmlVideos->videos[index].graphicsDest);
         }
         
-        videoDevice->serverDest  = NULL;
-        videoDevice->serverIndex = -1;
+        videoDevice->serverDest          = NULL;
+        videoDevice->serverIndex         = -1;
+        videoDevice->serverDelivery      = xmlVideos->videos[index].serverDelivery;
+        videoDevice->serverMaxFps        = xmlVideos->videos[index].serverMaxFps;
+        videoDevice->serverEveryNthFrame = xmlVideos->videos[index].serverEveryNthFrame;
+        videoDevice->serverJpegQuality   = xmlVideos->videos[index].serverJpegQuality;
+        videoDevice->serverJpegSlices    = xmlVideos->videos[index].serverJpegSlices;
         if (xmlVideos->videos[index].serverDest) {
             videoDevice->serverDest = strdup(xmlVideos->videos[index].serverDest);
         }
+
+        setVideoRecorder_f(videoDevice, &xmlVideos->videos[index]);
+
+        setVideoVariants_f(videoDevice, &xmlVideos->videos[index]);
     }
 
     Logd("Setting video listeners");
@@ -762,6 +796,8 @@ badConfig_exit:
             free(((*videoDevices)[index])->graphicsDest);
         }
 
+        releaseVideoVariants_f((*videoDevices)[index]);
+
         free(((*videoDevices)[index]));
     }
 
@@ -800,6 +836,8 @@ static enum core_error_e unloadVideosParams_f(struct core_s *obj)
             free(((*videoDevices)[index])->graphicsDest);
         }
 
+        releaseVideoVariants_f((*videoDevices)[index]);
+
         free(((*videoDevices)[index]));
     }
 
@@ -854,6 +892,9 @@ static enum core_error_e loadServersParams_f(struct core_s *obj)
         serverParams->acceptMode = xmlServers->servers[index].acceptMode;
         serverParams->priority   = xmlServers->servers[index].priority;
         serverParams->maxClients = xmlServers->servers[index].maxClients;
+
+        serverParams->senderThreads    = xmlServers->servers[index].senderThreads;
+        serverParams->pinSenderThreads = xmlServers->servers[index].pinSenderThreads;
         
         strncpy(serverParams->mime, xmlServers->servers[index].mime, sizeof(serverParams->mime));
         
@@ -987,6 +1028,8 @@ static enum core_error_e loadClientsParams_f(struct core_s *obj)
             ((*clientInfos)[index])->serverDest  = strdup(xmlClients->clients[index].serverDest);
             ((*clientInfos)[index])->serverIndex = -1;
         }
+
+        ((*clientInfos)[index])->checkPattern = xmlClients->clients[index].checkPattern;
         
         if (xmlClients->clients[index].serverHost
                 && xmlClients->clients[index].serverService
@@ -1233,3 +1276,105 @@ static void getLanguage_f(void *userData, char *currentIn, char *nextOut)
     
     strcpy(nextOut, common->xmlStrings[(index + 1) % common->nbLanguages].language);
 }
+
+/*!
+ *
+ */
+static void setVideoVariants_f(struct video_device_s *videoDevice, struct xml_video_s *xmlVideo)
+{
+    ASSERT(videoDevice && xmlVideo);
+
+    struct video_variant_s *variant;
+    struct xml_variant_s *xmlVariant;
+
+    videoDevice->nbVariants = 0;
+    videoDevice->variants   = NULL;
+
+    if (xmlVideo->nbVariants == 0) {
+        return;
+    }
+
+    ASSERT((videoDevice->variants = calloc(xmlVideo->nbVariants, sizeof(struct video_variant_s))));
+
+    uint8_t index;
+    for (index = 0; index < xmlVideo->nbVariants; index++) {
+        xmlVariant = &xmlVideo->variants[index];
+        variant    = &videoDevice->variants[videoDevice->nbVariants];
+
+        if (!xmlVariant->name || (xmlVariant->width == 0) || (xmlVariant->height == 0)) {
+            Loge("Variant %u of \"%s\" ignored - name, width and height are required",
+                    index, videoDevice->videoParams.name);
+            continue;
+        }
+
+        variant->name          = strdup(xmlVariant->name);
+        variant->width         = xmlVariant->width;
+        variant->height        = xmlVariant->height;
+        variant->filter        = (enum scaler_filter_e)xmlVariant->filter;
+        variant->jpegQuality   = xmlVariant->jpegQuality;
+        variant->graphicsDest  = (xmlVariant->graphicsDest ? strdup(xmlVariant->graphicsDest) : NULL);
+        variant->graphicsIndex = -1;
+        variant->serverDest    = (xmlVariant->serverDest ? strdup(xmlVariant->serverDest) : NULL);
+        variant->serverIndex   = -1;
+        variant->delivery      = (enum video_delivery_e)xmlVariant->delivery;
+        variant->maxFps        = xmlVariant->maxFps;
+
+        videoDevice->nbVariants++;
+    }
+}
+
+/*!
+ *
+ */
+static void releaseVideoVariants_f(struct video_device_s *videoDevice)
+{
+    ASSERT(videoDevice);
+
+    uint8_t index;
+    for (index = 0; index < videoDevice->nbVariants; index++) {
+        free(videoDevice->variants[index].name);
+
+        if (videoDevice->variants[index].graphicsDest) {
+            free(videoDevice->variants[index].graphicsDest);
+        }
+
+        if (videoDevice->variants[index].serverDest) {
+            free(videoDevice->variants[index].serverDest);
+        }
+    }
+
+    if (videoDevice->variants) {
+        free(videoDevice->variants);
+        videoDevice->variants = NULL;
+    }
+
+    videoDevice->nbVariants = 0;
+}
+
+/*!
+ *
+ */
+static void setVideoRecorder_f(struct video_device_s *videoDevice, struct xml_video_s *xmlVideo)
+{
+    ASSERT(videoDevice && xmlVideo);
+
+    struct recorder_params_s *recorderParams = &videoDevice->recorderParams;
+
+    memset(recorderParams, 0, sizeof(struct recorder_params_s));
+
+    if (!xmlVideo->recorderDest) {
+        return;
+    }
+
+    strncpy(recorderParams->directory, xmlVideo->recorderDest,
+            sizeof(recorderParams->directory) - 1);
+
+    recorderParams->container            = (enum recorder_container_e)xmlVideo->recorderContainer;
+    recorderParams->maxSegmentSize       = (uint64_t)xmlVideo->recorderMaxSegmentMb * 1024 * 1024;
+    recorderParams->maxSegmentDuration_s = xmlVideo->recorderMaxSegmentSec;
+    recorderParams->bufferSize           = (size_t)xmlVideo->recorderBufferKb * 1024;
+    recorderParams->nbBuffers            = xmlVideo->recorderNbBuffers;
+    recorderParams->directIo             = xmlVideo->recorderDirectIo;
+
+    videoDevice->recorderMaxFps = xmlVideo->recorderMaxFps;
+}
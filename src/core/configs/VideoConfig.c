@@ -88,9 +88,10 @@ enum configs_error_e getVideoConfig_f(struct configs_s *obj, struct video_config
 /* -------------------------------------------------------------------------------------------- */
 
 struct configs_video_capability_s gVideoCaps[] = {
-	{ "V4L2_CAP_VIDEO_CAPTURE",  V4L2_CAP_VIDEO_CAPTURE },
-	{ "V4L2_CAP_STREAMING",      V4L2_CAP_STREAMING     },
-	{ NULL,                      V4L2_CAP_VIDEO_CAPTURE }
+	{ "V4L2_CAP_VIDEO_CAPTURE",         V4L2_CAP_VIDEO_CAPTURE        },
+	{ "V4L2_CAP_VIDEO_CAPTURE_MPLANE",  V4L2_CAP_VIDEO_CAPTURE_MPLANE },
+	{ "V4L2_CAP_STREAMING",             V4L2_CAP_STREAMING            },
+	{ NULL,                             V4L2_CAP_VIDEO_CAPTURE        }
 };
 
 uint32_t gNbVideoCaps = (uint32_t)(sizeof(gVideoCaps) / sizeof(gVideoCaps[0]));
@@ -98,8 +99,9 @@ uint32_t gNbVideoCaps = (uint32_t)(sizeof(gVideoCaps) / sizeof(gVideoCaps[0]));
 /* //////////////////////////////////////////////////////////////////////////////////////////// */
 
 struct configs_video_buffer_type_s gVideoBufferTypes[] = {
-	{ "V4L2_BUF_TYPE_VIDEO_CAPTURE",  V4L2_BUF_TYPE_VIDEO_CAPTURE },
-	{ NULL,                           V4L2_BUF_TYPE_VIDEO_CAPTURE }
+	{ "V4L2_BUF_TYPE_VIDEO_CAPTURE",         V4L2_BUF_TYPE_VIDEO_CAPTURE        },
+	{ "V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE",  V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE },
+	{ NULL,                                  V4L2_BUF_TYPE_VIDEO_CAPTURE        }
 };
 
 uint32_t gNbVideoBufferTypes = (uint32_t)(sizeof(gVideoBufferTypes)
@@ -109,7 +111,13 @@ uint32_t gNbVideoBufferTypes = (uint32_t)(sizeof(gVideoBufferTypes)
 
 struct configs_video_pixel_format_s gVideoPixelFormats[] = {
 	{ "V4L2_PIX_FMT_MJPEG",  V4L2_PIX_FMT_MJPEG },
+	{ "V4L2_PIX_FMT_YUYV",   V4L2_PIX_FMT_YUYV  },
 	{ "V4L2_PIX_FMT_YVYU",   V4L2_PIX_FMT_YVYU  },
+	{ "V4L2_PIX_FMT_UYVY",   V4L2_PIX_FMT_UYVY  },
+	{ "V4L2_PIX_FMT_NV12",   V4L2_PIX_FMT_NV12  },
+	{ "V4L2_PIX_FMT_NV16",   V4L2_PIX_FMT_NV16  },
+	{ "V4L2_PIX_FMT_NV12M",  V4L2_PIX_FMT_NV12M },
+	{ "V4L2_PIX_FMT_NV16M",  V4L2_PIX_FMT_NV16M },
 	{ NULL,                  V4L2_PIX_FMT_MJPEG }
 };
 
@@ -132,6 +140,7 @@ uint32_t gNbVideoColorspaces = (uint32_t)(sizeof(gVideoColorspaces)
 struct configs_video_memory_s gVideoMemories[] = {
 	{ "V4L2_MEMORY_MMAP",     V4L2_MEMORY_MMAP    },
 	{ "V4L2_MEMORY_USERPTR",  V4L2_MEMORY_USERPTR },
+	{ "V4L2_MEMORY_DMABUF",   V4L2_MEMORY_DMABUF  },
 	{ NULL,                   V4L2_MEMORY_MMAP    }
 };
 
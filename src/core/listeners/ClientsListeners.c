@@ -32,6 +32,8 @@
 /* -------------------------------------------------------------------------------------------- */
 
 #include "core/Listeners.h"
+#include "utils/JpegError.h"
+#include "utils/Pattern.h"
 
 /* -------------------------------------------------------------------------------------------- */
 /* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
@@ -40,6 +42,8 @@
 #undef  TAG
 #define TAG "ClientsListeners"
 
+#define PATTERN_REPORT_PERIOD_US 1000000
+
 /* -------------------------------------------------------------------------------------------- */
 /* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
@@ -47,6 +51,8 @@
 struct clients_listeners_private_data_s {
     struct buffer_s           buffer;
     struct listeners_params_s *listenersParams;
+
+    struct pattern_s          *patternObj;
 };
 
 /* -------------------------------------------------------------------------------------------- */
@@ -64,6 +70,15 @@ static void onClientDataCb(struct client_params_s *params, struct buffer_s *buff
                            void *userData);
 static void onClientLinkCb(struct client_params_s *params, void *userData);
 
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PRIVATE FUNCTIONS PROTOTYPES /////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static void checkPattern_f(struct clients_listeners_private_data_s *pData,
+                           struct client_infos_s *clientInfos, struct buffer_s *buffer);
+static uint8_t readJpegStamp_f(struct clients_listeners_private_data_s *pData,
+                               struct buffer_s *buffer, struct pattern_stamp_s *stamp);
+
 /* -------------------------------------------------------------------------------------------- */
 /* ////////////////////////////// PUBLIC FUNCTIONS IMPLEMENTATION ///////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
@@ -93,6 +108,11 @@ enum listeners_error_e setClientsListeners_f(struct listeners_s *obj)
         for (index = 0; index < clientsInfos->nbClients; index++) {
             clientParams = &(clientsInfos->clientInfos[index])->clientParams;
 
+            if (clientsInfos->clientInfos[index]->checkPattern && !pData->patternObj
+                && (Pattern_Init(&pData->patternObj, PATTERN_TYPE_BARS) != PATTERN_ERROR_NONE)) {
+                Loge("Pattern_Init() failed - Stamps won't be checked");
+            }
+
             clientParams->onDataReceivedCb = onClientDataCb;
             clientParams->onLinkBrokenCb   = onClientLinkCb;
             clientParams->userData         = pData;
@@ -122,6 +142,9 @@ enum listeners_error_e unsetClientsListeners_f(struct listeners_s *obj)
     }
     
     if (pData) {
+        if (pData->patternObj) {
+            (void)Pattern_UnInit(&pData->patternObj);
+        }
         free(pData);
     }
     
@@ -168,6 +191,10 @@ static void onClientDataCb(struct client_params_s *params,
     pData->buffer.data   = buffer->data;
     pData->buffer.length = buffer->length;
 
+    if (clientInfos->checkPattern && pData->patternObj) {
+        checkPattern_f(pData, clientInfos, &pData->buffer);
+    }
+
     uint32_t j;
     if (graphicsObj && clientInfos->graphicsDest) {
         if (clientInfos->graphicsIndex == -1) {
@@ -227,3 +254,141 @@ static void onClientLinkCb(struct client_params_s *params, void *userData)
     
     Logd("Client link broken - name : \"%s\"", params->name);
 }
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////// PRIVATE FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ * Frames generated by "pattern://" video sources carry their sequence number and capture time.
+ * Latency is only meaningful when client and source share the same monotonic clock i.e. when
+ * they run on the same host
+ */
+static void checkPattern_f(struct clients_listeners_private_data_s *pData,
+                           struct client_infos_s *clientInfos, struct buffer_s *buffer)
+{
+    ASSERT(pData && clientInfos && buffer);
+
+    struct client_pattern_stats_s *stats = &clientInfos->patternStats;
+    struct pattern_stamp_s stamp;
+    uint64_t now_us;
+
+    if (!readJpegStamp_f(pData, buffer, &stamp)) {
+        return;
+    }
+
+    now_us = getMonotonicTime_us();
+
+    if (!stats->started || (stamp.counter <= stats->lastCounter)) {
+        /* First frame or source restarted */
+        memset(stats, 0, sizeof(struct client_pattern_stats_s));
+        stats->started       = 1;
+        stats->nextReport_us = now_us + PATTERN_REPORT_PERIOD_US;
+    }
+    else {
+        stats->nbDropped += stamp.counter - stats->lastCounter - 1;
+    }
+
+    stats->lastCounter = stamp.counter;
+    stats->nbFrames++;
+
+    if (now_us >= stamp.timestamp_us) {
+        uint64_t latency_us = now_us - stamp.timestamp_us;
+
+        stats->latencySum_us += latency_us;
+        if (latency_us > stats->latencyMax_us) {
+            stats->latencyMax_us = latency_us;
+        }
+    }
+
+    if (now_us < stats->nextReport_us) {
+        return;
+    }
+
+    Logi("Client \"%s\" - %u frame(s) / %u dropped - latency avg %lu us / max %lu us",
+            clientInfos->clientParams.name, stats->nbFrames, stats->nbDropped,
+            stats->latencySum_us / stats->nbFrames, stats->latencyMax_us);
+
+    stats->nbFrames      = 0;
+    stats->nbDropped     = 0;
+    stats->latencySum_us = 0;
+    stats->latencyMax_us = 0;
+    stats->nextReport_us = now_us + PATTERN_REPORT_PERIOD_US;
+}
+
+/*!
+ * Only the top rows holding the stamp are decoded. Raw frames are not checked since their
+ * format is not known by clients
+ */
+static uint8_t readJpegStamp_f(struct clients_listeners_private_data_s *pData,
+                               struct buffer_s *buffer, struct pattern_stamp_s *stamp)
+{
+    ASSERT(pData && pData->patternObj && buffer && stamp);
+
+    struct jpeg_decompress_struct cinfo;
+    struct jpeg_error_s jerr;
+    struct converter_frame_s frame;
+    uint8_t *data           = buffer->data;
+    uint8_t *volatile rows  = NULL;
+    volatile uint8_t found  = 0;
+    uint32_t blocksPerRow, nbRows;
+    JSAMPROW row;
+
+    if (!data || (buffer->length < 4) || (data[0] != 0xFF) || (data[1] != 0xD8)) {
+        return 0;
+    }
+
+    memset(&cinfo, 0, sizeof(struct jpeg_decompress_struct));
+
+    // Corrupted frames are expected on lossy links so don't flood logs
+    cinfo.err = JpegError_Init(&jerr, 1);
+
+    if (setjmp(jerr.jmpBuf)) {
+        goto exit;
+    }
+
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, data, (unsigned long)buffer->length);
+
+    if (jpeg_read_header(&cinfo, TRUE) != JPEG_HEADER_OK) {
+        goto exit;
+    }
+
+    cinfo.out_color_space = JCS_RGB;
+    jpeg_start_decompress(&cinfo);
+
+    blocksPerRow = cinfo.output_width / PATTERN_STAMP_BLOCK_SIZE;
+    if (blocksPerRow == 0) {
+        goto exit;
+    }
+
+    nbRows = (PATTERN_STAMP_NB_BITS + blocksPerRow - 1) / blocksPerRow * PATTERN_STAMP_BLOCK_SIZE;
+    if (nbRows > cinfo.output_height) {
+        goto exit;
+    }
+
+    ASSERT((rows = malloc((size_t)cinfo.output_width * 3 * nbRows)));
+
+    while (cinfo.output_scanline < nbRows) {
+        row = rows + (size_t)cinfo.output_scanline * cinfo.output_width * 3;
+        (void)jpeg_read_scanlines(&cinfo, &row, 1);
+    }
+
+    memset(&frame, 0, sizeof(struct converter_frame_s));
+    frame.format     = CONVERTER_FORMAT_RGB24;
+    frame.width      = cinfo.output_width & ~1U;
+    frame.height     = nbRows;
+    frame.planes[0]  = rows;
+    frame.strides[0] = cinfo.output_width * 3;
+
+    found = (pData->patternObj->readStamp(pData->patternObj, &frame, stamp) == PATTERN_ERROR_NONE);
+
+exit:
+    jpeg_destroy_decompress(&cinfo);
+
+    if (rows) {
+        free(rows);
+    }
+
+    return found;
+}
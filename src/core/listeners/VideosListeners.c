@@ -32,6 +32,8 @@
 /* -------------------------------------------------------------------------------------------- */
 
 #include "core/Listeners.h"
+#include "video/Encoder.h"
+#include "video/Resizer.h"
 
 /* -------------------------------------------------------------------------------------------- */
 /* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
@@ -42,15 +44,42 @@
 
 #define VIDEO_LISTENER4GFX_NAME    "videoListener4Gfx"
 #define VIDEO_LISTENER4SERVER_NAME "videoListener4Server"
+#define VIDEO_LISTENER4VARIANT_NAME "videoListener4Variant"
+#define VIDEO_LISTENER4RECORDER_NAME "videoListener4Recorder"
+#define VIDEO_LISTENER4SYNC_NAME    "videoListener4Sync"
+#define VIDEO_LISTENER_QUEUE_SIZE  1
 
 /* -------------------------------------------------------------------------------------------- */
 /* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
 
+struct videos_listeners_private_data_s;
+
+struct videos_listeners_variant_s {
+    struct video_variant_s                 *variant;
+
+    /* Created on first frame */
+    struct resizer_s                       *resizer;
+    uint8_t                                resizerFailed;
+
+    struct videos_listeners_private_data_s *pData;
+};
+
 struct videos_listeners_private_data_s {
-    uint8_t                   videoIndex;
-    struct buffer_s           buffer;
-    struct listeners_params_s *listenersParams;
+    uint8_t                           videoIndex;
+    struct listeners_params_s         *listenersParams;
+
+    /* Shared by all clients of serverDest - Created on first frame */
+    struct encoder_s                  *encoder;
+    struct video_area_s               encoderArea;
+    uint8_t                           encoderFailed;
+
+    /* Created on first frame */
+    struct recorder_s                 *recorder;
+    uint8_t                           recorderFailed;
+
+    uint8_t                           nbVariants;
+    struct videos_listeners_variant_s *variants;
 };
 
 /* -------------------------------------------------------------------------------------------- */
@@ -65,7 +94,25 @@ enum listeners_error_e unsetVideosListeners_f(struct listeners_s *obj);
 /* -------------------------------------------------------------------------------------------- */
 
 static void onVideo4GfxCb(struct video_buffer_s *videoBuffer, void *userData);
+static void onFrameSet4GfxCb(struct video_frame_set_s *frameSet, void *userData);
 static void onVideo4ServerCb(struct video_buffer_s *videoBuffer, void *userData);
+static void onVariantCb(struct video_buffer_s *videoBuffer, void *userData);
+static void onVideo4RecorderCb(struct video_buffer_s *videoBuffer, void *userData);
+static void onMotionCb(char *videoName, uint32_t score, uint8_t isMoving, void *userData);
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PRIVATE FUNCTIONS PROTOTYPES /////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static uint8_t encodeFrame_f(struct videos_listeners_private_data_s *pData,
+                             struct video_device_s *videoDevice,
+                             struct video_buffer_s *videoBuffer, struct buffer_s *buffer);
+static uint8_t isVariantUsed_f(struct input_s *input, struct video_variant_s *variant);
+
+static void sendToGraphics_f(struct context_s *ctx, char *graphicsDest, int32_t *graphicsIndex,
+                             struct buffer_s *buffer);
+static void sendToServer_f(struct context_s *ctx, char *serverDest, int32_t *serverIndex,
+                           struct buffer_s *buffer);
 
 /* -------------------------------------------------------------------------------------------- */
 /* ////////////////////////////// PUBLIC FUNCTIONS IMPLEMENTATION ///////////////////////////// */
@@ -87,6 +134,8 @@ enum listeners_error_e setVideosListeners_f(struct listeners_s *obj)
     uint8_t *nbVideoListeners                  = NULL;
     struct video_listener_s  ***videoListeners = NULL;
     struct video_listener_s  *videoListener    = NULL;
+    struct video_sync_listener_s *syncListener = NULL;
+    uint8_t isGfxSynced                        = 0;
 
     uint8_t videoIndex, listenerIndex;
     for (videoIndex = 0; videoIndex < nbDevices; videoIndex++) {
@@ -94,21 +143,44 @@ enum listeners_error_e setVideosListeners_f(struct listeners_s *obj)
         nbVideoListeners = &videoDevice->nbVideoListeners;
         videoListeners   = &videoDevice->videoListeners;
 
-        if (input->graphicsConfig.enable && videoDevice->graphicsDest) {
+        /* Frames matched by the sync group are drawn together */
+        isGfxSynced = (input->graphicsConfig.enable && videoDevice->graphicsDest
+                       && (videoDevice->videoParams.syncGroup[0] != '\0'));
+
+        /* Set before capture is started */
+        if (videoDevice->videoParams.motionThreshold > 0) {
+            videoDevice->videoParams.onMotionCb = onMotionCb;
+            videoDevice->videoParams.userData   = listenersParams;
+        }
+
+        if (input->graphicsConfig.enable && videoDevice->graphicsDest && !isGfxSynced) {
             *nbVideoListeners = 1;
         }
     
         if (input->serversConfig.enable && videoDevice->serverDest) {
             (*nbVideoListeners)++;
         }
+
+        if (videoDevice->recorderParams.directory[0] != '\0') {
+            (*nbVideoListeners)++;
+        }
+
+        uint8_t variantIndex;
+        for (variantIndex = 0; variantIndex < videoDevice->nbVariants; variantIndex++) {
+            if (isVariantUsed_f(input, &videoDevice->variants[variantIndex])) {
+                (*nbVideoListeners)++;
+            }
+        }
     
         Logd("nbVideoListeners = %u", *nbVideoListeners);
     
-        if (*nbVideoListeners > 0) {
+        if ((*nbVideoListeners > 0) || isGfxSynced) {
             struct videos_listeners_private_data_s *pData;
 
-            ASSERT((*videoListeners = calloc(*nbVideoListeners,
-                                             sizeof(struct video_listener_s*))));
+            if (*nbVideoListeners > 0) {
+                ASSERT((*videoListeners = calloc(*nbVideoListeners,
+                                                 sizeof(struct video_listener_s*))));
+            }
             ASSERT((pData = calloc(1, sizeof(struct videos_listeners_private_data_s))));
 
             pData->videoIndex      = videoIndex;
@@ -116,7 +188,18 @@ enum listeners_error_e setVideosListeners_f(struct listeners_s *obj)
 
             listenerIndex = 0;
 
-            if (input->graphicsConfig.enable && videoDevice->graphicsDest) {
+            /* Registered to the sync group instead of the device. Name must be unique in group */
+            if (isGfxSynced) {
+                ASSERT((videoDevice->syncListener = calloc(1,
+                                                           sizeof(struct video_sync_listener_s))));
+
+                syncListener = videoDevice->syncListener;
+                snprintf(syncListener->name, sizeof(syncListener->name), "%s%03u",
+                         VIDEO_LISTENER4SYNC_NAME, videoIndex);
+                syncListener->onFrameSetAvailableCb = onFrameSet4GfxCb;
+                syncListener->userData              = pData;
+            }
+            else if (input->graphicsConfig.enable && videoDevice->graphicsDest) {
                 (*videoListeners)[listenerIndex] = calloc(1, sizeof(struct video_listener_s));
                 ASSERT((*videoListeners)[listenerIndex]);
 
@@ -124,6 +207,10 @@ enum listeners_error_e setVideosListeners_f(struct listeners_s *obj)
                 strcpy(videoListener->name, VIDEO_LISTENER4GFX_NAME);
                 videoListener->onVideoBufferAvailableCb = onVideo4GfxCb;
                 videoListener->userData                 = pData;
+                videoListener->maxFps                   = videoDevice->graphicsMaxFps;
+                videoListener->everyNthFrame            = videoDevice->graphicsEveryNthFrame;
+                videoListener->delivery                 = videoDevice->graphicsDelivery;
+                videoListener->queueSize                = VIDEO_LISTENER_QUEUE_SIZE;
             
                 listenerIndex++;
             }
@@ -136,6 +223,62 @@ enum listeners_error_e setVideosListeners_f(struct listeners_s *obj)
                 strcpy(videoListener->name, VIDEO_LISTENER4SERVER_NAME);
                 videoListener->onVideoBufferAvailableCb = onVideo4ServerCb;
                 videoListener->userData                 = pData;
+                videoListener->maxFps                   = videoDevice->serverMaxFps;
+                videoListener->everyNthFrame            = videoDevice->serverEveryNthFrame;
+                videoListener->delivery                 = videoDevice->serverDelivery;
+                videoListener->queueSize                = VIDEO_LISTENER_QUEUE_SIZE;
+
+                listenerIndex++;
+            }
+
+            /* Always asynchronous so that a slow disk only delays recording */
+            if (videoDevice->recorderParams.directory[0] != '\0') {
+                (*videoListeners)[listenerIndex] = calloc(1, sizeof(struct video_listener_s));
+                ASSERT((*videoListeners)[listenerIndex]);
+
+                videoListener = (*videoListeners)[listenerIndex];
+                strcpy(videoListener->name, VIDEO_LISTENER4RECORDER_NAME);
+                videoListener->onVideoBufferAvailableCb = onVideo4RecorderCb;
+                videoListener->userData                 = pData;
+                videoListener->maxFps                   = videoDevice->recorderMaxFps;
+                videoListener->everyNthFrame            = 1;
+                videoListener->delivery                 = VIDEO_DELIVERY_ASYNC;
+                videoListener->queueSize                = VIDEO_LISTENER_QUEUE_SIZE;
+
+                listenerIndex++;
+            }
+
+            if (videoDevice->nbVariants > 0) {
+                ASSERT((pData->variants = calloc(videoDevice->nbVariants,
+                                                 sizeof(struct videos_listeners_variant_s))));
+            }
+
+            for (variantIndex = 0; variantIndex < videoDevice->nbVariants; variantIndex++) {
+                if (!isVariantUsed_f(input, &videoDevice->variants[variantIndex])) {
+                    Logw("Variant \"%s\" has no enabled destination",
+                            videoDevice->variants[variantIndex].name);
+                    continue;
+                }
+
+                struct videos_listeners_variant_s *variant = &pData->variants[pData->nbVariants++];
+                variant->variant = &videoDevice->variants[variantIndex];
+                variant->pData   = pData;
+
+                (*videoListeners)[listenerIndex] = calloc(1, sizeof(struct video_listener_s));
+                ASSERT((*videoListeners)[listenerIndex]);
+
+                /* Same length for all names so that they cannot be prefix of each other */
+                videoListener = (*videoListeners)[listenerIndex];
+                snprintf(videoListener->name, sizeof(videoListener->name), "%s%03u",
+                         VIDEO_LISTENER4VARIANT_NAME, variantIndex);
+                videoListener->onVideoBufferAvailableCb = onVariantCb;
+                videoListener->userData                 = variant;
+                videoListener->maxFps                   = variant->variant->maxFps;
+                videoListener->everyNthFrame            = 1;
+                videoListener->delivery                 = variant->variant->delivery;
+                videoListener->queueSize                = VIDEO_LISTENER_QUEUE_SIZE;
+
+                listenerIndex++;
             }
         }
     }
@@ -166,15 +309,52 @@ enum listeners_error_e unsetVideosListeners_f(struct listeners_s *obj)
         nbVideoListeners = videoDevice->nbVideoListeners;
         videoListeners   = &videoDevice->videoListeners;
 
+        videoDevice->videoParams.onMotionCb = NULL;
+        videoDevice->videoParams.userData   = NULL;
+
+        pData = NULL;
+
+        if (videoDevice->syncListener) {
+            pData = (struct videos_listeners_private_data_s*)(videoDevice->syncListener->userData);
+
+            free(videoDevice->syncListener);
+            videoDevice->syncListener = NULL;
+        }
+
         for (listenerIndex = 0; listenerIndex < nbVideoListeners; listenerIndex++) {
-            videoListener              = &(*videoListeners)[listenerIndex];
-            pData                      = (struct videos_listeners_private_data_s*)((*videoListener)->userData);
+            videoListener = &(*videoListeners)[listenerIndex];
+
+            if ((*videoListener)->onVideoBufferAvailableCb == onVariantCb) {
+                pData = ((struct videos_listeners_variant_s*)((*videoListener)->userData))->pData;
+            }
+            else {
+                pData = (struct videos_listeners_private_data_s*)((*videoListener)->userData);
+            }
             (*videoListener)->userData = NULL;
 
             free(*videoListener);
         }
 
         if (pData) {
+            if (pData->encoder) {
+                (void)Encoder_UnInit(&pData->encoder);
+            }
+
+            if (pData->recorder) {
+                (void)Recorder_UnInit(&pData->recorder);
+            }
+
+            uint8_t variantIndex;
+            for (variantIndex = 0; variantIndex < pData->nbVariants; variantIndex++) {
+                if (pData->variants[variantIndex].resizer) {
+                    (void)Resizer_UnInit(&pData->variants[variantIndex].resizer);
+                }
+            }
+
+            if (pData->variants) {
+                free(pData->variants);
+            }
+
             free(pData);
         }
 
@@ -198,37 +378,34 @@ static void onVideo4GfxCb(struct video_buffer_s *videoBuffer, void *userData)
     
     struct videos_listeners_private_data_s *pData = (struct videos_listeners_private_data_s*)userData;
     struct context_s *ctx                         = pData->listenersParams->ctx;
-    struct graphics_s *graphicsObj                = ctx->modules.graphicsObj;
-    struct graphics_infos_s *graphicsInfos        = &ctx->params.graphicsInfos;
     struct videos_infos_s *videosInfos            = &ctx->params.videosInfos;
     struct video_device_s *videoDevice            = videosInfos->devices[pData->videoIndex];
-    
-    if (graphicsObj
-        && videoDevice->graphicsDest
-        && (graphicsInfos->state == MODULE_STATE_STARTED)) {
+    struct buffer_s buffer                        = {0};
 
-        pData->buffer.data   = videoBuffer->data;
-        pData->buffer.length = videoBuffer->length;
-        
-        if (videoDevice->graphicsIndex == -1) {
-            uint32_t index;
-            for (index = 0; index < graphicsInfos->nbGfxElements; index++) {
-                if (strcmp(graphicsInfos->gfxElements[index]->name,
-                           videoDevice->graphicsDest) == 0) {
-                    Logd("Element \"%s\" found at index \"%u\"", videoDevice->graphicsDest, index);
-                    break;
-                }
-            }
-            if (index < graphicsInfos->nbGfxElements) {
-                videoDevice->graphicsIndex = (int32_t)index;
-            }
-            else {
-                Loge("Element \"%s\" does not exist", videoDevice->graphicsDest);
-                return;
-            }
+    buffer.data           = videoBuffer->data;
+    buffer.length         = videoBuffer->length;
+    buffer.captureTime_us = videoBuffer->captureTime_us;
+
+    sendToGraphics_f(ctx, videoDevice->graphicsDest, &videoDevice->graphicsIndex, &buffer);
+}
+
+/*!
+ * Draw the frame of this device among the ones matched by its sync group
+ */
+static void onFrameSet4GfxCb(struct video_frame_set_s *frameSet, void *userData)
+{
+    ASSERT(frameSet && userData);
+
+    struct videos_listeners_private_data_s *pData = (struct videos_listeners_private_data_s*)userData;
+    struct videos_infos_s *videosInfos            = &pData->listenersParams->ctx->params.videosInfos;
+    struct video_device_s *videoDevice            = videosInfos->devices[pData->videoIndex];
+
+    uint32_t index;
+    for (index = 0; index < frameSet->nbBuffers; index++) {
+        if (!strcmp(frameSet->names[index], videoDevice->videoParams.name)) {
+            onVideo4GfxCb(frameSet->buffers[index], pData);
+            return;
         }
-        
-        (void)graphicsObj->setData(graphicsObj, videoDevice->graphicsDest, &pData->buffer);
     }
 }
 
@@ -241,40 +418,353 @@ static void onVideo4ServerCb(struct video_buffer_s *videoBuffer, void *userData)
     
     struct videos_listeners_private_data_s *pData = (struct videos_listeners_private_data_s*)userData;
     struct context_s *ctx                         = pData->listenersParams->ctx;
-    struct server_s *serverObj                    = ctx->modules.serverObj;
-    struct servers_infos_s *serversInfos          = &ctx->params.serversInfos;
-    struct server_infos_s *serverInfos            = NULL;
     struct videos_infos_s *videosInfos            = &ctx->params.videosInfos;
     struct video_device_s *videoDevice            = videosInfos->devices[pData->videoIndex];
+    struct buffer_s buffer                        = {0};
 
-    pData->buffer.data   = videoBuffer->data;
-    pData->buffer.length = videoBuffer->length;
-    
-    if (serverObj && videoDevice->serverDest) {
-        if (videoDevice->serverIndex == -1) {
-            uint8_t index;
-            for (index = 0; index < serversInfos->nbServers; index++) {
-                serverInfos = serversInfos->serverInfos[index];
-
-                if (strcmp(serverInfos->serverParams.name, videoDevice->serverDest) == 0) {
-                    Logd("Server \"%s\" found at index \"%u\"", videoDevice->serverDest, index);
-                    break;
-                }
-            }
+    buffer.data           = videoBuffer->data;
+    buffer.length         = videoBuffer->length;
+    buffer.captureTime_us = videoBuffer->captureTime_us;
+
+    if ((videoDevice->serverJpegQuality > 0) && !encodeFrame_f(pData, videoDevice, videoBuffer,
+                                                                &buffer)) {
+        return;
+    }
+
+    sendToServer_f(ctx, videoDevice->serverDest, &videoDevice->serverIndex, &buffer);
+}
+
+/*!
+ * Resize frame once then give it to all destinations of the variant
+ */
+static void onVariantCb(struct video_buffer_s *videoBuffer, void *userData)
+{
+    ASSERT(videoBuffer && userData);
+
+    struct videos_listeners_variant_s *variantCtx = (struct videos_listeners_variant_s*)userData;
+    struct video_variant_s *variant               = variantCtx->variant;
+    struct context_s *ctx                         = variantCtx->pData->listenersParams->ctx;
+    struct video_s *videoObj                      = ctx->modules.videoObj;
+    struct videos_infos_s *videosInfos            = &ctx->params.videosInfos;
+    struct video_device_s *videoDevice            = videosInfos->devices[variantCtx->pData->videoIndex];
+    struct buffer_s buffer                        = {0};
+
+    if (variantCtx->resizerFailed) {
+        return;
+    }
+
+    if (!variantCtx->resizer) {
+        struct video_area_s videoArea = {0};
+        struct resizer_params_s resizerParams;
 
-            if (index == serversInfos->nbServers) {
-                Loge("Server \"%s\" does not exist", videoDevice->serverDest);
-                return;
+        if (!videoObj || (videoObj->getFinalVideoArea(videoObj, &videoDevice->videoParams,
+                                                      &videoArea) != VIDEO_ERROR_NONE)) {
+            Loge("Failed to get final video area of \"%s\"", videoDevice->videoParams.name);
+            variantCtx->resizerFailed = 1;
+            return;
+        }
+
+        memset(&resizerParams, 0, sizeof(resizerParams));
+        snprintf(resizerParams.name, sizeof(resizerParams.name), "%s", variant->name);
+        resizerParams.priority    = videoDevice->videoParams.priority;
+        resizerParams.pixelformat = videoDevice->videoParams.pixelformat;
+        resizerParams.srcWidth    = videoArea.width;
+        resizerParams.srcHeight   = videoArea.height;
+        resizerParams.dstWidth    = variant->width;
+        resizerParams.dstHeight   = variant->height;
+        resizerParams.filter      = variant->filter;
+        resizerParams.jpegQuality = variant->jpegQuality;
+
+        if (Resizer_Init(&variantCtx->resizer, &resizerParams) != RESIZER_ERROR_NONE) {
+            Loge("Failed to init resizer of variant \"%s\" - Disabled", variant->name);
+            variantCtx->resizerFailed = 1;
+            return;
+        }
+    }
+
+    if (variantCtx->resizer->resize(variantCtx->resizer, videoBuffer,
+                                    &buffer) != RESIZER_ERROR_NONE) {
+        Loge("Failed to resize frame of variant \"%s\"", variant->name);
+        return;
+    }
+
+    buffer.captureTime_us = videoBuffer->captureTime_us;
+
+    sendToGraphics_f(ctx, variant->graphicsDest, &variant->graphicsIndex, &buffer);
+    sendToServer_f(ctx, variant->serverDest, &variant->serverIndex, &buffer);
+}
+
+/*!
+ * Frames are recorded as captured
+ */
+static void onVideo4RecorderCb(struct video_buffer_s *videoBuffer, void *userData)
+{
+    ASSERT(videoBuffer && userData);
+
+    struct videos_listeners_private_data_s *pData = (struct videos_listeners_private_data_s*)userData;
+    struct video_s *videoObj                      = pData->listenersParams->ctx->modules.videoObj;
+    struct videos_infos_s *videosInfos            = &pData->listenersParams->ctx->params.videosInfos;
+    struct video_device_s *videoDevice            = videosInfos->devices[pData->videoIndex];
+    struct video_params_s *videoParams            = &videoDevice->videoParams;
+
+    if (pData->recorderFailed) {
+        return;
+    }
+
+    if (!pData->recorder) {
+        struct recorder_params_s *recorderParams = &videoDevice->recorderParams;
+        struct video_area_s videoArea            = {0};
+
+        if (!videoObj || (videoObj->getFinalVideoArea(videoObj, videoParams,
+                                                      &videoArea) != VIDEO_ERROR_NONE)) {
+            Loge("Failed to get final video area of \"%s\"", videoParams->name);
+            pData->recorderFailed = 1;
+            return;
+        }
+
+        strncpy(recorderParams->name, videoParams->name, sizeof(recorderParams->name) - 1);
+        recorderParams->priority    = videoParams->priority;
+        recorderParams->pixelformat = videoParams->pixelformat;
+        recorderParams->width       = videoArea.width;
+        recorderParams->height      = videoArea.height;
+        recorderParams->fps         = videoParams->desiredFps;
+
+        if (Recorder_Init(&pData->recorder, recorderParams) != RECORDER_ERROR_NONE) {
+            Loge("Failed to init recorder of \"%s\" - Disabled", videoParams->name);
+            pData->recorderFailed = 1;
+            return;
+        }
+    }
+
+    /* Dropped frames are reported when their segment is closed */
+    (void)pData->recorder->record(pData->recorder, videoBuffer);
+}
+
+/*!
+ * Called from the notification task of the video device
+ */
+static void onMotionCb(char *videoName, uint32_t score, uint8_t isMoving, void *userData)
+{
+    ASSERT(videoName && userData);
+
+    struct listeners_params_s *listenersParams = (struct listeners_params_s*)userData;
+    struct control_s *controlObj               = listenersParams->controlObj;
+
+    Logd("\"%s\" is %s - score = %u", videoName, (isMoving ? "moving" : "still"), score);
+
+    (void)controlObj->handleMotion(controlObj, videoName, score, isMoving);
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////// PRIVATE FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ * Encode raw frames once so that all clients get the same JPEG. MJPEG frames and formats not
+ * handled by the encoder are left untouched. Returns 0 if the frame has to be dropped, also
+ * when the encoder cannot be created since clients expect JPEG
+ */
+static uint8_t encodeFrame_f(struct videos_listeners_private_data_s *pData,
+                             struct video_device_s *videoDevice,
+                             struct video_buffer_s *videoBuffer, struct buffer_s *buffer)
+{
+    ASSERT(pData && videoDevice && videoBuffer && buffer);
+
+    struct video_s *videoObj           = pData->listenersParams->ctx->modules.videoObj;
+    struct video_params_s *videoParams = &videoDevice->videoParams;
+    struct video_area_s *videoArea     = &pData->encoderArea;
+    struct encoder_params_s params;
+    struct converter_frame_s frame     = {0};
+    size_t frameSize                   = 0;
+
+    if (pData->encoderFailed) {
+        return 0;
+    }
+
+    switch (videoParams->pixelformat) {
+        case V4L2_PIX_FMT_YUYV:
+            frame.format = CONVERTER_FORMAT_YUYV;
+            break;
+
+        case V4L2_PIX_FMT_YVYU:
+            frame.format = CONVERTER_FORMAT_YVYU;
+            break;
+
+        case V4L2_PIX_FMT_UYVY:
+            frame.format = CONVERTER_FORMAT_UYVY;
+            break;
+
+        case V4L2_PIX_FMT_NV12:
+        case V4L2_PIX_FMT_NV12M:
+            frame.format = CONVERTER_FORMAT_NV12;
+            break;
+
+        default:
+            return 1;
+    }
+
+    if (!pData->encoder) {
+        if (!videoObj
+            || (videoObj->getFinalVideoArea(videoObj, videoParams, videoArea) != VIDEO_ERROR_NONE)) {
+            Loge("Failed to get final video area of \"%s\"", videoParams->name);
+            goto encoderExit;
+        }
+
+        memset(&params, 0, sizeof(params));
+        strncpy(params.name, videoParams->name, sizeof(params.name) - 1);
+        params.priority = videoParams->priority;
+        params.width    = videoArea->width;
+        params.height   = videoArea->height;
+        params.quality  = videoDevice->serverJpegQuality;
+        params.nbSlices = videoDevice->serverJpegSlices;
+
+        if (Encoder_Init(&pData->encoder, &params) != ENCODER_ERROR_NONE) {
+            Loge("Failed to init encoder of \"%s\" - Frames will be dropped", videoParams->name);
+            goto encoderExit;
+        }
+    }
+
+    frame.width  = videoArea->width;
+    frame.height = videoArea->height;
+
+    /* Lines may be padded by the driver */
+    uint32_t bytesPerLine[2] = {
+        videoBuffer->planes[0].bytesPerLine,
+        videoBuffer->planes[1].bytesPerLine
+    };
+
+    switch (videoParams->pixelformat) {
+        case V4L2_PIX_FMT_NV12:
+            frame.strides[0] = (bytesPerLine[0] > 0 ? bytesPerLine[0] : frame.width);
+            frame.strides[1] = frame.strides[0];
+            frame.planes[0]  = videoBuffer->data;
+            frame.planes[1]  = (uint8_t*)videoBuffer->data
+                               + (size_t)frame.strides[0] * frame.height;
+            frameSize        = (size_t)frame.strides[0] * frame.height * 3 / 2;
+            break;
+
+        case V4L2_PIX_FMT_NV12M:
+            if (videoBuffer->nbPlanes < 2) {
+                Loge("NV12M frame with %u plane(s)", videoBuffer->nbPlanes);
+                return 0;
             }
+            frame.planes[0]  = videoBuffer->planes[0].data;
+            frame.planes[1]  = videoBuffer->planes[1].data;
+            frame.strides[0] = (bytesPerLine[0] > 0 ? bytesPerLine[0] : frame.width);
+            frame.strides[1] = (bytesPerLine[1] > 0 ? bytesPerLine[1] : frame.width);
+            frameSize        = (size_t)frame.strides[0] * frame.height;
+            break;
+
+        default: // Packed 4:2:2
+            frame.planes[0]  = videoBuffer->data;
+            frame.strides[0] = (bytesPerLine[0] > 0 ? bytesPerLine[0] : frame.width * 2);
+            frameSize        = (size_t)frame.strides[0] * frame.height;
+            break;
+    }
+
+    if (videoBuffer->length < frameSize) {
+        Logw("Truncated frame (%lu / %lu bytes) - Dropped", (unsigned long)videoBuffer->length,
+             (unsigned long)frameSize);
+        return 0;
+    }
+
+    if (pData->encoder->encode(pData->encoder, &frame, buffer) != ENCODER_ERROR_NONE) {
+        Loge("Failed to encode frame of \"%s\"", videoParams->name);
+        return 0;
+    }
+
+    return 1;
+
+encoderExit:
+    pData->encoderFailed = 1;
+    return 0;
+}
+
+/*!
+ *
+ */
+static uint8_t isVariantUsed_f(struct input_s *input, struct video_variant_s *variant)
+{
+    ASSERT(input && variant);
+
+    return ((input->graphicsConfig.enable && variant->graphicsDest)
+            || (input->serversConfig.enable && variant->serverDest));
+}
+
+/*!
+ *
+ */
+static void sendToGraphics_f(struct context_s *ctx, char *graphicsDest, int32_t *graphicsIndex,
+                             struct buffer_s *buffer)
+{
+    ASSERT(ctx && graphicsIndex && buffer);
+
+    struct graphics_s *graphicsObj         = ctx->modules.graphicsObj;
+    struct graphics_infos_s *graphicsInfos = &ctx->params.graphicsInfos;
+
+    if (!graphicsObj || !graphicsDest || (graphicsInfos->state != MODULE_STATE_STARTED)) {
+        return;
+    }
 
-            videoDevice->serverIndex = index;
+    if (*graphicsIndex == -1) {
+        uint32_t index;
+        for (index = 0; index < graphicsInfos->nbGfxElements; index++) {
+            if (strcmp(graphicsInfos->gfxElements[index]->name, graphicsDest) == 0) {
+                Logd("Element \"%s\" found at index \"%u\"", graphicsDest, index);
+                break;
+            }
+        }
+        if (index < graphicsInfos->nbGfxElements) {
+            *graphicsIndex = (int32_t)index;
         }
         else {
-            serverInfos = serversInfos->serverInfos[videoDevice->serverIndex];
+            Loge("Element \"%s\" does not exist", graphicsDest);
+            return;
         }
+    }
 
-        if (serverInfos->state == MODULE_STATE_STARTED) {
-            (void)serverObj->sendData(serverObj, &serverInfos->serverParams, &pData->buffer);
+    (void)graphicsObj->setData(graphicsObj, graphicsDest, buffer);
+}
+
+/*!
+ *
+ */
+static void sendToServer_f(struct context_s *ctx, char *serverDest, int32_t *serverIndex,
+                           struct buffer_s *buffer)
+{
+    ASSERT(ctx && serverIndex && buffer);
+
+    struct server_s *serverObj           = ctx->modules.serverObj;
+    struct servers_infos_s *serversInfos = &ctx->params.serversInfos;
+    struct server_infos_s *serverInfos   = NULL;
+
+    if (!serverObj || !serverDest) {
+        return;
+    }
+
+    if (*serverIndex == -1) {
+        uint8_t index;
+        for (index = 0; index < serversInfos->nbServers; index++) {
+            serverInfos = serversInfos->serverInfos[index];
+
+            if (strcmp(serverInfos->serverParams.name, serverDest) == 0) {
+                Logd("Server \"%s\" found at index \"%u\"", serverDest, index);
+                break;
+            }
         }
+
+        if (index == serversInfos->nbServers) {
+            Loge("Server \"%s\" does not exist", serverDest);
+            return;
+        }
+
+        *serverIndex = index;
+    }
+    else {
+        serverInfos = serversInfos->serverInfos[*serverIndex];
+    }
+
+    if (serverInfos->state == MODULE_STATE_STARTED) {
+        (void)serverObj->sendData(serverObj, &serverInfos->serverParams, buffer);
     }
 }
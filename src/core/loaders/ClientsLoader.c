@@ -242,6 +242,12 @@ static void onGeneralCb(void *userData, const char **attrs)
     	    .attrValue.vector  = (void**)&client->serverDest,
     	    .attrGetter.vector = parserObj->getString
         },
+    	{
+    	    .attrName          = XML_ATTR_CHECK_PATTERN,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&client->checkPattern,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
     	{
     	    NULL,
     	    PARSER_ATTR_TYPE_NONE,
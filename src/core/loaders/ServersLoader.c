@@ -239,6 +239,18 @@ static void onGeneralCb(void *userData, const char **attrs)
     	    .attrValue.scalar  = (void*)&server->maxClients,
     	    .attrGetter.scalar = parserObj->getUint32
         },
+    	{
+    	    .attrName          = XML_ATTR_SENDER_THREADS,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&server->senderThreads,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
+    	{
+    	    .attrName          = XML_ATTR_PIN_SENDER_THREADS,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&server->pinSenderThreads,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
     	{
     	    .attrName          = XML_ATTR_MIME,
     	    .attrType          = PARSER_ATTR_TYPE_VECTOR,
@@ -61,6 +61,14 @@ static void onDeviceCb(void *userData, const char **attrs);
 static void onCroppingAreaCb(void *userData, const char **attrs);
 static void onComposingAreaCb(void *userData, const char **attrs);
 static void onBufferCb(void *userData, const char **attrs);
+static void onChangeDetectionCb(void *userData, const char **attrs);
+static void onRecorderCb(void *userData, const char **attrs);
+static void onClipCb(void *userData, const char **attrs);
+static void onSyncCb(void *userData, const char **attrs);
+
+static void onVariantsStartCb(void *userData, const char **attrs);
+static void onVariantsEndCb(void *userData);
+static void onVariantCb(void *userData, const char **attrs);
 
 static void onConfigStartCb(void *userData, const char **attrs);
 static void onConfigEndCb(void *userData);
@@ -103,6 +111,12 @@ enum loaders_error_e loadVideosXml_f(struct loaders_s *obj, struct context_s *ct
     	{ XML_TAG_CROPPING_AREA,   onCroppingAreaCb,       NULL,                 NULL },
     	{ XML_TAG_COMPOSING_AREA,  onComposingAreaCb,      NULL,                 NULL },
     	{ XML_TAG_BUFFER,          onBufferCb,             NULL,                 NULL },
+    	{ XML_TAG_CHANGE_DETECTION, onChangeDetectionCb,   NULL,                 NULL },
+    	{ XML_TAG_RECORDER,        onRecorderCb,           NULL,                 NULL },
+    	{ XML_TAG_CLIP,            onClipCb,               NULL,                 NULL },
+    	{ XML_TAG_SYNC,            onSyncCb,               NULL,                 NULL },
+    	{ XML_TAG_VARIANTS,        onVariantsStartCb,      onVariantsEndCb,      NULL },
+    	{ XML_TAG_VARIANT,         onVariantCb,            NULL,                 NULL },
     	{ XML_TAG_CONFIG,          onConfigStartCb,        onConfigEndCb,        NULL },
     	{ XML_TAG_CAPABILITIES,    onCapabilitiesStartCb,  onCapabilitiesEndCb,  NULL },
     	{ XML_TAG_ITEM,            onItemCb,               NULL,                 NULL },
@@ -140,10 +154,31 @@ enum loaders_error_e unloadVideosXml_f(struct loaders_s *obj, struct xml_videos_
     
     uint8_t i, j;
     struct xml_video_s *video;
+    struct xml_variant_s *variant;
     struct xml_config_s *config;
     
     for (i = 0; i < xmlVideos->nbVideos; i++) {
         video = &xmlVideos->videos[i];
+
+        for (j = 0; j < video->nbVariants; j++) {
+            variant = &video->variants[j];
+            if (variant->name) {
+                free(variant->name);
+            }
+
+            if (variant->graphicsDest) {
+                free(variant->graphicsDest);
+            }
+
+            if (variant->serverDest) {
+                free(variant->serverDest);
+            }
+        }
+
+        if (video->variants) {
+            free(video->variants);
+        }
+
         if (video->graphicsDest) {
             free(video->graphicsDest);
         }
@@ -151,6 +186,14 @@ enum loaders_error_e unloadVideosXml_f(struct loaders_s *obj, struct xml_videos_
         if (video->serverDest) {
             free(video->serverDest);
         }
+
+        if (video->recorderDest) {
+            free(video->recorderDest);
+        }
+
+        if (video->syncGroup) {
+            free(video->syncGroup);
+        }
     
         if (video->deviceSrc) {
             free(video->deviceSrc);
@@ -278,6 +321,60 @@ static void onGeneralCb(void *userData, const char **attrs)
     	    .attrValue.vector  = (void**)&video->serverDest,
     	    .attrGetter.vector = parserObj->getString
         },
+    	{
+    	    .attrName          = XML_ATTR_GFX_DELIVERY,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->graphicsDelivery,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
+    	{
+    	    .attrName          = XML_ATTR_SERVER_DELIVERY,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->serverDelivery,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
+    	{
+    	    .attrName          = XML_ATTR_GFX_MAX_FPS,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->graphicsMaxFps,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
+    	{
+    	    .attrName          = XML_ATTR_SERVER_MAX_FPS,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->serverMaxFps,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
+    	{
+    	    .attrName          = XML_ATTR_GFX_EVERY_NTH_FRAME,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->graphicsEveryNthFrame,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
+    	{
+    	    .attrName          = XML_ATTR_SERVER_EVERY_NTH_FRAME,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->serverEveryNthFrame,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
+    	{
+    	    .attrName          = XML_ATTR_SERVER_JPEG_QUALITY,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->serverJpegQuality,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
+    	{
+    	    .attrName          = XML_ATTR_SERVER_JPEG_SLICES,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->serverJpegSlices,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
+    	{
+    	    .attrName          = XML_ATTR_RECORDER_DEST,
+    	    .attrType          = PARSER_ATTR_TYPE_VECTOR,
+    	    .attrValue.vector  = (void**)&video->recorderDest,
+    	    .attrGetter.vector = parserObj->getString
+        },
     	{
     	    NULL,
     	    PARSER_ATTR_TYPE_NONE,
@@ -299,6 +396,11 @@ static void onGeneralCb(void *userData, const char **attrs)
         free(video->serverDest);
         video->serverDest = NULL;
     }
+
+    if (video->recorderDest && ((video->recorderDest)[0] == '\0')) {
+        free(video->recorderDest);
+        video->recorderDest = NULL;
+    }
 }
 
 /*!
@@ -476,6 +578,18 @@ static void onBufferCb(void *userData, const char **attrs)
     	    .attrValue.scalar  = (void*)&video->desiredFps,
     	    .attrGetter.scalar = parserObj->getUint8
         },
+    	{
+    	    .attrName          = XML_ATTR_NB_SLOTS,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->nbSlots,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
+    	{
+    	    .attrName          = XML_ATTR_OVERFLOW_POLICY,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->overflowPolicy,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
     	{
     	    NULL,
     	    PARSER_ATTR_TYPE_NONE,
@@ -489,6 +603,332 @@ static void onBufferCb(void *userData, const char **attrs)
     }
 }
 
+/*!
+ *
+ */
+static void onChangeDetectionCb(void *userData, const char **attrs)
+{
+    ASSERT(userData);
+    
+    struct xml_videos_s *xmlVideos = (struct xml_videos_s*)userData;
+    struct xml_video_s *video      = &xmlVideos->videos[xmlVideos->nbVideos];
+    struct context_s *ctx          = (struct context_s*)xmlVideos->reserved;
+    struct parser_s *parserObj     = ctx->parserObj;
+    
+    struct parser_attr_handler_s attrHandlers[] = {
+    	{
+    	    .attrName          = XML_ATTR_THRESHOLD,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->motionThreshold,
+    	    .attrGetter.scalar = parserObj->getUint16
+        },
+    	{
+    	    .attrName          = XML_ATTR_GRID_STEP,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->motionGridStep,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
+    	{
+    	    .attrName          = XML_ATTR_KEEP_ALIVE_MS,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->keepAliveMs,
+    	    .attrGetter.scalar = parserObj->getUint32
+        },
+    	{
+    	    NULL,
+    	    PARSER_ATTR_TYPE_NONE,
+    	    NULL,
+    	    NULL
+        }
+    };
+    
+    if (parserObj->getAttributes(parserObj, attrHandlers, attrs) != PARSER_ERROR_NONE) {
+    	Loge("Failed to retrieve attributes in \"ChangeDetection\" tag");
+    }
+}
+
+/*!
+ *
+ */
+static void onRecorderCb(void *userData, const char **attrs)
+{
+    ASSERT(userData);
+    
+    struct xml_videos_s *xmlVideos = (struct xml_videos_s*)userData;
+    struct xml_video_s *video      = &xmlVideos->videos[xmlVideos->nbVideos];
+    struct context_s *ctx          = (struct context_s*)xmlVideos->reserved;
+    struct parser_s *parserObj     = ctx->parserObj;
+    
+    struct parser_attr_handler_s attrHandlers[] = {
+    	{
+    	    .attrName          = XML_ATTR_CONTAINER,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->recorderContainer,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
+    	{
+    	    .attrName          = XML_ATTR_MAX_SEGMENT_MB,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->recorderMaxSegmentMb,
+    	    .attrGetter.scalar = parserObj->getUint32
+        },
+    	{
+    	    .attrName          = XML_ATTR_MAX_SEGMENT_SEC,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->recorderMaxSegmentSec,
+    	    .attrGetter.scalar = parserObj->getUint32
+        },
+    	{
+    	    .attrName          = XML_ATTR_BUFFER_KB,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->recorderBufferKb,
+    	    .attrGetter.scalar = parserObj->getUint32
+        },
+    	{
+    	    .attrName          = XML_ATTR_NB_BUFFERS,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->recorderNbBuffers,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
+    	{
+    	    .attrName          = XML_ATTR_DIRECT_IO,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->recorderDirectIo,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
+    	{
+    	    .attrName          = XML_ATTR_MAX_FPS,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->recorderMaxFps,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
+    	{
+    	    NULL,
+    	    PARSER_ATTR_TYPE_NONE,
+    	    NULL,
+    	    NULL
+        }
+    };
+    
+    if (parserObj->getAttributes(parserObj, attrHandlers, attrs) != PARSER_ERROR_NONE) {
+    	Loge("Failed to retrieve attributes in \"Recorder\" tag");
+    }
+}
+
+/*!
+ *
+ */
+static void onClipCb(void *userData, const char **attrs)
+{
+    ASSERT(userData);
+    
+    struct xml_videos_s *xmlVideos = (struct xml_videos_s*)userData;
+    struct xml_video_s *video      = &xmlVideos->videos[xmlVideos->nbVideos];
+    struct context_s *ctx          = (struct context_s*)xmlVideos->reserved;
+    struct parser_s *parserObj     = ctx->parserObj;
+    
+    struct parser_attr_handler_s attrHandlers[] = {
+    	{
+    	    .attrName          = XML_ATTR_PRE_EVENT_SEC,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->clipPreEventSec,
+    	    .attrGetter.scalar = parserObj->getUint32
+        },
+    	{
+    	    .attrName          = XML_ATTR_POST_EVENT_SEC,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->clipPostEventSec,
+    	    .attrGetter.scalar = parserObj->getUint32
+        },
+    	{
+    	    .attrName          = XML_ATTR_MEMORY_MB,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->clipMemoryMb,
+    	    .attrGetter.scalar = parserObj->getUint32
+        },
+    	{
+    	    NULL,
+    	    PARSER_ATTR_TYPE_NONE,
+    	    NULL,
+    	    NULL
+        }
+    };
+    
+    if (parserObj->getAttributes(parserObj, attrHandlers, attrs) != PARSER_ERROR_NONE) {
+    	Loge("Failed to retrieve attributes in \"Clip\" tag");
+    }
+}
+
+/*!
+ *
+ */
+static void onSyncCb(void *userData, const char **attrs)
+{
+    ASSERT(userData);
+    
+    struct xml_videos_s *xmlVideos = (struct xml_videos_s*)userData;
+    struct xml_video_s *video      = &xmlVideos->videos[xmlVideos->nbVideos];
+    struct context_s *ctx          = (struct context_s*)xmlVideos->reserved;
+    struct parser_s *parserObj     = ctx->parserObj;
+    
+    struct parser_attr_handler_s attrHandlers[] = {
+    	{
+    	    .attrName          = XML_ATTR_GROUP,
+    	    .attrType          = PARSER_ATTR_TYPE_VECTOR,
+    	    .attrValue.vector  = (void**)&video->syncGroup,
+    	    .attrGetter.vector = parserObj->getString
+        },
+    	{
+    	    .attrName          = XML_ATTR_TOLERANCE_MS,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&video->syncToleranceMs,
+    	    .attrGetter.scalar = parserObj->getUint32
+        },
+    	{
+    	    NULL,
+    	    PARSER_ATTR_TYPE_NONE,
+    	    NULL,
+    	    NULL
+        }
+    };
+    
+    if (parserObj->getAttributes(parserObj, attrHandlers, attrs) != PARSER_ERROR_NONE) {
+    	Loge("Failed to retrieve attributes in \"Sync\" tag");
+    }
+    
+    if (video->syncGroup && ((video->syncGroup)[0] == '\0')) {
+        free(video->syncGroup);
+        video->syncGroup = NULL;
+    }
+}
+
+/*!
+ *
+ */
+static void onVariantsStartCb(void *userData, const char **attrs)
+{
+    ASSERT(userData);
+
+    (void)attrs;
+
+    Logd("Start parsing variants");
+}
+
+/*!
+ *
+ */
+static void onVariantsEndCb(void *userData)
+{
+    ASSERT(userData);
+
+    Logd("End parsing variants");
+}
+
+/*!
+ *
+ */
+static void onVariantCb(void *userData, const char **attrs)
+{
+    ASSERT(userData);
+
+    struct xml_videos_s *xmlVideos = (struct xml_videos_s*)userData;
+    struct xml_video_s *video      = &xmlVideos->videos[xmlVideos->nbVideos];
+    struct context_s *ctx          = (struct context_s*)xmlVideos->reserved;
+    struct parser_s *parserObj     = ctx->parserObj;
+
+    Logd("Adding variant %u", (video->nbVariants + 1));
+
+    video->variants = realloc(video->variants,
+                              (size_t)(video->nbVariants + 1) * sizeof(struct xml_variant_s));
+    ASSERT(video->variants);
+
+    memset(&video->variants[video->nbVariants], 0, sizeof(struct xml_variant_s));
+
+    struct xml_variant_s *variant = &video->variants[video->nbVariants];
+
+    struct parser_attr_handler_s attrHandlers[] = {
+    	{
+    	    .attrName          = XML_ATTR_NAME,
+    	    .attrType          = PARSER_ATTR_TYPE_VECTOR,
+    	    .attrValue.vector  = (void**)&variant->name,
+    	    .attrGetter.vector = parserObj->getString
+        },
+    	{
+    	    .attrName          = XML_ATTR_WIDTH,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&variant->width,
+    	    .attrGetter.scalar = parserObj->getUint32
+        },
+    	{
+    	    .attrName          = XML_ATTR_HEIGHT,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&variant->height,
+    	    .attrGetter.scalar = parserObj->getUint32
+        },
+    	{
+    	    .attrName          = XML_ATTR_FILTER,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&variant->filter,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
+    	{
+    	    .attrName          = XML_ATTR_JPEG_QUALITY,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&variant->jpegQuality,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
+    	{
+    	    .attrName          = XML_ATTR_GFX_DEST,
+    	    .attrType          = PARSER_ATTR_TYPE_VECTOR,
+    	    .attrValue.vector  = (void**)&variant->graphicsDest,
+    	    .attrGetter.vector = parserObj->getString
+        },
+    	{
+    	    .attrName          = XML_ATTR_SERVER_DEST,
+    	    .attrType          = PARSER_ATTR_TYPE_VECTOR,
+    	    .attrValue.vector  = (void**)&variant->serverDest,
+    	    .attrGetter.vector = parserObj->getString
+        },
+    	{
+    	    .attrName          = XML_ATTR_DELIVERY,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&variant->delivery,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
+    	{
+    	    .attrName          = XML_ATTR_MAX_FPS,
+    	    .attrType          = PARSER_ATTR_TYPE_SCALAR,
+    	    .attrValue.scalar  = (void*)&variant->maxFps,
+    	    .attrGetter.scalar = parserObj->getUint8
+        },
+    	{
+    	    NULL,
+    	    PARSER_ATTR_TYPE_NONE,
+    	    NULL,
+    	    NULL
+        }
+    };
+
+    ++video->nbVariants;
+
+    if (parserObj->getAttributes(parserObj, attrHandlers, attrs) != PARSER_ERROR_NONE) {
+    	Loge("Failed to retrieve attributes in \"Variant\" tag");
+    	return;
+    }
+
+    if (variant->graphicsDest && ((variant->graphicsDest)[0] == '\0')) {
+        free(variant->graphicsDest);
+        variant->graphicsDest = NULL;
+    }
+
+    if (variant->serverDest && ((variant->serverDest)[0] == '\0')) {
+        free(variant->serverDest);
+        variant->serverDest = NULL;
+    }
+
+    Logd("Video variant : \"%s\" (%ux%u)", variant->name, variant->width, variant->height);
+}
+
 /*!
  *
  */
@@ -95,6 +95,11 @@ struct graphics_private_data_s {
 
     struct fbdev_s           *fbDevObj;
     struct drawer_s          *drawerObj;
+
+    /* Capture -> display */
+    uint64_t                 nbDrawnFrames;
+    uint64_t                 lastLatency_us;
+    uint64_t                 maxLatency_us;
 };
 
 /* -------------------------------------------------------------------------------------------- */
@@ -315,6 +320,11 @@ enum graphics_error_e Graphics_UnInit(struct graphics_s **obj)
     struct graphics_private_data_s *pData   = (struct graphics_private_data_s*)((*obj)->pData);
     struct graphics_task_s *simulateEvtTask = &pData->simulateEvtTask;
 
+    if (pData->nbDrawnFrames > 0) {
+        Logd("%lu video frame(s) drawn / capture -> display latency = %lu us (max %lu us)",
+                pData->nbDrawnFrames, pData->lastLatency_us, pData->maxLatency_us);
+    }
+
     (void)FbDev_UnInit(&pData->fbDevObj);
 
     simulateEvtTask->quit = 1;
@@ -924,6 +934,22 @@ static enum graphics_error_e setData_f(struct graphics_s *obj, char *gfxElementN
     else if ((ret = updateElement_f(obj, gfxElement)) != GRAPHICS_ERROR_NONE) {
         Loge("Failed to update element : \"%s\"", gfxElementName);
     }
+
+    if ((ret == GRAPHICS_ERROR_NONE) && (gfxElement->type == GFX_ELEMENT_TYPE_VIDEO)
+        && (((struct buffer_s*)data)->captureTime_us > 0)) {
+        uint64_t captureTime_us = ((struct buffer_s*)data)->captureTime_us;
+        uint64_t now_us         = getMonotonicTime_us();
+
+        if (captureTime_us <= now_us) {
+            pData->lastLatency_us = now_us - captureTime_us;
+
+            if (pData->lastLatency_us > pData->maxLatency_us) {
+                pData->maxLatency_us = pData->lastLatency_us;
+            }
+        }
+
+        pData->nbDrawnFrames++;
+    }
     
 elementExit:
     (void)pData->gfxElementsList->unlock(pData->gfxElementsList);
@@ -39,6 +39,7 @@
 #include "SDL2/SDL_image.h"
 #include "SDL2/SDL_ttf.h"
 
+#include "utils/Converter.h"
 #include "utils/Log.h"
 
 #include "graphics/Drawer.h"
@@ -108,6 +109,8 @@ struct drawer_private_data_s {
     SDL_Rect               rect;
     SDL_Event              event;
     SDL_mutex              *lock;
+
+    struct converter_s     *converter;
 };
 
 /* -------------------------------------------------------------------------------------------- */
@@ -178,6 +181,8 @@ static enum drawer_error_e createSurfaceFromTarget_f(struct drawer_s *obj, enum
                                                      SDL_Surface **surface, SDL_Rect *rect);
 static enum drawer_error_e writeSurfaceToFile_f(struct drawer_s *obj, SDL_Surface *surface,
                                                 struct gfx_image_s *inOut);
+static enum drawer_error_e saveYuvBuffer_f(struct drawer_s *obj, struct buffer_s *buffer,
+                                           struct gfx_image_s *inOut);
 
 static enum drawer_error_e adjustDrawingRect_f(struct drawer_s *obj, enum gfx_target_e target,
                                                SDL_Rect *inOut);
@@ -216,6 +221,10 @@ enum drawer_error_e Drawer_Init(struct drawer_s **obj)
     (*obj)->stopAwaitingEvent = stopAwaitingEvent_f;
     
     ASSERT((pData->lock = SDL_CreateMutex()));
+
+    if (Converter_Init(&pData->converter, CONVERTER_KERNEL_AUTO) != CONVERTER_ERROR_NONE) {
+        Logw("Non-MJPEG buffers won't be saved");
+    }
     
     (*obj)->pData = (void*)pData;
     
@@ -231,6 +240,10 @@ enum drawer_error_e Drawer_UnInit(struct drawer_s **obj)
     
     struct drawer_private_data_s *pData = (struct drawer_private_data_s*)((*obj)->pData);
     
+    if (pData->converter) {
+        (void)Converter_UnInit(&pData->converter);
+    }
+
     SDL_DestroyMutex(pData->lock);
     
     free(pData);
@@ -922,8 +935,7 @@ static enum drawer_error_e saveBuffer_f(struct drawer_s *obj, struct buffer_s *b
         SDL_RWclose(pData->video.rwops);
     }
     else {
-        // TODO: Implementation for non-MJPEG format
-        Logw("Non-MJPEG format not supported yet");
+        ret = saveYuvBuffer_f(obj, buffer, inOut);
     }
 
     SDL_UnlockMutex(pData->lock);
@@ -1872,6 +1884,67 @@ static enum drawer_error_e writeSurfaceToFile_f(struct drawer_s *obj, SDL_Surfac
     return DRAWER_ERROR_NONE;
 }
 
+/*!
+ * Called with pData->lock held
+ */
+static enum drawer_error_e saveYuvBuffer_f(struct drawer_s *obj, struct buffer_s *buffer,
+                                           struct gfx_image_s *inOut)
+{
+    ASSERT(obj && obj->pData && buffer && inOut);
+
+    struct drawer_private_data_s *pData = (struct drawer_private_data_s*)(obj->pData);
+    struct converter_s *converter       = pData->converter;
+    enum drawer_error_e ret             = DRAWER_ERROR_SAVE;
+    uint32_t width                      = pData->video.params.rect.w;
+    uint32_t height                     = pData->video.params.rect.h;
+
+    struct converter_frame_s src, dst;
+    size_t srcSize, dstSize;
+    uint8_t *rgb;
+
+    if (!converter) {
+        Loge("No converter available");
+        return DRAWER_ERROR_SAVE;
+    }
+
+    if ((converter->getFrameSize(converter, CONVERTER_FORMAT_YVYU, width, height, &srcSize)
+                                                                    != CONVERTER_ERROR_NONE)
+        || (buffer->length < srcSize)) {
+        Loge("Unexpected buffer size %lu for %ux%u", buffer->length, width, height);
+        return DRAWER_ERROR_PARAMS;
+    }
+
+    (void)converter->getFrameSize(converter, CONVERTER_FORMAT_RGB24, width, height, &dstSize);
+    ASSERT((rgb = malloc(dstSize)));
+
+    (void)converter->setFrame(converter, CONVERTER_FORMAT_YVYU, width, height, buffer->data, &src);
+    (void)converter->setFrame(converter, CONVERTER_FORMAT_RGB24, width, height, rgb, &dst);
+
+    if (converter->convert(converter, &src, &dst) != CONVERTER_ERROR_NONE) {
+        Loge("Failed to convert video buffer");
+        goto exit;
+    }
+
+    pData->video.surface = SDL_CreateRGBSurfaceWithFormatFrom(rgb, (int32_t)width,
+                                                              (int32_t)height, 24,
+                                                              (int32_t)dst.strides[0],
+                                                              SDL_PIXELFORMAT_RGB24);
+    if (!pData->video.surface) {
+        Loge("SDL_CreateRGBSurfaceWithFormatFrom() failed - %s", SDL_GetError());
+        goto exit;
+    }
+
+    Logd("Save video buffer to \"%s\"", inOut->path);
+    ret = writeSurfaceToFile_f(obj, pData->video.surface, inOut);
+
+    SDL_FreeSurface(pData->video.surface);
+
+exit:
+    free(rgb);
+
+    return ret;
+}
+
 static enum drawer_error_e adjustDrawingRect_f(struct drawer_s *obj, enum gfx_target_e target,
                                                SDL_Rect *inOut)
 {
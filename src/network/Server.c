@@ -31,6 +31,9 @@
 /* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
 
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <time.h>
 
 #include "network/Server.h"
@@ -45,12 +48,68 @@
 #define WATCHER_TASK_NAME "server-WatcherTask"
 #define SENDER_TASK_NAME  "server-SenderTask"
 
+#define SENDER_MAX_EVENTS 32
+#define MAX_SENDERS       16
+
+/* Clients are watched using their id so the new frame eventfd needs an id no client can have */
+#define SENDER_FRAME_EVENT UINT64_MAX
+
 /* -------------------------------------------------------------------------------------------- */
 /* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
 
+/* Filled once by sendData() then only read. Back to the pool when refCount drops to 0 */
+struct server_frame_s {
+    uint32_t        refCount;
+    uint64_t        id;
+
+    struct buffer_s buffer;
+    size_t          size;                    /* Allocated */
+
+    size_t          headerLength;            /* HTTP part header sent before buffer */
+    char            header[MAX_HEADER_SIZE];
+};
+
+/* Clients are sharded across senders. Each one has its own thread, clients and epoll set */
+struct server_sender_s {
+    uint32_t                id;
+    struct server_context_s *ctx;
+    struct task_params_s    taskParams;
+    uint8_t                 pinned;
+
+    struct list_s           *clientsList;
+
+    int32_t                 frameFd;
+    int32_t                 epollFd;
+    struct epoll_event      events[SENDER_MAX_EVENTS];
+
+    /* Frame not taken by the sender yet. Protected by ctx->lock */
+    struct server_frame_s   *latestFrame;
+
+    /* Newest frame given to clients. Only accessed by the sender */
+    struct server_frame_s   *currentFrame;
+
+    /* Only accessed with clientsList locked */
+    uint64_t                lastFrameId;
+    uint64_t                nbClientFrames;  /* Frames entirely sent to a client */
+    uint64_t                nbSendCalls;     /* And completed send calls it took */
+};
+
 struct client_link_pdata_s {
-    uint8_t isAuthorizedReceiver;
+    uint8_t                 isAuthorizedReceiver;
+    struct server_sender_s  *sender;
+
+    /* Connection-oriented clients only. frame's header then buffer are written from offset each
+     * time the socket is writable until the whole frame is sent. Only accessed by its sender */
+    struct server_frame_s   *frame;
+    size_t                  offset;
+    uint8_t                 isWatchingOut;
+
+    /* Frames dispatched while the previous one was being sent are dropped and the newest one is
+     * sent next. Only accessed with clientsList locked */
+    uint64_t                lastFrameId;
+    uint64_t                nbSentFrames;
+    uint64_t                nbDroppedFrames;
 };
 
 struct server_context_s {
@@ -70,20 +129,26 @@ struct server_context_s {
     struct http_404_not_found_s   http404NotFound;
     struct http_content_s         httpContent;
     
-    struct list_s                 *clientsList;
-    
-    sem_t                         sem;
+    uint32_t                      nbSenders;
+    struct server_sender_s        *senders;
+    uint32_t                      lastClientId;
     
+    /* Frames pool. lock protects refCounts and senders' latestFrame */
     pthread_mutex_t               lock;
-    struct buffer_s               bufferIn;
-    struct buffer_s               bufferOut;
+    struct server_frame_s         **frames;
+    uint32_t                      nbFrames;
+    uint64_t                      lastFrameId;
     
     struct buffer_s               watcherTempBuffer;
-    struct buffer_s               senderTempBuffer;
+
+    /* Capture -> wire (first client to receive the whole frame). Protected by lock */
+    uint64_t                      lastSentFrameId;
+    uint64_t                      nbSentBuffers;
+    uint64_t                      lastLatency_us;
+    uint64_t                      maxLatency_us;
     
     struct task_s                 *serverTask;
     struct task_params_s          watcherTaskParams;
-    struct task_params_s          senderTaskParams;
     
     struct addrinfo               hints;
     struct addrinfo               *result;
@@ -124,6 +189,10 @@ static enum server_error_e disconnectClient_f(struct server_s *obj, struct serve
 static enum server_error_e sendData_f(struct server_s *obj, struct server_params_s *params,
                                       struct buffer_s *buffer);
 
+static enum server_error_e getClientStats_f(struct server_s *obj, struct server_params_s *params,
+                                            struct link_s *client,
+                                            struct server_client_stats_s *stats);
+
 /* -------------------------------------------------------------------------------------------- */
 /* /////////////////////////////// PRIVATE FUNCTIONS PROTOTYPES /////////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
@@ -134,6 +203,31 @@ static enum server_error_e closeServerSocket_f(struct server_context_s *ctx);
 static enum server_error_e getServerContext_f(struct server_s *obj, char *serverName,
                                               struct server_context_s **ctxOut);
 
+static enum server_error_e openSender_f(struct server_context_s *ctx,
+                                        struct server_sender_s *sender);
+static void closeSender_f(struct server_sender_s *sender);
+static void notifySender_f(struct server_sender_s *sender);
+static struct server_sender_s *getLeastLoadedSender_f(struct server_context_s *ctx);
+
+static enum server_error_e getClient_f(struct server_sender_s *sender, uint32_t id,
+                                       struct link_s **clientOut);
+static enum server_error_e watchClient_f(struct server_sender_s *sender, struct link_s *client,
+                                         uint32_t events);
+static void dropClient_f(struct server_sender_s *sender, struct link_s *client);
+
+static struct server_frame_s *getFreeFrame_f(struct server_context_s *ctx);
+static void retainFrame_f(struct server_context_s *ctx, struct server_frame_s *frame);
+static void releaseFrame_f(struct server_context_s *ctx, struct server_frame_s *frame);
+
+static void getClientStatsLocked_f(struct server_sender_s *sender, struct link_s *client,
+                                   struct server_client_stats_s *stats);
+static int8_t startFrame_f(struct server_sender_s *sender, struct link_s *client,
+                           struct server_frame_s *frame);
+static int8_t flushClient_f(struct server_sender_s *sender, struct link_s *client);
+static void dispatchFrame_f(struct server_sender_s *sender, struct server_private_data_s *pData,
+                            struct server_frame_s *frame);
+static void updateStats_f(struct server_context_s *ctx, uint64_t frameId, uint64_t captureTime_us);
+
 static void watcherTaskFct_f(struct task_params_s *params);
 static void senderTaskFct_f(struct task_params_s *params);
 
@@ -186,6 +280,8 @@ enum server_error_e Server_Init(struct server_s **obj)
     (*obj)->disconnectClient = disconnectClient_f;
     
     (*obj)->sendData         = sendData_f;
+
+    (*obj)->getClientStats   = getClientStats_f;
     
     (*obj)->pData            = (void*)pData;
     
@@ -254,31 +350,39 @@ static enum server_error_e start_f(struct server_s *obj, struct server_params_s
         goto exit;
     }
     
-    /* Init clients list, sem and mutex */
-    struct list_callbacks_s listCallbacks = {0};
-    listCallbacks.compareCb = compareClientCb;
-    listCallbacks.releaseCb = releaseClientCb;
-    listCallbacks.browseCb  = NULL;
-    
-    if (List_Init(&ctx->clientsList, &listCallbacks) != LIST_ERROR_NONE) {
-        Loge("List_Init() failed");
-        goto list_exit;
-    }
-    
-    if (sem_init(&ctx->sem, 0, 0) != 0) {
-        Loge("sem_init() failed");
-        goto sem_exit;
-    }
-    
+    /* Init mutex and senders */
     if (pthread_mutex_init(&ctx->lock, NULL) != 0) {
         Loge("pthread_mutex_init() failed");
         goto mutex_exit;
     }
+
+    // Connectionless clients are all written through the server socket
+    ctx->nbSenders = (params->senderThreads > 0) ? params->senderThreads : 1;
+
+    if (ctx->server->useDestAddress && (ctx->nbSenders > 1)) {
+        Logw("%s : Only one sender thread is used by connectionless servers", params->name);
+        ctx->nbSenders = 1;
+    }
+    else if (ctx->nbSenders > MAX_SENDERS) {
+        Logw("%s : senderThreads limited to %u", params->name, MAX_SENDERS);
+        ctx->nbSenders = MAX_SENDERS;
+    }
+
+    ASSERT((ctx->senders = calloc(ctx->nbSenders, sizeof(struct server_sender_s))));
+    ctx->lastClientId = (uint32_t)time(NULL);
+
+    uint32_t nbOpenedSenders;
+    for (nbOpenedSenders = 0; nbOpenedSenders < ctx->nbSenders; nbOpenedSenders++) {
+        if (openSender_f(ctx, &ctx->senders[nbOpenedSenders]) != SERVER_ERROR_NONE) {
+            Loge("Failed to open sender %u", nbOpenedSenders);
+            goto senders_exit;
+        }
+    }
     
     /* Init and start tasks */
     if (Task_Init(&ctx->serverTask) != TASK_ERROR_NONE) {
         Loge("Task_Init() failed");
-        goto task_init_exit;
+        goto senders_exit;
     }
     
     // Watcher
@@ -295,54 +399,66 @@ static enum server_error_e start_f(struct server_s *obj, struct server_params_s
         goto watcher_create_exit;
     }
     
-    // Sender
-    snprintf(ctx->senderTaskParams.name, sizeof(ctx->senderTaskParams.name), "%s-%u.%u.%u",
-                SENDER_TASK_NAME, params->type, params->link, params->acceptMode);
-    ctx->senderTaskParams.priority = params->priority;
-    ctx->senderTaskParams.fct      = senderTaskFct_f;
-    ctx->senderTaskParams.fctData  = ctx;
-    ctx->senderTaskParams.userData = pData;
-    ctx->senderTaskParams.atExit   = NULL;
-    
-    if (ctx->serverTask->create(ctx->serverTask, &ctx->senderTaskParams) != TASK_ERROR_NONE) {
-        Loge("Failed to create senderTask");
-        goto sender_create_exit;
+    // Senders
+    struct server_sender_s *sender;
+    uint32_t nbCreatedSenders;
+    for (nbCreatedSenders = 0; nbCreatedSenders < ctx->nbSenders; nbCreatedSenders++) {
+        sender = &ctx->senders[nbCreatedSenders];
+
+        snprintf(sender->taskParams.name, sizeof(sender->taskParams.name), "%s-%u.%u.%u-%u",
+                    SENDER_TASK_NAME, params->type, params->link, params->acceptMode, sender->id);
+        sender->taskParams.priority = params->priority;
+        sender->taskParams.fct      = senderTaskFct_f;
+        sender->taskParams.fctData  = sender;
+        sender->taskParams.userData = pData;
+        sender->taskParams.atExit   = NULL;
+
+        if (ctx->serverTask->create(ctx->serverTask, &sender->taskParams) != TASK_ERROR_NONE) {
+            Loge("Failed to create senderTask %u", sender->id);
+            goto sender_create_exit;
+        }
     }
     
     /* Add server's ctx to list */
     if (!pData->serversList
         || (pData->serversList->lock(pData->serversList) != LIST_ERROR_NONE)) {
         Loge("Failed to lock serversList");
-        goto lock_exit;
+        goto sender_create_exit;
     }
     pData->serversList->add(pData->serversList, (void*)ctx);
     (void)pData->serversList->unlock(pData->serversList);
     
     // Start
     (void)ctx->serverTask->start(ctx->serverTask, &ctx->watcherTaskParams);
-    (void)ctx->serverTask->start(ctx->serverTask, &ctx->senderTaskParams);
+
+    for (nbCreatedSenders = 0; nbCreatedSenders < ctx->nbSenders; nbCreatedSenders++) {
+        (void)ctx->serverTask->start(ctx->serverTask, &ctx->senders[nbCreatedSenders].taskParams);
+    }
     
     return SERVER_ERROR_NONE;
 
-lock_exit:
-    (void)ctx->serverTask->destroy(ctx->serverTask, &ctx->senderTaskParams);
-
 sender_create_exit:
+    while (nbCreatedSenders > 0) {
+        nbCreatedSenders--;
+        (void)ctx->serverTask->destroy(ctx->serverTask,
+                                       &ctx->senders[nbCreatedSenders].taskParams);
+    }
+
     (void)ctx->serverTask->destroy(ctx->serverTask, &ctx->watcherTaskParams);
 
 watcher_create_exit:
     (void)Task_UnInit(&ctx->serverTask);
 
-task_init_exit:
+senders_exit:
+    while (nbOpenedSenders > 0) {
+        nbOpenedSenders--;
+        closeSender_f(&ctx->senders[nbOpenedSenders]);
+    }
+
+    free(ctx->senders);
     (void)pthread_mutex_destroy(&ctx->lock);
 
 mutex_exit:
-    (void)sem_destroy(&ctx->sem);
-
-sem_exit:
-    (void)List_UnInit(&ctx->clientsList);
-
-list_exit:
     (void)closeServerSocket_f(ctx);
 
 exit:
@@ -368,6 +484,34 @@ static enum server_error_e stop_f(struct server_s *obj, struct server_params_s *
 
     struct server_private_data_s *pData = (struct server_private_data_s*)(obj->pData);
 
+    if (ctx->nbSentBuffers > 0) {
+        Logd("%s : %lu buffer(s) sent / capture -> wire latency = %lu us (max %lu us)",
+                params->name, ctx->nbSentBuffers, ctx->lastLatency_us, ctx->maxLatency_us);
+    }
+
+    struct server_sender_s *sender;
+    uint64_t nbClientFrames, nbSendCalls;
+
+    uint32_t index;
+    for (index = 0; index < ctx->nbSenders; index++) {
+        sender = &ctx->senders[index];
+
+        if (sender->clientsList->lock(sender->clientsList) != LIST_ERROR_NONE) {
+            continue;
+        }
+
+        nbClientFrames = sender->nbClientFrames;
+        nbSendCalls    = sender->nbSendCalls;
+
+        (void)sender->clientsList->unlock(sender->clientsList);
+
+        if (nbClientFrames > 0) {
+            Logd("%s : sender %u - %lu frame(s) sent to clients / %.2f send call(s) per frame "
+                 "per client", params->name, index, nbClientFrames,
+                 (double)nbSendCalls / (double)nbClientFrames);
+        }
+    }
+
     if (!pData->serversList
         || pData->serversList->lock(pData->serversList) != LIST_ERROR_NONE) {
         Loge("Failed to lock serversList");
@@ -398,7 +542,9 @@ static enum server_error_e addReceiver_f(struct server_s *obj, struct server_par
         goto exit;
     }
     
-    if (ctx->clientsList->lock(ctx->clientsList) != LIST_ERROR_NONE) {
+    struct server_sender_s *sender = ((struct client_link_pdata_s*)client->pData)->sender;
+
+    if (sender->clientsList->lock(sender->clientsList) != LIST_ERROR_NONE) {
         Loge("Failed to lock clientsList");
         ret = SERVER_ERROR_LOCK;
         goto exit;
@@ -406,7 +552,7 @@ static enum server_error_e addReceiver_f(struct server_s *obj, struct server_par
     
     ((struct client_link_pdata_s*)client->pData)->isAuthorizedReceiver = 1;
     
-    (void)ctx->clientsList->unlock(ctx->clientsList);
+    (void)sender->clientsList->unlock(sender->clientsList);
 
 exit:
     return ret;
@@ -428,7 +574,9 @@ static enum server_error_e removeReceiver_f(struct server_s *obj, struct server_
         goto exit;
     }
     
-    if (ctx->clientsList->lock(ctx->clientsList) != LIST_ERROR_NONE) {
+    struct server_sender_s *sender = ((struct client_link_pdata_s*)client->pData)->sender;
+
+    if (sender->clientsList->lock(sender->clientsList) != LIST_ERROR_NONE) {
         Loge("Failed to lock clientsList");
         ret = SERVER_ERROR_LOCK;
         goto exit;
@@ -436,7 +584,7 @@ static enum server_error_e removeReceiver_f(struct server_s *obj, struct server_
     
     ((struct client_link_pdata_s*)client->pData)->isAuthorizedReceiver = 0;
     
-    (void)ctx->clientsList->unlock(ctx->clientsList);
+    (void)sender->clientsList->unlock(sender->clientsList);
 
 exit:
     return ret;
@@ -459,17 +607,21 @@ static enum server_error_e suspendSender_f(struct server_s *obj, struct server_p
 
     ctx->senderSuspended = 1;
 
-    while (sem_trywait(&ctx->sem) == 0) {
-        Logd("Resettig semaphore counter to zero");
-    }
-
     if (pthread_mutex_lock(&ctx->lock) != 0) {
         ret = SERVER_ERROR_LOCK;
         goto exit;
     }
 
-    ctx->bufferIn.length = 0;
-    ctx->bufferIn.data   = NULL;
+    uint32_t index;
+    for (index = 0; index < ctx->nbSenders; index++) {
+        if (ctx->senders[index].latestFrame) {
+            Logd("%s : Frame %lu dropped by sender %u", params->name,
+                    ctx->senders[index].latestFrame->id, index);
+
+            ctx->senders[index].latestFrame->refCount--;
+            ctx->senders[index].latestFrame = NULL;
+        }
+    }
 
     (void)pthread_mutex_unlock(&ctx->lock);
 
@@ -514,15 +666,17 @@ static enum server_error_e disconnectClient_f(struct server_s *obj, struct serve
         goto exit;
     }
     
-    if (ctx->clientsList->lock(ctx->clientsList) != LIST_ERROR_NONE) {
+    struct server_sender_s *sender = ((struct client_link_pdata_s*)client->pData)->sender;
+
+    if (sender->clientsList->lock(sender->clientsList) != LIST_ERROR_NONE) {
         Loge("Failed to lock clientsList");
         ret = SERVER_ERROR_LOCK;
         goto exit;
     }
         
-    ctx->clientsList->remove(ctx->clientsList, (void*)&client->id);
+    sender->clientsList->remove(sender->clientsList, (void*)&client->id);
     
-    (void)ctx->clientsList->unlock(ctx->clientsList);
+    (void)sender->clientsList->unlock(sender->clientsList);
 
 exit:
     return ret;
@@ -544,24 +698,111 @@ static enum server_error_e sendData_f(struct server_s *obj, struct server_params
         goto exit;
     }
     
+    if (ctx->senderSuspended || !buffer->data || (buffer->length == 0)) {
+        goto exit;
+    }
+
+    if (pthread_mutex_lock(&ctx->lock) != 0) {
+        ret = SERVER_ERROR_LOCK;
+        goto exit;
+    }
+
+    // Not in the pool anymore while being filled
+    struct server_frame_s *frame = getFreeFrame_f(ctx);
+    frame->refCount = 1;
+
+    (void)pthread_mutex_unlock(&ctx->lock);
+
+    // Only reallocated when a bigger frame is received
+    if (frame->size < buffer->length) {
+        free(frame->buffer.data);
+        ASSERT((frame->buffer.data = malloc(buffer->length)));
+        frame->size = buffer->length;
+    }
+
+    memcpy(frame->buffer.data, buffer->data, buffer->length);
+    frame->buffer.length         = buffer->length;
+    frame->buffer.captureTime_us = buffer->captureTime_us;
+
+    // Part header is the same for all clients
+    frame->headerLength = 0;
+
+    if (ctx->params.mode == LINK_MODE_HTTP) {
+        struct server_private_data_s *pData = (struct server_private_data_s*)(obj->pData);
+
+        strcpy(ctx->httpContent.mime, ctx->params.mime);
+        ctx->httpContent.length = frame->buffer.length;
+        pData->linkHelper->prepareHttpContent(pData->linkHelper, &ctx->httpContent);
+
+        frame->headerLength = strlen(ctx->httpContent.str);
+        memcpy(frame->header, ctx->httpContent.str, frame->headerLength);
+    }
+
     if (pthread_mutex_lock(&ctx->lock) != 0) {
         ret = SERVER_ERROR_LOCK;
         goto exit;
     }
 
-    if (!ctx->senderSuspended) {
-        ctx->bufferIn.length = buffer->length;
-        ctx->bufferIn.data   = buffer->data;
+    frame->id = ++ctx->lastFrameId;
+
+    uint8_t notify = !ctx->senderSuspended;
+    uint32_t index;
+
+    // All senders share the frame. One not taken yet is replaced by the new one
+    for (index = 0; notify && (index < ctx->nbSenders); index++) {
+        if (ctx->senders[index].latestFrame) {
+            ctx->senders[index].latestFrame->refCount--;
+        }
 
-        (void)sem_post(&ctx->sem);
+        ctx->senders[index].latestFrame = frame;
+        frame->refCount++;
     }
 
+    frame->refCount--;
+
     (void)pthread_mutex_unlock(&ctx->lock);
+
+    for (index = 0; notify && (index < ctx->nbSenders); index++) {
+        notifySender_f(&ctx->senders[index]);
+    }
     
 exit:
     return ret;
 }
 
+/*!
+ *
+ */
+static enum server_error_e getClientStats_f(struct server_s *obj, struct server_params_s *params,
+                                            struct link_s *client,
+                                            struct server_client_stats_s *stats)
+{
+    ASSERT(obj && obj->pData && params && client && stats);
+
+    struct server_context_s *ctx = NULL;
+    enum server_error_e ret      = SERVER_ERROR_NONE;
+
+    if ((ret = getServerContext_f(obj, params->name, &ctx)) != SERVER_ERROR_NONE) {
+        Loge("Failed to retrieve %s's context", params->name);
+        goto exit;
+    }
+
+    struct server_sender_s *sender = ((struct client_link_pdata_s*)client->pData)->sender;
+
+    if (sender->clientsList->lock(sender->clientsList) != LIST_ERROR_NONE) {
+        Loge("Failed to lock clientsList");
+        ret = SERVER_ERROR_LOCK;
+        goto exit;
+    }
+
+    getClientStatsLocked_f(sender, client, stats);
+
+    (void)sender->clientsList->unlock(sender->clientsList);
+
+exit:
+    return ret;
+}
+
 /* -------------------------------------------------------------------------------------------- */
 /* ///////////////////////////// PRIVATE FUNCTIONS IMPLEMENTATION ///////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
@@ -798,6 +1039,480 @@ exit:
     return ret;
 }
 
+/*!
+ *
+ */
+static enum server_error_e openSender_f(struct server_context_s *ctx,
+                                        struct server_sender_s *sender)
+{
+    ASSERT(ctx && sender);
+
+    sender->id  = (uint32_t)(sender - ctx->senders);
+    sender->ctx = ctx;
+
+    struct list_callbacks_s listCallbacks = {0};
+    listCallbacks.compareCb = compareClientCb;
+    listCallbacks.releaseCb = releaseClientCb;
+    listCallbacks.browseCb  = NULL;
+
+    if (List_Init(&sender->clientsList, &listCallbacks) != LIST_ERROR_NONE) {
+        Loge("List_Init() failed");
+        goto list_exit;
+    }
+
+    if ((sender->epollFd = epoll_create1(EPOLL_CLOEXEC)) < 0) {
+        Loge("epoll_create1() failed - %s", strerror(errno));
+        goto epoll_exit;
+    }
+
+    if ((sender->frameFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) < 0) {
+        Loge("eventfd() failed - %s", strerror(errno));
+        goto eventfd_exit;
+    }
+
+    struct epoll_event event = {0};
+    event.events   = EPOLLIN;
+    event.data.u64 = SENDER_FRAME_EVENT;
+
+    if (epoll_ctl(sender->epollFd, EPOLL_CTL_ADD, sender->frameFd, &event) < 0) {
+        Loge("Failed to watch eventfd - %s", strerror(errno));
+        goto watch_exit;
+    }
+
+    return SERVER_ERROR_NONE;
+
+watch_exit:
+    close(sender->frameFd);
+
+eventfd_exit:
+    close(sender->epollFd);
+
+epoll_exit:
+    (void)List_UnInit(&sender->clientsList);
+
+list_exit:
+    return SERVER_ERROR_INIT;
+}
+
+/*!
+ * Sender's task must be stopped. Frames still being sent are released
+ */
+static void closeSender_f(struct server_sender_s *sender)
+{
+    ASSERT(sender);
+
+    (void)sender->clientsList->lock(sender->clientsList);
+    sender->clientsList->removeAll(sender->clientsList);
+    (void)sender->clientsList->unlock(sender->clientsList);
+
+    (void)List_UnInit(&sender->clientsList);
+
+    close(sender->frameFd);
+    close(sender->epollFd);
+}
+
+/*!
+ *
+ */
+static void notifySender_f(struct server_sender_s *sender)
+{
+    ASSERT(sender);
+
+    uint64_t value = 1;
+    if (write(sender->frameFd, &value, sizeof(value)) < 0) {
+        Loge("Failed to notify sender %u - %s", sender->id, strerror(errno));
+    }
+}
+
+/*!
+ *
+ */
+static struct server_sender_s *getLeastLoadedSender_f(struct server_context_s *ctx)
+{
+    ASSERT(ctx && ctx->senders);
+
+    struct server_sender_s *sender = &ctx->senders[0];
+    uint32_t minClients            = UINT32_MAX;
+    uint32_t nbClients, index;
+
+    if (ctx->nbSenders == 1) {
+        return sender;
+    }
+
+    for (index = 0; index < ctx->nbSenders; index++) {
+        if (ctx->senders[index].clientsList->lock(ctx->senders[index].clientsList)
+                                                                        != LIST_ERROR_NONE) {
+            continue;
+        }
+
+        (void)ctx->senders[index].clientsList->getNbElements(ctx->senders[index].clientsList,
+                                                             &nbClients);
+        (void)ctx->senders[index].clientsList->unlock(ctx->senders[index].clientsList);
+
+        if (nbClients < minClients) {
+            minClients = nbClients;
+            sender     = &ctx->senders[index];
+        }
+    }
+
+    return sender;
+}
+
+/*!
+ * clientsList must be locked
+ */
+static enum server_error_e getClient_f(struct server_sender_s *sender, uint32_t id,
+                                       struct link_s **clientOut)
+{
+    ASSERT(sender && clientOut);
+
+    struct list_s *clientsList = sender->clientsList;
+
+    uint32_t nbClients;
+    if (clientsList->getNbElements(clientsList, &nbClients) != LIST_ERROR_NONE) {
+        return SERVER_ERROR_LIST;
+    }
+
+    while (nbClients > 0) {
+        if (clientsList->getElement(clientsList, (void**)clientOut) != LIST_ERROR_NONE) {
+            return SERVER_ERROR_LIST;
+        }
+
+        if ((*clientOut)->id == id) {
+            return SERVER_ERROR_NONE;
+        }
+
+        nbClients--;
+    }
+
+    return SERVER_ERROR_LIST;
+}
+
+/*!
+ *
+ */
+static enum server_error_e watchClient_f(struct server_sender_s *sender, struct link_s *client,
+                                         uint32_t events)
+{
+    ASSERT(sender && client && client->pData);
+
+    struct client_link_pdata_s *clientData = (struct client_link_pdata_s*)client->pData;
+
+    struct epoll_event event = {0};
+    event.events   = events;
+    event.data.u64 = client->id;
+
+    int32_t op = EPOLL_CTL_ADD;
+    if (clientData->isWatchingOut || (events & EPOLLOUT)) {
+        op = EPOLL_CTL_MOD;
+    }
+
+    if (epoll_ctl(sender->epollFd, op, client->sock, &event) < 0) {
+        Loge("Failed to watch client %u - %s", client->id, strerror(errno));
+        return SERVER_ERROR_PARAMS;
+    }
+
+    clientData->isWatchingOut = !!(events & EPOLLOUT);
+
+    return SERVER_ERROR_NONE;
+}
+
+/*!
+ * clientsList must be locked
+ */
+static void dropClient_f(struct server_sender_s *sender, struct link_s *client)
+{
+    ASSERT(sender && sender->ctx && client);
+
+    struct server_context_s *ctx = sender->ctx;
+
+    if (ctx->params.onClientStateChangedCb) {
+        ctx->params.onClientStateChangedCb(&ctx->params, client, STATE_DISCONNECTED,
+                                                                 ctx->params.userData);
+    }
+
+    // Client disconnected
+    (void)sender->clientsList->remove(sender->clientsList, (void*)&client->id);
+}
+
+/*!
+ * ctx->lock must be locked. The pool only grows when all frames are still being sent
+ */
+static struct server_frame_s *getFreeFrame_f(struct server_context_s *ctx)
+{
+    ASSERT(ctx);
+
+    uint32_t index;
+    for (index = 0; index < ctx->nbFrames; index++) {
+        if (ctx->frames[index]->refCount == 0) {
+            return ctx->frames[index];
+        }
+    }
+
+    ASSERT((ctx->frames = realloc(ctx->frames, (ctx->nbFrames + 1) * sizeof(*ctx->frames))));
+    ASSERT((ctx->frames[ctx->nbFrames] = calloc(1, sizeof(struct server_frame_s))));
+
+    Logd("%s : %u frame(s) in pool", ctx->params.name, ctx->nbFrames + 1);
+
+    return ctx->frames[ctx->nbFrames++];
+}
+
+/*!
+ *
+ */
+static void retainFrame_f(struct server_context_s *ctx, struct server_frame_s *frame)
+{
+    ASSERT(ctx && frame);
+
+    (void)pthread_mutex_lock(&ctx->lock);
+    frame->refCount++;
+    (void)pthread_mutex_unlock(&ctx->lock);
+}
+
+/*!
+ *
+ */
+static void releaseFrame_f(struct server_context_s *ctx, struct server_frame_s *frame)
+{
+    ASSERT(ctx && frame);
+
+    (void)pthread_mutex_lock(&ctx->lock);
+
+    if (frame->refCount == 0) {
+        Loge("Frame %lu is not retained", frame->id);
+    }
+    else {
+        frame->refCount--;
+    }
+
+    (void)pthread_mutex_unlock(&ctx->lock);
+}
+
+/*!
+ * clientsList must be locked
+ */
+static void getClientStatsLocked_f(struct server_sender_s *sender, struct link_s *client,
+                                   struct server_client_stats_s *stats)
+{
+    ASSERT(sender && client && client->pData && stats);
+
+    struct client_link_pdata_s *clientData = (struct client_link_pdata_s*)client->pData;
+
+    stats->nbSentFrames    = clientData->nbSentFrames;
+    stats->nbDroppedFrames = clientData->nbDroppedFrames;
+
+    // A client busy with an old frame will only get the newest one
+    if ((clientData->lastFrameId > 0) && (sender->lastFrameId > clientData->lastFrameId)) {
+        stats->nbDroppedFrames += sender->lastFrameId - clientData->lastFrameId - 1;
+    }
+}
+
+/*!
+ * clientsList must be locked
+ */
+static int8_t startFrame_f(struct server_sender_s *sender, struct link_s *client,
+                           struct server_frame_s *frame)
+{
+    ASSERT(sender && client && client->pData && frame);
+
+    struct client_link_pdata_s *clientData = (struct client_link_pdata_s*)client->pData;
+
+    if (clientData->lastFrameId > 0) {
+        clientData->nbDroppedFrames += frame->id - clientData->lastFrameId - 1;
+    }
+    clientData->lastFrameId = frame->id;
+
+    retainFrame_f(sender->ctx, frame);
+    clientData->frame  = frame;
+    clientData->offset = 0;
+
+    return flushClient_f(sender, client);
+}
+
+/*!
+ * Never blocks: EPOLLOUT is watched until the socket can take the rest of the frame
+ */
+static int8_t flushClient_f(struct server_sender_s *sender, struct link_s *client)
+{
+    ASSERT(sender && client && client->pData);
+
+    struct client_link_pdata_s *clientData = (struct client_link_pdata_s*)client->pData;
+    struct server_frame_s *frame           = clientData->frame;
+    size_t length                          = frame->headerLength + frame->buffer.length;
+    struct iovec iov[2];
+    struct msghdr msg = {0};
+    ssize_t nbWritten;
+
+    msg.msg_iov = iov;
+
+    // Header and data are sent by the same call so they are not split into 2 segments
+    while (clientData->offset < length) {
+        if (clientData->offset < frame->headerLength) {
+            iov[0].iov_base = frame->header + clientData->offset;
+            iov[0].iov_len  = frame->headerLength - clientData->offset;
+            iov[1].iov_base = frame->buffer.data;
+            iov[1].iov_len  = frame->buffer.length;
+            msg.msg_iovlen  = 2;
+        }
+        else {
+            iov[0].iov_base = (uint8_t*)frame->buffer.data
+                              + (clientData->offset - frame->headerLength);
+            iov[0].iov_len  = length - clientData->offset;
+            msg.msg_iovlen  = 1;
+        }
+
+        if ((nbWritten = sendmsg(client->sock, &msg, MSG_DONTWAIT)) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+                Logw("Failed to send data to client %u - %s", client->id, strerror(errno));
+                return ERROR;
+            }
+
+            if (!clientData->isWatchingOut
+                && (watchClient_f(sender, client, EPOLLOUT) != SERVER_ERROR_NONE)) {
+                return ERROR;
+            }
+
+            return BUSY;
+        }
+
+        sender->nbSendCalls++;
+        clientData->offset += (size_t)nbWritten;
+    }
+
+    if (clientData->isWatchingOut && (watchClient_f(sender, client, 0) != SERVER_ERROR_NONE)) {
+        return ERROR;
+    }
+
+    updateStats_f(sender->ctx, frame->id, frame->buffer.captureTime_us);
+    sender->nbClientFrames++;
+    clientData->nbSentFrames++;
+
+    clientData->frame  = NULL;
+    clientData->offset = 0;
+    releaseFrame_f(sender->ctx, frame);
+
+    return DONE;
+}
+
+/*!
+ * clientsList must be locked. All clients are given the same frame
+ */
+static void dispatchFrame_f(struct server_sender_s *sender, struct server_private_data_s *pData,
+                            struct server_frame_s *frame)
+{
+    ASSERT(sender && sender->ctx && pData && frame);
+
+    struct server_context_s *ctx = sender->ctx;
+    struct list_s *clientsList   = sender->clientsList;
+
+    sender->lastFrameId = frame->id;
+
+    uint32_t nbClients;
+    if ((clientsList->getNbElements(clientsList, &nbClients) != LIST_ERROR_NONE)
+        || (nbClients == 0)) {
+        return;
+    }
+
+    struct link_s *client = NULL;
+    struct client_link_pdata_s *clientData;
+
+    while (nbClients > 0) {
+        nbClients--;
+
+        if (clientsList->getElement(clientsList, (void*)&client) != LIST_ERROR_NONE) {
+            break;
+        }
+
+        clientData = (struct client_link_pdata_s*)client->pData;
+
+        if (clientData->isAuthorizedReceiver != 1) {
+            clientData->lastFrameId = 0; // Frames not received meanwhile are not dropped ones
+            continue;
+        }
+
+        if (client->useDestAddress) { // Connectionless : one datagram per frame
+            if (pData->linkHelper->isReadyForWriting(pData->linkHelper, ctx->server, 0) == NO) {
+                continue;
+            }
+
+            if (clientData->lastFrameId > 0) {
+                clientData->nbDroppedFrames += frame->id - clientData->lastFrameId - 1;
+            }
+            clientData->lastFrameId = frame->id;
+
+            sender->nbSendCalls++;
+
+            switch (pData->linkHelper->writeData(pData->linkHelper, ctx->server, client,
+                                                 &frame->buffer, NULL)) {
+                case ERROR:
+                    dropClient_f(sender, client);
+                    break;
+
+                case DONE:
+                    updateStats_f(ctx, frame->id, frame->buffer.captureTime_us);
+                    sender->nbClientFrames++;
+                    clientData->nbSentFrames++;
+                    break;
+
+                default:
+                    clientData->nbDroppedFrames++;
+                    break;
+            }
+            continue;
+        }
+
+        // Still sending a previous frame. Interleaving both would corrupt the stream so the
+        // newest frame is sent once it is done
+        if (clientData->frame) {
+            continue;
+        }
+
+        if (startFrame_f(sender, client, frame) == ERROR) {
+            dropClient_f(sender, client);
+        }
+    }
+}
+
+/*!
+ * Shared by all senders
+ */
+static void updateStats_f(struct server_context_s *ctx, uint64_t frameId, uint64_t captureTime_us)
+{
+    ASSERT(ctx);
+
+    if (pthread_mutex_lock(&ctx->lock) != 0) {
+        return;
+    }
+
+    if (frameId <= ctx->lastSentFrameId) {
+        goto exit;
+    }
+
+    ctx->lastSentFrameId = frameId;
+    ctx->nbSentBuffers++;
+
+    if (captureTime_us == 0) {
+        goto exit;
+    }
+
+    uint64_t now_us = getMonotonicTime_us();
+
+    if (captureTime_us <= now_us) {
+        ctx->lastLatency_us = now_us - captureTime_us;
+
+        if (ctx->lastLatency_us > ctx->maxLatency_us) {
+            ctx->maxLatency_us = ctx->lastLatency_us;
+        }
+    }
+
+exit:
+    (void)pthread_mutex_unlock(&ctx->lock);
+}
+
 /*!
  *
  */
@@ -1024,23 +1739,32 @@ standard:
         }
     }
 
+    // New clients go to the sender having the fewest of them
+    struct server_sender_s *sender = getLeastLoadedSender_f(ctx);
+
     ASSERT((client->pData = calloc(1, sizeof(struct client_link_pdata_s))));
+    ((struct client_link_pdata_s*)client->pData)->sender = sender;
 
-    if (ctx->clientsList->lock(ctx->clientsList) != LIST_ERROR_NONE) {
+    if (sender->clientsList->lock(sender->clientsList) != LIST_ERROR_NONE) {
         Loge("Failed to lock clientsList");
         goto exit_calloc;
     }
 
-    (void)ctx->clientsList->getNbElements(ctx->clientsList, &client->id);
-    client->id += (uint32_t)time(NULL);
+    client->id = ++ctx->lastClientId;
 
     if (ctx->params.acceptMode == SERVER_ACCEPT_MODE_AUTOMATIC) {
         ((struct client_link_pdata_s*)client->pData)->isAuthorizedReceiver = 1;
     }
+
+    // Errors and hang-ups are always reported so disconnections are seen even between frames
+    if (!client->useDestAddress && (watchClient_f(sender, client, 0) != SERVER_ERROR_NONE)) {
+        (void)sender->clientsList->unlock(sender->clientsList);
+        goto exit_calloc;
+    }
     
-    ctx->clientsList->add(ctx->clientsList, (void*)client);
+    sender->clientsList->add(sender->clientsList, (void*)client);
     
-    (void)ctx->clientsList->unlock(ctx->clientsList);
+    (void)sender->clientsList->unlock(sender->clientsList);
     
     if (ctx->params.onClientStateChangedCb) {
         ctx->params.onClientStateChangedCb(&ctx->params, client, STATE_CONNECTED,
@@ -1061,128 +1785,113 @@ exit:
 }
 
 /*!
- *
+ * Wakes up on new frames and on writable clients. A client is only given a new frame once the
+ * previous one has been entirely sent so a slow link never delays the other clients
  */
 static void senderTaskFct_f(struct task_params_s *params)
 {
     ASSERT(params && params->fctData && params->userData);
-    
-    struct server_context_s *ctx        = (struct server_context_s*)params->fctData;
+
+    struct server_sender_s *sender      = (struct server_sender_s*)params->fctData;
+    struct server_context_s *ctx        = sender->ctx;
     struct server_private_data_s *pData = (struct server_private_data_s*)params->userData;
-    
-    if (ctx->quit) {
-        return;
+
+    if (ctx->params.pinSenderThreads && !sender->pinned) {
+        cpu_set_t cpuset;
+        long nbCpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+        CPU_ZERO(&cpuset);
+        CPU_SET((size_t)sender->id % (size_t)(nbCpus > 0 ? nbCpus : 1), &cpuset);
+
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) != 0) {
+            Logw("Failed to pin sender %u", sender->id);
+        }
+
+        sender->pinned = 1;
     }
-    
-    sem_wait(&ctx->sem);
-    
+
     if (ctx->quit) {
         return;
     }
 
-    if (ctx->senderSuspended) {
+    int32_t nbEvents = epoll_wait(sender->epollFd, sender->events, SENDER_MAX_EVENTS,
+                                  WAIT_TIME_2S);
+
+    if (ctx->quit || (nbEvents <= 0)) {
         return;
     }
 
-    if (ctx->clientsList->lock(ctx->clientsList) != LIST_ERROR_NONE) {
+    if (sender->clientsList->lock(sender->clientsList) != LIST_ERROR_NONE) {
         Logd("Failed to lock clientsList");
         return;
     }
-    
-    uint32_t nbClients;
-    if (ctx->clientsList->getNbElements(ctx->clientsList, &nbClients) == LIST_ERROR_NONE) {
-        if (nbClients > 0) {
-            if (pthread_mutex_lock(&ctx->lock) != 0) {
-                goto exit;
-            }
 
-            if (ctx->bufferIn.data && (ctx->bufferIn.length != 0)) {
-                ctx->bufferOut.length = ctx->bufferIn.length;
-                ASSERT((ctx->bufferOut.data = calloc(1, ctx->bufferOut.length)));
-                memcpy(ctx->bufferOut.data, ctx->bufferIn.data, ctx->bufferOut.length);
-            }
-            else {
-                nbClients = 0; // Force exit!
-            }
+    struct link_s *client                  = NULL;
+    struct client_link_pdata_s *clientData = NULL;
+    uint8_t newFrame                       = 0;
+    uint64_t nbFrames;
+    int32_t index;
+    int8_t ret;
+
+    for (index = 0; index < nbEvents; index++) {
+        if (sender->events[index].data.u64 == SENDER_FRAME_EVENT) {
+            // Only the latest frame is kept by sendData()
+            newFrame = (read(sender->frameFd, &nbFrames, sizeof(nbFrames)) > 0);
+            continue;
+        }
 
-            (void)pthread_mutex_unlock(&ctx->lock);
+        if (getClient_f(sender, (uint32_t)sender->events[index].data.u64,
+                        &client) != SERVER_ERROR_NONE) {
+            continue; // Already disconnected
         }
-        else {
-            goto exit;
+
+        if (sender->events[index].events & (EPOLLERR | EPOLLHUP)) {
+            dropClient_f(sender, client);
+            continue;
         }
-        
-        struct link_s *client = NULL;
-        while (nbClients > 0) {
-            nbClients--;
-            
-            if (ctx->clientsList->getElement(ctx->clientsList,
-                                             (void*)&client) != LIST_ERROR_NONE) {
-                break;
-            }
-            
-            if (((struct client_link_pdata_s*)client->pData)->isAuthorizedReceiver != 1) {
-                continue;
-            }
-            
-            if (pData->linkHelper->isReadyForWriting(pData->linkHelper,
-                                                     client->useDestAddress ? ctx->server
-                                                                            : client, 0) == NO) {
-                continue;
-            }
-            
-            if (ctx->params.mode == LINK_MODE_HTTP) {
-                strcpy(ctx->httpContent.mime, ctx->params.mime);
-                ctx->httpContent.length = ctx->bufferOut.length;
-                pData->linkHelper->prepareHttpContent(pData->linkHelper, &ctx->httpContent);
-                
-                ctx->senderTempBuffer.data   = (void*)ctx->httpContent.str;
-                ctx->senderTempBuffer.length = strlen(ctx->httpContent.str);
-                    
-                if (pData->linkHelper->writeData(pData->linkHelper,
-                                                 client->useDestAddress ? ctx->server : client,
-                                                 client->useDestAddress ? client : NULL,
-                                                 &ctx->senderTempBuffer, NULL) == ERROR) {
-                    if (ctx->params.onClientStateChangedCb) {
-                        ctx->params.onClientStateChangedCb(&ctx->params, client,
-                                                           STATE_DISCONNECTED,
-                                                           ctx->params.userData);
-                    }
-                    // Client disconnected
-                    (void)ctx->clientsList->remove(ctx->clientsList, (void*)&client->id);
-                    goto next_client;
-                }
-            }
-            
-            if (pData->linkHelper->writeData(pData->linkHelper,
-                                             client->useDestAddress ? ctx->server : client,
-                                             client->useDestAddress ? client : NULL,
-                                             &ctx->bufferOut, NULL) == ERROR) {
-                if (ctx->params.onClientStateChangedCb) {
-                    ctx->params.onClientStateChangedCb(&ctx->params, client, STATE_DISCONNECTED,
-                                                                             ctx->params.userData);
-                }
-                
-                // Client disconnected
-                (void)ctx->clientsList->remove(ctx->clientsList, (void*)&client->id);
-                goto next_client;
-            }
 
-next_client:
-            ;
+        if (!(sender->events[index].events & EPOLLOUT)) {
+            continue;
         }
-        
-        (void)pthread_mutex_lock(&ctx->lock);
-        
-        if (ctx->bufferOut.data) {
-            free(ctx->bufferOut.data);
-            ctx->bufferOut.data = NULL;
+
+        clientData = (struct client_link_pdata_s*)client->pData;
+        ret        = flushClient_f(sender, client);
+
+        // Latest frame wins: the ones dispatched while this one was being sent are dropped
+        if ((ret == DONE) && sender->currentFrame && !ctx->senderSuspended
+            && (clientData->isAuthorizedReceiver == 1)
+            && (sender->currentFrame->id > clientData->lastFrameId)) {
+            ret = startFrame_f(sender, client, sender->currentFrame);
         }
-            
+
+        if (ret == ERROR) {
+            dropClient_f(sender, client);
+        }
+    }
+
+    if (ctx->senderSuspended && sender->currentFrame) {
+        releaseFrame_f(ctx, sender->currentFrame);
+        sender->currentFrame = NULL;
+    }
+
+    struct server_frame_s *frame = NULL;
+
+    if (newFrame && (pthread_mutex_lock(&ctx->lock) == 0)) {
+        frame               = sender->latestFrame;
+        sender->latestFrame = NULL;
         (void)pthread_mutex_unlock(&ctx->lock);
     }
 
-exit:
-    (void)ctx->clientsList->unlock(ctx->clientsList);
+    if (frame) {
+        dispatchFrame_f(sender, pData, frame);
+
+        if (sender->currentFrame) {
+            releaseFrame_f(ctx, sender->currentFrame);
+        }
+        sender->currentFrame = frame;
+    }
+
+    (void)sender->clientsList->unlock(sender->clientsList);
 }
 
 /* -------------------------------------------------------------------------------------------- */
@@ -1213,26 +1922,41 @@ static void releaseServerCb(struct list_s *obj, void *element)
     
     /* Stop and uninit tasks */
     ctx->quit = 1;
-    sem_post(&ctx->sem);
+
+    uint32_t index;
+    for (index = 0; index < ctx->nbSenders; index++) {
+        notifySender_f(&ctx->senders[index]);
+    }
 
     (void)ctx->serverTask->stop(ctx->serverTask, &ctx->watcherTaskParams);
-    (void)ctx->serverTask->stop(ctx->serverTask, &ctx->senderTaskParams);
+
+    for (index = 0; index < ctx->nbSenders; index++) {
+        (void)ctx->serverTask->stop(ctx->serverTask, &ctx->senders[index].taskParams);
+    }
     
     (void)ctx->serverTask->destroy(ctx->serverTask, &ctx->watcherTaskParams);
-    (void)ctx->serverTask->destroy(ctx->serverTask, &ctx->senderTaskParams);
+
+    for (index = 0; index < ctx->nbSenders; index++) {
+        (void)ctx->serverTask->destroy(ctx->serverTask, &ctx->senders[index].taskParams);
+    }
     
     (void)Task_UnInit(&ctx->serverTask);
     
-    /* Destroy sem and mutex */
+    /* Close senders. Frames still being sent are released */
+    for (index = 0; index < ctx->nbSenders; index++) {
+        closeSender_f(&ctx->senders[index]);
+    }
+    free(ctx->senders);
+
+    /* Release frames pool */
+    for (index = 0; index < ctx->nbFrames; index++) {
+        free(ctx->frames[index]->buffer.data);
+        free(ctx->frames[index]);
+    }
+    free(ctx->frames);
+
+    /* Destroy mutex */
     (void)pthread_mutex_destroy(&ctx->lock);
-    (void)sem_destroy(&ctx->sem);
-    
-    /* Uninit clientsList */
-    (void)ctx->clientsList->lock(ctx->clientsList);
-    ctx->clientsList->removeAll(ctx->clientsList);
-    (void)ctx->clientsList->unlock(ctx->clientsList);
-        
-    (void)List_UnInit(&ctx->clientsList);
     
     /* Close socket */
     (void)closeServerSocket_f(ctx);
@@ -1262,10 +1986,23 @@ static void releaseClientCb(struct list_s *obj, void *element)
     
     struct link_s *client = (struct link_s*)element;
     
+    // Closing the socket also removes it from senderTask's epoll set
     close(client->sock);
     
     if (client->pData) {
-        free(client->pData);
+        struct client_link_pdata_s *clientData = (struct client_link_pdata_s*)client->pData;
+
+        struct server_client_stats_s stats;
+        getClientStatsLocked_f(clientData->sender, client, &stats);
+
+        Logd("Client %u : %lu frame(s) sent / %lu dropped", client->id,
+                stats.nbSentFrames, stats.nbDroppedFrames);
+
+        if (clientData->frame) {
+            releaseFrame_f(clientData->sender->ctx, clientData->frame);
+        }
+
+        free(clientData);
     }
     
     free(client);
@@ -0,0 +1,1118 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file Converter.c
+* \brief Pixel format conversion with SIMD kernels
+* \author Boubacar DIENE
+*
+* Frames are converted row by row : each source row is first unpacked to planar Y, U and V rows
+* (chroma subsampled horizontally) which are then packed to the destination format. Only the hot
+* steps (YUV -> RGB and chroma deinterleaving) have SIMD kernels, the remaining ones being mostly
+* memcpy()
+*/
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#include <arm_neon.h>
+#endif
+
+#include "utils/Converter.h"
+#include "utils/Log.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#undef  TAG
+#define TAG "Converter"
+
+#if defined(__SSE2__)
+    #define CONVERTER_HAVE_SSE2
+    #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        #define CONVERTER_HAVE_AVX2
+        #define TARGET_AVX2 __attribute__((target("avx2")))
+    #endif
+#endif
+
+#if defined(__ARM_NEON) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    #define CONVERTER_HAVE_NEON
+#endif
+
+/* BT.601 limited range with 6 bits of precision so that all products fit in 16 bits. Luma
+ * coefficient is 74.5 i.e (y * 74) + (y >> 1) otherwise white would not reach 255 */
+#define COEF_Y   74
+#define COEF_RV 102
+#define COEF_GU  25
+#define COEF_GV  52
+#define COEF_BU 129
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/* u and v have width / 2 elements */
+typedef void (*converter_yuv_to_rgb_row_f)(const uint8_t *y, const uint8_t *u, const uint8_t *v,
+                                           uint8_t *dst, uint32_t width, uint8_t hasAlpha);
+typedef void (*converter_unpack_packed_row_f)(const uint8_t *src, uint8_t *y, uint8_t *u,
+                                              uint8_t *v, uint32_t width,
+                                              enum converter_format_e format);
+typedef void (*converter_unpack_uv_row_f)(const uint8_t *src, uint8_t *u, uint8_t *v,
+                                          uint32_t nbPairs);
+
+struct converter_kernels_s {
+    converter_yuv_to_rgb_row_f    yuvToRgbRow;
+    converter_unpack_packed_row_f unpackPackedRow;
+    converter_unpack_uv_row_f     unpackUvRow;
+};
+
+/* Position of each component in a 4-byte group of packed 4:2:2 formats */
+struct converter_packed_layout_s {
+    uint8_t y0;
+    uint8_t y1;
+    uint8_t u;
+    uint8_t v;
+};
+
+struct converter_private_data_s {
+    enum converter_kernel_e          kernel;
+    const struct converter_kernels_s *kernels;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PUBLIC FUNCTIONS PROTOTYPES //////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static enum converter_error_e getFrameSize_f(struct converter_s *obj,
+                                             enum converter_format_e format,
+                                             uint32_t width, uint32_t height, size_t *size);
+static enum converter_error_e setFrame_f(struct converter_s *obj, enum converter_format_e format,
+                                         uint32_t width, uint32_t height, void *data,
+                                         struct converter_frame_s *frame);
+
+static enum converter_error_e convert_f(struct converter_s *obj, struct converter_frame_s *src,
+                                        struct converter_frame_s *dst);
+
+static enum converter_error_e getKernel_f(struct converter_s *obj,
+                                          enum converter_kernel_e *kernel);
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PRIVATE FUNCTIONS PROTOTYPES /////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static uint8_t isKernelSupported_f(enum converter_kernel_e kernel);
+static uint8_t isYuvFormat_f(enum converter_format_e format);
+static uint32_t getNbPlanes_f(enum converter_format_e format);
+static size_t getRowSize_f(enum converter_format_e format, uint32_t plane, uint32_t width);
+static enum converter_error_e checkFrame_f(struct converter_frame_s *frame);
+
+static void getYuvRow_f(const struct converter_kernels_s *kernels,
+                        struct converter_frame_s *src, uint32_t row, uint8_t *scratch,
+                        const uint8_t **y, const uint8_t **u, const uint8_t **v);
+static void putYuvRow_f(const struct converter_kernels_s *kernels,
+                        struct converter_frame_s *dst, uint32_t row,
+                        const uint8_t *y, const uint8_t *u, const uint8_t *v);
+
+static uint8_t clamp_f(int32_t value);
+static void storeRgb24_f(const uint8_t *r, const uint8_t *g, const uint8_t *b, uint8_t *dst,
+                         uint32_t nbPixels);
+
+static void yuvToRgbRowScalar_f(const uint8_t *y, const uint8_t *u, const uint8_t *v,
+                                uint8_t *dst, uint32_t width, uint8_t hasAlpha);
+static void unpackPackedRowScalar_f(const uint8_t *src, uint8_t *y, uint8_t *u, uint8_t *v,
+                                    uint32_t width, enum converter_format_e format);
+static void unpackUvRowScalar_f(const uint8_t *src, uint8_t *u, uint8_t *v, uint32_t nbPairs);
+
+#ifdef CONVERTER_HAVE_SSE2
+static void yuvToRgbRowSse2_f(const uint8_t *y, const uint8_t *u, const uint8_t *v,
+                              uint8_t *dst, uint32_t width, uint8_t hasAlpha);
+static void unpackPackedRowSse2_f(const uint8_t *src, uint8_t *y, uint8_t *u, uint8_t *v,
+                                  uint32_t width, enum converter_format_e format);
+static void unpackUvRowSse2_f(const uint8_t *src, uint8_t *u, uint8_t *v, uint32_t nbPairs);
+#endif
+
+#ifdef CONVERTER_HAVE_AVX2
+static void yuvToRgbRowAvx2_f(const uint8_t *y, const uint8_t *u, const uint8_t *v,
+                              uint8_t *dst, uint32_t width, uint8_t hasAlpha);
+#endif
+
+#ifdef CONVERTER_HAVE_NEON
+static void yuvToRgbRowNeon_f(const uint8_t *y, const uint8_t *u, const uint8_t *v,
+                              uint8_t *dst, uint32_t width, uint8_t hasAlpha);
+static void unpackPackedRowNeon_f(const uint8_t *src, uint8_t *y, uint8_t *u, uint8_t *v,
+                                  uint32_t width, enum converter_format_e format);
+static void unpackUvRowNeon_f(const uint8_t *src, uint8_t *u, uint8_t *v, uint32_t nbPairs);
+#endif
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// GLOBALS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static const struct converter_packed_layout_s gPackedLayouts[] = {
+    [CONVERTER_FORMAT_YUYV] = { .y0 = 0, .y1 = 2, .u = 1, .v = 3 },
+    [CONVERTER_FORMAT_YVYU] = { .y0 = 0, .y1 = 2, .u = 3, .v = 1 },
+    [CONVERTER_FORMAT_UYVY] = { .y0 = 1, .y1 = 3, .u = 0, .v = 2 }
+};
+
+static const struct converter_kernels_s gKernels[CONVERTER_KERNEL_MAX] = {
+    [CONVERTER_KERNEL_SCALAR] = {
+        .yuvToRgbRow     = yuvToRgbRowScalar_f,
+        .unpackPackedRow = unpackPackedRowScalar_f,
+        .unpackUvRow     = unpackUvRowScalar_f
+    },
+#ifdef CONVERTER_HAVE_SSE2
+    [CONVERTER_KERNEL_SSE2] = {
+        .yuvToRgbRow     = yuvToRgbRowSse2_f,
+        .unpackPackedRow = unpackPackedRowSse2_f,
+        .unpackUvRow     = unpackUvRowSse2_f
+    },
+#endif
+#ifdef CONVERTER_HAVE_AVX2
+    /* Deinterleaving is memory bound so SSE2 is enough */
+    [CONVERTER_KERNEL_AVX2] = {
+        .yuvToRgbRow     = yuvToRgbRowAvx2_f,
+        .unpackPackedRow = unpackPackedRowSse2_f,
+        .unpackUvRow     = unpackUvRowSse2_f
+    },
+#endif
+#ifdef CONVERTER_HAVE_NEON
+    [CONVERTER_KERNEL_NEON] = {
+        .yuvToRgbRow     = yuvToRgbRowNeon_f,
+        .unpackPackedRow = unpackPackedRowNeon_f,
+        .unpackUvRow     = unpackUvRowNeon_f
+    },
+#endif
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+enum converter_error_e Converter_Init(struct converter_s **obj, enum converter_kernel_e kernel)
+{
+    ASSERT(obj);
+
+    if (kernel == CONVERTER_KERNEL_AUTO) {
+        if (isKernelSupported_f(CONVERTER_KERNEL_AVX2)) {
+            kernel = CONVERTER_KERNEL_AVX2;
+        }
+        else if (isKernelSupported_f(CONVERTER_KERNEL_NEON)) {
+            kernel = CONVERTER_KERNEL_NEON;
+        }
+        else if (isKernelSupported_f(CONVERTER_KERNEL_SSE2)) {
+            kernel = CONVERTER_KERNEL_SSE2;
+        }
+        else {
+            kernel = CONVERTER_KERNEL_SCALAR;
+        }
+    }
+    else if (!isKernelSupported_f(kernel)) {
+        Loge("Kernel %u not supported", kernel);
+        return CONVERTER_ERROR_PARAMS;
+    }
+
+    ASSERT((*obj = calloc(1, sizeof(struct converter_s))));
+
+    struct converter_private_data_s *pData;
+    ASSERT((pData = calloc(1, sizeof(struct converter_private_data_s))));
+
+    pData->kernel  = kernel;
+    pData->kernels = &gKernels[kernel];
+
+    (*obj)->getFrameSize = getFrameSize_f;
+    (*obj)->setFrame     = setFrame_f;
+    (*obj)->convert      = convert_f;
+    (*obj)->getKernel    = getKernel_f;
+
+    (*obj)->pData = (void*)pData;
+
+    return CONVERTER_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+enum converter_error_e Converter_UnInit(struct converter_s **obj)
+{
+    ASSERT(obj && *obj && (*obj)->pData);
+
+    free((*obj)->pData);
+    free(*obj);
+    *obj = NULL;
+
+    return CONVERTER_ERROR_NONE;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////// PUBLIC FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+static enum converter_error_e getFrameSize_f(struct converter_s *obj,
+                                             enum converter_format_e format,
+                                             uint32_t width, uint32_t height, size_t *size)
+{
+    ASSERT(obj && obj->pData && size);
+
+    struct converter_frame_s frame = {0};
+    enum converter_error_e ret     = CONVERTER_ERROR_NONE;
+
+    /* Any non-NULL address is fine to compute offsets */
+    if ((ret = setFrame_f(obj, format, width, height, (void*)obj, &frame)) != CONVERTER_ERROR_NONE) {
+        return ret;
+    }
+
+    switch (format) {
+        case CONVERTER_FORMAT_NV12:
+            *size = (size_t)frame.strides[0] * height
+                    + (size_t)frame.strides[1] * ((height + 1) / 2);
+            break;
+
+        case CONVERTER_FORMAT_I420:
+            *size = (size_t)frame.strides[0] * height
+                    + (size_t)frame.strides[1] * ((height + 1) / 2) * 2;
+            break;
+
+        default:
+            *size = (size_t)frame.strides[0] * height;
+            break;
+    }
+
+    return CONVERTER_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+static enum converter_error_e setFrame_f(struct converter_s *obj, enum converter_format_e format,
+                                         uint32_t width, uint32_t height, void *data,
+                                         struct converter_frame_s *frame)
+{
+    ASSERT(obj && obj->pData && frame);
+
+    if (!data || (format >= CONVERTER_FORMAT_MAX) || (width == 0) || (height == 0)
+        || ((width % 2) != 0)) {
+        Loge("Bad params");
+        return CONVERTER_ERROR_PARAMS;
+    }
+
+    memset(frame, 0, sizeof(struct converter_frame_s));
+
+    frame->format    = format;
+    frame->width     = width;
+    frame->height    = height;
+    frame->planes[0] = (uint8_t*)data;
+
+    switch (format) {
+        case CONVERTER_FORMAT_YUYV:
+        case CONVERTER_FORMAT_YVYU:
+        case CONVERTER_FORMAT_UYVY:
+            frame->strides[0] = width * 2;
+            break;
+
+        case CONVERTER_FORMAT_NV12:
+            frame->strides[0] = width;
+            frame->strides[1] = width;
+            frame->planes[1]  = frame->planes[0] + (size_t)width * height;
+            break;
+
+        case CONVERTER_FORMAT_I420:
+            frame->strides[0] = width;
+            frame->strides[1] = width / 2;
+            frame->strides[2] = width / 2;
+            frame->planes[1]  = frame->planes[0] + (size_t)width * height;
+            frame->planes[2]  = frame->planes[1] + (size_t)(width / 2) * ((height + 1) / 2);
+            break;
+
+        case CONVERTER_FORMAT_RGB24:
+            frame->strides[0] = width * 3;
+            break;
+
+        case CONVERTER_FORMAT_ARGB8888:
+            frame->strides[0] = width * 4;
+            break;
+
+        default:
+            return CONVERTER_ERROR_FORMAT;
+    }
+
+    return CONVERTER_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+static enum converter_error_e convert_f(struct converter_s *obj, struct converter_frame_s *src,
+                                        struct converter_frame_s *dst)
+{
+    ASSERT(obj && obj->pData);
+
+    if (!src || !dst || (checkFrame_f(src) != CONVERTER_ERROR_NONE)
+        || (checkFrame_f(dst) != CONVERTER_ERROR_NONE)
+        || (src->width != dst->width) || (src->height != dst->height)) {
+        Loge("Bad params");
+        return CONVERTER_ERROR_PARAMS;
+    }
+
+    if (!isYuvFormat_f(src->format)) {
+        Loge("Conversion from format %u not supported", src->format);
+        return CONVERTER_ERROR_FORMAT;
+    }
+
+    struct converter_private_data_s *pData = (struct converter_private_data_s*)(obj->pData);
+    uint32_t row, plane;
+
+    /* Nothing to convert */
+    if (src->format == dst->format) {
+        size_t rowSize;
+        uint32_t nbRows;
+
+        for (plane = 0; plane < getNbPlanes_f(src->format); plane++) {
+            nbRows  = ((plane == 0) ? src->height : (src->height + 1) / 2);
+            rowSize = getRowSize_f(src->format, plane, src->width);
+
+            for (row = 0; row < nbRows; row++) {
+                memcpy(dst->planes[plane] + (size_t)row * dst->strides[plane],
+                       src->planes[plane] + (size_t)row * src->strides[plane], rowSize);
+            }
+        }
+
+        return CONVERTER_ERROR_NONE;
+    }
+
+    /* Planar Y, U and V rows */
+    uint8_t *scratch;
+    ASSERT((scratch = malloc((size_t)src->width * 2)));
+
+    const uint8_t *y, *u, *v;
+
+    for (row = 0; row < src->height; row++) {
+        getYuvRow_f(pData->kernels, src, row, scratch, &y, &u, &v);
+        putYuvRow_f(pData->kernels, dst, row, y, u, v);
+    }
+
+    free(scratch);
+
+    return CONVERTER_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+static enum converter_error_e getKernel_f(struct converter_s *obj,
+                                          enum converter_kernel_e *kernel)
+{
+    ASSERT(obj && obj->pData && kernel);
+
+    struct converter_private_data_s *pData = (struct converter_private_data_s*)(obj->pData);
+
+    *kernel = pData->kernel;
+
+    return CONVERTER_ERROR_NONE;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////// PRIVATE FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+static uint8_t isKernelSupported_f(enum converter_kernel_e kernel)
+{
+    switch (kernel) {
+        case CONVERTER_KERNEL_SCALAR:
+            return 1;
+
+#ifdef CONVERTER_HAVE_SSE2
+        case CONVERTER_KERNEL_SSE2:
+            return 1;
+#endif
+
+#ifdef CONVERTER_HAVE_AVX2
+        case CONVERTER_KERNEL_AVX2:
+            return (__builtin_cpu_supports("avx2") != 0);
+#endif
+
+#ifdef CONVERTER_HAVE_NEON
+        case CONVERTER_KERNEL_NEON:
+            return 1;
+#endif
+
+        default:
+            return 0;
+    }
+}
+
+/*!
+ *
+ */
+static uint8_t isYuvFormat_f(enum converter_format_e format)
+{
+    return ((format != CONVERTER_FORMAT_RGB24) && (format != CONVERTER_FORMAT_ARGB8888));
+}
+
+/*!
+ *
+ */
+static uint32_t getNbPlanes_f(enum converter_format_e format)
+{
+    switch (format) {
+        case CONVERTER_FORMAT_NV12:
+            return 2;
+
+        case CONVERTER_FORMAT_I420:
+            return 3;
+
+        default:
+            return 1;
+    }
+}
+
+/*!
+ * Number of useful bytes in a row of the given plane
+ */
+static size_t getRowSize_f(enum converter_format_e format, uint32_t plane, uint32_t width)
+{
+    switch (format) {
+        case CONVERTER_FORMAT_NV12:
+            return width;
+
+        case CONVERTER_FORMAT_I420:
+            return ((plane == 0) ? width : width / 2);
+
+        case CONVERTER_FORMAT_RGB24:
+            return (size_t)width * 3;
+
+        case CONVERTER_FORMAT_ARGB8888:
+            return (size_t)width * 4;
+
+        default:
+            return (size_t)width * 2;
+    }
+}
+
+/*!
+ *
+ */
+static enum converter_error_e checkFrame_f(struct converter_frame_s *frame)
+{
+    ASSERT(frame);
+
+    if ((frame->format >= CONVERTER_FORMAT_MAX) || (frame->width == 0) || (frame->height == 0)
+        || ((frame->width % 2) != 0)) {
+        return CONVERTER_ERROR_PARAMS;
+    }
+
+    uint32_t plane;
+    for (plane = 0; plane < getNbPlanes_f(frame->format); plane++) {
+        if (!frame->planes[plane] || (frame->strides[plane] == 0)) {
+            return CONVERTER_ERROR_PARAMS;
+        }
+    }
+
+    return CONVERTER_ERROR_NONE;
+}
+
+/*!
+ * Get planar Y, U and V rows from source. scratch must hold 2 * width bytes
+ */
+static void getYuvRow_f(const struct converter_kernels_s *kernels,
+                        struct converter_frame_s *src, uint32_t row, uint8_t *scratch,
+                        const uint8_t **y, const uint8_t **u, const uint8_t **v)
+{
+    ASSERT(kernels && src && scratch && y && u && v);
+
+    uint8_t *scratchY = scratch;
+    uint8_t *scratchU = scratchY + src->width;
+    uint8_t *scratchV = scratchU + src->width / 2;
+
+    switch (src->format) {
+        case CONVERTER_FORMAT_NV12:
+            kernels->unpackUvRow(src->planes[1] + (size_t)(row / 2) * src->strides[1],
+                                 scratchU, scratchV, src->width / 2);
+            *y = src->planes[0] + (size_t)row * src->strides[0];
+            *u = scratchU;
+            *v = scratchV;
+            break;
+
+        case CONVERTER_FORMAT_I420:
+            *y = src->planes[0] + (size_t)row * src->strides[0];
+            *u = src->planes[1] + (size_t)(row / 2) * src->strides[1];
+            *v = src->planes[2] + (size_t)(row / 2) * src->strides[2];
+            break;
+
+        default:
+            kernels->unpackPackedRow(src->planes[0] + (size_t)row * src->strides[0],
+                                     scratchY, scratchU, scratchV, src->width, src->format);
+            *y = scratchY;
+            *u = scratchU;
+            *v = scratchV;
+            break;
+    }
+}
+
+/*!
+ * Write planar Y, U and V rows to destination. 4:2:0 chroma is taken from even rows
+ */
+static void putYuvRow_f(const struct converter_kernels_s *kernels,
+                        struct converter_frame_s *dst, uint32_t row,
+                        const uint8_t *y, const uint8_t *u, const uint8_t *v)
+{
+    ASSERT(kernels && dst && y && u && v);
+
+    uint8_t *out = dst->planes[0] + (size_t)row * dst->strides[0];
+    uint32_t x;
+
+    switch (dst->format) {
+        case CONVERTER_FORMAT_RGB24:
+            kernels->yuvToRgbRow(y, u, v, out, dst->width, 0);
+            break;
+
+        case CONVERTER_FORMAT_ARGB8888:
+            kernels->yuvToRgbRow(y, u, v, out, dst->width, 1);
+            break;
+
+        case CONVERTER_FORMAT_NV12:
+            memcpy(out, y, dst->width);
+
+            if ((row % 2) == 0) {
+                out = dst->planes[1] + (size_t)(row / 2) * dst->strides[1];
+                for (x = 0; x < dst->width / 2; x++) {
+                    out[2 * x]     = u[x];
+                    out[2 * x + 1] = v[x];
+                }
+            }
+            break;
+
+        case CONVERTER_FORMAT_I420:
+            memcpy(out, y, dst->width);
+
+            if ((row % 2) == 0) {
+                memcpy(dst->planes[1] + (size_t)(row / 2) * dst->strides[1], u, dst->width / 2);
+                memcpy(dst->planes[2] + (size_t)(row / 2) * dst->strides[2], v, dst->width / 2);
+            }
+            break;
+
+        default: {
+            const struct converter_packed_layout_s *layout = &gPackedLayouts[dst->format];
+
+            for (x = 0; x < dst->width / 2; x++) {
+                out[4 * x + layout->y0] = y[2 * x];
+                out[4 * x + layout->y1] = y[2 * x + 1];
+                out[4 * x + layout->u]  = u[x];
+                out[4 * x + layout->v]  = v[x];
+            }
+            break;
+        }
+    }
+}
+
+/*!
+ *
+ */
+static uint8_t clamp_f(int32_t value)
+{
+    return (uint8_t)(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+/*!
+ *
+ */
+static void storeRgb24_f(const uint8_t *r, const uint8_t *g, const uint8_t *b, uint8_t *dst,
+                         uint32_t nbPixels)
+{
+    uint32_t x;
+    for (x = 0; x < nbPixels; x++) {
+        dst[3 * x]     = r[x];
+        dst[3 * x + 1] = g[x];
+        dst[3 * x + 2] = b[x];
+    }
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// SCALAR ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ * Reference implementation. SIMD kernels must give exactly the same results
+ */
+static void yuvToRgbRowScalar_f(const uint8_t *y, const uint8_t *u, const uint8_t *v,
+                                uint8_t *dst, uint32_t width, uint8_t hasAlpha)
+{
+    int32_t c, d, e;
+    uint8_t r, g, b;
+    uint32_t x, pixel;
+
+    for (x = 0; x < width; x++) {
+        c = (y[x] - 16) * COEF_Y + ((y[x] - 16) >> 1);
+        d = u[x / 2] - 128;
+        e = v[x / 2] - 128;
+
+        r = clamp_f((c + COEF_RV * e + 32) >> 6);
+        g = clamp_f((c - (COEF_GU * d + COEF_GV * e) + 32) >> 6);
+        b = clamp_f((c + COEF_BU * d + 32) >> 6);
+
+        if (hasAlpha) {
+            pixel = (0xFFu << 24) | ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+            memcpy(dst + 4 * x, &pixel, sizeof(pixel));
+        }
+        else {
+            dst[3 * x]     = r;
+            dst[3 * x + 1] = g;
+            dst[3 * x + 2] = b;
+        }
+    }
+}
+
+/*!
+ *
+ */
+static void unpackPackedRowScalar_f(const uint8_t *src, uint8_t *y, uint8_t *u, uint8_t *v,
+                                    uint32_t width, enum converter_format_e format)
+{
+    const struct converter_packed_layout_s *layout = &gPackedLayouts[format];
+
+    uint32_t x;
+    for (x = 0; x < width / 2; x++) {
+        y[2 * x]     = src[4 * x + layout->y0];
+        y[2 * x + 1] = src[4 * x + layout->y1];
+        u[x]         = src[4 * x + layout->u];
+        v[x]         = src[4 * x + layout->v];
+    }
+}
+
+/*!
+ *
+ */
+static void unpackUvRowScalar_f(const uint8_t *src, uint8_t *u, uint8_t *v, uint32_t nbPairs)
+{
+    uint32_t x;
+    for (x = 0; x < nbPairs; x++) {
+        u[x] = src[2 * x];
+        v[x] = src[2 * x + 1];
+    }
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////////// SSE2 /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#ifdef CONVERTER_HAVE_SSE2
+
+/*!
+ * 16 pixels per iteration
+ */
+static void yuvToRgbRowSse2_f(const uint8_t *y, const uint8_t *u, const uint8_t *v,
+                              uint8_t *dst, uint32_t width, uint8_t hasAlpha)
+{
+    const __m128i zero  = _mm_setzero_si128();
+    const __m128i alpha = _mm_set1_epi8(-1);
+    const __m128i y16   = _mm_set1_epi16(16);
+    const __m128i c128  = _mm_set1_epi16(128);
+    const __m128i round = _mm_set1_epi16(32);
+    const __m128i kY    = _mm_set1_epi16(COEF_Y);
+    const __m128i kRV   = _mm_set1_epi16(COEF_RV);
+    const __m128i kGU   = _mm_set1_epi16(COEF_GU);
+    const __m128i kGV   = _mm_set1_epi16(COEF_GV);
+    const __m128i kBU   = _mm_set1_epi16(COEF_BU);
+    const uint32_t bpp  = (hasAlpha ? 4 : 3);
+
+    uint8_t rgb[3][16] __attribute__((aligned(16)));
+    __m128i yy, uu, vv, yLo, yHi, d, e, dLo, dHi, eLo, eHi, r, g, b;
+    __m128i bg0, bg1, ra0, ra1;
+    uint32_t x;
+
+    for (x = 0; x + 16 <= width; x += 16) {
+        yy = _mm_loadu_si128((const __m128i*)(const void*)(y + x));
+        uu = _mm_loadl_epi64((const __m128i*)(const void*)(u + x / 2));
+        vv = _mm_loadl_epi64((const __m128i*)(const void*)(v + x / 2));
+
+        yLo = _mm_sub_epi16(_mm_unpacklo_epi8(yy, zero), y16);
+        yHi = _mm_sub_epi16(_mm_unpackhi_epi8(yy, zero), y16);
+        yLo = _mm_add_epi16(_mm_mullo_epi16(yLo, kY), _mm_srai_epi16(yLo, 1));
+        yHi = _mm_add_epi16(_mm_mullo_epi16(yHi, kY), _mm_srai_epi16(yHi, 1));
+
+        /* Each chroma sample is shared by 2 pixels */
+        d   = _mm_sub_epi16(_mm_unpacklo_epi8(uu, zero), c128);
+        e   = _mm_sub_epi16(_mm_unpacklo_epi8(vv, zero), c128);
+        dLo = _mm_unpacklo_epi16(d, d);
+        dHi = _mm_unpackhi_epi16(d, d);
+        eLo = _mm_unpacklo_epi16(e, e);
+        eHi = _mm_unpackhi_epi16(e, e);
+
+        r = _mm_packus_epi16(
+                _mm_srai_epi16(_mm_adds_epi16(_mm_adds_epi16(yLo, _mm_mullo_epi16(eLo, kRV)),
+                                              round), 6),
+                _mm_srai_epi16(_mm_adds_epi16(_mm_adds_epi16(yHi, _mm_mullo_epi16(eHi, kRV)),
+                                              round), 6));
+        g = _mm_packus_epi16(
+                _mm_srai_epi16(_mm_adds_epi16(_mm_subs_epi16(yLo,
+                                                  _mm_adds_epi16(_mm_mullo_epi16(dLo, kGU),
+                                                                 _mm_mullo_epi16(eLo, kGV))),
+                                              round), 6),
+                _mm_srai_epi16(_mm_adds_epi16(_mm_subs_epi16(yHi,
+                                                  _mm_adds_epi16(_mm_mullo_epi16(dHi, kGU),
+                                                                 _mm_mullo_epi16(eHi, kGV))),
+                                              round), 6));
+        b = _mm_packus_epi16(
+                _mm_srai_epi16(_mm_adds_epi16(_mm_adds_epi16(yLo, _mm_mullo_epi16(dLo, kBU)),
+                                              round), 6),
+                _mm_srai_epi16(_mm_adds_epi16(_mm_adds_epi16(yHi, _mm_mullo_epi16(dHi, kBU)),
+                                              round), 6));
+
+        if (hasAlpha) {
+            /* B G R A in memory */
+            bg0 = _mm_unpacklo_epi8(b, g);
+            bg1 = _mm_unpackhi_epi8(b, g);
+            ra0 = _mm_unpacklo_epi8(r, alpha);
+            ra1 = _mm_unpackhi_epi8(r, alpha);
+
+            _mm_storeu_si128((__m128i*)(void*)(dst + 4 * x),      _mm_unpacklo_epi16(bg0, ra0));
+            _mm_storeu_si128((__m128i*)(void*)(dst + 4 * x + 16), _mm_unpackhi_epi16(bg0, ra0));
+            _mm_storeu_si128((__m128i*)(void*)(dst + 4 * x + 32), _mm_unpacklo_epi16(bg1, ra1));
+            _mm_storeu_si128((__m128i*)(void*)(dst + 4 * x + 48), _mm_unpackhi_epi16(bg1, ra1));
+        }
+        else {
+            _mm_store_si128((__m128i*)(void*)rgb[0], r);
+            _mm_store_si128((__m128i*)(void*)rgb[1], g);
+            _mm_store_si128((__m128i*)(void*)rgb[2], b);
+
+            storeRgb24_f(rgb[0], rgb[1], rgb[2], dst + 3 * x, 16);
+        }
+    }
+
+    yuvToRgbRowScalar_f(y + x, u + x / 2, v + x / 2, dst + bpp * x, width - x, hasAlpha);
+}
+
+/*!
+ * 16 pixels per iteration
+ */
+static void unpackPackedRowSse2_f(const uint8_t *src, uint8_t *y, uint8_t *u, uint8_t *v,
+                                  uint32_t width, enum converter_format_e format)
+{
+    const __m128i mask = _mm_set1_epi16(0x00FF);
+    const __m128i zero = _mm_setzero_si128();
+
+    __m128i a, b, even, odd, luma, chroma, first, second;
+    uint32_t x;
+
+    for (x = 0; x + 16 <= width; x += 16) {
+        a = _mm_loadu_si128((const __m128i*)(const void*)(src + 2 * x));
+        b = _mm_loadu_si128((const __m128i*)(const void*)(src + 2 * x + 16));
+
+        even = _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask));
+        odd  = _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+
+        luma   = (format == CONVERTER_FORMAT_UYVY ? odd : even);
+        chroma = (format == CONVERTER_FORMAT_UYVY ? even : odd);
+
+        first  = _mm_packus_epi16(_mm_and_si128(chroma, mask), zero);
+        second = _mm_packus_epi16(_mm_srli_epi16(chroma, 8), zero);
+
+        _mm_storeu_si128((__m128i*)(void*)(y + x), luma);
+
+        if (format == CONVERTER_FORMAT_YVYU) {
+            _mm_storel_epi64((__m128i*)(void*)(u + x / 2), second);
+            _mm_storel_epi64((__m128i*)(void*)(v + x / 2), first);
+        }
+        else {
+            _mm_storel_epi64((__m128i*)(void*)(u + x / 2), first);
+            _mm_storel_epi64((__m128i*)(void*)(v + x / 2), second);
+        }
+    }
+
+    unpackPackedRowScalar_f(src + 2 * x, y + x, u + x / 2, v + x / 2, width - x, format);
+}
+
+/*!
+ * 16 pairs per iteration
+ */
+static void unpackUvRowSse2_f(const uint8_t *src, uint8_t *u, uint8_t *v, uint32_t nbPairs)
+{
+    const __m128i mask = _mm_set1_epi16(0x00FF);
+
+    __m128i a, b;
+    uint32_t x;
+
+    for (x = 0; x + 16 <= nbPairs; x += 16) {
+        a = _mm_loadu_si128((const __m128i*)(const void*)(src + 2 * x));
+        b = _mm_loadu_si128((const __m128i*)(const void*)(src + 2 * x + 16));
+
+        _mm_storeu_si128((__m128i*)(void*)(u + x),
+                         _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask)));
+        _mm_storeu_si128((__m128i*)(void*)(v + x),
+                         _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)));
+    }
+
+    unpackUvRowScalar_f(src + 2 * x, u + x, v + x, nbPairs - x);
+}
+
+#endif //CONVERTER_HAVE_SSE2
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////////// AVX2 /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#ifdef CONVERTER_HAVE_AVX2
+
+/*!
+ * 32 pixels per iteration. Only called if supported by the running cpu
+ */
+TARGET_AVX2
+static void yuvToRgbRowAvx2_f(const uint8_t *y, const uint8_t *u, const uint8_t *v,
+                              uint8_t *dst, uint32_t width, uint8_t hasAlpha)
+{
+    const __m256i alpha = _mm256_set1_epi8(-1);
+    const __m256i y16   = _mm256_set1_epi16(16);
+    const __m256i c128  = _mm256_set1_epi16(128);
+    const __m256i round = _mm256_set1_epi16(32);
+    const __m256i kY    = _mm256_set1_epi16(COEF_Y);
+    const __m256i kRV   = _mm256_set1_epi16(COEF_RV);
+    const __m256i kGU   = _mm256_set1_epi16(COEF_GU);
+    const __m256i kGV   = _mm256_set1_epi16(COEF_GV);
+    const __m256i kBU   = _mm256_set1_epi16(COEF_BU);
+    const uint32_t bpp  = (hasAlpha ? 4 : 3);
+
+    uint8_t rgb[3][32] __attribute__((aligned(32)));
+    __m128i uu, vv;
+    __m256i yLo, yHi, dLo, dHi, eLo, eHi, r, g, b;
+    __m256i bg0, bg1, ra0, ra1, p0, p1, p2, p3;
+    uint32_t x;
+
+    for (x = 0; x + 32 <= width; x += 32) {
+        /* Widening keeps pixels in order whereas 256 bits unpacks work per 128 bits lane */
+        yLo = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(const void*)(y + x)));
+        yHi = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(const void*)(y + x + 16)));
+        yLo = _mm256_sub_epi16(yLo, y16);
+        yHi = _mm256_sub_epi16(yHi, y16);
+        yLo = _mm256_add_epi16(_mm256_mullo_epi16(yLo, kY), _mm256_srai_epi16(yLo, 1));
+        yHi = _mm256_add_epi16(_mm256_mullo_epi16(yHi, kY), _mm256_srai_epi16(yHi, 1));
+
+        /* Each chroma sample is shared by 2 pixels */
+        uu  = _mm_loadu_si128((const __m128i*)(const void*)(u + x / 2));
+        vv  = _mm_loadu_si128((const __m128i*)(const void*)(v + x / 2));
+        dLo = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_unpacklo_epi8(uu, uu)), c128);
+        dHi = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_unpackhi_epi8(uu, uu)), c128);
+        eLo = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_unpacklo_epi8(vv, vv)), c128);
+        eHi = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_unpackhi_epi8(vv, vv)), c128);
+
+        r = _mm256_packus_epi16(
+                _mm256_srai_epi16(_mm256_adds_epi16(
+                    _mm256_adds_epi16(yLo, _mm256_mullo_epi16(eLo, kRV)), round), 6),
+                _mm256_srai_epi16(_mm256_adds_epi16(
+                    _mm256_adds_epi16(yHi, _mm256_mullo_epi16(eHi, kRV)), round), 6));
+        g = _mm256_packus_epi16(
+                _mm256_srai_epi16(_mm256_adds_epi16(
+                    _mm256_subs_epi16(yLo, _mm256_adds_epi16(_mm256_mullo_epi16(dLo, kGU),
+                                                             _mm256_mullo_epi16(eLo, kGV))),
+                    round), 6),
+                _mm256_srai_epi16(_mm256_adds_epi16(
+                    _mm256_subs_epi16(yHi, _mm256_adds_epi16(_mm256_mullo_epi16(dHi, kGU),
+                                                             _mm256_mullo_epi16(eHi, kGV))),
+                    round), 6));
+        b = _mm256_packus_epi16(
+                _mm256_srai_epi16(_mm256_adds_epi16(
+                    _mm256_adds_epi16(yLo, _mm256_mullo_epi16(dLo, kBU)), round), 6),
+                _mm256_srai_epi16(_mm256_adds_epi16(
+                    _mm256_adds_epi16(yHi, _mm256_mullo_epi16(dHi, kBU)), round), 6));
+
+        /* packus works per lane : restore pixels order */
+        r = _mm256_permute4x64_epi64(r, 0xD8);
+        g = _mm256_permute4x64_epi64(g, 0xD8);
+        b = _mm256_permute4x64_epi64(b, 0xD8);
+
+        if (hasAlpha) {
+            /* B G R A in memory. Lane 0 holds pixels 0-15 and lane 1 pixels 16-31 */
+            bg0 = _mm256_unpacklo_epi8(b, g);
+            bg1 = _mm256_unpackhi_epi8(b, g);
+            ra0 = _mm256_unpacklo_epi8(r, alpha);
+            ra1 = _mm256_unpackhi_epi8(r, alpha);
+
+            p0 = _mm256_unpacklo_epi16(bg0, ra0); /* Pixels 0-3   | 16-19 */
+            p1 = _mm256_unpackhi_epi16(bg0, ra0); /* Pixels 4-7   | 20-23 */
+            p2 = _mm256_unpacklo_epi16(bg1, ra1); /* Pixels 8-11  | 24-27 */
+            p3 = _mm256_unpackhi_epi16(bg1, ra1); /* Pixels 12-15 | 28-31 */
+
+            _mm256_storeu_si256((__m256i*)(void*)(dst + 4 * x),
+                                _mm256_permute2x128_si256(p0, p1, 0x20));
+            _mm256_storeu_si256((__m256i*)(void*)(dst + 4 * x + 32),
+                                _mm256_permute2x128_si256(p2, p3, 0x20));
+            _mm256_storeu_si256((__m256i*)(void*)(dst + 4 * x + 64),
+                                _mm256_permute2x128_si256(p0, p1, 0x31));
+            _mm256_storeu_si256((__m256i*)(void*)(dst + 4 * x + 96),
+                                _mm256_permute2x128_si256(p2, p3, 0x31));
+        }
+        else {
+            _mm256_store_si256((__m256i*)(void*)rgb[0], r);
+            _mm256_store_si256((__m256i*)(void*)rgb[1], g);
+            _mm256_store_si256((__m256i*)(void*)rgb[2], b);
+
+            storeRgb24_f(rgb[0], rgb[1], rgb[2], dst + 3 * x, 32);
+        }
+    }
+
+    yuvToRgbRowSse2_f(y + x, u + x / 2, v + x / 2, dst + bpp * x, width - x, hasAlpha);
+}
+
+#endif //CONVERTER_HAVE_AVX2
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////////// NEON /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#ifdef CONVERTER_HAVE_NEON
+
+/*!
+ * 16 pixels per iteration
+ */
+static void yuvToRgbRowNeon_f(const uint8_t *y, const uint8_t *u, const uint8_t *v,
+                              uint8_t *dst, uint32_t width, uint8_t hasAlpha)
+{
+    const int16x8_t y16   = vdupq_n_s16(16);
+    const int16x8_t c128  = vdupq_n_s16(128);
+    const int16x8_t round = vdupq_n_s16(32);
+    const uint32_t bpp    = (hasAlpha ? 4 : 3);
+
+    uint8x16_t yy;
+    uint8x8_t uu, vv;
+    int16x8_t yLo, yHi, d, e, dLo, dHi, eLo, eHi;
+    int16x8x2_t zipped;
+    uint8x16x4_t argb;
+    uint8x16x3_t rgb;
+    uint32_t x;
+
+    argb.val[3] = vdupq_n_u8(0xFF);
+
+    for (x = 0; x + 16 <= width; x += 16) {
+        yy = vld1q_u8(y + x);
+        uu = vld1_u8(u + x / 2);
+        vv = vld1_u8(v + x / 2);
+
+        yLo = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(yy))), y16);
+        yHi = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(yy))), y16);
+        yLo = vaddq_s16(vmulq_n_s16(yLo, COEF_Y), vshrq_n_s16(yLo, 1));
+        yHi = vaddq_s16(vmulq_n_s16(yHi, COEF_Y), vshrq_n_s16(yHi, 1));
+
+        /* Each chroma sample is shared by 2 pixels */
+        d      = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(uu)), c128);
+        e      = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vv)), c128);
+        zipped = vzipq_s16(d, d);
+        dLo    = zipped.val[0];
+        dHi    = zipped.val[1];
+        zipped = vzipq_s16(e, e);
+        eLo    = zipped.val[0];
+        eHi    = zipped.val[1];
+
+        rgb.val[0] = vcombine_u8(
+                vqmovun_s16(vshrq_n_s16(vqaddq_s16(vqaddq_s16(yLo, vmulq_n_s16(eLo, COEF_RV)),
+                                                   round), 6)),
+                vqmovun_s16(vshrq_n_s16(vqaddq_s16(vqaddq_s16(yHi, vmulq_n_s16(eHi, COEF_RV)),
+                                                   round), 6)));
+        rgb.val[1] = vcombine_u8(
+                vqmovun_s16(vshrq_n_s16(vqaddq_s16(vqsubq_s16(yLo,
+                                            vqaddq_s16(vmulq_n_s16(dLo, COEF_GU),
+                                                       vmulq_n_s16(eLo, COEF_GV))),
+                                                   round), 6)),
+                vqmovun_s16(vshrq_n_s16(vqaddq_s16(vqsubq_s16(yHi,
+                                            vqaddq_s16(vmulq_n_s16(dHi, COEF_GU),
+                                                       vmulq_n_s16(eHi, COEF_GV))),
+                                                   round), 6)));
+        rgb.val[2] = vcombine_u8(
+                vqmovun_s16(vshrq_n_s16(vqaddq_s16(vqaddq_s16(yLo, vmulq_n_s16(dLo, COEF_BU)),
+                                                   round), 6)),
+                vqmovun_s16(vshrq_n_s16(vqaddq_s16(vqaddq_s16(yHi, vmulq_n_s16(dHi, COEF_BU)),
+                                                   round), 6)));
+
+        if (hasAlpha) {
+            /* B G R A in memory */
+            argb.val[0] = rgb.val[2];
+            argb.val[1] = rgb.val[1];
+            argb.val[2] = rgb.val[0];
+            vst4q_u8(dst + 4 * x, argb);
+        }
+        else {
+            vst3q_u8(dst + 3 * x, rgb);
+        }
+    }
+
+    yuvToRgbRowScalar_f(y + x, u + x / 2, v + x / 2, dst + bpp * x, width - x, hasAlpha);
+}
+
+/*!
+ * 32 pixels per iteration
+ */
+static void unpackPackedRowNeon_f(const uint8_t *src, uint8_t *y, uint8_t *u, uint8_t *v,
+                                  uint32_t width, enum converter_format_e format)
+{
+    const struct converter_packed_layout_s *layout = &gPackedLayouts[format];
+
+    uint8x16x4_t groups;
+    uint8x16x2_t luma;
+    uint32_t x;
+
+    for (x = 0; x + 32 <= width; x += 32) {
+        groups = vld4q_u8(src + 2 * x);
+
+        luma.val[0] = groups.val[layout->y0];
+        luma.val[1] = groups.val[layout->y1];
+
+        vst2q_u8(y + x, luma);
+        vst1q_u8(u + x / 2, groups.val[layout->u]);
+        vst1q_u8(v + x / 2, groups.val[layout->v]);
+    }
+
+    unpackPackedRowScalar_f(src + 2 * x, y + x, u + x / 2, v + x / 2, width - x, format);
+}
+
+/*!
+ * 16 pairs per iteration
+ */
+static void unpackUvRowNeon_f(const uint8_t *src, uint8_t *u, uint8_t *v, uint32_t nbPairs)
+{
+    uint8x16x2_t pairs;
+    uint32_t x;
+
+    for (x = 0; x + 16 <= nbPairs; x += 16) {
+        pairs = vld2q_u8(src + 2 * x);
+
+        vst1q_u8(u + x, pairs.val[0]);
+        vst1q_u8(v + x, pairs.val[1]);
+    }
+
+    unpackUvRowScalar_f(src + 2 * x, u + x, v + x, nbPairs - x);
+}
+
+#endif //CONVERTER_HAVE_NEON
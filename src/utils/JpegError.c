@@ -0,0 +1,107 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file JpegError.c
+* \brief libjpeg's errors handling
+* \author Boubacar DIENE
+*/
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include "utils/Log.h"
+#include "utils/JpegError.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#undef  TAG
+#define TAG "JpegError"
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PRIVATE FUNCTIONS PROTOTYPES /////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static void onJpegErrorCb(j_common_ptr cinfo);
+static void onJpegMessageCb(j_common_ptr cinfo);
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+struct jpeg_error_mgr *JpegError_Init(struct jpeg_error_s *err, uint8_t isQuiet)
+{
+    ASSERT(err);
+
+    struct jpeg_error_mgr *mgr = jpeg_std_error(&err->mgr);
+
+    mgr->error_exit     = onJpegErrorCb;
+    mgr->output_message = onJpegMessageCb;
+
+    err->isQuiet = isQuiet;
+
+    return mgr;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////// PRIVATE FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ * Replace libjpeg's default handler which exits the process
+ */
+static void onJpegErrorCb(j_common_ptr cinfo)
+{
+    ASSERT(cinfo && cinfo->err);
+
+    struct jpeg_error_s *err = (struct jpeg_error_s*)(void*)cinfo->err;
+
+    (*cinfo->err->output_message)(cinfo);
+
+    longjmp(err->jmpBuf, 1);
+}
+
+/*!
+ *
+ */
+static void onJpegMessageCb(j_common_ptr cinfo)
+{
+    ASSERT(cinfo && cinfo->err);
+
+    struct jpeg_error_s *err = (struct jpeg_error_s*)(void*)cinfo->err;
+    char message[JMSG_LENGTH_MAX];
+
+    if (err->isQuiet) {
+        return;
+    }
+
+    (*cinfo->err->format_message)(cinfo, message);
+
+    Logw("libjpeg : %s", message);
+}
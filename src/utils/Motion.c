@@ -0,0 +1,463 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file Motion.c
+* \brief Change detection based on the sum of absolute differences of luma samples
+* \author Boubacar DIENE
+*
+* Only one row out of gridStep is compared so that the cost stays negligible compared to the
+* capture itself. Whole rows are processed by SIMD kernels : chroma bytes of packed formats are
+* simply masked out
+*/
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#include <arm_neon.h>
+#endif
+
+#include "utils/Log.h"
+#include "utils/Motion.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#undef  TAG
+#define TAG "Motion"
+
+#if defined(__SSE2__)
+    #define MOTION_HAVE_SSE2
+    #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        #define MOTION_HAVE_AVX2
+    #endif
+#endif
+
+#if defined(__ARM_NEON) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    #define MOTION_HAVE_NEON
+#endif
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/* Sum of |a[x] - b[x]| for bytes selected by mask. Low byte of mask applies to even bytes */
+typedef uint64_t (*motion_sad_row_f)(const uint8_t *a, const uint8_t *b, uint32_t size,
+                                     uint16_t mask);
+
+/* Luma samples of the first plane */
+struct motion_layout_s {
+    uint8_t  bytesPerPixel;
+    uint16_t mask;
+};
+
+struct motion_private_data_s {
+    enum converter_kernel_e kernel;
+    motion_sad_row_f        sadRow;
+    uint32_t                gridStep;
+
+    /* Sampled rows of the reference frame */
+    uint8_t                 hasReference;
+    enum converter_format_e format;
+    uint32_t                width;
+    uint32_t                height;
+    uint8_t                 *rows;
+    size_t                  rowsSize;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PUBLIC FUNCTIONS PROTOTYPES //////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static enum motion_error_e getScore_f(struct motion_s *obj, struct converter_frame_s *frame,
+                                      uint32_t *score);
+static enum motion_error_e setReference_f(struct motion_s *obj, struct converter_frame_s *frame);
+
+static enum motion_error_e getKernel_f(struct motion_s *obj, enum converter_kernel_e *kernel);
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PRIVATE FUNCTIONS PROTOTYPES /////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static uint8_t isKernelSupported_f(enum converter_kernel_e kernel);
+static enum motion_error_e checkFrame_f(struct converter_frame_s *frame);
+
+static uint64_t sadRowScalar_f(const uint8_t *a, const uint8_t *b, uint32_t size,
+                               uint16_t mask);
+
+#ifdef MOTION_HAVE_SSE2
+static uint64_t sadRowSse2_f(const uint8_t *a, const uint8_t *b, uint32_t size, uint16_t mask);
+#endif
+
+#ifdef MOTION_HAVE_NEON
+static uint64_t sadRowNeon_f(const uint8_t *a, const uint8_t *b, uint32_t size, uint16_t mask);
+#endif
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// GLOBALS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static const struct motion_layout_s gLayouts[] = {
+    [CONVERTER_FORMAT_YUYV] = { 2, 0x00FF },
+    [CONVERTER_FORMAT_YVYU] = { 2, 0x00FF },
+    [CONVERTER_FORMAT_UYVY] = { 2, 0xFF00 },
+    [CONVERTER_FORMAT_NV12] = { 1, 0xFFFF },
+    [CONVERTER_FORMAT_I420] = { 1, 0xFFFF }
+};
+
+static const motion_sad_row_f gKernels[CONVERTER_KERNEL_MAX] = {
+    [CONVERTER_KERNEL_SCALAR] = sadRowScalar_f,
+#ifdef MOTION_HAVE_SSE2
+    [CONVERTER_KERNEL_SSE2]   = sadRowSse2_f,
+#endif
+#ifdef MOTION_HAVE_AVX2
+    /* Memory bound so SSE2 is enough */
+    [CONVERTER_KERNEL_AVX2]   = sadRowSse2_f,
+#endif
+#ifdef MOTION_HAVE_NEON
+    [CONVERTER_KERNEL_NEON]   = sadRowNeon_f,
+#endif
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+enum motion_error_e Motion_Init(struct motion_s **obj, enum converter_kernel_e kernel,
+                                uint32_t gridStep)
+{
+    ASSERT(obj);
+
+    if (kernel == CONVERTER_KERNEL_AUTO) {
+        if (isKernelSupported_f(CONVERTER_KERNEL_AVX2)) {
+            kernel = CONVERTER_KERNEL_AVX2;
+        }
+        else if (isKernelSupported_f(CONVERTER_KERNEL_NEON)) {
+            kernel = CONVERTER_KERNEL_NEON;
+        }
+        else if (isKernelSupported_f(CONVERTER_KERNEL_SSE2)) {
+            kernel = CONVERTER_KERNEL_SSE2;
+        }
+        else {
+            kernel = CONVERTER_KERNEL_SCALAR;
+        }
+    }
+    else if (!isKernelSupported_f(kernel)) {
+        Loge("Kernel %u not supported", kernel);
+        return MOTION_ERROR_PARAMS;
+    }
+
+    ASSERT((*obj = calloc(1, sizeof(struct motion_s))));
+
+    struct motion_private_data_s *pData;
+    ASSERT((pData = calloc(1, sizeof(struct motion_private_data_s))));
+
+    pData->kernel   = kernel;
+    pData->sadRow   = gKernels[kernel];
+    pData->gridStep = (gridStep > 0 ? gridStep : MOTION_DEFAULT_GRID_STEP);
+
+    (*obj)->getScore     = getScore_f;
+    (*obj)->setReference = setReference_f;
+    (*obj)->getKernel    = getKernel_f;
+
+    (*obj)->pData = (void*)pData;
+
+    return MOTION_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+enum motion_error_e Motion_UnInit(struct motion_s **obj)
+{
+    ASSERT(obj && *obj && (*obj)->pData);
+
+    struct motion_private_data_s *pData = (struct motion_private_data_s*)((*obj)->pData);
+
+    if (pData->rows) {
+        free(pData->rows);
+    }
+
+    free(pData);
+    free(*obj);
+    *obj = NULL;
+
+    return MOTION_ERROR_NONE;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////// PUBLIC FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+static enum motion_error_e getScore_f(struct motion_s *obj, struct converter_frame_s *frame,
+                                      uint32_t *score)
+{
+    ASSERT(obj && obj->pData && score);
+
+    struct motion_private_data_s *pData = (struct motion_private_data_s*)(obj->pData);
+    enum motion_error_e ret;
+
+    if (!frame) {
+        return MOTION_ERROR_PARAMS;
+    }
+
+    if ((ret = checkFrame_f(frame)) != MOTION_ERROR_NONE) {
+        return ret;
+    }
+
+    if (!pData->hasReference || (pData->format != frame->format)
+        || (pData->width != frame->width) || (pData->height != frame->height)) {
+        *score = MOTION_MAX_SCORE;
+        return MOTION_ERROR_NONE;
+    }
+
+    const struct motion_layout_s *layout = &gLayouts[frame->format];
+    uint32_t rowSize                     = frame->width * layout->bytesPerPixel;
+    const uint8_t *reference             = pData->rows;
+    uint64_t sum                         = 0;
+    uint64_t nbRows                      = 0;
+    uint32_t y;
+
+    for (y = 0; y < frame->height; y += pData->gridStep) {
+        sum += pData->sadRow(frame->planes[0] + (size_t)y * frame->strides[0], reference,
+                             rowSize, layout->mask);
+        reference += rowSize;
+        nbRows++;
+    }
+
+    *score = (uint32_t)((sum * MOTION_MAX_SCORE) / (nbRows * frame->width * 255));
+
+    return MOTION_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+static enum motion_error_e setReference_f(struct motion_s *obj, struct converter_frame_s *frame)
+{
+    ASSERT(obj && obj->pData);
+
+    struct motion_private_data_s *pData = (struct motion_private_data_s*)(obj->pData);
+    enum motion_error_e ret;
+
+    if (!frame) {
+        return MOTION_ERROR_PARAMS;
+    }
+
+    if ((ret = checkFrame_f(frame)) != MOTION_ERROR_NONE) {
+        return ret;
+    }
+
+    uint32_t rowSize = frame->width * gLayouts[frame->format].bytesPerPixel;
+    uint32_t nbRows  = (frame->height + pData->gridStep - 1) / pData->gridStep;
+    size_t size      = (size_t)nbRows * rowSize;
+
+    if (size > pData->rowsSize) {
+        uint8_t *rows = realloc(pData->rows, size);
+        if (!rows) {
+            Loge("Failed to allocate %zu bytes", size);
+            pData->hasReference = 0;
+            return MOTION_ERROR_PARAMS;
+        }
+        pData->rows     = rows;
+        pData->rowsSize = size;
+    }
+
+    uint8_t *reference = pData->rows;
+    uint32_t y;
+
+    for (y = 0; y < frame->height; y += pData->gridStep) {
+        memcpy(reference, frame->planes[0] + (size_t)y * frame->strides[0], rowSize);
+        reference += rowSize;
+    }
+
+    pData->format       = frame->format;
+    pData->width        = frame->width;
+    pData->height       = frame->height;
+    pData->hasReference = 1;
+
+    return MOTION_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+static enum motion_error_e getKernel_f(struct motion_s *obj, enum converter_kernel_e *kernel)
+{
+    ASSERT(obj && obj->pData && kernel);
+
+    struct motion_private_data_s *pData = (struct motion_private_data_s*)(obj->pData);
+
+    *kernel = pData->kernel;
+
+    return MOTION_ERROR_NONE;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////// PRIVATE FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+static uint8_t isKernelSupported_f(enum converter_kernel_e kernel)
+{
+    switch (kernel) {
+        case CONVERTER_KERNEL_SCALAR:
+            return 1;
+
+#ifdef MOTION_HAVE_SSE2
+        case CONVERTER_KERNEL_SSE2:
+            return 1;
+#endif
+
+#ifdef MOTION_HAVE_AVX2
+        case CONVERTER_KERNEL_AVX2:
+            return (__builtin_cpu_supports("avx2") != 0);
+#endif
+
+#ifdef MOTION_HAVE_NEON
+        case CONVERTER_KERNEL_NEON:
+            return 1;
+#endif
+
+        default:
+            return 0;
+    }
+}
+
+/*!
+ *
+ */
+static enum motion_error_e checkFrame_f(struct converter_frame_s *frame)
+{
+    ASSERT(frame);
+
+    if (frame->format > CONVERTER_FORMAT_I420) {
+        return MOTION_ERROR_FORMAT;
+    }
+
+    if ((frame->width == 0) || (frame->height == 0) || !frame->planes[0]
+        || (frame->strides[0] < frame->width * gLayouts[frame->format].bytesPerPixel)) {
+        return MOTION_ERROR_PARAMS;
+    }
+
+    return MOTION_ERROR_NONE;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// SCALAR ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+static uint64_t sadRowScalar_f(const uint8_t *a, const uint8_t *b, uint32_t size, uint16_t mask)
+{
+    uint64_t sum = 0;
+    uint32_t x;
+
+    for (x = 0; x < size; x++) {
+        if ((mask >> ((x & 1) * 8)) & 0xFF) {
+            sum += (uint64_t)(a[x] > b[x] ? a[x] - b[x] : b[x] - a[x]);
+        }
+    }
+
+    return sum;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////////// SSE2 /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#ifdef MOTION_HAVE_SSE2
+
+/*!
+ * 16 bytes per iteration
+ */
+static uint64_t sadRowSse2_f(const uint8_t *a, const uint8_t *b, uint32_t size, uint16_t mask)
+{
+    const __m128i m = _mm_set1_epi16((int16_t)mask);
+
+    __m128i sum = _mm_setzero_si128();
+    __m128i aa, bb;
+    uint64_t lanes[2];
+    uint32_t x;
+
+    for (x = 0; x + 16 <= size; x += 16) {
+        aa  = _mm_and_si128(_mm_loadu_si128((const __m128i*)(const void*)(a + x)), m);
+        bb  = _mm_and_si128(_mm_loadu_si128((const __m128i*)(const void*)(b + x)), m);
+        sum = _mm_add_epi64(sum, _mm_sad_epu8(aa, bb));
+    }
+
+    _mm_storeu_si128((__m128i*)(void*)lanes, sum);
+
+    /* x is even so mask still applies to the remaining bytes */
+    return lanes[0] + lanes[1] + sadRowScalar_f(a + x, b + x, size - x, mask);
+}
+
+#endif //MOTION_HAVE_SSE2
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////////// NEON /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#ifdef MOTION_HAVE_NEON
+
+/*!
+ * 16 bytes per iteration
+ */
+static uint64_t sadRowNeon_f(const uint8_t *a, const uint8_t *b, uint32_t size, uint16_t mask)
+{
+    const uint8x16_t m = vreinterpretq_u8_u16(vdupq_n_u16(mask));
+
+    uint32x4_t sum = vdupq_n_u32(0);
+    uint64x2_t total;
+    uint8x16_t diff;
+    uint32_t x;
+
+    for (x = 0; x + 16 <= size; x += 16) {
+        diff = vandq_u8(vabdq_u8(vld1q_u8(a + x), vld1q_u8(b + x)), m);
+        sum  = vpadalq_u16(sum, vpaddlq_u8(diff));
+    }
+
+    total = vpaddlq_u32(sum);
+
+    return vgetq_lane_u64(total, 0) + vgetq_lane_u64(total, 1)
+           + sadRowScalar_f(a + x, b + x, size - x, mask);
+}
+
+#endif //MOTION_HAVE_NEON
@@ -0,0 +1,553 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file Pattern.c
+* \brief Synthetic video frames with an embedded frame counter and timestamp
+* \author Boubacar DIENE
+*
+* Colour bars are vertical so only the first row of each plane is drawn pixel by pixel, the
+* other ones are copies of it. Stamps are made of squares of the darkest and lightest grey so
+* that they can be read back by thresholding the center of each square, even after a lossy
+* compression
+*/
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include "utils/Log.h"
+#include "utils/Pattern.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#undef  TAG
+#define TAG "Pattern"
+
+#define PATTERN_NB_BARS     8
+#define PATTERN_BARS_SPEED  4 /* Pixels per frame */
+
+#define PATTERN_STAMP_MAGIC 0xA53C
+#define PATTERN_STAMP_LEVEL 128
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/* Same colour in BT.601 limited range YUV and in RGB */
+struct pattern_color_s {
+    uint8_t y, u, v;
+    uint8_t r, g, b;
+};
+
+struct pattern_private_data_s {
+    enum pattern_type_e type;
+    uint64_t            seed; /* Noise generator */
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PUBLIC FUNCTIONS PROTOTYPES //////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static enum pattern_error_e generate_f(struct pattern_s *obj, struct converter_frame_s *frame,
+                                       struct pattern_stamp_s *stamp);
+static enum pattern_error_e readStamp_f(struct pattern_s *obj, struct converter_frame_s *frame,
+                                        struct pattern_stamp_s *stamp);
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PRIVATE FUNCTIONS PROTOTYPES /////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static enum pattern_error_e checkFrame_f(struct converter_frame_s *frame);
+static uint32_t getPlaneGeometry_f(struct converter_frame_s *frame, uint32_t plane,
+                                   size_t *rowSize, uint32_t *nbRows);
+
+static void drawBars_f(struct converter_frame_s *frame, uint32_t counter);
+static void drawNoise_f(struct pattern_private_data_s *pData, struct converter_frame_s *frame);
+static void drawStamp_f(struct converter_frame_s *frame, struct pattern_stamp_s *stamp);
+
+static void fillRect_f(struct converter_frame_s *frame, uint32_t left, uint32_t top,
+                       uint32_t width, uint32_t height, const struct pattern_color_s *color);
+static uint8_t getLuma_f(struct converter_frame_s *frame, uint32_t x, uint32_t y);
+static uint8_t isStampable_f(struct converter_frame_s *frame);
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////////////// GLOBAL VARIABLES ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/* 75% colour bars */
+static const struct pattern_color_s gBars[PATTERN_NB_BARS] = {
+    { 180, 128, 128, 191, 191, 191 }, /* White   */
+    { 162,  44, 142, 191, 191,   0 }, /* Yellow  */
+    { 131, 156,  44,   0, 191, 191 }, /* Cyan    */
+    { 112,  72,  58,   0, 191,   0 }, /* Green   */
+    {  84, 184, 198, 191,   0, 191 }, /* Magenta */
+    {  65, 100, 212, 191,   0,   0 }, /* Red     */
+    {  35, 212, 114,   0,   0, 191 }, /* Blue    */
+    {  16, 128, 128,   0,   0,   0 }  /* Black   */
+};
+
+static const struct pattern_color_s gStampColors[2] = {
+    {  16, 128, 128,   0,   0,   0 }, /* 0 */
+    { 235, 128, 128, 255, 255, 255 }  /* 1 */
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+enum pattern_error_e Pattern_Init(struct pattern_s **obj, enum pattern_type_e type)
+{
+    ASSERT(obj);
+
+    if (type >= PATTERN_TYPE_MAX) {
+        Loge("Pattern %u not supported", type);
+        return PATTERN_ERROR_PARAMS;
+    }
+
+    ASSERT((*obj = calloc(1, sizeof(struct pattern_s))));
+
+    struct pattern_private_data_s *pData;
+    ASSERT((pData = calloc(1, sizeof(struct pattern_private_data_s))));
+
+    pData->type = type;
+    pData->seed = 0x9E3779B97F4A7C15ULL;
+
+    (*obj)->generate  = generate_f;
+    (*obj)->readStamp = readStamp_f;
+
+    (*obj)->pData = (void*)pData;
+
+    return PATTERN_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+enum pattern_error_e Pattern_UnInit(struct pattern_s **obj)
+{
+    ASSERT(obj && *obj && (*obj)->pData);
+
+    free((*obj)->pData);
+    free(*obj);
+    *obj = NULL;
+
+    return PATTERN_ERROR_NONE;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////// PUBLIC FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+static enum pattern_error_e generate_f(struct pattern_s *obj, struct converter_frame_s *frame,
+                                       struct pattern_stamp_s *stamp)
+{
+    ASSERT(obj && obj->pData);
+
+    struct pattern_private_data_s *pData = (struct pattern_private_data_s*)(obj->pData);
+    enum pattern_error_e ret             = PATTERN_ERROR_NONE;
+
+    if (!frame || !stamp) {
+        Loge("Bad params");
+        return PATTERN_ERROR_PARAMS;
+    }
+
+    if ((ret = checkFrame_f(frame)) != PATTERN_ERROR_NONE) {
+        return ret;
+    }
+
+    switch (pData->type) {
+        case PATTERN_TYPE_BARS:
+            drawBars_f(frame, stamp->counter);
+            break;
+
+        case PATTERN_TYPE_NOISE:
+            drawNoise_f(pData, frame);
+            break;
+
+        default:
+            return PATTERN_ERROR_PARAMS;
+    }
+
+    if (isStampable_f(frame)) {
+        drawStamp_f(frame, stamp);
+    }
+
+    return PATTERN_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+static enum pattern_error_e readStamp_f(struct pattern_s *obj, struct converter_frame_s *frame,
+                                        struct pattern_stamp_s *stamp)
+{
+    ASSERT(obj && obj->pData);
+
+    enum pattern_error_e ret = PATTERN_ERROR_NONE;
+
+    if (!frame || !stamp) {
+        Loge("Bad params");
+        return PATTERN_ERROR_PARAMS;
+    }
+
+    if ((ret = checkFrame_f(frame)) != PATTERN_ERROR_NONE) {
+        return ret;
+    }
+
+    if (!isStampable_f(frame)) {
+        return PATTERN_ERROR_NOT_FOUND;
+    }
+
+    uint32_t blocksPerRow = frame->width / PATTERN_STAMP_BLOCK_SIZE;
+    uint64_t high         = 0;
+    uint64_t low          = 0;
+    uint32_t bit, x, y;
+
+    /* MSB first: 16 bits of magic, 32 bits of counter then 64 bits of timestamp */
+    for (bit = 0; bit < PATTERN_STAMP_NB_BITS; bit++) {
+        x = (bit % blocksPerRow) * PATTERN_STAMP_BLOCK_SIZE + PATTERN_STAMP_BLOCK_SIZE / 2;
+        y = (bit / blocksPerRow) * PATTERN_STAMP_BLOCK_SIZE + PATTERN_STAMP_BLOCK_SIZE / 2;
+
+        high = (high << 1) | (low >> 63);
+        low  = (low << 1) | (getLuma_f(frame, x, y) >= PATTERN_STAMP_LEVEL ? 1 : 0);
+    }
+
+    if ((high >> 32) != PATTERN_STAMP_MAGIC) {
+        return PATTERN_ERROR_NOT_FOUND;
+    }
+
+    stamp->counter      = (uint32_t)high;
+    stamp->timestamp_us = low;
+
+    return PATTERN_ERROR_NONE;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////// PRIVATE FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+static enum pattern_error_e checkFrame_f(struct converter_frame_s *frame)
+{
+    ASSERT(frame);
+
+    if (frame->format >= CONVERTER_FORMAT_MAX) {
+        return PATTERN_ERROR_FORMAT;
+    }
+
+    uint32_t nbPlanes = getPlaneGeometry_f(frame, 0, NULL, NULL);
+    size_t rowSize;
+    uint32_t plane;
+
+    if ((frame->width == 0) || (frame->height == 0) || ((frame->width % 2) != 0)) {
+        return PATTERN_ERROR_PARAMS;
+    }
+
+    for (plane = 0; plane < nbPlanes; plane++) {
+        (void)getPlaneGeometry_f(frame, plane, &rowSize, NULL);
+
+        if (!frame->planes[plane] || (frame->strides[plane] < rowSize)) {
+            return PATTERN_ERROR_PARAMS;
+        }
+    }
+
+    return PATTERN_ERROR_NONE;
+}
+
+/*!
+ * Bytes of meaningful data per row of the given plane. Returns the number of planes
+ */
+static uint32_t getPlaneGeometry_f(struct converter_frame_s *frame, uint32_t plane,
+                                   size_t *rowSize, uint32_t *nbRows)
+{
+    ASSERT(frame);
+
+    uint32_t nbPlanes = 1;
+    size_t size       = frame->width;
+    uint32_t rows     = frame->height;
+
+    switch (frame->format) {
+        case CONVERTER_FORMAT_YUYV:
+        case CONVERTER_FORMAT_YVYU:
+        case CONVERTER_FORMAT_UYVY:
+            size = 2 * (size_t)frame->width;
+            break;
+
+        case CONVERTER_FORMAT_NV12:
+            nbPlanes = 2;
+            rows     = (plane > 0 ? (frame->height + 1) / 2 : frame->height);
+            break;
+
+        case CONVERTER_FORMAT_I420:
+            nbPlanes = 3;
+            size     = (plane > 0 ? frame->width / 2 : frame->width);
+            rows     = (plane > 0 ? (frame->height + 1) / 2 : frame->height);
+            break;
+
+        case CONVERTER_FORMAT_RGB24:
+            size = 3 * (size_t)frame->width;
+            break;
+
+        case CONVERTER_FORMAT_ARGB8888:
+            size = 4 * (size_t)frame->width;
+            break;
+
+        default:
+            ;
+    }
+
+    if (rowSize) {
+        *rowSize = size;
+    }
+
+    if (nbRows) {
+        *nbRows = rows;
+    }
+
+    return nbPlanes;
+}
+
+/*!
+ *
+ */
+static void drawBars_f(struct converter_frame_s *frame, uint32_t counter)
+{
+    ASSERT(frame);
+
+    /* Even offset so that both pixels sharing chroma samples belong to the same bar */
+    uint32_t offset = (uint32_t)(((uint64_t)counter * PATTERN_BARS_SPEED) % frame->width) & ~1U;
+    uint32_t nbPlanes, plane, row, nbRows, x, bar;
+    size_t rowSize;
+
+    for (x = 0; x < frame->width; x += 2) {
+        bar = (uint32_t)((((uint64_t)x + offset) % frame->width) * PATTERN_NB_BARS / frame->width);
+        fillRect_f(frame, x, 0, 2, 1, &gBars[bar]);
+    }
+
+    nbPlanes = getPlaneGeometry_f(frame, 0, NULL, NULL);
+
+    for (plane = 0; plane < nbPlanes; plane++) {
+        (void)getPlaneGeometry_f(frame, plane, &rowSize, &nbRows);
+
+        for (row = 1; row < nbRows; row++) {
+            memcpy(frame->planes[plane] + (size_t)row * frame->strides[plane],
+                   frame->planes[plane], rowSize);
+        }
+    }
+}
+
+/*!
+ * xorshift64* so that every frame is different and nothing can be predicted by encoders
+ */
+static void drawNoise_f(struct pattern_private_data_s *pData, struct converter_frame_s *frame)
+{
+    ASSERT(pData && frame);
+
+    uint32_t nbPlanes = getPlaneGeometry_f(frame, 0, NULL, NULL);
+    uint64_t seed     = pData->seed;
+    uint64_t value;
+    uint32_t plane, row, nbRows;
+    size_t rowSize, i;
+    uint8_t *data;
+
+    for (plane = 0; plane < nbPlanes; plane++) {
+        (void)getPlaneGeometry_f(frame, plane, &rowSize, &nbRows);
+
+        for (row = 0; row < nbRows; row++) {
+            data = frame->planes[plane] + (size_t)row * frame->strides[plane];
+
+            for (i = 0; i < rowSize; i += sizeof(value)) {
+                seed ^= seed >> 12;
+                seed ^= seed << 25;
+                seed ^= seed >> 27;
+                value = seed * 0x2545F4914F6CDD1DULL;
+
+                memcpy(data + i, &value,
+                       (rowSize - i < sizeof(value) ? rowSize - i : sizeof(value)));
+            }
+
+            /* Opaque pixels */
+            if (frame->format == CONVERTER_FORMAT_ARGB8888) {
+                uint32_t argb;
+                for (i = 0; i < rowSize; i += sizeof(argb)) {
+                    memcpy(&argb, data + i, sizeof(argb));
+                    argb |= 0xFF000000;
+                    memcpy(data + i, &argb, sizeof(argb));
+                }
+            }
+        }
+    }
+
+    pData->seed = seed;
+}
+
+/*!
+ *
+ */
+static void drawStamp_f(struct converter_frame_s *frame, struct pattern_stamp_s *stamp)
+{
+    ASSERT(frame && stamp);
+
+    uint32_t blocksPerRow = frame->width / PATTERN_STAMP_BLOCK_SIZE;
+    uint64_t high         = ((uint64_t)PATTERN_STAMP_MAGIC << 32) | stamp->counter;
+    uint64_t low          = stamp->timestamp_us;
+    uint32_t bit, value;
+
+    for (bit = 0; bit < PATTERN_STAMP_NB_BITS; bit++) {
+        if (bit < PATTERN_STAMP_NB_BITS - 64) {
+            value = (uint32_t)(high >> (PATTERN_STAMP_NB_BITS - 64 - 1 - bit)) & 1;
+        }
+        else {
+            value = (uint32_t)(low >> (PATTERN_STAMP_NB_BITS - 1 - bit)) & 1;
+        }
+
+        fillRect_f(frame, (bit % blocksPerRow) * PATTERN_STAMP_BLOCK_SIZE,
+                          (bit / blocksPerRow) * PATTERN_STAMP_BLOCK_SIZE,
+                          PATTERN_STAMP_BLOCK_SIZE, PATTERN_STAMP_BLOCK_SIZE,
+                          &gStampColors[value]);
+    }
+}
+
+/*!
+ * left and width must be even. Chroma rows shared with rows outside the area are overwritten
+ */
+static void fillRect_f(struct converter_frame_s *frame, uint32_t left, uint32_t top,
+                       uint32_t width, uint32_t height, const struct pattern_color_s *color)
+{
+    ASSERT(frame && color);
+
+    uint32_t argb = 0xFF000000 | ((uint32_t)color->r << 16) | ((uint32_t)color->g << 8) | color->b;
+    uint32_t x, y;
+    uint8_t *row, *chroma;
+
+    for (y = top; y < top + height; y++) {
+        row = frame->planes[0] + (size_t)y * frame->strides[0];
+
+        for (x = left; x < left + width; x++) {
+            switch (frame->format) {
+                case CONVERTER_FORMAT_YUYV:
+                    row[2 * x]           = color->y;
+                    row[4 * (x / 2) + 1] = color->u;
+                    row[4 * (x / 2) + 3] = color->v;
+                    break;
+
+                case CONVERTER_FORMAT_YVYU:
+                    row[2 * x]           = color->y;
+                    row[4 * (x / 2) + 1] = color->v;
+                    row[4 * (x / 2) + 3] = color->u;
+                    break;
+
+                case CONVERTER_FORMAT_UYVY:
+                    row[2 * x + 1]       = color->y;
+                    row[4 * (x / 2)]     = color->u;
+                    row[4 * (x / 2) + 2] = color->v;
+                    break;
+
+                case CONVERTER_FORMAT_NV12:
+                    row[x]    = color->y;
+                    chroma    = frame->planes[1] + (size_t)(y / 2) * frame->strides[1];
+                    chroma[2 * (x / 2)]     = color->u;
+                    chroma[2 * (x / 2) + 1] = color->v;
+                    break;
+
+                case CONVERTER_FORMAT_I420:
+                    row[x] = color->y;
+                    frame->planes[1][(size_t)(y / 2) * frame->strides[1] + x / 2] = color->u;
+                    frame->planes[2][(size_t)(y / 2) * frame->strides[2] + x / 2] = color->v;
+                    break;
+
+                case CONVERTER_FORMAT_RGB24:
+                    row[3 * x]     = color->r;
+                    row[3 * x + 1] = color->g;
+                    row[3 * x + 2] = color->b;
+                    break;
+
+                case CONVERTER_FORMAT_ARGB8888:
+                    memcpy(row + 4 * x, &argb, sizeof(argb));
+                    break;
+
+                default:
+                    ;
+            }
+        }
+    }
+}
+
+/*!
+ * Green is used for RGB formats as stamps are grey
+ */
+static uint8_t getLuma_f(struct converter_frame_s *frame, uint32_t x, uint32_t y)
+{
+    ASSERT(frame);
+
+    uint8_t *row = frame->planes[0] + (size_t)y * frame->strides[0];
+    uint32_t argb;
+
+    switch (frame->format) {
+        case CONVERTER_FORMAT_YUYV:
+        case CONVERTER_FORMAT_YVYU:
+            return row[2 * x];
+
+        case CONVERTER_FORMAT_UYVY:
+            return row[2 * x + 1];
+
+        case CONVERTER_FORMAT_RGB24:
+            return row[3 * x + 1];
+
+        case CONVERTER_FORMAT_ARGB8888:
+            memcpy(&argb, row + 4 * x, sizeof(argb));
+            return (uint8_t)(argb >> 8);
+
+        default:
+            return row[x];
+    }
+}
+
+/*!
+ *
+ */
+static uint8_t isStampable_f(struct converter_frame_s *frame)
+{
+    ASSERT(frame);
+
+    uint32_t blocksPerRow = frame->width / PATTERN_STAMP_BLOCK_SIZE;
+
+    if (blocksPerRow == 0) {
+        return 0;
+    }
+
+    uint32_t nbBlockRows = (PATTERN_STAMP_NB_BITS + blocksPerRow - 1) / blocksPerRow;
+
+    return (nbBlockRows * PATTERN_STAMP_BLOCK_SIZE <= frame->height);
+}
@@ -0,0 +1,664 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file Reactor.c
+* \brief Event loop(s) dispatching readiness of many fds to a few threads
+* \author Boubacar DIENE
+*/
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include "utils/List.h"
+#include "utils/Log.h"
+#include "utils/Reactor.h"
+#include "utils/Task.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#undef  TAG
+#define TAG "Reactor"
+
+#define REACTOR_MAX_EVENTS 16
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+struct reactor_shard_s;
+
+struct reactor_source_s {
+    int32_t                 fd;
+    reactor_on_event_cb     onEventCb;
+    void                    *userData;
+
+    uint8_t                 removed;
+    struct reactor_source_s *next;    /* Removed sources waiting to be freed */
+
+    struct reactor_shard_s  *shard;
+};
+
+struct reactor_shard_s {
+    uint32_t                id;
+    volatile uint8_t        quit;
+    uint8_t                 pinned;
+
+    int32_t                 epollFd;
+    int32_t                 wakeupFd;
+
+    /* Held while events are dispatched */
+    pthread_mutex_t         lock;
+
+    uint32_t                nbSources;      /* Protected by sourcesList's lock */
+    struct reactor_source_s *removedSources;
+
+    struct task_params_s    taskParams;
+    struct reactor_s        *reactor;
+};
+
+struct reactor_private_data_s {
+    struct reactor_params_s params;
+
+    struct task_s           *task;
+    struct list_s           *sourcesList;
+
+    uint32_t                nbShards;
+    struct reactor_shard_s  *shards;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PUBLIC FUNCTIONS PROTOTYPES //////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static enum reactor_error_e add_f(struct reactor_s *obj, int32_t fd,
+                                  reactor_on_event_cb onEventCb, void *userData);
+static enum reactor_error_e remove_f(struct reactor_s *obj, int32_t fd);
+
+static enum reactor_error_e suspend_f(struct reactor_s *obj, int32_t fd);
+static enum reactor_error_e resume_f(struct reactor_s *obj, int32_t fd);
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PRIVATE FUNCTIONS PROTOTYPES /////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static enum reactor_error_e initShard_f(struct reactor_s *obj, struct reactor_shard_s *shard,
+                                        uint32_t id);
+static void uninitShard_f(struct reactor_s *obj, struct reactor_shard_s *shard);
+static void wakeUpShard_f(struct reactor_shard_s *shard);
+static void freeRemovedSources_f(struct reactor_shard_s *shard);
+
+static enum reactor_error_e getSource_f(struct reactor_s *obj, int32_t fd,
+                                        struct reactor_source_s **sourceOut);
+static enum reactor_error_e watchSource_f(struct reactor_source_s *source, uint32_t events);
+
+static void shardFct_f(struct task_params_s *params);
+
+static uint8_t compareSourceCb(struct list_s *obj, void *elementToCheck, void *userData);
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+enum reactor_error_e Reactor_Init(struct reactor_s **obj, struct reactor_params_s *params)
+{
+    ASSERT(obj && params);
+
+    if (params->nbThreads == 0) {
+        Loge("Bad params");
+        return REACTOR_ERROR_PARAMS;
+    }
+
+    ASSERT((*obj = calloc(1, sizeof(struct reactor_s))));
+
+    struct reactor_private_data_s *pData;
+    ASSERT((pData = calloc(1, sizeof(struct reactor_private_data_s))));
+
+    memcpy(&pData->params, params, sizeof(struct reactor_params_s));
+
+    (*obj)->add     = add_f;
+    (*obj)->remove  = remove_f;
+    (*obj)->suspend = suspend_f;
+    (*obj)->resume  = resume_f;
+
+    (*obj)->pData = (void*)pData;
+
+    struct list_callbacks_s listCallbacks = {0};
+    listCallbacks.compareCb = compareSourceCb;
+    listCallbacks.releaseCb = NULL;
+    listCallbacks.browseCb  = NULL;
+
+    if (List_Init(&pData->sourcesList, &listCallbacks) != LIST_ERROR_NONE) {
+        Loge("List_Init() failed");
+        goto list_exit;
+    }
+
+    if (Task_Init(&pData->task) != TASK_ERROR_NONE) {
+        Loge("Task_Init() failed");
+        goto task_exit;
+    }
+
+    ASSERT((pData->shards = calloc(params->nbThreads, sizeof(struct reactor_shard_s))));
+
+    for (pData->nbShards = 0; pData->nbShards < params->nbThreads; pData->nbShards++) {
+        if (initShard_f(*obj, &pData->shards[pData->nbShards], pData->nbShards)
+                                                                    != REACTOR_ERROR_NONE) {
+            Loge("Failed to init shard %u", pData->nbShards);
+            goto shard_exit;
+        }
+    }
+
+    return REACTOR_ERROR_NONE;
+
+shard_exit:
+    while (pData->nbShards > 0) {
+        uninitShard_f(*obj, &pData->shards[--pData->nbShards]);
+    }
+    free(pData->shards);
+
+    (void)Task_UnInit(&pData->task);
+
+task_exit:
+    (void)List_UnInit(&pData->sourcesList);
+
+list_exit:
+    free(pData);
+    free(*obj);
+    *obj = NULL;
+
+    return REACTOR_ERROR_INIT;
+}
+
+/*!
+ *
+ */
+enum reactor_error_e Reactor_UnInit(struct reactor_s **obj)
+{
+    ASSERT(obj && *obj && (*obj)->pData);
+
+    struct reactor_private_data_s *pData = (struct reactor_private_data_s*)((*obj)->pData);
+    struct reactor_source_s *source      = NULL;
+
+    while (pData->nbShards > 0) {
+        uninitShard_f(*obj, &pData->shards[--pData->nbShards]);
+    }
+    free(pData->shards);
+
+    /* Sources that have not been removed */
+    if (pData->sourcesList->lock(pData->sourcesList) == LIST_ERROR_NONE) {
+        uint32_t nbElements = 0;
+        (void)pData->sourcesList->getNbElements(pData->sourcesList, &nbElements);
+
+        while (nbElements > 0) {
+            if (pData->sourcesList->getElement(pData->sourcesList,
+                                               (void**)&source) == LIST_ERROR_NONE) {
+                Logw("fd %d still watched", source->fd);
+                free(source);
+            }
+            nbElements--;
+        }
+
+        (void)pData->sourcesList->removeAll(pData->sourcesList);
+        (void)pData->sourcesList->unlock(pData->sourcesList);
+    }
+
+    (void)Task_UnInit(&pData->task);
+    (void)List_UnInit(&pData->sourcesList);
+
+    free(pData);
+    free(*obj);
+    *obj = NULL;
+
+    return REACTOR_ERROR_NONE;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////// PUBLIC FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+static enum reactor_error_e add_f(struct reactor_s *obj, int32_t fd,
+                                  reactor_on_event_cb onEventCb, void *userData)
+{
+    ASSERT(obj && obj->pData);
+
+    struct reactor_private_data_s *pData = (struct reactor_private_data_s*)(obj->pData);
+    struct reactor_source_s *source      = NULL;
+    struct reactor_shard_s *shard        = NULL;
+    enum reactor_error_e ret             = REACTOR_ERROR_NONE;
+
+    if ((fd < 0) || !onEventCb) {
+        Loge("Bad params");
+        return REACTOR_ERROR_PARAMS;
+    }
+
+    if (getSource_f(obj, fd, &source) == REACTOR_ERROR_NONE) {
+        Loge("fd %d already watched", fd);
+        return REACTOR_ERROR_PARAMS;
+    }
+
+    if (pData->sourcesList->lock(pData->sourcesList) != LIST_ERROR_NONE) {
+        Loge("Failed to lock sourcesList");
+        return REACTOR_ERROR_LIST;
+    }
+
+    /* Least loaded thread */
+    uint32_t index;
+    for (index = 0; index < pData->nbShards; index++) {
+        if (!shard || (pData->shards[index].nbSources < shard->nbSources)) {
+            shard = &pData->shards[index];
+        }
+    }
+
+    ASSERT((source = calloc(1, sizeof(struct reactor_source_s))));
+
+    source->fd        = fd;
+    source->onEventCb = onEventCb;
+    source->userData  = userData;
+    source->shard     = shard;
+
+    /* shard->lock is not taken here since callbacks may call suspend() i.e lock sourcesList */
+    struct epoll_event event = {0};
+    event.events   = EPOLLIN;
+    event.data.ptr = source;
+
+    if (epoll_ctl(shard->epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        Loge("Failed to watch fd %d - %s", fd, strerror(errno));
+        free(source);
+        ret = REACTOR_ERROR_IO;
+        goto exit;
+    }
+
+    shard->nbSources++;
+
+    (void)pData->sourcesList->add(pData->sourcesList, (void*)source);
+
+    Logd("fd %d handled by thread %u", fd, shard->id);
+
+exit:
+    (void)pData->sourcesList->unlock(pData->sourcesList);
+
+    return ret;
+}
+
+/*!
+ *
+ */
+static enum reactor_error_e remove_f(struct reactor_s *obj, int32_t fd)
+{
+    ASSERT(obj && obj->pData);
+
+    struct reactor_private_data_s *pData = (struct reactor_private_data_s*)(obj->pData);
+    struct reactor_source_s *source      = NULL;
+    enum reactor_error_e ret             = REACTOR_ERROR_NONE;
+
+    if ((ret = getSource_f(obj, fd, &source)) != REACTOR_ERROR_NONE) {
+        Loge("fd %d not watched", fd);
+        return ret;
+    }
+
+    if (pData->sourcesList->lock(pData->sourcesList) != LIST_ERROR_NONE) {
+        Loge("Failed to lock sourcesList");
+        return REACTOR_ERROR_LIST;
+    }
+
+    struct reactor_shard_s *shard = source->shard;
+
+    (void)pData->sourcesList->remove(pData->sourcesList, (void*)&fd);
+    shard->nbSources--;
+    (void)pData->sourcesList->unlock(pData->sourcesList);
+
+    /* Wait for the current callback if any. Events already returned by epoll_wait() may still
+     * refer to source so it is freed by the shard itself after they are handled */
+    (void)pthread_mutex_lock(&shard->lock);
+
+    if (epoll_ctl(shard->epollFd, EPOLL_CTL_DEL, fd, NULL) < 0) {
+        Logw("Failed to unwatch fd %d - %s", fd, strerror(errno));
+    }
+
+    source->removed       = 1;
+    source->next          = shard->removedSources;
+    shard->removedSources = source;
+
+    (void)pthread_mutex_unlock(&shard->lock);
+
+    wakeUpShard_f(shard);
+
+    return REACTOR_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+static enum reactor_error_e suspend_f(struct reactor_s *obj, int32_t fd)
+{
+    ASSERT(obj && obj->pData);
+
+    struct reactor_source_s *source = NULL;
+    enum reactor_error_e ret        = REACTOR_ERROR_NONE;
+
+    if ((ret = getSource_f(obj, fd, &source)) != REACTOR_ERROR_NONE) {
+        Loge("fd %d not watched", fd);
+        return ret;
+    }
+
+    return watchSource_f(source, 0);
+}
+
+/*!
+ *
+ */
+static enum reactor_error_e resume_f(struct reactor_s *obj, int32_t fd)
+{
+    ASSERT(obj && obj->pData);
+
+    struct reactor_source_s *source = NULL;
+    enum reactor_error_e ret        = REACTOR_ERROR_NONE;
+
+    if ((ret = getSource_f(obj, fd, &source)) != REACTOR_ERROR_NONE) {
+        Loge("fd %d not watched", fd);
+        return ret;
+    }
+
+    return watchSource_f(source, EPOLLIN);
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////// PRIVATE FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+static enum reactor_error_e initShard_f(struct reactor_s *obj, struct reactor_shard_s *shard,
+                                        uint32_t id)
+{
+    ASSERT(obj && obj->pData && shard);
+
+    struct reactor_private_data_s *pData = (struct reactor_private_data_s*)(obj->pData);
+
+    shard->id       = id;
+    shard->reactor  = obj;
+    shard->wakeupFd = -1;
+
+    if ((shard->epollFd = epoll_create1(EPOLL_CLOEXEC)) < 0) {
+        Loge("epoll_create1() failed - %s", strerror(errno));
+        goto epoll_exit;
+    }
+
+    if ((shard->wakeupFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) < 0) {
+        Loge("eventfd() failed - %s", strerror(errno));
+        goto eventfd_exit;
+    }
+
+    /* NULL data <=> wake up event */
+    struct epoll_event event = {0};
+    event.events   = EPOLLIN;
+    event.data.ptr = NULL;
+
+    if (epoll_ctl(shard->epollFd, EPOLL_CTL_ADD, shard->wakeupFd, &event) < 0) {
+        Loge("Failed to watch eventfd - %s", strerror(errno));
+        goto ctl_exit;
+    }
+
+    if (pthread_mutex_init(&shard->lock, NULL) != 0) {
+        Loge("pthread_mutex_init() failed");
+        goto ctl_exit;
+    }
+
+    snprintf(shard->taskParams.name, sizeof(shard->taskParams.name), "%.64s-%u",
+             pData->params.name, id);
+    shard->taskParams.priority = pData->params.priority;
+    shard->taskParams.fct      = shardFct_f;
+    shard->taskParams.fctData  = obj;
+    shard->taskParams.userData = shard;
+    shard->taskParams.atExit   = NULL;
+
+    if (pData->task->create(pData->task, &shard->taskParams) != TASK_ERROR_NONE) {
+        Loge("Failed to create task");
+        goto task_exit;
+    }
+
+    (void)pData->task->start(pData->task, &shard->taskParams);
+
+    return REACTOR_ERROR_NONE;
+
+task_exit:
+    (void)pthread_mutex_destroy(&shard->lock);
+
+ctl_exit:
+    close(shard->wakeupFd);
+
+eventfd_exit:
+    close(shard->epollFd);
+
+epoll_exit:
+    return REACTOR_ERROR_INIT;
+}
+
+/*!
+ *
+ */
+static void uninitShard_f(struct reactor_s *obj, struct reactor_shard_s *shard)
+{
+    ASSERT(obj && obj->pData && shard);
+
+    struct reactor_private_data_s *pData = (struct reactor_private_data_s*)(obj->pData);
+
+    shard->quit = 1;
+    wakeUpShard_f(shard);
+
+    (void)pData->task->stop(pData->task, &shard->taskParams);
+    (void)pData->task->destroy(pData->task, &shard->taskParams);
+
+    freeRemovedSources_f(shard);
+
+    (void)pthread_mutex_destroy(&shard->lock);
+
+    close(shard->wakeupFd);
+    close(shard->epollFd);
+}
+
+/*!
+ *
+ */
+static void wakeUpShard_f(struct reactor_shard_s *shard)
+{
+    ASSERT(shard);
+
+    uint64_t value = 1;
+
+    if (write(shard->wakeupFd, &value, sizeof(value)) < 0) {
+        Logw("Failed to wake up thread %u - %s", shard->id, strerror(errno));
+    }
+}
+
+/*!
+ *
+ */
+static void freeRemovedSources_f(struct reactor_shard_s *shard)
+{
+    ASSERT(shard);
+
+    struct reactor_source_s *source;
+
+    while ((source = shard->removedSources)) {
+        shard->removedSources = source->next;
+        free(source);
+    }
+}
+
+/*!
+ *
+ */
+static enum reactor_error_e getSource_f(struct reactor_s *obj, int32_t fd,
+                                        struct reactor_source_s **sourceOut)
+{
+    ASSERT(obj && obj->pData && sourceOut);
+
+    struct reactor_private_data_s *pData = (struct reactor_private_data_s*)(obj->pData);
+    enum reactor_error_e ret             = REACTOR_ERROR_NONE;
+
+    if (pData->sourcesList->lock(pData->sourcesList) != LIST_ERROR_NONE) {
+        Loge("Failed to lock sourcesList");
+        return REACTOR_ERROR_LIST;
+    }
+
+    uint32_t nbElements;
+    if (pData->sourcesList->getNbElements(pData->sourcesList, &nbElements) != LIST_ERROR_NONE) {
+        Loge("Failed to get number of elements");
+        ret = REACTOR_ERROR_LIST;
+        goto exit;
+    }
+
+    while (nbElements > 0) {
+        if (pData->sourcesList->getElement(pData->sourcesList,
+                                           (void**)sourceOut) != LIST_ERROR_NONE) {
+            Loge("Failed to retrieve element");
+            ret = REACTOR_ERROR_LIST;
+            goto exit;
+        }
+
+        if ((*sourceOut)->fd == fd) {
+            break;
+        }
+
+        nbElements--;
+    }
+
+    if (nbElements == 0) {
+        *sourceOut = NULL;
+        ret        = REACTOR_ERROR_PARAMS;
+    }
+
+exit:
+    (void)pData->sourcesList->unlock(pData->sourcesList);
+
+    return ret;
+}
+
+/*!
+ *
+ */
+static enum reactor_error_e watchSource_f(struct reactor_source_s *source, uint32_t events)
+{
+    ASSERT(source && source->shard);
+
+    struct epoll_event event = {0};
+    event.events   = events;
+    event.data.ptr = source;
+
+    if (epoll_ctl(source->shard->epollFd, EPOLL_CTL_MOD, source->fd, &event) < 0) {
+        Loge("Failed to update fd %d - %s", source->fd, strerror(errno));
+        return REACTOR_ERROR_IO;
+    }
+
+    return REACTOR_ERROR_NONE;
+}
+
+/*!
+ * Wait for events on all fds handled by this shard then call their callback
+ */
+static void shardFct_f(struct task_params_s *params)
+{
+    ASSERT(params && params->fctData && params->userData);
+
+    struct reactor_s *obj                = (struct reactor_s*)params->fctData;
+    struct reactor_shard_s *shard        = (struct reactor_shard_s*)params->userData;
+    struct reactor_private_data_s *pData = (struct reactor_private_data_s*)(obj->pData);
+
+    struct epoll_event events[REACTOR_MAX_EVENTS];
+    struct reactor_source_s *source;
+    int32_t nbEvents, index;
+    uint64_t value;
+
+    if (pData->params.pinThreads && !shard->pinned) {
+        cpu_set_t cpuset;
+        long nbCpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+        CPU_ZERO(&cpuset);
+        CPU_SET((size_t)shard->id % (size_t)(nbCpus > 0 ? nbCpus : 1), &cpuset);
+
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) != 0) {
+            Logw("Failed to pin thread %u", shard->id);
+        }
+
+        shard->pinned = 1;
+    }
+
+    if (shard->quit) {
+        return;
+    }
+
+    if ((nbEvents = epoll_wait(shard->epollFd, events, REACTOR_MAX_EVENTS, -1)) < 0) {
+        if (errno != EINTR) {
+            Loge("epoll_wait() failed - %s", strerror(errno));
+        }
+        return;
+    }
+
+    (void)pthread_mutex_lock(&shard->lock);
+
+    for (index = 0; (index < nbEvents) && !shard->quit; index++) {
+        source = (struct reactor_source_s*)events[index].data.ptr;
+
+        if (!source) {
+            (void)read(shard->wakeupFd, &value, sizeof(value));
+            continue;
+        }
+
+        if (!source->removed) {
+            source->onEventCb(obj, source->fd, events[index].events, source->userData);
+        }
+    }
+
+    freeRemovedSources_f(shard);
+
+    (void)pthread_mutex_unlock(&shard->lock);
+}
+
+/*!
+ *
+ */
+static uint8_t compareSourceCb(struct list_s *obj, void *elementToCheck, void *userData)
+{
+    ASSERT(obj && elementToCheck && userData);
+
+    struct reactor_source_s *source = (struct reactor_source_s*)elementToCheck;
+    int32_t fd                      = *((int32_t*)userData);
+
+    return (source->fd == fd);
+}
@@ -0,0 +1,188 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file Ring.c
+* \brief Bounded lock-free ring
+* \author Boubacar DIENE
+*/
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include "utils/Log.h"
+#include "utils/Ring.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#undef  TAG
+#define TAG "Ring"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+struct ring_private_data_s {
+    uint32_t nbSlots;
+    void     **slots;
+
+    /* Both indexes only grow so there is no ABA issue when head is updated using CAS */
+    uint64_t head; /* Next element to pop  */
+    uint64_t tail; /* Next free slot       */
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/*                                 PUBLIC FUNCTIONS PROTOTYPES                                  */
+/* -------------------------------------------------------------------------------------------- */
+
+static enum ring_error_e push_f(struct ring_s *obj, void *element);
+static enum ring_error_e pop_f(struct ring_s *obj, void **element);
+
+static enum ring_error_e getNbElements_f(struct ring_s *obj, uint32_t *nbElements);
+
+/* -------------------------------------------------------------------------------------------- */
+/*                                         INITIALIZER                                          */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+enum ring_error_e Ring_Init(struct ring_s **obj, uint32_t nbSlots)
+{
+    ASSERT(obj);
+
+    if (nbSlots == 0) {
+        Loge("Bad params");
+        return RING_ERROR_PARAMS;
+    }
+
+    ASSERT((*obj = calloc(1, sizeof(struct ring_s))));
+
+    struct ring_private_data_s *pData;
+    ASSERT((pData = calloc(1, sizeof(struct ring_private_data_s))));
+    ASSERT((pData->slots = calloc(nbSlots, sizeof(void*))));
+
+    pData->nbSlots = nbSlots;
+
+    (*obj)->push          = push_f;
+    (*obj)->pop           = pop_f;
+    (*obj)->getNbElements = getNbElements_f;
+
+    (*obj)->pData = (void*)pData;
+
+    return RING_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+enum ring_error_e Ring_UnInit(struct ring_s **obj)
+{
+    ASSERT(obj && *obj && (*obj)->pData);
+
+    struct ring_private_data_s *pData = (struct ring_private_data_s*)((*obj)->pData);
+
+    free(pData->slots);
+    free(pData);
+    free(*obj);
+    *obj = NULL;
+
+    return RING_ERROR_NONE;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/*                               PUBLIC FUNCTIONS IMPLEMENTATION                                */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+static enum ring_error_e push_f(struct ring_s *obj, void *element)
+{
+    ASSERT(obj && obj->pData && element);
+
+    struct ring_private_data_s *pData = (struct ring_private_data_s*)obj->pData;
+
+    uint64_t tail = __atomic_load_n(&pData->tail, __ATOMIC_RELAXED);
+    uint64_t head = __atomic_load_n(&pData->head, __ATOMIC_ACQUIRE);
+
+    if (tail - head >= pData->nbSlots) {
+        return RING_ERROR_FULL;
+    }
+
+    __atomic_store_n(&pData->slots[tail % pData->nbSlots], element, __ATOMIC_RELAXED);
+    __atomic_store_n(&pData->tail, tail + 1, __ATOMIC_RELEASE);
+
+    return RING_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+static enum ring_error_e pop_f(struct ring_s *obj, void **element)
+{
+    ASSERT(obj && obj->pData && element);
+
+    struct ring_private_data_s *pData = (struct ring_private_data_s*)obj->pData;
+
+    uint64_t head = __atomic_load_n(&pData->head, __ATOMIC_ACQUIRE);
+    uint64_t tail;
+    void *slot;
+
+    do {
+        tail = __atomic_load_n(&pData->tail, __ATOMIC_ACQUIRE);
+
+        if (head == tail) {
+            return RING_ERROR_EMPTY;
+        }
+
+        /* Slot is only read here. Its content is discarded if another thread pops it first */
+        slot = __atomic_load_n(&pData->slots[head % pData->nbSlots], __ATOMIC_RELAXED);
+    }
+    while (!__atomic_compare_exchange_n(&pData->head, &head, head + 1, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+    *element = slot;
+
+    return RING_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+static enum ring_error_e getNbElements_f(struct ring_s *obj, uint32_t *nbElements)
+{
+    ASSERT(obj && obj->pData && nbElements);
+
+    struct ring_private_data_s *pData = (struct ring_private_data_s*)obj->pData;
+
+    uint64_t head = __atomic_load_n(&pData->head, __ATOMIC_ACQUIRE);
+    uint64_t tail = __atomic_load_n(&pData->tail, __ATOMIC_ACQUIRE);
+
+    *nbElements = (uint32_t)(tail - head);
+
+    return RING_ERROR_NONE;
+}
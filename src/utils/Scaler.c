@@ -0,0 +1,842 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/*!
+* \file Scaler.c
+* \brief Resizing of YUV frames with SIMD kernels
+* \author Boubacar DIENE
+*
+* Each plane is resized in two passes : a vertical pass computes one row with the source width
+* from the source rows covered by a destination row, then a horizontal pass resamples every
+* component of that row. Only the vertical pass, which works on whole rows whatever the layout,
+* has SIMD kernels. The horizontal one only touches destination samples
+*/
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#include <arm_neon.h>
+#endif
+
+#include "utils/Log.h"
+#include "utils/Scaler.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#undef  TAG
+#define TAG "Scaler"
+
+#if defined(__SSE2__)
+    #define SCALER_HAVE_SSE2
+    #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        #define SCALER_HAVE_AVX2
+    #endif
+#endif
+
+#if defined(__ARM_NEON) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    #define SCALER_HAVE_NEON
+#endif
+
+#define SCALER_MAX_PLANES   3
+#define SCALER_MAX_CHANNELS 3
+
+/* Bilinear weights have 8 bits of precision */
+#define WEIGHT_ONE          256
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/* dst = (a * (WEIGHT_ONE - weight) + b * weight) / WEIGHT_ONE */
+typedef void (*scaler_blend_row_f)(const uint8_t *a, const uint8_t *b, uint8_t *dst,
+                                   uint32_t size, uint32_t weight);
+typedef void (*scaler_accumulate_row_f)(const uint8_t *src, uint16_t *acc, uint32_t size);
+/* count > 1 */
+typedef void (*scaler_average_row_f)(const uint16_t *acc, uint8_t *dst, uint32_t size,
+                                     uint32_t count);
+
+struct scaler_kernels_s {
+    scaler_blend_row_f      blendRow;
+    scaler_accumulate_row_f accumulateRow;
+    scaler_average_row_f    averageRow;
+};
+
+/* Samples of a component are located at offset + i * step in a row */
+struct scaler_channel_s {
+    uint8_t offset;
+    uint8_t step;
+    uint8_t isChroma; /* width / 2 samples */
+};
+
+struct scaler_plane_s {
+    uint8_t                 isSubsampled; /* (height + 1) / 2 rows */
+    uint8_t                 rowSizeNum;   /* Row size is width * rowSizeNum / rowSizeDen */
+    uint8_t                 rowSizeDen;
+
+    uint8_t                 nbChannels;
+    struct scaler_channel_s channels[SCALER_MAX_CHANNELS];
+};
+
+struct scaler_layout_s {
+    uint8_t               nbPlanes;
+    struct scaler_plane_s planes[SCALER_MAX_PLANES];
+};
+
+/* Source samples used to compute a destination one */
+struct scaler_taps_s {
+    uint32_t *first;
+    uint32_t *count;  /* Box only    */
+    uint16_t *weight; /* Bilinear only */
+};
+
+struct scaler_private_data_s {
+    enum converter_kernel_e       kernel;
+    const struct scaler_kernels_s *kernels;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PUBLIC FUNCTIONS PROTOTYPES //////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static enum scaler_error_e scale_f(struct scaler_s *obj, struct converter_frame_s *src,
+                                   struct converter_frame_s *dst, enum scaler_filter_e filter);
+
+static enum scaler_error_e getKernel_f(struct scaler_s *obj, enum converter_kernel_e *kernel);
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PRIVATE FUNCTIONS PROTOTYPES /////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static uint8_t isKernelSupported_f(enum converter_kernel_e kernel);
+static enum scaler_error_e checkFrame_f(struct converter_frame_s *frame);
+
+static void getTap_f(uint32_t index, uint32_t srcSize, uint32_t dstSize,
+                     enum scaler_filter_e filter, uint32_t *first, uint32_t *count,
+                     uint16_t *weight);
+static void initTaps_f(struct scaler_taps_s *taps, uint32_t srcSize, uint32_t dstSize,
+                       enum scaler_filter_e filter);
+static void uninitTaps_f(struct scaler_taps_s *taps);
+
+static const uint8_t *scaleVertically_f(const struct scaler_kernels_s *kernels,
+                                        const uint8_t *src, uint32_t srcStride,
+                                        uint32_t srcRows, uint32_t dstRow, uint32_t dstRows,
+                                        uint32_t rowSize, enum scaler_filter_e filter,
+                                        uint8_t *tmp, uint16_t *acc);
+static void scaleHorizontally_f(const uint8_t *src, uint8_t *dst,
+                                const struct scaler_channel_s *channel,
+                                const struct scaler_taps_s *taps, uint32_t dstSize,
+                                enum scaler_filter_e filter);
+static void scalePlane_f(const struct scaler_kernels_s *kernels,
+                         const struct scaler_plane_s *plane,
+                         const uint8_t *src, uint32_t srcStride,
+                         uint32_t srcWidth, uint32_t srcHeight,
+                         uint8_t *dst, uint32_t dstStride,
+                         uint32_t dstWidth, uint32_t dstHeight, enum scaler_filter_e filter);
+
+static void blendRowScalar_f(const uint8_t *a, const uint8_t *b, uint8_t *dst, uint32_t size,
+                             uint32_t weight);
+static void accumulateRowScalar_f(const uint8_t *src, uint16_t *acc, uint32_t size);
+static void averageRowScalar_f(const uint16_t *acc, uint8_t *dst, uint32_t size,
+                               uint32_t count);
+
+#ifdef SCALER_HAVE_SSE2
+static void blendRowSse2_f(const uint8_t *a, const uint8_t *b, uint8_t *dst, uint32_t size,
+                           uint32_t weight);
+static void accumulateRowSse2_f(const uint8_t *src, uint16_t *acc, uint32_t size);
+static void averageRowSse2_f(const uint16_t *acc, uint8_t *dst, uint32_t size, uint32_t count);
+#endif
+
+#ifdef SCALER_HAVE_NEON
+static void blendRowNeon_f(const uint8_t *a, const uint8_t *b, uint8_t *dst, uint32_t size,
+                           uint32_t weight);
+static void accumulateRowNeon_f(const uint8_t *src, uint16_t *acc, uint32_t size);
+static void averageRowNeon_f(const uint16_t *acc, uint8_t *dst, uint32_t size, uint32_t count);
+#endif
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// GLOBALS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static const struct scaler_layout_s gLayouts[] = {
+    [CONVERTER_FORMAT_YUYV] = {
+        .nbPlanes = 1,
+        .planes   = {
+            { 0, 2, 1, 3, { { 0, 2, 0 }, { 1, 4, 1 }, { 3, 4, 1 } } }
+        }
+    },
+    [CONVERTER_FORMAT_YVYU] = {
+        .nbPlanes = 1,
+        .planes   = {
+            { 0, 2, 1, 3, { { 0, 2, 0 }, { 1, 4, 1 }, { 3, 4, 1 } } }
+        }
+    },
+    [CONVERTER_FORMAT_UYVY] = {
+        .nbPlanes = 1,
+        .planes   = {
+            { 0, 2, 1, 3, { { 1, 2, 0 }, { 0, 4, 1 }, { 2, 4, 1 } } }
+        }
+    },
+    [CONVERTER_FORMAT_NV12] = {
+        .nbPlanes = 2,
+        .planes   = {
+            { 0, 1, 1, 1, { { 0, 1, 0 } } },
+            { 1, 1, 1, 2, { { 0, 2, 1 }, { 1, 2, 1 } } }
+        }
+    },
+    [CONVERTER_FORMAT_I420] = {
+        .nbPlanes = 3,
+        .planes   = {
+            { 0, 1, 1, 1, { { 0, 1, 0 } } },
+            { 1, 1, 2, 1, { { 0, 1, 1 } } },
+            { 1, 1, 2, 1, { { 0, 1, 1 } } }
+        }
+    }
+};
+
+static const struct scaler_kernels_s gKernels[CONVERTER_KERNEL_MAX] = {
+    [CONVERTER_KERNEL_SCALAR] = {
+        .blendRow      = blendRowScalar_f,
+        .accumulateRow = accumulateRowScalar_f,
+        .averageRow    = averageRowScalar_f
+    },
+#ifdef SCALER_HAVE_SSE2
+    [CONVERTER_KERNEL_SSE2] = {
+        .blendRow      = blendRowSse2_f,
+        .accumulateRow = accumulateRowSse2_f,
+        .averageRow    = averageRowSse2_f
+    },
+#endif
+#ifdef SCALER_HAVE_AVX2
+    /* Memory bound so SSE2 is enough */
+    [CONVERTER_KERNEL_AVX2] = {
+        .blendRow      = blendRowSse2_f,
+        .accumulateRow = accumulateRowSse2_f,
+        .averageRow    = averageRowSse2_f
+    },
+#endif
+#ifdef SCALER_HAVE_NEON
+    [CONVERTER_KERNEL_NEON] = {
+        .blendRow      = blendRowNeon_f,
+        .accumulateRow = accumulateRowNeon_f,
+        .averageRow    = averageRowNeon_f
+    },
+#endif
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+enum scaler_error_e Scaler_Init(struct scaler_s **obj, enum converter_kernel_e kernel)
+{
+    ASSERT(obj);
+
+    if (kernel == CONVERTER_KERNEL_AUTO) {
+        if (isKernelSupported_f(CONVERTER_KERNEL_AVX2)) {
+            kernel = CONVERTER_KERNEL_AVX2;
+        }
+        else if (isKernelSupported_f(CONVERTER_KERNEL_NEON)) {
+            kernel = CONVERTER_KERNEL_NEON;
+        }
+        else if (isKernelSupported_f(CONVERTER_KERNEL_SSE2)) {
+            kernel = CONVERTER_KERNEL_SSE2;
+        }
+        else {
+            kernel = CONVERTER_KERNEL_SCALAR;
+        }
+    }
+    else if (!isKernelSupported_f(kernel)) {
+        Loge("Kernel %u not supported", kernel);
+        return SCALER_ERROR_PARAMS;
+    }
+
+    ASSERT((*obj = calloc(1, sizeof(struct scaler_s))));
+
+    struct scaler_private_data_s *pData;
+    ASSERT((pData = calloc(1, sizeof(struct scaler_private_data_s))));
+
+    pData->kernel  = kernel;
+    pData->kernels = &gKernels[kernel];
+
+    (*obj)->scale     = scale_f;
+    (*obj)->getKernel = getKernel_f;
+
+    (*obj)->pData = (void*)pData;
+
+    return SCALER_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+enum scaler_error_e Scaler_UnInit(struct scaler_s **obj)
+{
+    ASSERT(obj && *obj && (*obj)->pData);
+
+    free((*obj)->pData);
+    free(*obj);
+    *obj = NULL;
+
+    return SCALER_ERROR_NONE;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////// PUBLIC FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+static enum scaler_error_e scale_f(struct scaler_s *obj, struct converter_frame_s *src,
+                                   struct converter_frame_s *dst, enum scaler_filter_e filter)
+{
+    ASSERT(obj && obj->pData);
+
+    if (!src || !dst || (filter >= SCALER_FILTER_MAX)
+        || (checkFrame_f(src) != SCALER_ERROR_NONE) || (checkFrame_f(dst) != SCALER_ERROR_NONE)
+        || ((uint64_t)src->width > (uint64_t)dst->width * SCALER_MAX_RATIO)
+        || ((uint64_t)src->height > (uint64_t)dst->height * SCALER_MAX_RATIO)) {
+        Loge("Bad params");
+        return SCALER_ERROR_PARAMS;
+    }
+
+    if (src->format != dst->format) {
+        Loge("Formats differ (%u / %u)", src->format, dst->format);
+        return SCALER_ERROR_FORMAT;
+    }
+
+    struct scaler_private_data_s *pData = (struct scaler_private_data_s*)(obj->pData);
+    const struct scaler_layout_s *layout = &gLayouts[src->format];
+    uint32_t plane;
+
+    for (plane = 0; plane < layout->nbPlanes; plane++) {
+        scalePlane_f(pData->kernels, &layout->planes[plane],
+                     src->planes[plane], src->strides[plane], src->width, src->height,
+                     dst->planes[plane], dst->strides[plane], dst->width, dst->height, filter);
+    }
+
+    return SCALER_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+static enum scaler_error_e getKernel_f(struct scaler_s *obj, enum converter_kernel_e *kernel)
+{
+    ASSERT(obj && obj->pData && kernel);
+
+    struct scaler_private_data_s *pData = (struct scaler_private_data_s*)(obj->pData);
+
+    *kernel = pData->kernel;
+
+    return SCALER_ERROR_NONE;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////// PRIVATE FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+static uint8_t isKernelSupported_f(enum converter_kernel_e kernel)
+{
+    switch (kernel) {
+        case CONVERTER_KERNEL_SCALAR:
+            return 1;
+
+#ifdef SCALER_HAVE_SSE2
+        case CONVERTER_KERNEL_SSE2:
+            return 1;
+#endif
+
+#ifdef SCALER_HAVE_AVX2
+        case CONVERTER_KERNEL_AVX2:
+            return (__builtin_cpu_supports("avx2") != 0);
+#endif
+
+#ifdef SCALER_HAVE_NEON
+        case CONVERTER_KERNEL_NEON:
+            return 1;
+#endif
+
+        default:
+            return 0;
+    }
+}
+
+/*!
+ *
+ */
+static enum scaler_error_e checkFrame_f(struct converter_frame_s *frame)
+{
+    ASSERT(frame);
+
+    if ((frame->format > CONVERTER_FORMAT_I420) || (frame->width == 0) || (frame->height == 0)
+        || ((frame->width % 2) != 0)) {
+        return SCALER_ERROR_PARAMS;
+    }
+
+    uint32_t plane;
+    for (plane = 0; plane < gLayouts[frame->format].nbPlanes; plane++) {
+        if (!frame->planes[plane] || (frame->strides[plane] == 0)) {
+            return SCALER_ERROR_PARAMS;
+        }
+    }
+
+    return SCALER_ERROR_NONE;
+}
+
+/*!
+ * Box : source samples [first, first + count[
+ * Bilinear : first and first + 1 weighted by weight. Samples centers are aligned
+ */
+static void getTap_f(uint32_t index, uint32_t srcSize, uint32_t dstSize,
+                     enum scaler_filter_e filter, uint32_t *first, uint32_t *count,
+                     uint16_t *weight)
+{
+    ASSERT(first && count && weight);
+
+    if (filter == SCALER_FILTER_BOX) {
+        uint32_t last = (uint32_t)(((uint64_t)index + 1) * srcSize / dstSize);
+
+        *first  = (uint32_t)((uint64_t)index * srcSize / dstSize);
+        *count  = ((last > *first) ? last - *first : 1);
+        *weight = 0;
+        return;
+    }
+
+    int64_t pos = ((int64_t)(2 * index + 1) * srcSize * WEIGHT_ONE) / (2 * (int64_t)dstSize)
+                  - WEIGHT_ONE / 2;
+    pos = ((pos < 0) ? 0 : pos);
+
+    *first  = (uint32_t)(pos / WEIGHT_ONE);
+    *count  = 2;
+    *weight = (uint16_t)(pos % WEIGHT_ONE);
+
+    if (*first + 1 >= srcSize) {
+        *first  = srcSize - 1;
+        *count  = 1;
+        *weight = 0;
+    }
+}
+
+/*!
+ *
+ */
+static void initTaps_f(struct scaler_taps_s *taps, uint32_t srcSize, uint32_t dstSize,
+                       enum scaler_filter_e filter)
+{
+    ASSERT(taps);
+
+    ASSERT((taps->first = malloc(dstSize * sizeof(uint32_t))));
+    ASSERT((taps->count = malloc(dstSize * sizeof(uint32_t))));
+    ASSERT((taps->weight = malloc(dstSize * sizeof(uint16_t))));
+
+    uint32_t index;
+    for (index = 0; index < dstSize; index++) {
+        getTap_f(index, srcSize, dstSize, filter,
+                 &taps->first[index], &taps->count[index], &taps->weight[index]);
+    }
+}
+
+/*!
+ *
+ */
+static void uninitTaps_f(struct scaler_taps_s *taps)
+{
+    ASSERT(taps);
+
+    free(taps->first);
+    free(taps->count);
+    free(taps->weight);
+
+    memset(taps, 0, sizeof(struct scaler_taps_s));
+}
+
+/*!
+ * Row with the source width matching dstRow. Source row is directly returned when possible
+ */
+static const uint8_t *scaleVertically_f(const struct scaler_kernels_s *kernels,
+                                        const uint8_t *src, uint32_t srcStride,
+                                        uint32_t srcRows, uint32_t dstRow, uint32_t dstRows,
+                                        uint32_t rowSize, enum scaler_filter_e filter,
+                                        uint8_t *tmp, uint16_t *acc)
+{
+    ASSERT(kernels && src && tmp && acc);
+
+    uint32_t first, count, row;
+    uint16_t weight;
+
+    getTap_f(dstRow, srcRows, dstRows, filter, &first, &count, &weight);
+
+    if ((count == 1) || ((filter == SCALER_FILTER_BILINEAR) && (weight == 0))) {
+        return src + (size_t)first * srcStride;
+    }
+
+    if (filter == SCALER_FILTER_BILINEAR) {
+        kernels->blendRow(src + (size_t)first * srcStride, src + (size_t)(first + 1) * srcStride,
+                          tmp, rowSize, weight);
+        return tmp;
+    }
+
+    memset(acc, 0, rowSize * sizeof(uint16_t));
+    for (row = first; row < first + count; row++) {
+        kernels->accumulateRow(src + (size_t)row * srcStride, acc, rowSize);
+    }
+    kernels->averageRow(acc, tmp, rowSize, count);
+
+    return tmp;
+}
+
+/*!
+ *
+ */
+static void scaleHorizontally_f(const uint8_t *src, uint8_t *dst,
+                                const struct scaler_channel_s *channel,
+                                const struct scaler_taps_s *taps, uint32_t dstSize,
+                                enum scaler_filter_e filter)
+{
+    ASSERT(src && dst && channel && taps);
+
+    const uint8_t *in = src + channel->offset;
+    uint8_t *out      = dst + channel->offset;
+    uint32_t step     = channel->step;
+    uint32_t index, i, sum, count;
+
+    for (index = 0; index < dstSize; index++) {
+        const uint8_t *sample = in + (size_t)taps->first[index] * step;
+        count = taps->count[index];
+
+        if (count == 1) {
+            out[(size_t)index * step] = sample[0];
+        }
+        else if (filter == SCALER_FILTER_BILINEAR) {
+            out[(size_t)index * step] = (uint8_t)((sample[0] * (WEIGHT_ONE - taps->weight[index])
+                                                   + sample[step] * taps->weight[index]
+                                                   + WEIGHT_ONE / 2) / WEIGHT_ONE);
+        }
+        else {
+            for (i = 0, sum = 0; i < count; i++) {
+                sum += sample[(size_t)i * step];
+            }
+            out[(size_t)index * step] = (uint8_t)((sum + count / 2) / count);
+        }
+    }
+}
+
+/*!
+ *
+ */
+static void scalePlane_f(const struct scaler_kernels_s *kernels,
+                         const struct scaler_plane_s *plane,
+                         const uint8_t *src, uint32_t srcStride,
+                         uint32_t srcWidth, uint32_t srcHeight,
+                         uint8_t *dst, uint32_t dstStride,
+                         uint32_t dstWidth, uint32_t dstHeight, enum scaler_filter_e filter)
+{
+    ASSERT(kernels && plane && src && dst);
+
+    uint32_t srcRows     = (plane->isSubsampled ? (srcHeight + 1) / 2 : srcHeight);
+    uint32_t dstRows     = (plane->isSubsampled ? (dstHeight + 1) / 2 : dstHeight);
+    uint32_t srcRowSize  = srcWidth * plane->rowSizeNum / plane->rowSizeDen;
+    uint32_t dstRowSize  = dstWidth * plane->rowSizeNum / plane->rowSizeDen;
+    uint8_t sameWidth    = (srcWidth == dstWidth);
+
+    struct scaler_taps_s taps[SCALER_MAX_CHANNELS] = {{0}};
+    const uint8_t *row;
+    uint8_t *tmp;
+    uint16_t *acc;
+    uint32_t dstRow, channel;
+
+    ASSERT((tmp = malloc(srcRowSize)));
+    ASSERT((acc = malloc(srcRowSize * sizeof(uint16_t))));
+
+    if (!sameWidth) {
+        for (channel = 0; channel < plane->nbChannels; channel++) {
+            initTaps_f(&taps[channel],
+                       (plane->channels[channel].isChroma ? srcWidth / 2 : srcWidth),
+                       (plane->channels[channel].isChroma ? dstWidth / 2 : dstWidth), filter);
+        }
+    }
+
+    for (dstRow = 0; dstRow < dstRows; dstRow++) {
+        row = scaleVertically_f(kernels, src, srcStride, srcRows, dstRow, dstRows, srcRowSize,
+                                filter, tmp, acc);
+
+        if (sameWidth) {
+            memcpy(dst + (size_t)dstRow * dstStride, row, dstRowSize);
+            continue;
+        }
+
+        for (channel = 0; channel < plane->nbChannels; channel++) {
+            scaleHorizontally_f(row, dst + (size_t)dstRow * dstStride,
+                                &plane->channels[channel], &taps[channel],
+                                (plane->channels[channel].isChroma ? dstWidth / 2 : dstWidth),
+                                filter);
+        }
+    }
+
+    if (!sameWidth) {
+        for (channel = 0; channel < plane->nbChannels; channel++) {
+            uninitTaps_f(&taps[channel]);
+        }
+    }
+
+    free(acc);
+    free(tmp);
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// SCALAR ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+static void blendRowScalar_f(const uint8_t *a, const uint8_t *b, uint8_t *dst, uint32_t size,
+                             uint32_t weight)
+{
+    uint32_t x;
+
+    for (x = 0; x < size; x++) {
+        dst[x] = (uint8_t)((a[x] * (WEIGHT_ONE - weight) + b[x] * weight + WEIGHT_ONE / 2)
+                           / WEIGHT_ONE);
+    }
+}
+
+/*!
+ *
+ */
+static void accumulateRowScalar_f(const uint8_t *src, uint16_t *acc, uint32_t size)
+{
+    uint32_t x;
+
+    for (x = 0; x < size; x++) {
+        acc[x] = (uint16_t)(acc[x] + src[x]);
+    }
+}
+
+/*!
+ * Division by a multiplication with a 16 bits reciprocal so that SIMD kernels give the same
+ * results
+ */
+static void averageRowScalar_f(const uint16_t *acc, uint8_t *dst, uint32_t size, uint32_t count)
+{
+    uint32_t reciprocal = (65536 + count - 1) / count;
+    uint32_t x;
+
+    for (x = 0; x < size; x++) {
+        dst[x] = (uint8_t)(((acc[x] + count / 2) * reciprocal) >> 16);
+    }
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////////// SSE2 /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#ifdef SCALER_HAVE_SSE2
+
+/*!
+ * 16 bytes per iteration
+ */
+static void blendRowSse2_f(const uint8_t *a, const uint8_t *b, uint8_t *dst, uint32_t size,
+                           uint32_t weight)
+{
+    const __m128i zero  = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi16(WEIGHT_ONE / 2);
+    const __m128i wA    = _mm_set1_epi16((int16_t)(WEIGHT_ONE - weight));
+    const __m128i wB    = _mm_set1_epi16((int16_t)weight);
+
+    __m128i aa, bb, lo, hi;
+    uint32_t x;
+
+    for (x = 0; x + 16 <= size; x += 16) {
+        aa = _mm_loadu_si128((const __m128i*)(const void*)(a + x));
+        bb = _mm_loadu_si128((const __m128i*)(const void*)(b + x));
+
+        lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(aa, zero), wA),
+                           _mm_mullo_epi16(_mm_unpacklo_epi8(bb, zero), wB));
+        hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(aa, zero), wA),
+                           _mm_mullo_epi16(_mm_unpackhi_epi8(bb, zero), wB));
+
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, round), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, round), 8);
+
+        _mm_storeu_si128((__m128i*)(void*)(dst + x), _mm_packus_epi16(lo, hi));
+    }
+
+    if (x < size) {
+        blendRowScalar_f(a + x, b + x, dst + x, size - x, weight);
+    }
+}
+
+/*!
+ *
+ */
+static void accumulateRowSse2_f(const uint8_t *src, uint16_t *acc, uint32_t size)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    __m128i ss, lo, hi;
+    uint32_t x;
+
+    for (x = 0; x + 16 <= size; x += 16) {
+        ss = _mm_loadu_si128((const __m128i*)(const void*)(src + x));
+        lo = _mm_loadu_si128((const __m128i*)(void*)(acc + x));
+        hi = _mm_loadu_si128((const __m128i*)(void*)(acc + x + 8));
+
+        _mm_storeu_si128((__m128i*)(void*)(acc + x),
+                         _mm_add_epi16(lo, _mm_unpacklo_epi8(ss, zero)));
+        _mm_storeu_si128((__m128i*)(void*)(acc + x + 8),
+                         _mm_add_epi16(hi, _mm_unpackhi_epi8(ss, zero)));
+    }
+
+    if (x < size) {
+        accumulateRowScalar_f(src + x, acc + x, size - x);
+    }
+}
+
+/*!
+ *
+ */
+static void averageRowSse2_f(const uint16_t *acc, uint8_t *dst, uint32_t size, uint32_t count)
+{
+    const __m128i half       = _mm_set1_epi16((int16_t)(count / 2));
+    const __m128i reciprocal = _mm_set1_epi16((int16_t)((65536 + count - 1) / count));
+
+    __m128i lo, hi;
+    uint32_t x;
+
+    for (x = 0; x + 16 <= size; x += 16) {
+        lo = _mm_loadu_si128((const __m128i*)(const void*)(acc + x));
+        hi = _mm_loadu_si128((const __m128i*)(const void*)(acc + x + 8));
+
+        lo = _mm_mulhi_epu16(_mm_add_epi16(lo, half), reciprocal);
+        hi = _mm_mulhi_epu16(_mm_add_epi16(hi, half), reciprocal);
+
+        _mm_storeu_si128((__m128i*)(void*)(dst + x), _mm_packus_epi16(lo, hi));
+    }
+
+    if (x < size) {
+        averageRowScalar_f(acc + x, dst + x, size - x, count);
+    }
+}
+
+#endif //SCALER_HAVE_SSE2
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////////// NEON /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#ifdef SCALER_HAVE_NEON
+
+/*!
+ * 16 bytes per iteration
+ */
+static void blendRowNeon_f(const uint8_t *a, const uint8_t *b, uint8_t *dst, uint32_t size,
+                           uint32_t weight)
+{
+    const uint16x8_t wA = vdupq_n_u16((uint16_t)(WEIGHT_ONE - weight));
+    const uint16x8_t wB = vdupq_n_u16((uint16_t)weight);
+
+    uint8x16_t aa, bb;
+    uint16x8_t lo, hi;
+    uint32_t x;
+
+    for (x = 0; x + 16 <= size; x += 16) {
+        aa = vld1q_u8(a + x);
+        bb = vld1q_u8(b + x);
+
+        lo = vmlaq_u16(vmulq_u16(vmovl_u8(vget_low_u8(aa)), wA), vmovl_u8(vget_low_u8(bb)), wB);
+        hi = vmlaq_u16(vmulq_u16(vmovl_u8(vget_high_u8(aa)), wA), vmovl_u8(vget_high_u8(bb)), wB);
+
+        vst1q_u8(dst + x, vcombine_u8(vrshrn_n_u16(lo, 8), vrshrn_n_u16(hi, 8)));
+    }
+
+    if (x < size) {
+        blendRowScalar_f(a + x, b + x, dst + x, size - x, weight);
+    }
+}
+
+/*!
+ *
+ */
+static void accumulateRowNeon_f(const uint8_t *src, uint16_t *acc, uint32_t size)
+{
+    uint8x16_t ss;
+    uint32_t x;
+
+    for (x = 0; x + 16 <= size; x += 16) {
+        ss = vld1q_u8(src + x);
+
+        vst1q_u16(acc + x, vaddw_u8(vld1q_u16(acc + x), vget_low_u8(ss)));
+        vst1q_u16(acc + x + 8, vaddw_u8(vld1q_u16(acc + x + 8), vget_high_u8(ss)));
+    }
+
+    if (x < size) {
+        accumulateRowScalar_f(src + x, acc + x, size - x);
+    }
+}
+
+/*!
+ *
+ */
+static void averageRowNeon_f(const uint16_t *acc, uint8_t *dst, uint32_t size, uint32_t count)
+{
+    const uint16x8_t half       = vdupq_n_u16((uint16_t)(count / 2));
+    const uint16x4_t reciprocal = vdup_n_u16((uint16_t)((65536 + count - 1) / count));
+
+    uint16x8_t lo, hi;
+    uint32_t x;
+
+    for (x = 0; x + 16 <= size; x += 16) {
+        lo = vaddq_u16(vld1q_u16(acc + x), half);
+        hi = vaddq_u16(vld1q_u16(acc + x + 8), half);
+
+        lo = vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(lo), reciprocal), 16),
+                          vshrn_n_u32(vmull_u16(vget_high_u16(lo), reciprocal), 16));
+        hi = vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(hi), reciprocal), 16),
+                          vshrn_n_u32(vmull_u16(vget_high_u16(hi), reciprocal), 16));
+
+        vst1q_u8(dst + x, vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+    }
+
+    if (x < size) {
+        averageRowScalar_f(acc + x, dst + x, size - x, count);
+    }
+}
+
+#endif //SCALER_HAVE_NEON
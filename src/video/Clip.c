@@ -0,0 +1,683 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file Clip.c
+* \brief Pre-event ring of frames dumped to file on request
+* \author Boubacar DIENE
+*
+* Frames are copied one after the other to a memory area allocated once, wrapping to its
+* beginning when the end is reached. The oldest frames are evicted when they get older than
+* preEvent_s or when room is needed, except those a running dump has not written yet. The
+* writer task reads frames directly from the ring so a dump does not copy them again
+*/
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "utils/Log.h"
+#include "utils/Task.h"
+
+#include "video/Clip.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#undef  TAG
+#define TAG "Clip"
+
+#define WRITER_TASK_NAME  "clip"
+
+/* Prefix followed by the extension */
+#define CLIP_PATH_SIZE    (MAX_PATH_SIZE + 8)
+
+/* Dump is closed if no frame is captured for that long after its end */
+#define DUMP_TIMEOUT_US   (2 * 1000000ULL)
+#define WRITER_WAIT_MS    500
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+struct clip_frame_s {
+    size_t   offset;
+    size_t   size;
+    uint64_t captureTime_us;
+};
+
+struct clip_private_data_s {
+    struct clip_params_s params;
+
+    uint8_t              *memory;
+    uint32_t             maxFrames;
+    struct clip_frame_s  *frames;   /* Frame number n is frames[n % maxFrames] */
+
+    /* Protected by lock */
+    pthread_mutex_t      lock;
+    uint64_t             first;     /* Number of the oldest buffered frame */
+    uint64_t             next;      /* Number of the next pushed frame */
+    size_t               head;      /* Where the next frame is copied */
+
+    uint8_t              dumping;
+    uint64_t             cursor;    /* Next frame to write - Frames from there are not evicted */
+    uint64_t             dumpEnd_us;
+    char                 pathPrefix[MAX_PATH_SIZE];
+
+    struct clip_stats_s  stats;
+
+    /* Writer side */
+    struct task_s        *writerTask;
+    struct task_params_s taskParams;
+    sem_t                writerSem;
+    volatile uint8_t     quit;
+
+    uint8_t              isOpen;
+    int                  fd;
+    int                  indexFd;
+    uint64_t             fileOffset;
+    uint32_t             nbWrittenFrames;
+    uint8_t              writeFailed;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PUBLIC FUNCTIONS PROTOTYPES //////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static enum clip_error_e push_f(struct clip_s *obj, struct video_buffer_s *videoBuffer);
+static enum clip_error_e dump_f(struct clip_s *obj, const char *pathPrefix, uint32_t postEvent_s);
+static enum clip_error_e getStats_f(struct clip_s *obj, struct clip_stats_s *stats);
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PRIVATE FUNCTIONS PROTOTYPES /////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static uint8_t reserve_f(struct clip_private_data_s *pData, size_t size, uint64_t captureTime_us,
+                         size_t *offset);
+static uint8_t getRoom_f(struct clip_private_data_s *pData, size_t size, size_t *offset);
+static uint8_t isEvictable_f(struct clip_private_data_s *pData);
+
+static void writerFct_f(struct task_params_s *params);
+static void waitWriter_f(struct clip_private_data_s *pData);
+static void openFiles_f(struct clip_private_data_s *pData);
+static void writeFrame_f(struct clip_private_data_s *pData, struct clip_frame_s *frame);
+static void closeFiles_f(struct clip_private_data_s *pData);
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+enum clip_error_e Clip_Init(struct clip_s **obj, struct clip_params_s *params)
+{
+    ASSERT(obj && params);
+
+    if (params->preEvent_s == 0) {
+        Loge("Bad params");
+        return CLIP_ERROR_PARAMS;
+    }
+
+    ASSERT((*obj = calloc(1, sizeof(struct clip_s))));
+
+    struct clip_private_data_s *pData;
+    ASSERT((pData = calloc(1, sizeof(struct clip_private_data_s))));
+
+    pData->params  = *params;
+    pData->fd      = -1;
+    pData->indexFd = -1;
+
+    if (pData->params.memorySize == 0) {
+        pData->params.memorySize = CLIP_DEFAULT_MEMORY_SIZE;
+    }
+
+    pData->maxFrames = (uint32_t)(pData->params.memorySize / CLIP_MIN_FRAME_SIZE) + 1;
+
+    if (!(pData->memory = malloc(pData->params.memorySize))) {
+        Loge("Failed to allocate %lu bytes", pData->params.memorySize);
+        goto memory_exit;
+    }
+
+    ASSERT((pData->frames = calloc(pData->maxFrames, sizeof(struct clip_frame_s))));
+
+    if (pthread_mutex_init(&pData->lock, NULL) != 0) {
+        Loge("pthread_mutex_init() failed");
+        goto lock_exit;
+    }
+
+    if (sem_init(&pData->writerSem, 0, 0) != 0) {
+        Loge("sem_init() failed");
+        goto sem_exit;
+    }
+
+    if (Task_Init(&pData->writerTask) != TASK_ERROR_NONE) {
+        Loge("Task_Init() failed");
+        goto task_exit;
+    }
+
+    struct task_params_s *taskParams = &pData->taskParams;
+
+    snprintf(taskParams->name, sizeof(taskParams->name), "%s-%.16s", WRITER_TASK_NAME,
+             params->name);
+    taskParams->priority = params->priority;
+    taskParams->fct      = writerFct_f;
+    taskParams->fctData  = pData;
+    taskParams->userData = NULL;
+    taskParams->atExit   = NULL;
+
+    if (pData->writerTask->create(pData->writerTask, taskParams) != TASK_ERROR_NONE) {
+        Loge("Failed to create writer task");
+        goto create_exit;
+    }
+
+    (void)pData->writerTask->start(pData->writerTask, taskParams);
+
+    Logd("%s : keeping last %u seconds of frames in %lu bytes", params->name,
+            params->preEvent_s, pData->params.memorySize);
+
+    (*obj)->push     = push_f;
+    (*obj)->dump     = dump_f;
+    (*obj)->getStats = getStats_f;
+
+    (*obj)->pData = (void*)pData;
+
+    return CLIP_ERROR_NONE;
+
+create_exit:
+    (void)Task_UnInit(&pData->writerTask);
+
+task_exit:
+    (void)sem_destroy(&pData->writerSem);
+
+sem_exit:
+    (void)pthread_mutex_destroy(&pData->lock);
+
+lock_exit:
+    free(pData->frames);
+    free(pData->memory);
+
+memory_exit:
+    free(pData);
+    free(*obj);
+    *obj = NULL;
+
+    return CLIP_ERROR_INIT;
+}
+
+/*!
+ *
+ */
+enum clip_error_e Clip_UnInit(struct clip_s **obj)
+{
+    ASSERT(obj && *obj && (*obj)->pData);
+
+    struct clip_private_data_s *pData = (struct clip_private_data_s*)((*obj)->pData);
+
+    /* Frames already captured are written before the task leaves */
+    pData->quit = 1;
+    sem_post(&pData->writerSem);
+
+    (void)pData->writerTask->stop(pData->writerTask, &pData->taskParams);
+    (void)pData->writerTask->destroy(pData->writerTask, &pData->taskParams);
+    (void)Task_UnInit(&pData->writerTask);
+
+    if (pData->isOpen) {
+        closeFiles_f(pData);
+    }
+
+    (void)sem_destroy(&pData->writerSem);
+    (void)pthread_mutex_destroy(&pData->lock);
+
+    free(pData->frames);
+    free(pData->memory);
+
+    free(pData);
+    free(*obj);
+    *obj = NULL;
+
+    return CLIP_ERROR_NONE;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////// PUBLIC FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ * Only the calling thread adds frames so the reserved area can be filled without the lock
+ */
+static enum clip_error_e push_f(struct clip_s *obj, struct video_buffer_s *videoBuffer)
+{
+    ASSERT(obj && obj->pData && videoBuffer);
+
+    struct clip_private_data_s *pData = (struct clip_private_data_s*)(obj->pData);
+    struct clip_frame_s *frame;
+    uint32_t nbPlanes, index;
+    size_t frameSize, offset;
+    uint8_t dumping;
+
+    nbPlanes  = (videoBuffer->nbPlanes > 1 ? videoBuffer->nbPlanes : 0);
+    frameSize = (nbPlanes > 0 ? 0 : videoBuffer->length);
+
+    for (index = 0; index < nbPlanes; index++) {
+        frameSize += videoBuffer->planes[index].length;
+    }
+
+    if (frameSize == 0) {
+        return CLIP_ERROR_PARAMS;
+    }
+
+    (void)pthread_mutex_lock(&pData->lock);
+
+    if (!reserve_f(pData, frameSize, videoBuffer->captureTime_us, &offset)) {
+        pData->stats.nbDroppedFrames++;
+        (void)pthread_mutex_unlock(&pData->lock);
+        return CLIP_ERROR_FULL;
+    }
+
+    (void)pthread_mutex_unlock(&pData->lock);
+
+    if (nbPlanes == 0) {
+        memcpy(pData->memory + offset, videoBuffer->data, frameSize);
+    }
+    else {
+        size_t copied = 0;
+        for (index = 0; index < nbPlanes; index++) {
+            memcpy(pData->memory + offset + copied, videoBuffer->planes[index].data,
+                   videoBuffer->planes[index].length);
+            copied += videoBuffer->planes[index].length;
+        }
+    }
+
+    (void)pthread_mutex_lock(&pData->lock);
+
+    frame                 = &pData->frames[pData->next % pData->maxFrames];
+    frame->offset         = offset;
+    frame->size           = frameSize;
+    frame->captureTime_us = videoBuffer->captureTime_us;
+
+    pData->next++;
+    pData->head = offset + frameSize;
+    dumping     = pData->dumping;
+
+    (void)pthread_mutex_unlock(&pData->lock);
+
+    if (dumping) {
+        sem_post(&pData->writerSem);
+    }
+
+    return CLIP_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+static enum clip_error_e dump_f(struct clip_s *obj, const char *pathPrefix, uint32_t postEvent_s)
+{
+    ASSERT(obj && obj->pData && pathPrefix);
+
+    struct clip_private_data_s *pData = (struct clip_private_data_s*)(obj->pData);
+    uint64_t dumpEnd_us;
+
+    if (postEvent_s == 0) {
+        postEvent_s = pData->params.postEvent_s;
+    }
+
+    dumpEnd_us = getMonotonicTime_us() + (uint64_t)postEvent_s * 1000000;
+
+    (void)pthread_mutex_lock(&pData->lock);
+
+    if (pData->dumping) {
+        if (dumpEnd_us > pData->dumpEnd_us) {
+            pData->dumpEnd_us = dumpEnd_us;
+        }
+        (void)pthread_mutex_unlock(&pData->lock);
+
+        Logi("%s : dump to \"%s\" extended by %u seconds", pData->params.name,
+                pData->pathPrefix, postEvent_s);
+        return CLIP_ERROR_NONE;
+    }
+
+    snprintf(pData->pathPrefix, sizeof(pData->pathPrefix), "%s", pathPrefix);
+
+    pData->dumping    = 1;
+    pData->cursor     = pData->first;
+    pData->dumpEnd_us = dumpEnd_us;
+    pData->stats.nbDumps++;
+
+    Logi("%s : dumping %lu buffered frames and next %u seconds to \"%s\"", pData->params.name,
+            pData->next - pData->first, postEvent_s, pData->pathPrefix);
+
+    (void)pthread_mutex_unlock(&pData->lock);
+
+    sem_post(&pData->writerSem);
+
+    return CLIP_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+static enum clip_error_e getStats_f(struct clip_s *obj, struct clip_stats_s *stats)
+{
+    ASSERT(obj && obj->pData && stats);
+
+    struct clip_private_data_s *pData = (struct clip_private_data_s*)(obj->pData);
+
+    (void)pthread_mutex_lock(&pData->lock);
+
+    *stats                  = pData->stats;
+    stats->nbBufferedFrames = pData->next - pData->first;
+
+    if (pData->next > pData->first) {
+        stats->bufferedDuration_ms = (uint32_t)(
+                (pData->frames[(pData->next - 1) % pData->maxFrames].captureTime_us
+                 - pData->frames[pData->first % pData->maxFrames].captureTime_us) / 1000);
+    }
+
+    (void)pthread_mutex_unlock(&pData->lock);
+
+    return CLIP_ERROR_NONE;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////// PRIVATE FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ * Evict frames older than preEvent_s then as many frames as needed to store the new one.
+ * Called with lock held
+ */
+static uint8_t reserve_f(struct clip_private_data_s *pData, size_t size, uint64_t captureTime_us,
+                         size_t *offset)
+{
+    ASSERT(pData && offset);
+
+    uint64_t maxAge_us = (uint64_t)pData->params.preEvent_s * 1000000;
+
+    if (size > pData->params.memorySize) {
+        return 0;
+    }
+
+    while ((pData->first < pData->next)
+           && (captureTime_us > pData->frames[pData->first % pData->maxFrames].captureTime_us
+                                + maxAge_us)
+           && isEvictable_f(pData)) {
+        pData->first++;
+    }
+
+    while (((pData->next - pData->first) >= pData->maxFrames)
+           || !getRoom_f(pData, size, offset)) {
+        if ((pData->first == pData->next) || !isEvictable_f(pData)) {
+            return 0;
+        }
+        pData->first++;
+    }
+
+    return 1;
+}
+
+/*!
+ * Buffered frames go from the oldest one to head, possibly wrapping to the beginning of memory
+ */
+static uint8_t getRoom_f(struct clip_private_data_s *pData, size_t size, size_t *offset)
+{
+    ASSERT(pData && offset);
+
+    size_t tail;
+
+    if (pData->first == pData->next) {
+        *offset = 0;
+        return 1;
+    }
+
+    tail = pData->frames[pData->first % pData->maxFrames].offset;
+
+    if (pData->head > tail) {
+        if (pData->params.memorySize - pData->head >= size) {
+            *offset = pData->head;
+            return 1;
+        }
+
+        if (tail >= size) {
+            *offset = 0;
+            return 1;
+        }
+
+        return 0;
+    }
+
+    if (tail - pData->head >= size) {
+        *offset = pData->head;
+        return 1;
+    }
+
+    return 0;
+}
+
+/*!
+ * Called with lock held
+ */
+static uint8_t isEvictable_f(struct clip_private_data_s *pData)
+{
+    ASSERT(pData);
+
+    return !pData->dumping || (pData->first < pData->cursor);
+}
+
+/*!
+ *
+ */
+static void writerFct_f(struct task_params_s *params)
+{
+    ASSERT(params && params->fctData);
+
+    struct clip_private_data_s *pData = (struct clip_private_data_s*)params->fctData;
+    struct clip_frame_s frame;
+    uint8_t isOver = 0;
+
+    waitWriter_f(pData);
+
+    (void)pthread_mutex_lock(&pData->lock);
+
+    if (!pData->dumping) {
+        (void)pthread_mutex_unlock(&pData->lock);
+        return;
+    }
+
+    if (!pData->isOpen) {
+        (void)pthread_mutex_unlock(&pData->lock);
+        openFiles_f(pData);
+        (void)pthread_mutex_lock(&pData->lock);
+    }
+
+    while (pData->cursor < pData->next) {
+        frame = pData->frames[pData->cursor % pData->maxFrames];
+
+        if (frame.captureTime_us >= pData->dumpEnd_us) {
+            isOver = 1;
+            break;
+        }
+
+        /* Frame cannot be evicted as long as cursor has not moved */
+        (void)pthread_mutex_unlock(&pData->lock);
+        writeFrame_f(pData, &frame);
+        (void)pthread_mutex_lock(&pData->lock);
+
+        pData->cursor++;
+    }
+
+    if (pData->quit || (getMonotonicTime_us() > pData->dumpEnd_us + DUMP_TIMEOUT_US)) {
+        isOver = 1;
+    }
+
+    if (isOver) {
+        pData->dumping = 0;
+    }
+
+    (void)pthread_mutex_unlock(&pData->lock);
+
+    if (isOver) {
+        closeFiles_f(pData);
+    }
+}
+
+/*!
+ * Wake up regularly while dumping to close the files even if capture is stopped
+ */
+static void waitWriter_f(struct clip_private_data_s *pData)
+{
+    ASSERT(pData);
+
+    struct timespec ts;
+    uint8_t dumping;
+
+    if (pData->quit) {
+        return;
+    }
+
+    (void)pthread_mutex_lock(&pData->lock);
+    dumping = pData->dumping;
+    (void)pthread_mutex_unlock(&pData->lock);
+
+    if (!dumping) {
+        sem_wait(&pData->writerSem);
+        return;
+    }
+
+    (void)clock_gettime(CLOCK_REALTIME, &ts);
+
+    ts.tv_nsec += WRITER_WAIT_MS * 1000000L;
+    ts.tv_sec  += ts.tv_nsec / 1000000000L;
+    ts.tv_nsec %= 1000000000L;
+
+    (void)sem_timedwait(&pData->writerSem, &ts);
+}
+
+/*!
+ * Frames are still consumed when files cannot be written so that the ring is not blocked
+ */
+static void openFiles_f(struct clip_private_data_s *pData)
+{
+    ASSERT(pData && !pData->isOpen);
+
+    char path[CLIP_PATH_SIZE];
+    uint8_t isJpeg = (pData->params.pixelformat == V4L2_PIX_FMT_MJPEG)
+                     || (pData->params.pixelformat == V4L2_PIX_FMT_JPEG);
+    int flags      = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+
+    pData->isOpen          = 1;
+    pData->fileOffset      = 0;
+    pData->nbWrittenFrames = 0;
+    pData->writeFailed     = 0;
+
+    snprintf(path, sizeof(path), "%s.%s", pData->pathPrefix, (isJpeg ? "mjpeg" : "raw"));
+
+    if ((pData->fd = open(path, flags, 0644)) < 0) {
+        Loge("Failed to create \"%s\" - %s", path, strerror(errno));
+        goto error;
+    }
+
+    snprintf(path, sizeof(path), "%s.idx", pData->pathPrefix);
+
+    if ((pData->indexFd = open(path, flags, 0644)) < 0) {
+        Loge("Failed to create \"%s\" - %s", path, strerror(errno));
+        goto error;
+    }
+
+    return;
+
+error:
+    pData->writeFailed = 1;
+
+    (void)pthread_mutex_lock(&pData->lock);
+    pData->stats.nbWriteErrors++;
+    (void)pthread_mutex_unlock(&pData->lock);
+}
+
+/*!
+ * Index has the same format as the one of raw recordings i.e "offset size captureTime_us"
+ */
+static void writeFrame_f(struct clip_private_data_s *pData, struct clip_frame_s *frame)
+{
+    ASSERT(pData && frame);
+
+    if (pData->writeFailed) {
+        return;
+    }
+
+    if (!writeAll(pData->fd, pData->memory + frame->offset, frame->size)
+        || (dprintf(pData->indexFd, "%lu %lu %lu\n", pData->fileOffset, frame->size,
+                    frame->captureTime_us) < 0)) {
+        Loge("Failed to write \"%s\" - %s", pData->pathPrefix, strerror(errno));
+        pData->writeFailed = 1;
+
+        (void)pthread_mutex_lock(&pData->lock);
+        pData->stats.nbWriteErrors++;
+        (void)pthread_mutex_unlock(&pData->lock);
+        return;
+    }
+
+    pData->fileOffset += frame->size;
+    pData->nbWrittenFrames++;
+}
+
+/*!
+ *
+ */
+static void closeFiles_f(struct clip_private_data_s *pData)
+{
+    ASSERT(pData && pData->isOpen);
+
+    pData->isOpen = 0;
+
+    if (pData->fd != -1) {
+        if (close(pData->fd) != 0) {
+            pData->writeFailed = 1;
+        }
+        pData->fd = -1;
+    }
+
+    if (pData->indexFd != -1) {
+        if (close(pData->indexFd) != 0) {
+            pData->writeFailed = 1;
+        }
+        pData->indexFd = -1;
+    }
+
+    if (pData->writeFailed) {
+        Loge("%s : dump to \"%s\" failed", pData->params.name, pData->pathPrefix);
+        return;
+    }
+
+    Logi("%s : %u frames (%lu bytes) dumped to \"%s\"", pData->params.name,
+            pData->nbWrittenFrames, pData->fileOffset, pData->pathPrefix);
+}
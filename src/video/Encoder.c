@@ -0,0 +1,729 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file Encoder.c
+* \brief JPEG encoding of raw video frames
+* \author Boubacar DIENE
+*
+* The frame is split into horizontal slices made of whole MCU rows. Each slice is converted to
+* I420 then compressed as a standalone JPEG image by its own thread. Since all slices share the
+* same tables and a restart interval equal to the number of MCUs in a slice, their entropy-coded
+* data can be concatenated with RSTn markers in between to form a single baseline JPEG
+*/
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include <semaphore.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <time.h>
+
+#include <jpeglib.h>
+
+#include "utils/JpegError.h"
+#include "utils/Log.h"
+#include "utils/Task.h"
+
+#include "video/Encoder.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#undef  TAG
+#define TAG "Encoder"
+
+#define SLICE_TASK_NAME    "enc"
+#define SLICE_QUIT_WAIT_MS 10
+
+/* 4:2:0 subsampling */
+#define MCU_SIZE          16
+
+#define MAX_DIMENSION     65535
+#define MAX_RESTART       65535
+#define HEADERS_MAX_SIZE  1024
+
+#define JPEG_MARKER_SOF0  0xC0
+#define JPEG_MARKER_RST0  0xD0
+#define JPEG_MARKER_EOI   0xD9
+#define JPEG_MARKER_SOS   0xDA
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+struct encoder_slice_s {
+    uint32_t                      index;
+    uint32_t                      firstRow;
+    uint32_t                      nbRows;
+    uint32_t                      nbPaddedRows;
+
+    struct converter_frame_s      i420;
+    uint8_t                       *i420Data;
+
+    struct jpeg_compress_struct   cinfo;
+    struct jpeg_error_s           jerr;
+    unsigned char                 *jpeg;
+    unsigned long                 jpegSize;
+    unsigned long                 jpegCapacity;
+
+    enum encoder_error_e          ret;
+
+    sem_t                         startSem;
+    struct task_params_s          taskParams;
+
+    struct encoder_private_data_s *pData;
+};
+
+struct encoder_private_data_s {
+    struct encoder_params_s  params;
+
+    struct converter_s       *converter;
+    struct task_s            *sliceTask;
+
+    uint32_t                 nbSlices;
+    uint32_t                 rowsPerSlice;
+    struct encoder_slice_s   *slices;
+
+    struct converter_frame_s *in;
+    sem_t                    doneSem;
+    volatile uint8_t         quit;
+
+    uint8_t                  *output;
+    size_t                   outputCapacity;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PUBLIC FUNCTIONS PROTOTYPES //////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static enum encoder_error_e encode_f(struct encoder_s *obj, struct converter_frame_s *in,
+                                     struct buffer_s *out);
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PRIVATE FUNCTIONS PROTOTYPES /////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static enum encoder_error_e initSlice_f(struct encoder_private_data_s *pData,
+                                        struct encoder_slice_s *slice, uint32_t index);
+static void uninitSlice_f(struct encoder_private_data_s *pData, struct encoder_slice_s *slice);
+
+static void encodeSlice_f(struct encoder_private_data_s *pData, struct encoder_slice_s *slice);
+static void padSlice_f(struct encoder_slice_s *slice);
+static enum encoder_error_e compressSlice_f(struct encoder_slice_s *slice);
+
+static enum encoder_error_e assembleSlices_f(struct encoder_private_data_s *pData,
+                                             struct buffer_s *out);
+static uint8_t findSegment_f(const uint8_t *data, size_t size, uint8_t marker, size_t *offset);
+
+static void sliceFct_f(struct task_params_s *params);
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+enum encoder_error_e Encoder_Init(struct encoder_s **obj, struct encoder_params_s *params)
+{
+    ASSERT(obj && params);
+
+    if ((params->width == 0) || (params->height == 0) || ((params->width % 2) != 0)
+        || (params->width > MAX_DIMENSION) || (params->height > MAX_DIMENSION)
+        || (params->quality > 100)) {
+        Loge("Bad params");
+        return ENCODER_ERROR_PARAMS;
+    }
+
+    uint32_t nbMcuRows = (params->height + MCU_SIZE - 1) / MCU_SIZE;
+    uint32_t nbSlices  = (params->nbSlices > 0 ? params->nbSlices : 1);
+
+    nbSlices = (nbSlices > ENCODER_MAX_SLICES ? ENCODER_MAX_SLICES : nbSlices);
+    nbSlices = (nbSlices > nbMcuRows ? nbMcuRows : nbSlices);
+
+    uint32_t rowsPerSlice = ((nbMcuRows + nbSlices - 1) / nbSlices) * MCU_SIZE;
+    nbSlices              = (params->height + rowsPerSlice - 1) / rowsPerSlice;
+
+    if ((nbSlices > 1)
+        && ((params->width + MCU_SIZE - 1) / MCU_SIZE) * (rowsPerSlice / MCU_SIZE) > MAX_RESTART) {
+        Loge("%ux%u frame needs more than %u slices", params->width, params->height, nbSlices);
+        return ENCODER_ERROR_PARAMS;
+    }
+
+    ASSERT((*obj = calloc(1, sizeof(struct encoder_s))));
+
+    struct encoder_private_data_s *pData;
+    ASSERT((pData = calloc(1, sizeof(struct encoder_private_data_s))));
+
+    pData->params       = *params;
+    pData->nbSlices     = nbSlices;
+    pData->rowsPerSlice = rowsPerSlice;
+
+    if (pData->params.quality == 0) {
+        pData->params.quality = ENCODER_DEFAULT_QUALITY;
+    }
+
+    if (Converter_Init(&pData->converter, CONVERTER_KERNEL_AUTO) != CONVERTER_ERROR_NONE) {
+        Loge("Converter_Init() failed");
+        goto converter_exit;
+    }
+
+    if (sem_init(&pData->doneSem, 0, 0) != 0) {
+        Loge("sem_init() failed");
+        goto sem_exit;
+    }
+
+    if ((nbSlices > 1) && (Task_Init(&pData->sliceTask) != TASK_ERROR_NONE)) {
+        Loge("Task_Init() failed");
+        goto task_exit;
+    }
+
+    ASSERT((pData->slices = calloc(nbSlices, sizeof(struct encoder_slice_s))));
+
+    uint32_t index;
+    for (index = 0; index < nbSlices; index++) {
+        if (initSlice_f(pData, &pData->slices[index], index) != ENCODER_ERROR_NONE) {
+            Loge("Failed to init slice %u", index);
+            goto slices_exit;
+        }
+    }
+
+    Logd("%s : %ux%u frames split into %u slice(s) of %u rows", pData->params.name,
+            params->width, params->height, nbSlices, rowsPerSlice);
+
+    (*obj)->encode = encode_f;
+    (*obj)->pData  = (void*)pData;
+
+    return ENCODER_ERROR_NONE;
+
+slices_exit:
+    while (index > 0) {
+        uninitSlice_f(pData, &pData->slices[--index]);
+    }
+    free(pData->slices);
+
+    if (pData->sliceTask) {
+        (void)Task_UnInit(&pData->sliceTask);
+    }
+
+task_exit:
+    (void)sem_destroy(&pData->doneSem);
+
+sem_exit:
+    (void)Converter_UnInit(&pData->converter);
+
+converter_exit:
+    free(pData);
+    free(*obj);
+    *obj = NULL;
+
+    return ENCODER_ERROR_INIT;
+}
+
+/*!
+ *
+ */
+enum encoder_error_e Encoder_UnInit(struct encoder_s **obj)
+{
+    ASSERT(obj && *obj && (*obj)->pData);
+
+    struct encoder_private_data_s *pData = (struct encoder_private_data_s*)((*obj)->pData);
+
+    pData->quit = 1;
+
+    uint32_t index;
+    for (index = 0; index < pData->nbSlices; index++) {
+        uninitSlice_f(pData, &pData->slices[index]);
+    }
+    free(pData->slices);
+
+    if (pData->sliceTask) {
+        (void)Task_UnInit(&pData->sliceTask);
+    }
+
+    (void)sem_destroy(&pData->doneSem);
+    (void)Converter_UnInit(&pData->converter);
+
+    free(pData->output);
+    free(pData);
+    free(*obj);
+    *obj = NULL;
+
+    return ENCODER_ERROR_NONE;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////// PUBLIC FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+static enum encoder_error_e encode_f(struct encoder_s *obj, struct converter_frame_s *in,
+                                     struct buffer_s *out)
+{
+    ASSERT(obj && obj->pData && in && out);
+
+    struct encoder_private_data_s *pData = (struct encoder_private_data_s*)(obj->pData);
+    uint32_t index;
+
+    if ((in->width != pData->params.width) || (in->height != pData->params.height)) {
+        Loge("%ux%u frame given to %ux%u encoder", in->width, in->height,
+                pData->params.width, pData->params.height);
+        return ENCODER_ERROR_PARAMS;
+    }
+
+    pData->in = in;
+
+    for (index = 1; index < pData->nbSlices; index++) {
+        sem_post(&pData->slices[index].startSem);
+    }
+
+    /* First slice is encoded by the caller */
+    encodeSlice_f(pData, &pData->slices[0]);
+
+    for (index = 1; index < pData->nbSlices; index++) {
+        sem_wait(&pData->doneSem);
+    }
+
+    pData->in = NULL;
+
+    for (index = 0; index < pData->nbSlices; index++) {
+        if (pData->slices[index].ret != ENCODER_ERROR_NONE) {
+            Loge("%s : failed to encode slice %u", pData->params.name, index);
+            return ENCODER_ERROR_ENCODE;
+        }
+    }
+
+    if (pData->nbSlices == 1) {
+        out->data   = pData->slices[0].jpeg;
+        out->length = pData->slices[0].jpegSize;
+
+        return ENCODER_ERROR_NONE;
+    }
+
+    return assembleSlices_f(pData, out);
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////// PRIVATE FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+static enum encoder_error_e initSlice_f(struct encoder_private_data_s *pData,
+                                        struct encoder_slice_s *slice, uint32_t index)
+{
+    ASSERT(pData && slice);
+
+    struct encoder_params_s *params      = &pData->params;
+    struct jpeg_compress_struct *cinfo   = &slice->cinfo;
+    struct converter_s *converter        = pData->converter;
+    size_t size                          = 0;
+
+    slice->pData        = pData;
+    slice->index        = index;
+    slice->firstRow     = index * pData->rowsPerSlice;
+    slice->nbRows       = params->height - slice->firstRow;
+    slice->nbRows       = (slice->nbRows > pData->rowsPerSlice ? pData->rowsPerSlice
+                                                               : slice->nbRows);
+    slice->nbPaddedRows = ((slice->nbRows + MCU_SIZE - 1) / MCU_SIZE) * MCU_SIZE;
+
+    /* libjpeg reads whole MCUs in raw mode so rows are padded too */
+    uint32_t paddedWidth = ((params->width + MCU_SIZE - 1) / MCU_SIZE) * MCU_SIZE;
+
+    (void)converter->getFrameSize(converter, CONVERTER_FORMAT_I420, paddedWidth,
+                                  slice->nbPaddedRows, &size);
+    ASSERT((slice->i420Data = malloc(size)));
+    (void)converter->setFrame(converter, CONVERTER_FORMAT_I420, paddedWidth,
+                              slice->nbPaddedRows, slice->i420Data, &slice->i420);
+
+    slice->i420.width = params->width;
+
+    /* Enough for most frames, libjpeg reallocates it otherwise */
+    slice->jpegCapacity = (unsigned long)(size + HEADERS_MAX_SIZE);
+    ASSERT((slice->jpeg = malloc(slice->jpegCapacity)));
+
+    cinfo->err = JpegError_Init(&slice->jerr, 0);
+
+    if (setjmp(slice->jerr.jmpBuf)) {
+        goto jpeg_exit;
+    }
+
+    jpeg_create_compress(cinfo);
+
+    cinfo->image_width      = params->width;
+    cinfo->image_height     = slice->nbRows;
+    cinfo->input_components = 3;
+    cinfo->in_color_space   = JCS_YCbCr;
+
+    jpeg_set_defaults(cinfo);
+    jpeg_set_quality(cinfo, params->quality, TRUE);
+
+    cinfo->raw_data_in                  = TRUE;
+    cinfo->comp_info[0].h_samp_factor   = 2;
+    cinfo->comp_info[0].v_samp_factor   = 2;
+    cinfo->comp_info[1].h_samp_factor   = 1;
+    cinfo->comp_info[1].v_samp_factor   = 1;
+    cinfo->comp_info[2].h_samp_factor   = 1;
+    cinfo->comp_info[2].v_samp_factor   = 1;
+
+    /* No restart marker inside a slice, one between slices */
+    if (pData->nbSlices > 1) {
+        cinfo->restart_interval = ((params->width + MCU_SIZE - 1) / MCU_SIZE)
+                                  * (pData->rowsPerSlice / MCU_SIZE);
+    }
+
+    if (sem_init(&slice->startSem, 0, 0) != 0) {
+        Loge("sem_init() failed");
+        goto sem_exit;
+    }
+
+    if (index == 0) {
+        return ENCODER_ERROR_NONE;
+    }
+
+    struct task_params_s *taskParams = &slice->taskParams;
+
+    snprintf(taskParams->name, sizeof(taskParams->name), "%s-%.16s-%u",
+             SLICE_TASK_NAME, params->name, index);
+    taskParams->priority = params->priority;
+    taskParams->fct      = sliceFct_f;
+    taskParams->fctData  = pData;
+    taskParams->userData = slice;
+    taskParams->atExit   = NULL;
+
+    if (pData->sliceTask->create(pData->sliceTask, taskParams) != TASK_ERROR_NONE) {
+        Loge("Failed to create slice task");
+        goto task_exit;
+    }
+
+    (void)pData->sliceTask->start(pData->sliceTask, taskParams);
+
+    return ENCODER_ERROR_NONE;
+
+task_exit:
+    (void)sem_destroy(&slice->startSem);
+
+sem_exit:
+    jpeg_destroy_compress(cinfo);
+
+jpeg_exit:
+    free(slice->jpeg);
+    free(slice->i420Data);
+
+    return ENCODER_ERROR_INIT;
+}
+
+/*!
+ *
+ */
+static void uninitSlice_f(struct encoder_private_data_s *pData, struct encoder_slice_s *slice)
+{
+    ASSERT(pData && slice);
+
+    if (slice->index > 0) {
+        pData->quit = 1;
+        sem_post(&slice->startSem);
+
+        (void)pData->sliceTask->stop(pData->sliceTask, &slice->taskParams);
+        (void)pData->sliceTask->destroy(pData->sliceTask, &slice->taskParams);
+    }
+
+    (void)sem_destroy(&slice->startSem);
+    jpeg_destroy_compress(&slice->cinfo);
+
+    free(slice->jpeg);
+    free(slice->i420Data);
+}
+
+/*!
+ *
+ */
+static void encodeSlice_f(struct encoder_private_data_s *pData, struct encoder_slice_s *slice)
+{
+    ASSERT(pData && pData->in && slice);
+
+    struct converter_s *converter = pData->converter;
+    struct converter_frame_s src  = *pData->in;
+    struct converter_frame_s dst  = slice->i420;
+    uint32_t plane;
+
+    /* Slices start on an even row so that 4:2:0 chroma planes can be offset too */
+    src.height = slice->nbRows;
+    dst.height = slice->nbRows;
+
+    src.planes[0] += (size_t)slice->firstRow * src.strides[0];
+    for (plane = 1; plane < CONVERTER_MAX_PLANES; plane++) {
+        if (src.planes[plane]) {
+            src.planes[plane] += (size_t)(slice->firstRow / 2) * src.strides[plane];
+        }
+    }
+
+    if (converter->convert(converter, &src, &dst) != CONVERTER_ERROR_NONE) {
+        slice->ret = ENCODER_ERROR_ENCODE;
+        return;
+    }
+
+    padSlice_f(slice);
+
+    slice->ret = compressSlice_f(slice);
+}
+
+/*!
+ * libjpeg expects whole MCUs : repeat last columns then last rows
+ */
+static void padSlice_f(struct encoder_slice_s *slice)
+{
+    ASSERT(slice);
+
+    struct converter_frame_s *i420 = &slice->i420;
+    uint32_t nbChromaRows          = (slice->nbRows + 1) / 2;
+    uint32_t chromaWidth           = i420->width / 2;
+    uint8_t *line;
+    uint32_t row, plane;
+
+    if (i420->strides[0] > i420->width) {
+        for (row = 0; row < slice->nbRows; row++) {
+            line = i420->planes[0] + (size_t)row * i420->strides[0];
+            memset(line + i420->width, line[i420->width - 1], i420->strides[0] - i420->width);
+        }
+
+        for (plane = 1; plane < 3; plane++) {
+            for (row = 0; row < nbChromaRows; row++) {
+                line = i420->planes[plane] + (size_t)row * i420->strides[plane];
+                memset(line + chromaWidth, line[chromaWidth - 1],
+                       i420->strides[plane] - chromaWidth);
+            }
+        }
+    }
+
+    for (row = slice->nbRows; row < slice->nbPaddedRows; row++) {
+        memcpy(i420->planes[0] + (size_t)row * i420->strides[0],
+               i420->planes[0] + (size_t)(slice->nbRows - 1) * i420->strides[0],
+               i420->strides[0]);
+    }
+
+    for (plane = 1; plane < 3; plane++) {
+        for (row = nbChromaRows; row < slice->nbPaddedRows / 2; row++) {
+            memcpy(i420->planes[plane] + (size_t)row * i420->strides[plane],
+                   i420->planes[plane] + (size_t)(nbChromaRows - 1) * i420->strides[plane],
+                   i420->strides[plane]);
+        }
+    }
+}
+
+/*!
+ *
+ */
+static enum encoder_error_e compressSlice_f(struct encoder_slice_s *slice)
+{
+    ASSERT(slice);
+
+    struct jpeg_compress_struct *cinfo = &slice->cinfo;
+    struct converter_frame_s *i420     = &slice->i420;
+    unsigned char *previous            = slice->jpeg;
+
+    JSAMPROW yRows[MCU_SIZE], uRows[MCU_SIZE / 2], vRows[MCU_SIZE / 2];
+    JSAMPARRAY planes[3] = { yRows, uRows, vRows };
+    enum encoder_error_e ret           = ENCODER_ERROR_NONE;
+    uint32_t row, index;
+
+    if (setjmp(slice->jerr.jmpBuf)) {
+        /* libjpeg only hands a grown buffer back when the destination is terminated */
+        cinfo->dest->term_destination(cinfo);
+        jpeg_abort_compress(cinfo);
+        ret = ENCODER_ERROR_ENCODE;
+        goto exit;
+    }
+
+    slice->jpegSize = slice->jpegCapacity;
+    jpeg_mem_dest(cinfo, &slice->jpeg, &slice->jpegSize);
+
+    jpeg_start_compress(cinfo, TRUE);
+
+    for (row = 0; row < slice->nbPaddedRows; row += MCU_SIZE) {
+        for (index = 0; index < MCU_SIZE; index++) {
+            yRows[index] = i420->planes[0] + (size_t)(row + index) * i420->strides[0];
+        }
+
+        for (index = 0; index < MCU_SIZE / 2; index++) {
+            uRows[index] = i420->planes[1] + (size_t)(row / 2 + index) * i420->strides[1];
+            vRows[index] = i420->planes[2] + (size_t)(row / 2 + index) * i420->strides[2];
+        }
+
+        (void)jpeg_write_raw_data(cinfo, planes, MCU_SIZE);
+    }
+
+    jpeg_finish_compress(cinfo);
+
+exit:
+    /* Output buffer was too small and has been replaced by libjpeg */
+    if (slice->jpeg != previous) {
+        free(previous);
+        slice->jpegCapacity = slice->jpegSize;
+    }
+
+    return ret;
+}
+
+/*!
+ * First slice provides the headers, its height is patched to the frame's one
+ */
+static enum encoder_error_e assembleSlices_f(struct encoder_private_data_s *pData,
+                                             struct buffer_s *out)
+{
+    ASSERT(pData && out);
+
+    struct encoder_slice_s *slice = &pData->slices[0];
+    size_t sofOffset, sosOffset;
+    size_t starts[ENCODER_MAX_SLICES];
+    size_t length, size;
+    uint32_t index;
+
+    if (!findSegment_f(slice->jpeg, slice->jpegSize, JPEG_MARKER_SOF0, &sofOffset)) {
+        Loge("SOF0 not found");
+        return ENCODER_ERROR_ENCODE;
+    }
+
+    /* Headers + entropy-coded data without EOI */
+    starts[0] = 0;
+    size      = slice->jpegSize - 2;
+
+    for (index = 1; index < pData->nbSlices; index++) {
+        slice = &pData->slices[index];
+
+        if (!findSegment_f(slice->jpeg, slice->jpegSize, JPEG_MARKER_SOS, &sosOffset)) {
+            Loge("SOS not found in slice %u", index);
+            return ENCODER_ERROR_ENCODE;
+        }
+
+        starts[index] = sosOffset + 2 + (size_t)((slice->jpeg[sosOffset + 2] << 8)
+                                                 | slice->jpeg[sosOffset + 3]);
+        size         += 2 + (slice->jpegSize - 2 - starts[index]);
+    }
+
+    size += 2;
+
+    if (pData->outputCapacity < size) {
+        free(pData->output);
+        ASSERT((pData->output = malloc(size)));
+        pData->outputCapacity = size;
+    }
+
+    uint8_t *output = pData->output;
+
+    for (index = 0; index < pData->nbSlices; index++) {
+        slice = &pData->slices[index];
+
+        if (index > 0) {
+            *output++ = 0xFF;
+            *output++ = (uint8_t)(JPEG_MARKER_RST0 + ((index - 1) % 8));
+        }
+
+        length = slice->jpegSize - 2 - starts[index];
+        memcpy(output, slice->jpeg + starts[index], length);
+        output += length;
+    }
+
+    *output++ = 0xFF;
+    *output++ = JPEG_MARKER_EOI;
+
+    /* SOF0 : marker(2) length(2) precision(1) height(2) width(2) */
+    pData->output[sofOffset + 5] = (uint8_t)(pData->params.height >> 8);
+    pData->output[sofOffset + 6] = (uint8_t)(pData->params.height & 0xFF);
+
+    out->data   = pData->output;
+    out->length = size;
+
+    return ENCODER_ERROR_NONE;
+}
+
+/*!
+ * Walk through header segments until marker is found. Stop at SOS
+ */
+static uint8_t findSegment_f(const uint8_t *data, size_t size, uint8_t marker, size_t *offset)
+{
+    ASSERT(data && offset);
+
+    /* Skip SOI */
+    size_t current = 2;
+
+    while (current + 4 <= size) {
+        if (data[current] != 0xFF) {
+            return 0;
+        }
+
+        if (data[current + 1] == marker) {
+            *offset = current;
+            return 1;
+        }
+
+        if (data[current + 1] == JPEG_MARKER_SOS) {
+            return 0;
+        }
+
+        current += 2 + (size_t)((data[current + 2] << 8) | data[current + 3]);
+    }
+
+    return 0;
+}
+
+/*!
+ *
+ */
+static void sliceFct_f(struct task_params_s *params)
+{
+    ASSERT(params && params->fctData && params->userData);
+
+    struct encoder_private_data_s *pData = (struct encoder_private_data_s*)params->fctData;
+    struct encoder_slice_s *slice        = (struct encoder_slice_s*)params->userData;
+    struct timespec ts;
+
+    // Slice tasks may be SCHED_FIFO: block until stop() is called instead of spinning
+    if (pData->quit) {
+        (void)clock_gettime(CLOCK_REALTIME, &ts);
+
+        ts.tv_nsec += SLICE_QUIT_WAIT_MS * 1000000L;
+        ts.tv_sec  += ts.tv_nsec / 1000000000L;
+        ts.tv_nsec %= 1000000000L;
+
+        (void)sem_timedwait(&slice->startSem, &ts);
+        return;
+    }
+
+    sem_wait(&slice->startSem);
+
+    if (pData->quit) {
+        return;
+    }
+
+    encodeSlice_f(pData, slice);
+
+    sem_post(&pData->doneSem);
+}
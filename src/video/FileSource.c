@@ -0,0 +1,1355 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file FileSource.c
+* \brief Replay MJPEG or raw video files, or generate test patterns, through V4L2 API
+* \author Boubacar DIENE
+*/
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/select.h>
+#include <sys/timerfd.h>
+
+#include "utils/Log.h"
+#include "utils/Pattern.h"
+
+#include "video/Encoder.h"
+#include "video/FileSource.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#undef  TAG
+#define TAG "FileSource"
+
+#define FILE_SOURCE_DRIVER_NAME "mmstreamer-file"
+
+#define JPEG_MARKER     0xFF
+#define JPEG_SOI        0xD8
+#define JPEG_EOI        0xD9
+#define JPEG_SOS        0xDA
+
+/* Worst case of noise encoded at a high quality */
+#define PATTERN_JPEG_MAX_SIZE(width, height) (3 * (size_t)(width) * (height) + 4096)
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+struct file_source_frame_s {
+    size_t offset;
+    size_t size;
+};
+
+struct file_source_pattern_s {
+    const char          *name;
+    enum pattern_type_e type;
+};
+
+struct file_source_private_data_s {
+    int32_t                    fileFd;
+    uint8_t                    *data;        /* Whole file mapped in memory */
+    size_t                     size;
+
+    struct file_source_frame_s *frames;
+    uint32_t                   nbFrames;
+    uint32_t                   nextFrame;
+    size_t                     maxFrameSize;
+
+    /* pattern:// sources */
+    struct pattern_s           *pattern;
+    struct converter_s         *converter;
+    struct encoder_s           *encoder;     /* MJPEG only */
+    enum converter_format_e    patternFormat;
+    uint8_t                    *patternData; /* Raw frame to encode */
+
+    uint32_t                   fps;          /* 0 <=> deviceFd is an eventfd, not a timerfd */
+    uint8_t                    isStreaming;
+    uint32_t                   sequence;
+
+    pthread_mutex_t            lock;
+    uint32_t                   *queue;       /* Indexes of buffers queued by the user */
+    uint32_t                   queueHead;
+    uint32_t                   nbQueued;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PUBLIC FUNCTIONS PROTOTYPES //////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static enum v4l2_error_e openDevice_f(struct v4l2_s *obj,
+                                      struct v4l2_open_device_params_s *params);
+static enum v4l2_error_e closeDevice_f(struct v4l2_s *obj);
+
+static enum v4l2_error_e configureDevice_f(struct v4l2_s *obj,
+                                           struct v4l2_configure_device_params_s *params);
+static enum v4l2_error_e setCroppingArea_f(struct v4l2_s *obj,
+                                           struct v4l2_selection_params_s *cropRectInOut);
+static enum v4l2_error_e setComposingArea_f(struct v4l2_s *obj,
+                                            struct v4l2_selection_params_s *composeRectInOut);
+
+static enum v4l2_error_e requestBuffers_f(struct v4l2_s *obj,
+                                          struct v4l2_request_buffers_params_s *params);
+static enum v4l2_error_e releaseBuffers_f(struct v4l2_s *obj);
+
+static enum v4l2_error_e startCapture_f(struct v4l2_s *obj);
+static enum v4l2_error_e stopCapture_f(struct v4l2_s *obj);
+
+static enum v4l2_error_e awaitData_f(struct v4l2_s *obj, int32_t timeout_ms);
+static enum v4l2_error_e stopAwaitingData_f(struct v4l2_s *obj);
+
+static enum v4l2_error_e queueBuffer_f(struct v4l2_s *obj, uint32_t index);
+static enum v4l2_error_e dequeueBuffer_f(struct v4l2_s *obj,
+                                         struct v4l2_dequeued_buffer_s *bufferOut);
+
+static enum v4l2_error_e disconnectDevice_f(struct v4l2_s *obj);
+static enum v4l2_error_e reconnectDevice_f(struct v4l2_s *obj);
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PRIVATE FUNCTIONS PROTOTYPES /////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static enum v4l2_error_e openFile_f(struct file_source_private_data_s *pData,
+                                     const char *path);
+static enum v4l2_error_e openPattern_f(struct file_source_private_data_s *pData,
+                                       const char *name);
+static void closeSource_f(struct file_source_private_data_s *pData);
+
+static enum v4l2_error_e configurePattern_f(struct file_source_private_data_s *pData,
+                                            struct v4l2_configure_device_params_s *params,
+                                            uint32_t *width, uint32_t *bytesPerLine,
+                                            size_t *frameSize);
+static enum v4l2_error_e generateFrame_f(struct v4l2_s *obj, struct v4l2_mapping_plane_s *plane,
+                                         struct pattern_stamp_s *stamp, size_t *bytesused);
+
+static uint8_t isCompressed_f(uint32_t pixelformat);
+static uint8_t getRawFrameLayout_f(uint32_t pixelformat, uint32_t width, uint32_t height,
+                                   uint32_t *bytesPerLine, size_t *frameSize);
+
+static enum v4l2_error_e indexJpegFrames_f(struct file_source_private_data_s *pData);
+static enum v4l2_error_e indexRawFrames_f(struct file_source_private_data_s *pData,
+                                          size_t frameSize);
+static void addFrame_f(struct file_source_private_data_s *pData, size_t offset, size_t size);
+static uint8_t getJpegSize_f(uint8_t *data, size_t size, uint32_t *width, uint32_t *height);
+
+static void flushQueue_f(struct v4l2_s *obj);
+static void requeue_f(struct v4l2_s *obj, uint32_t index);
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////////////// GLOBAL VARIABLES ///////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static const struct file_source_pattern_s gPatterns[] = {
+    { "bars",  PATTERN_TYPE_BARS  },
+    { "noise", PATTERN_TYPE_NOISE }
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ * \fn enum v4l2_error_e FileSource_Init(struct v4l2_s **obj)
+ * \brief Create an instance of V4l2 module reading frames from a file
+ * \param[in, out] obj
+ * \return V4L2_ERROR_NONE on success
+ * \return V4L2_ERROR_MEMORY on error
+ */
+enum v4l2_error_e FileSource_Init(struct v4l2_s **obj)
+{
+    ASSERT(obj && (*obj = calloc(1, sizeof(struct v4l2_s))));
+
+    struct file_source_private_data_s *pData;
+    ASSERT((pData = calloc(1, sizeof(struct file_source_private_data_s))));
+
+    if (pthread_mutex_init(&pData->lock, NULL) != 0) {
+        Loge("pthread_mutex_init() failed");
+        free(pData);
+        free(*obj);
+        *obj = NULL;
+        return V4L2_ERROR_MEMORY;
+    }
+
+    pData->fileFd = -1;
+
+    (*obj)->openDevice       = openDevice_f;
+    (*obj)->closeDevice      = closeDevice_f;
+
+    (*obj)->configureDevice  = configureDevice_f;
+    (*obj)->setCroppingArea  = setCroppingArea_f;
+    (*obj)->setComposingArea = setComposingArea_f;
+
+    (*obj)->requestBuffers   = requestBuffers_f;
+    (*obj)->releaseBuffers   = releaseBuffers_f;
+
+    (*obj)->startCapture     = startCapture_f;
+    (*obj)->stopCapture      = stopCapture_f;
+
+    (*obj)->awaitData        = awaitData_f;
+    (*obj)->stopAwaitingData = stopAwaitingData_f;
+
+    (*obj)->queueBuffer      = queueBuffer_f;
+    (*obj)->dequeueBuffer    = dequeueBuffer_f;
+
+    (*obj)->disconnectDevice = disconnectDevice_f;
+    (*obj)->reconnectDevice  = reconnectDevice_f;
+
+    (*obj)->deviceFd                = -1;
+    (*obj)->quitFd[V4L2_PIPE_READ]  = -1;
+    (*obj)->quitFd[V4L2_PIPE_WRITE] = -1;
+
+    (*obj)->pData = pData;
+
+    return V4L2_ERROR_NONE;
+}
+
+/*!
+ * \fn enum v4l2_error_e FileSource_UnInit(struct v4l2_s **obj)
+ * \brief Destroy object created using FileSource_Init()
+ * \param[in, out] obj
+ * \return V4L2_ERROR_NONE on success
+ */
+enum v4l2_error_e FileSource_UnInit(struct v4l2_s **obj)
+{
+    ASSERT(obj && *obj && (*obj)->pData);
+
+    struct file_source_private_data_s *pData = (*obj)->pData;
+
+    (void)pthread_mutex_destroy(&pData->lock);
+
+    free(pData);
+    free(*obj);
+    *obj = NULL;
+
+    return V4L2_ERROR_NONE;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////// PUBLIC FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ * \fn static enum v4l2_error_e openDevice_f(struct v4l2_s *obj,
+ *                                           struct v4l2_open_device_params_s *params)
+ * \brief Map file to replay in memory or create pattern generator
+ * \param[in] obj
+ * \param[in] params
+ * \return V4L2_ERROR_NONE on success
+ * \return V4L2_ERROR_UNKNOWN_DEVICE, V4L2_ERROR_IO or V4L2_ERROR_BAD_CAPS on error
+ */
+static enum v4l2_error_e openDevice_f(struct v4l2_s *obj,
+                                      struct v4l2_open_device_params_s *params)
+{
+    ASSERT(obj && obj->pData && params);
+
+    struct file_source_private_data_s *pData = obj->pData;
+    enum v4l2_error_e ret                    = V4L2_ERROR_NONE;
+
+    if (strncmp(params->path, PATTERN_SOURCE_SCHEME, strlen(PATTERN_SOURCE_SCHEME)) == 0) {
+        ret = openPattern_f(pData, params->path + strlen(PATTERN_SOURCE_SCHEME));
+    }
+    else if (strncmp(params->path, FILE_SOURCE_SCHEME, strlen(FILE_SOURCE_SCHEME)) == 0) {
+        ret = openFile_f(pData, params->path + strlen(FILE_SOURCE_SCHEME));
+    }
+    else {
+        ret = openFile_f(pData, params->path);
+    }
+
+    if (ret != V4L2_ERROR_NONE) {
+        return ret;
+    }
+
+    if (pipe(obj->quitFd) < 0) {
+        Loge("Failed to create pipe - %s", strerror(errno));
+        ret = V4L2_ERROR_IO;
+        goto pipe_exit;
+    }
+
+    snprintf((char*)obj->caps.driver, sizeof(obj->caps.driver), "%s", FILE_SOURCE_DRIVER_NAME);
+    obj->caps.capabilities = V4L2_CAP_VIDEO_CAPTURE | V4L2_CAP_STREAMING;
+    obj->caps.device_caps  = obj->caps.capabilities;
+
+    if (!(obj->caps.capabilities & params->caps)) {
+        Loge("Requested capapbilities not supported");
+        ret = V4L2_ERROR_BAD_CAPS;
+        goto caps_exit;
+    }
+
+    strncpy(obj->path, params->path, sizeof(obj->path));
+
+    return V4L2_ERROR_NONE;
+
+caps_exit:
+    close(obj->quitFd[V4L2_PIPE_READ]);
+    obj->quitFd[V4L2_PIPE_READ] = -1;
+    close(obj->quitFd[V4L2_PIPE_WRITE]);
+    obj->quitFd[V4L2_PIPE_WRITE] = -1;
+
+pipe_exit:
+    closeSource_f(pData);
+
+    return ret;
+}
+
+/*!
+ * \fn static enum v4l2_error_e closeDevice_f(struct v4l2_s *obj)
+ * \brief Unmap replayed file or destroy pattern generator
+ * \param[in] obj
+ * \return V4L2_ERROR_NONE on success
+ */
+static enum v4l2_error_e closeDevice_f(struct v4l2_s *obj)
+{
+    ASSERT(obj && obj->pData);
+
+    struct file_source_private_data_s *pData = obj->pData;
+
+    if (obj->deviceFd != -1) {
+        close(obj->deviceFd);
+        obj->deviceFd = -1;
+    }
+
+    if (obj->quitFd[V4L2_PIPE_READ] != -1) {
+        close(obj->quitFd[V4L2_PIPE_READ]);
+        close(obj->quitFd[V4L2_PIPE_WRITE]);
+        obj->quitFd[V4L2_PIPE_READ]  = -1;
+        obj->quitFd[V4L2_PIPE_WRITE] = -1;
+    }
+
+    closeSource_f(pData);
+
+    return V4L2_ERROR_NONE;
+}
+
+/*!
+ * \fn static enum v4l2_error_e configureDevice_f(struct v4l2_s *obj,
+ *                                                struct v4l2_configure_device_params_s *params)
+ * \brief Split file into frames, or prepare pattern generation, and create the fd signaling
+ *        when the next frame is due
+ * \param[in] obj
+ * \param[in] params
+ * \return V4L2_ERROR_NONE on success
+ * \return V4L2_ERROR_BAD_CAPS or V4L2_ERROR_IO on error
+ */
+static enum v4l2_error_e configureDevice_f(struct v4l2_s *obj,
+                                           struct v4l2_configure_device_params_s *params)
+{
+    ASSERT(obj && obj->pData && params);
+
+    struct file_source_private_data_s *pData = obj->pData;
+    enum v4l2_error_e ret                    = V4L2_ERROR_NONE;
+    uint32_t width                           = params->width;
+    uint32_t height                          = params->height;
+    uint32_t bytesPerLine                    = 0;
+    size_t frameSize                         = 0;
+
+    ASSERT(pData->data || pData->pattern);
+
+    /* Called again when the selection API is not supported */
+    free(pData->frames);
+    pData->frames    = NULL;
+    pData->nbFrames  = 0;
+    pData->nextFrame = 0;
+
+    if (obj->deviceFd != -1) {
+        close(obj->deviceFd);
+        obj->deviceFd = -1;
+    }
+
+    if (pData->pattern) {
+        if ((ret = configurePattern_f(pData, params, &width, &bytesPerLine,
+                                      &frameSize)) != V4L2_ERROR_NONE) {
+            goto exit;
+        }
+    }
+    else if (isCompressed_f(params->pixelformat)) {
+        if ((ret = indexJpegFrames_f(pData)) != V4L2_ERROR_NONE) {
+            goto exit;
+        }
+
+        struct file_source_frame_s *first = &pData->frames[0];
+
+        if (!getJpegSize_f(pData->data + first->offset, first->size, &width, &height)) {
+            Logw("Size of JPEG frames not found - Using %ux%u", width, height);
+        }
+
+        frameSize = pData->maxFrameSize;
+    }
+    else {
+        if (!getRawFrameLayout_f(params->pixelformat, width, height,
+                                 &bytesPerLine, &frameSize)) {
+            Loge("Pixel format 0x%08x cannot be replayed", params->pixelformat);
+            ret = V4L2_ERROR_BAD_CAPS;
+            goto exit;
+        }
+
+        if ((ret = indexRawFrames_f(pData, frameSize)) != V4L2_ERROR_NONE) {
+            goto exit;
+        }
+    }
+
+    /* Buffers are always single-planar */
+    memset(&obj->format, 0, sizeof(struct v4l2_format));
+    obj->format.type                 = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    obj->format.fmt.pix.width        = width;
+    obj->format.fmt.pix.height       = height;
+    obj->format.fmt.pix.pixelformat  = params->pixelformat;
+    obj->format.fmt.pix.colorspace   = params->colorspace;
+    obj->format.fmt.pix.field        = V4L2_FIELD_NONE;
+    obj->format.fmt.pix.bytesperline = bytesPerLine;
+    obj->format.fmt.pix.sizeimage    = (uint32_t)frameSize;
+
+    obj->isMplane = 0;
+    obj->width    = width;
+    obj->height   = height;
+
+    /* A timer paces frames. Otherwise, a frame is ready as soon as a buffer is queued */
+    pData->fps = params->desiredFps;
+
+    if (pData->fps > 0) {
+        obj->deviceFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    }
+    else {
+        obj->deviceFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC | EFD_SEMAPHORE);
+    }
+
+    if (obj->deviceFd < 0) {
+        Loge("Failed to create %s - %s", (pData->fps > 0 ? "timerfd" : "eventfd"),
+                                          strerror(errno));
+        ret = V4L2_ERROR_IO;
+        goto exit;
+    }
+
+    if (pData->pattern) {
+        Logd("Pattern of %ux%u - %u fps%s", width, height, pData->fps,
+                (pData->fps > 0 ? "" : " (As fast as possible)"));
+    }
+    else {
+        Logd("%u frame(s) of %ux%u - %u fps%s", pData->nbFrames, width, height, pData->fps,
+                (pData->fps > 0 ? "" : " (As fast as possible)"));
+    }
+
+exit:
+    return ret;
+}
+
+/*!
+ * \fn static enum v4l2_error_e setCroppingArea_f(struct v4l2_s *obj,
+ *                                                struct v4l2_selection_params_s *cropRectInOut)
+ * \brief Frames are replayed as is so the cropping area is always the full frame
+ * \param[in] obj
+ * \param[in, out] cropRectInOut
+ * \return V4L2_ERROR_NONE
+ */
+static enum v4l2_error_e setCroppingArea_f(struct v4l2_s *obj,
+                                           struct v4l2_selection_params_s *cropRectInOut)
+{
+    ASSERT(obj && cropRectInOut);
+
+    cropRectInOut->left   = 0;
+    cropRectInOut->top    = 0;
+    cropRectInOut->width  = obj->width;
+    cropRectInOut->height = obj->height;
+
+    return V4L2_ERROR_NONE;
+}
+
+/*!
+ * \fn static enum v4l2_error_e setComposingArea_f(struct v4l2_s *obj,
+ *                                                 struct v4l2_selection_params_s *composeRectInOut)
+ * \brief Frames are replayed as is so the composing area is always the full frame
+ * \param[in] obj
+ * \param[in, out] composeRectInOut
+ * \return V4L2_ERROR_NONE
+ */
+static enum v4l2_error_e setComposingArea_f(struct v4l2_s *obj,
+                                            struct v4l2_selection_params_s *composeRectInOut)
+{
+    ASSERT(obj && composeRectInOut);
+
+    composeRectInOut->left   = 0;
+    composeRectInOut->top    = 0;
+    composeRectInOut->width  = obj->width;
+    composeRectInOut->height = obj->height;
+
+    return V4L2_ERROR_NONE;
+}
+
+/*!
+ * \fn static enum v4l2_error_e requestBuffers_f(struct v4l2_s *obj,
+ *                                               struct v4l2_request_buffers_params_s *params)
+ * \brief Allocate buffers large enough for the biggest frame of the file
+ * \param[in] obj
+ * \param[in] params
+ * \return V4L2_ERROR_NONE on success
+ * \return V4L2_ERROR_MEMORY on error
+ */
+static enum v4l2_error_e requestBuffers_f(struct v4l2_s *obj,
+                                          struct v4l2_request_buffers_params_s *params)
+{
+    ASSERT(obj && obj->pData && (obj->deviceFd != -1) && params);
+
+    struct file_source_private_data_s *pData = obj->pData;
+
+    if (params->count == 0) {
+        Loge("At least one buffer is required");
+        return V4L2_ERROR_MEMORY;
+    }
+
+    /* No dma-buf here, whatever the requested memory is */
+    obj->memory        = params->memory;
+    obj->nbBuffers     = params->count;
+    obj->maxBufferSize = obj->format.fmt.pix.sizeimage;
+
+    ASSERT((obj->map = calloc(obj->nbBuffers, sizeof(struct v4l2_mapping_buffer_s))));
+    ASSERT((pData->queue = calloc(obj->nbBuffers, sizeof(uint32_t))));
+
+    uint32_t i, p;
+    for (i = 0; i < obj->nbBuffers; i++) {
+        for (p = 0; p < VIDEO_MAX_PLANES; p++) {
+            obj->map[i].planes[p].dmabufFd = -1;
+        }
+
+        obj->map[i].index            = i;
+        obj->map[i].nbPlanes         = 1;
+        obj->map[i].planes[0].length = obj->maxBufferSize;
+        ASSERT((obj->map[i].planes[0].start = calloc(1, obj->maxBufferSize)));
+    }
+
+    pData->queueHead = 0;
+    pData->nbQueued  = 0;
+
+    return V4L2_ERROR_NONE;
+}
+
+/*!
+ * \fn static enum v4l2_error_e releaseBuffers_f(struct v4l2_s *obj)
+ * \brief Release allocated buffers
+ * \param[in] obj
+ * \return V4L2_ERROR_NONE on success
+ */
+static enum v4l2_error_e releaseBuffers_f(struct v4l2_s *obj)
+{
+    ASSERT(obj && obj->pData);
+
+    struct file_source_private_data_s *pData = obj->pData;
+
+    if (obj->map) {
+        uint32_t i;
+        for (i = 0; i < obj->nbBuffers; i++) {
+            free(obj->map[i].planes[0].start);
+        }
+
+        free(obj->map);
+        obj->map = NULL;
+    }
+
+    free(pData->queue);
+    pData->queue    = NULL;
+    pData->nbQueued = 0;
+
+    obj->nbBuffers = 0;
+
+    return V4L2_ERROR_NONE;
+}
+
+/*!
+ * \fn static enum v4l2_error_e startCapture_f(struct v4l2_s *obj)
+ * \brief Start replaying file
+ * \param[in] obj
+ * \return V4L2_ERROR_NONE on success
+ * \return V4L2_ERROR_CAPTURE on error
+ */
+static enum v4l2_error_e startCapture_f(struct v4l2_s *obj)
+{
+    ASSERT(obj && obj->pData && (obj->deviceFd != -1));
+
+    struct file_source_private_data_s *pData = obj->pData;
+
+    if (pData->fps > 0) {
+        struct itimerspec period;
+        memset(&period, 0, sizeof(struct itimerspec));
+        period.it_interval.tv_sec  = (pData->fps == 1 ? 1 : 0);
+        period.it_interval.tv_nsec = (pData->fps == 1 ? 0 : 1000000000L / pData->fps);
+        period.it_value            = period.it_interval;
+
+        if (timerfd_settime(obj->deviceFd, 0, &period, NULL) < 0) {
+            Loge("timerfd_settime() failed - %s", strerror(errno));
+            return V4L2_ERROR_CAPTURE;
+        }
+    }
+
+    (void)pthread_mutex_lock(&pData->lock);
+    pData->isStreaming = 1;
+    pData->sequence    = 0;
+    (void)pthread_mutex_unlock(&pData->lock);
+
+    return V4L2_ERROR_NONE;
+}
+
+/*!
+ * \fn static enum v4l2_error_e stopCapture_f(struct v4l2_s *obj)
+ * \brief Stop replaying file. As with STREAMOFF, all queued buffers are dequeued
+ * \param[in] obj
+ * \return V4L2_ERROR_NONE on success
+ * \return V4L2_ERROR_CAPTURE on error
+ */
+static enum v4l2_error_e stopCapture_f(struct v4l2_s *obj)
+{
+    ASSERT(obj && obj->pData && (obj->deviceFd != -1));
+
+    struct file_source_private_data_s *pData = obj->pData;
+    enum v4l2_error_e ret                    = V4L2_ERROR_NONE;
+
+    if (pData->fps > 0) {
+        struct itimerspec disarm;
+        memset(&disarm, 0, sizeof(struct itimerspec));
+
+        if (timerfd_settime(obj->deviceFd, 0, &disarm, NULL) < 0) {
+            Loge("timerfd_settime() failed - %s", strerror(errno));
+            ret = V4L2_ERROR_CAPTURE;
+        }
+    }
+
+    (void)pthread_mutex_lock(&pData->lock);
+    pData->isStreaming = 0;
+    flushQueue_f(obj);
+    (void)pthread_mutex_unlock(&pData->lock);
+
+    return ret;
+}
+
+/*!
+ * \fn static enum v4l2_error_e awaitData_f(struct v4l2_s *obj, int32_t timeout_ms)
+ * \brief Wait until the next frame is due
+ * \param[in] obj
+ * \param[in] timeout_ms : Time in ms to wait before returning / -1 => not used
+ * \return V4L2_ERROR_NONE on success
+ * \return V4L2_ERROR_TIMEOUT on timeout
+ */
+static enum v4l2_error_e awaitData_f(struct v4l2_s *obj, int32_t timeout_ms)
+{
+    ASSERT(obj && (obj->deviceFd != -1));
+
+    int32_t selectRetval;
+    int32_t maxFd;
+    fd_set fds;
+    struct timeval timeout = {0};
+    struct timeval *tv     = NULL;
+
+    FD_ZERO(&fds);
+    FD_SET(obj->deviceFd, &fds);
+    FD_SET(obj->quitFd[V4L2_PIPE_READ], &fds);
+
+    maxFd = (obj->deviceFd > obj->quitFd[V4L2_PIPE_READ] ? obj->deviceFd : obj->quitFd[V4L2_PIPE_READ]);
+
+    if (timeout_ms > 0) {
+        timeout.tv_sec  = timeout_ms / 1000;
+        timeout.tv_usec = (timeout_ms % 1000) * 1000;
+        tv              = &timeout;
+    }
+
+    selectRetval = select(maxFd + 1, &fds, NULL, NULL, tv);
+
+    if (selectRetval == 0) { /* Timeout */
+        return V4L2_ERROR_TIMEOUT;
+    }
+
+    return V4L2_ERROR_NONE;
+}
+
+/*!
+ * \fn static enum v4l2_error_e stopAwaitingData_f(struct v4l2_s *obj)
+ * \brief Avoid deadlock in awaitData()
+ * \param[in] obj
+ * \return V4L2_ERROR_NONE on success
+ * \return V4L2_ERROR_IO on error
+ */
+static enum v4l2_error_e stopAwaitingData_f(struct v4l2_s *obj)
+{
+    ASSERT(obj && (obj->quitFd[V4L2_PIPE_WRITE] != -1));
+
+    if (write(obj->quitFd[V4L2_PIPE_WRITE], "\n", 1) < 0) {
+        Loge("Writing to pipe failed - %s", strerror(errno));
+        return V4L2_ERROR_IO;
+    }
+
+    return V4L2_ERROR_NONE;
+}
+
+/*!
+ * \fn static enum v4l2_error_e queueBuffer_f(struct v4l2_s *obj, uint32_t index)
+ * \brief Give buffer back so that it can be filled with a next frame
+ * \param[in] obj
+ * \param[in] index
+ * \return V4L2_ERROR_NONE on success
+ * \return V4L2_ERROR_IO on error
+ */
+static enum v4l2_error_e queueBuffer_f(struct v4l2_s *obj, uint32_t index)
+{
+    ASSERT(obj && obj->pData && (obj->deviceFd != -1));
+
+    struct file_source_private_data_s *pData = obj->pData;
+    enum v4l2_error_e ret                    = V4L2_ERROR_NONE;
+    uint64_t one                             = 1;
+
+    if (index >= obj->nbBuffers) {
+        Loge("Bad index %u", index);
+        return V4L2_ERROR_IO;
+    }
+
+    (void)pthread_mutex_lock(&pData->lock);
+
+    ASSERT(pData->nbQueued < obj->nbBuffers);
+    pData->queue[(pData->queueHead + pData->nbQueued) % obj->nbBuffers] = index;
+    pData->nbQueued++;
+
+    if ((pData->fps == 0) && (write(obj->deviceFd, &one, sizeof(one)) < 0)) {
+        Loge("Failed to signal buffer %u - %s", index, strerror(errno));
+        pData->nbQueued--;
+        ret = V4L2_ERROR_IO;
+    }
+
+    (void)pthread_mutex_unlock(&pData->lock);
+
+    return ret;
+}
+
+/*!
+ * \fn static enum v4l2_error_e dequeueBuffer_f(struct v4l2_s *obj,
+ *                                              struct v4l2_dequeued_buffer_s *bufferOut)
+ * \brief Fill the oldest queued buffer with the next frame of the file or of the pattern
+ * \param[in] obj
+ * \param[out] bufferOut : Index in obj->map of the filled buffer, size of the frame, timestamp
+ *                         and sequence number
+ * \return V4L2_ERROR_NONE on success
+ * \return V4L2_ERROR_IO if no frame is due or no buffer is queued
+ */
+static enum v4l2_error_e dequeueBuffer_f(struct v4l2_s *obj,
+                                         struct v4l2_dequeued_buffer_s *bufferOut)
+{
+    ASSERT(obj && obj->pData && (obj->deviceFd != -1) && bufferOut);
+
+    struct file_source_private_data_s *pData = obj->pData;
+    enum v4l2_error_e ret                    = V4L2_ERROR_NONE;
+    uint64_t nbExpirations                   = 0;
+
+    (void)pthread_mutex_lock(&pData->lock);
+
+    if (!pData->isStreaming) {
+        ret = V4L2_ERROR_CAPTURE;
+        goto exit;
+    }
+
+    if (read(obj->deviceFd, &nbExpirations, sizeof(nbExpirations)) != sizeof(nbExpirations)) {
+        ret = V4L2_ERROR_IO;
+        goto exit;
+    }
+
+    /* Ticks missed while no buffer was queued are frames lost as with a real device */
+    if (pData->nbQueued == 0) {
+        pData->sequence += (uint32_t)nbExpirations;
+        ret = V4L2_ERROR_IO;
+        goto exit;
+    }
+
+    pData->sequence += (uint32_t)nbExpirations - 1;
+
+    uint32_t index                     = pData->queue[pData->queueHead];
+    struct v4l2_mapping_plane_s *plane = &obj->map[index].planes[0];
+    struct file_source_frame_s *frame  = NULL;
+    struct pattern_stamp_s stamp;
+    struct timespec now;
+
+    pData->queueHead = (pData->queueHead + 1) % obj->nbBuffers;
+    pData->nbQueued--;
+
+    stamp.counter = pData->sequence++;
+
+    if (!pData->pattern) {
+        frame            = &pData->frames[pData->nextFrame];
+        pData->nextFrame = (pData->nextFrame + 1) % pData->nbFrames;
+    }
+
+    /* The buffer is owned until it is queued again so no need to block queueBuffer() */
+    (void)pthread_mutex_unlock(&pData->lock);
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    stamp.timestamp_us = (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+
+    if (frame) {
+        memcpy(plane->start, pData->data + frame->offset, frame->size);
+        bufferOut->bytesused[0] = frame->size;
+    }
+    else if (generateFrame_f(obj, plane, &stamp, &bufferOut->bytesused[0]) != V4L2_ERROR_NONE) {
+        requeue_f(obj, index);
+        return V4L2_ERROR_IO;
+    }
+
+    bufferOut->index             = index;
+    bufferOut->timestamp.tv_sec  = now.tv_sec;
+    bufferOut->timestamp.tv_usec = now.tv_nsec / 1000;
+    bufferOut->isMonotonic       = 1;
+    bufferOut->sequence          = stamp.counter;
+
+    return V4L2_ERROR_NONE;
+
+exit:
+    (void)pthread_mutex_unlock(&pData->lock);
+
+    return ret;
+}
+
+/*!
+ * \fn static enum v4l2_error_e disconnectDevice_f(struct v4l2_s *obj)
+ * \brief Files and patterns never go away
+ * \param[in] obj
+ * \return V4L2_ERROR_NONE
+ */
+static enum v4l2_error_e disconnectDevice_f(struct v4l2_s *obj)
+{
+    ASSERT(obj);
+
+    return V4L2_ERROR_NONE;
+}
+
+/*!
+ * \fn static enum v4l2_error_e reconnectDevice_f(struct v4l2_s *obj)
+ * \brief Files and patterns never go away
+ * \param[in] obj
+ * \return V4L2_ERROR_UNKNOWN_DEVICE
+ */
+static enum v4l2_error_e reconnectDevice_f(struct v4l2_s *obj)
+{
+    ASSERT(obj);
+
+    Loge("\"%s\" cannot be reconnected", obj->path);
+
+    return V4L2_ERROR_UNKNOWN_DEVICE;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////// PRIVATE FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+static enum v4l2_error_e openFile_f(struct file_source_private_data_s *pData, const char *path)
+{
+    ASSERT(pData && path);
+
+    struct stat st;
+
+    if ((pData->fileFd = open(path, O_RDONLY | O_CLOEXEC)) < 0) {
+        Loge("Failed to open \"%s\" - %s", path, strerror(errno));
+        return V4L2_ERROR_UNKNOWN_DEVICE;
+    }
+
+    if ((fstat(pData->fileFd, &st) < 0) || (st.st_size <= 0)) {
+        Loge("\"%s\" is empty or cannot be read", path);
+        goto exit;
+    }
+
+    pData->size = (size_t)st.st_size;
+    pData->data = mmap(NULL, pData->size, PROT_READ, MAP_PRIVATE, pData->fileFd, 0);
+
+    if (pData->data == MAP_FAILED) {
+        Loge("mmap() failed - %s", strerror(errno));
+        pData->data = NULL;
+        goto exit;
+    }
+
+    (void)madvise(pData->data, pData->size, MADV_SEQUENTIAL);
+
+    Logd("Replaying \"%s\" (%lu bytes)", path, pData->size);
+
+    return V4L2_ERROR_NONE;
+
+exit:
+    close(pData->fileFd);
+    pData->fileFd = -1;
+
+    return V4L2_ERROR_IO;
+}
+
+/*!
+ *
+ */
+static enum v4l2_error_e openPattern_f(struct file_source_private_data_s *pData,
+                                       const char *name)
+{
+    ASSERT(pData && name);
+
+    uint32_t nbPatterns = (uint32_t)(sizeof(gPatterns) / sizeof(gPatterns[0]));
+    uint32_t i;
+
+    for (i = 0; (i < nbPatterns) && (strcmp(gPatterns[i].name, name) != 0); i++);
+
+    if (i == nbPatterns) {
+        Loge("Unknown pattern \"%s\"", name);
+        return V4L2_ERROR_UNKNOWN_DEVICE;
+    }
+
+    if (Pattern_Init(&pData->pattern, gPatterns[i].type) != PATTERN_ERROR_NONE) {
+        Loge("Pattern_Init() failed");
+        return V4L2_ERROR_IO;
+    }
+
+    if (Converter_Init(&pData->converter, CONVERTER_KERNEL_AUTO) != CONVERTER_ERROR_NONE) {
+        Loge("Converter_Init() failed");
+        (void)Pattern_UnInit(&pData->pattern);
+        return V4L2_ERROR_IO;
+    }
+
+    Logd("Generating \"%s\" pattern", name);
+
+    return V4L2_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+static void closeSource_f(struct file_source_private_data_s *pData)
+{
+    ASSERT(pData);
+
+    free(pData->frames);
+    pData->frames   = NULL;
+    pData->nbFrames = 0;
+
+    if (pData->data) {
+        (void)munmap(pData->data, pData->size);
+        pData->data = NULL;
+    }
+
+    if (pData->fileFd != -1) {
+        close(pData->fileFd);
+        pData->fileFd = -1;
+    }
+
+    if (pData->encoder) {
+        (void)Encoder_UnInit(&pData->encoder);
+    }
+
+    free(pData->patternData);
+    pData->patternData = NULL;
+
+    if (pData->converter) {
+        (void)Converter_UnInit(&pData->converter);
+    }
+
+    if (pData->pattern) {
+        (void)Pattern_UnInit(&pData->pattern);
+    }
+}
+
+/*!
+ * MJPEG patterns are drawn in I420 then encoded. Other formats are drawn in place
+ */
+static enum v4l2_error_e configurePattern_f(struct file_source_private_data_s *pData,
+                                            struct v4l2_configure_device_params_s *params,
+                                            uint32_t *width, uint32_t *bytesPerLine,
+                                            size_t *frameSize)
+{
+    ASSERT(pData && pData->converter && params && width && bytesPerLine && frameSize);
+
+    struct converter_frame_s frame;
+    size_t size;
+
+    if (pData->encoder) {
+        (void)Encoder_UnInit(&pData->encoder);
+    }
+
+    free(pData->patternData);
+    pData->patternData = NULL;
+
+    switch (params->pixelformat) {
+        case V4L2_PIX_FMT_YUYV:
+            pData->patternFormat = CONVERTER_FORMAT_YUYV;
+            break;
+
+        case V4L2_PIX_FMT_YVYU:
+            pData->patternFormat = CONVERTER_FORMAT_YVYU;
+            break;
+
+        case V4L2_PIX_FMT_UYVY:
+            pData->patternFormat = CONVERTER_FORMAT_UYVY;
+            break;
+
+        case V4L2_PIX_FMT_NV12:
+        case V4L2_PIX_FMT_NV12M:
+            pData->patternFormat = CONVERTER_FORMAT_NV12;
+            break;
+
+        case V4L2_PIX_FMT_YUV420:
+        case V4L2_PIX_FMT_MJPEG:
+        case V4L2_PIX_FMT_JPEG:
+            pData->patternFormat = CONVERTER_FORMAT_I420;
+            break;
+
+        case V4L2_PIX_FMT_RGB24:
+            pData->patternFormat = CONVERTER_FORMAT_RGB24;
+            break;
+
+        default:
+            Loge("Pixel format 0x%08x cannot be generated", params->pixelformat);
+            return V4L2_ERROR_BAD_CAPS;
+    }
+
+    /* Chroma is shared by pairs of pixels */
+    *width = params->width & ~1U;
+
+    /* Only strides of the frame are needed here, data is never accessed */
+    if ((pData->converter->getFrameSize(pData->converter, pData->patternFormat, *width,
+                                        params->height, &size) != CONVERTER_ERROR_NONE)
+        || (pData->converter->setFrame(pData->converter, pData->patternFormat, *width,
+                                       params->height, (void*)pData, &frame)
+                                       != CONVERTER_ERROR_NONE)) {
+        Loge("Bad pattern size %ux%u", params->width, params->height);
+        return V4L2_ERROR_BAD_CAPS;
+    }
+
+    if (!isCompressed_f(params->pixelformat)) {
+        *bytesPerLine = frame.strides[0];
+        *frameSize    = size;
+        return V4L2_ERROR_NONE;
+    }
+
+    struct encoder_params_s encoderParams;
+    memset(&encoderParams, 0, sizeof(struct encoder_params_s));
+
+    strcpy(encoderParams.name, "pattern");
+    encoderParams.priority = PRIORITY_DEFAULT;
+    encoderParams.width    = *width;
+    encoderParams.height   = params->height;
+
+    if (Encoder_Init(&pData->encoder, &encoderParams) != ENCODER_ERROR_NONE) {
+        Loge("Encoder_Init() failed");
+        return V4L2_ERROR_BAD_CAPS;
+    }
+
+    ASSERT((pData->patternData = calloc(1, size)));
+
+    *bytesPerLine = 0;
+    *frameSize    = PATTERN_JPEG_MAX_SIZE(*width, params->height);
+
+    return V4L2_ERROR_NONE;
+}
+
+/*!
+ * Called without pData->lock held as buffers being filled cannot be touched by anyone else
+ */
+static enum v4l2_error_e generateFrame_f(struct v4l2_s *obj, struct v4l2_mapping_plane_s *plane,
+                                         struct pattern_stamp_s *stamp, size_t *bytesused)
+{
+    ASSERT(obj && obj->pData && plane && stamp && bytesused);
+
+    struct file_source_private_data_s *pData = obj->pData;
+    struct converter_frame_s frame;
+    struct buffer_s jpeg;
+
+    (void)pData->converter->setFrame(pData->converter, pData->patternFormat, obj->width,
+                                     obj->height,
+                                     (pData->encoder ? pData->patternData : plane->start),
+                                     &frame);
+
+    if (pData->pattern->generate(pData->pattern, &frame, stamp) != PATTERN_ERROR_NONE) {
+        Loge("Failed to generate frame %u", stamp->counter);
+        return V4L2_ERROR_IO;
+    }
+
+    if (!pData->encoder) {
+        *bytesused = obj->format.fmt.pix.sizeimage;
+        return V4L2_ERROR_NONE;
+    }
+
+    memset(&jpeg, 0, sizeof(struct buffer_s));
+
+    if (pData->encoder->encode(pData->encoder, &frame, &jpeg) != ENCODER_ERROR_NONE) {
+        Loge("Failed to encode frame %u", stamp->counter);
+        return V4L2_ERROR_IO;
+    }
+
+    if (jpeg.length > plane->length) {
+        Logw("Frame %u dropped - %lu bytes > %lu bytes", stamp->counter, jpeg.length,
+                                                          plane->length);
+        return V4L2_ERROR_IO;
+    }
+
+    memcpy(plane->start, jpeg.data, jpeg.length);
+    *bytesused = jpeg.length;
+
+    return V4L2_ERROR_NONE;
+}
+
+/*!
+ * Frames of variable size to be split on JPEG markers
+ */
+static uint8_t isCompressed_f(uint32_t pixelformat)
+{
+    return ((pixelformat == V4L2_PIX_FMT_MJPEG) || (pixelformat == V4L2_PIX_FMT_JPEG));
+}
+
+/*!
+ * Size of raw frames stored one after the other without padding. Returns 0 if not supported
+ */
+static uint8_t getRawFrameLayout_f(uint32_t pixelformat, uint32_t width, uint32_t height,
+                                   uint32_t *bytesPerLine, size_t *frameSize)
+{
+    ASSERT(bytesPerLine && frameSize);
+
+    size_t lumaSize = (size_t)width * height;
+
+    switch (pixelformat) {
+        case V4L2_PIX_FMT_YUYV:
+        case V4L2_PIX_FMT_YVYU:
+        case V4L2_PIX_FMT_UYVY:
+            *bytesPerLine = 2 * width;
+            *frameSize    = 2 * lumaSize;
+            break;
+
+        case V4L2_PIX_FMT_NV12:
+        case V4L2_PIX_FMT_NV12M:
+        case V4L2_PIX_FMT_YUV420:
+            *bytesPerLine = width;
+            *frameSize    = lumaSize + 2 * (((size_t)width + 1) / 2) * ((height + 1) / 2);
+            break;
+
+        case V4L2_PIX_FMT_NV16:
+        case V4L2_PIX_FMT_NV16M:
+            *bytesPerLine = width;
+            *frameSize    = 2 * lumaSize;
+            break;
+
+        case V4L2_PIX_FMT_RGB24:
+        case V4L2_PIX_FMT_BGR24:
+            *bytesPerLine = 3 * width;
+            *frameSize    = 3 * lumaSize;
+            break;
+
+        default:
+            return 0;
+    }
+
+    return (*frameSize > 0);
+}
+
+/*!
+ * Find each SOI ... EOI sequence. An EOI only ends a frame if followed by the end of the file
+ * or by the next SOI so that EOI of embedded thumbnails are skipped
+ */
+static enum v4l2_error_e indexJpegFrames_f(struct file_source_private_data_s *pData)
+{
+    ASSERT(pData && pData->data);
+
+    uint8_t *data = pData->data;
+    size_t size   = pData->size;
+    size_t start  = 0;
+    size_t i;
+
+    pData->maxFrameSize = 0;
+
+    while (start + 4 <= size) {
+        if ((data[start] != JPEG_MARKER) || (data[start + 1] != JPEG_SOI)) {
+            start++;
+            continue;
+        }
+
+        for (i = start + 2; i + 2 <= size; i++) {
+            if ((data[i] != JPEG_MARKER) || (data[i + 1] != JPEG_EOI)) {
+                continue;
+            }
+
+            if ((i + 2 == size)
+                || ((i + 4 <= size) && (data[i + 2] == JPEG_MARKER)
+                                    && (data[i + 3] == JPEG_SOI))) {
+                break;
+            }
+        }
+
+        if (i + 2 > size) {
+            Logw("Truncated frame ignored at offset %lu", start);
+            break;
+        }
+
+        addFrame_f(pData, start, i + 2 - start);
+        start = i + 2;
+    }
+
+    if (pData->nbFrames == 0) {
+        Loge("No JPEG frame found");
+        return V4L2_ERROR_IO;
+    }
+
+    return V4L2_ERROR_NONE;
+}
+
+/*!
+ * Trailing bytes not making a whole frame are ignored
+ */
+static enum v4l2_error_e indexRawFrames_f(struct file_source_private_data_s *pData,
+                                          size_t frameSize)
+{
+    ASSERT(pData && (frameSize > 0));
+
+    size_t offset;
+
+    pData->maxFrameSize = 0;
+
+    for (offset = 0; offset + frameSize <= pData->size; offset += frameSize) {
+        addFrame_f(pData, offset, frameSize);
+    }
+
+    if (pData->nbFrames == 0) {
+        Loge("File smaller than a frame of %lu bytes", frameSize);
+        return V4L2_ERROR_IO;
+    }
+
+    if (offset != pData->size) {
+        Logw("%lu trailing byte(s) ignored", pData->size - offset);
+    }
+
+    return V4L2_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+static void addFrame_f(struct file_source_private_data_s *pData, size_t offset, size_t size)
+{
+    ASSERT(pData);
+
+    /* Grow by powers of two */
+    if ((pData->nbFrames & (pData->nbFrames - 1)) == 0) {
+        size_t capacity = (pData->nbFrames > 0 ? 2 * (size_t)pData->nbFrames : 1);
+        ASSERT((pData->frames = realloc(pData->frames,
+                                        capacity * sizeof(struct file_source_frame_s))));
+    }
+
+    pData->frames[pData->nbFrames].offset = offset;
+    pData->frames[pData->nbFrames].size   = size;
+    pData->nbFrames++;
+
+    if (pData->maxFrameSize < size) {
+        pData->maxFrameSize = size;
+    }
+}
+
+/*!
+ * Read dimensions from the SOFn segment. Returns 0 if not found
+ */
+static uint8_t getJpegSize_f(uint8_t *data, size_t size, uint32_t *width, uint32_t *height)
+{
+    ASSERT(data && width && height);
+
+    size_t pos = 2;
+    uint8_t marker;
+
+    while (pos + 4 <= size) {
+        if (data[pos] != JPEG_MARKER) {
+            return 0;
+        }
+
+        marker = data[pos + 1];
+
+        if (marker == JPEG_MARKER) { /* Fill byte */
+            pos++;
+            continue;
+        }
+
+        if ((marker == JPEG_SOS) || (marker == JPEG_EOI)) {
+            return 0;
+        }
+
+        /* SOF0 - SOF15 except DHT, JPG and DAC */
+        if ((marker >= 0xC0) && (marker <= 0xCF)
+            && (marker != 0xC4) && (marker != 0xC8) && (marker != 0xCC)) {
+            if (pos + 9 > size) {
+                return 0;
+            }
+
+            *height = (uint32_t)((data[pos + 5] << 8) | data[pos + 6]);
+            *width  = (uint32_t)((data[pos + 7] << 8) | data[pos + 8]);
+
+            return ((*width > 0) && (*height > 0));
+        }
+
+        pos += 2 + (size_t)((data[pos + 2] << 8) | data[pos + 3]);
+    }
+
+    return 0;
+}
+
+/*!
+ * Called with pData->lock held
+ */
+static void flushQueue_f(struct v4l2_s *obj)
+{
+    ASSERT(obj && obj->pData);
+
+    struct file_source_private_data_s *pData = obj->pData;
+    uint64_t count;
+
+    pData->queueHead = 0;
+    pData->nbQueued  = 0;
+
+    if (pData->fps == 0) {
+        while (read(obj->deviceFd, &count, sizeof(count)) == sizeof(count)) {
+            /* One buffer per read() in semaphore mode */
+        }
+    }
+}
+
+/*!
+ * Give back a buffer that could not be filled as if it had never been dequeued
+ */
+static void requeue_f(struct v4l2_s *obj, uint32_t index)
+{
+    ASSERT(obj && obj->pData);
+
+    struct file_source_private_data_s *pData = obj->pData;
+    uint64_t one                             = 1;
+
+    (void)pthread_mutex_lock(&pData->lock);
+
+    if (pData->isStreaming && (pData->nbQueued < obj->nbBuffers)) {
+        pData->queueHead = (pData->queueHead + obj->nbBuffers - 1) % obj->nbBuffers;
+        pData->queue[pData->queueHead] = index;
+        pData->nbQueued++;
+
+        if ((pData->fps == 0) && (write(obj->deviceFd, &one, sizeof(one)) < 0)) {
+            Loge("Failed to signal buffer %u - %s", index, strerror(errno));
+        }
+    }
+
+    (void)pthread_mutex_unlock(&pData->lock);
+}
@@ -0,0 +1,1003 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file Recorder.c
+* \brief Write-behind recording of video frames to AVI or raw files
+* \author Boubacar DIENE
+*
+* Frames are copied by the capture side to large aligned buffers which are handed to a writer
+* task through a ring. A frame may span several buffers so that all of them but the last one of
+* a segment are completely filled, which keeps O_DIRECT writes aligned. When not enough buffers
+* are free for a frame, this one is dropped instead of waiting for the disk
+*/
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "utils/Log.h"
+#include "utils/Ring.h"
+#include "utils/Task.h"
+
+#include "video/Recorder.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#undef  TAG
+#define TAG "Recorder"
+
+#define WRITER_TASK_NAME     "rec"
+
+/* Alignment of buffers, of their size and of O_DIRECT writes */
+#define IO_ALIGNMENT         4096
+
+#define DEFAULT_FPS          25
+
+#define INDEX_INITIAL_SIZE   1024
+
+/* Directory followed by the segment's name */
+#define SEGMENT_PATH_SIZE    (2 * MAX_PATH_SIZE)
+
+/* Layout of the RIFF headers written before the first frame of an AVI segment */
+#define AVI_HEADER_SIZE      224
+#define AVI_HDRL_OFFSET      12
+#define AVI_STRL_OFFSET      88
+#define AVI_MOVI_OFFSET      212
+#define AVI_CHUNK_HEADER     8
+#define AVI_INDEX_ENTRY_SIZE 16
+
+#define AVIF_HASINDEX        0x10
+#define AVIIF_KEYFRAME       0x10
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+struct recorder_index_entry_s {
+    uint64_t offset; /* From the "movi" list for AVI, from the beginning of the file for raw */
+    uint32_t size;
+    uint64_t captureTime_us;
+};
+
+/* Created by the capture side, released by the writer task once its last buffer is written */
+struct recorder_segment_s {
+    char                          path[SEGMENT_PATH_SIZE];
+    uint32_t                      number;
+
+    uint64_t                      size; /* Headers included */
+    uint64_t                      firstCaptureTime_us;
+    uint64_t                      lastCaptureTime_us;
+    uint32_t                      nbDroppedFrames;
+
+    uint32_t                      nbEntries;
+    uint32_t                      maxEntries;
+    struct recorder_index_entry_s *entries;
+};
+
+struct recorder_buffer_s {
+    uint8_t                   *data;
+    size_t                    length;
+    struct recorder_segment_s *segment;
+    uint8_t                   isLast;  /* Segment can be indexed and closed once written */
+};
+
+struct recorder_private_data_s {
+    struct recorder_params_s  params;
+
+    struct recorder_buffer_s  *buffers;
+    struct ring_s             *freeRing;
+    struct ring_s             *fullRing;
+
+    /* Capture side */
+    struct recorder_buffer_s  *fill;
+    struct recorder_segment_s *segment;
+    uint32_t                  nbSegments;
+
+    /* Writer side */
+    struct task_s             *writerTask;
+    struct task_params_s      taskParams;
+    sem_t                     fullSem;
+    volatile uint8_t          quit;
+
+    int                       fd;
+    struct recorder_segment_s *writing;
+    uint8_t                   writeFailed;
+
+    pthread_mutex_t           statsLock;
+    struct recorder_stats_s   stats;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PUBLIC FUNCTIONS PROTOTYPES //////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static enum recorder_error_e record_f(struct recorder_s *obj, struct video_buffer_s *videoBuffer);
+static enum recorder_error_e getStats_f(struct recorder_s *obj, struct recorder_stats_s *stats);
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PRIVATE FUNCTIONS PROTOTYPES /////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static uint8_t needsRotation_f(struct recorder_private_data_s *pData, size_t chunkSize,
+                               uint64_t captureTime_us);
+static void openSegment_f(struct recorder_private_data_s *pData, uint64_t captureTime_us);
+static void closeSegment_f(struct recorder_private_data_s *pData);
+static void append_f(struct recorder_private_data_s *pData, const void *data, size_t size);
+static void addIndexEntry_f(struct recorder_segment_s *segment, uint64_t offset, uint32_t size,
+                            uint64_t captureTime_us);
+
+static void writerFct_f(struct task_params_s *params);
+static void writeBuffer_f(struct recorder_private_data_s *pData,
+                          struct recorder_buffer_s *buffer);
+static void openFile_f(struct recorder_private_data_s *pData, struct recorder_segment_s *segment);
+static void finishSegment_f(struct recorder_private_data_s *pData);
+static uint8_t writeAviIndex_f(struct recorder_private_data_s *pData,
+                               struct recorder_segment_s *segment);
+static uint8_t writeRawIndex_f(struct recorder_segment_s *segment);
+static void disableDirectIo_f(struct recorder_private_data_s *pData);
+
+static void buildAviHeader_f(struct recorder_params_s *params,
+                             struct recorder_segment_s *segment, uint8_t *header);
+static void getAviFormat_f(uint32_t pixelformat, uint32_t *compression, uint16_t *bitCount);
+static void put16_f(uint8_t *dst, uint16_t value);
+static void put32_f(uint8_t *dst, uint32_t value);
+static void putFourcc_f(uint8_t *dst, const char *fourcc);
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+enum recorder_error_e Recorder_Init(struct recorder_s **obj, struct recorder_params_s *params)
+{
+    ASSERT(obj && params);
+
+    struct stat st;
+
+    if ((params->width == 0) || (params->height == 0) || (params->directory[0] == '\0')) {
+        Loge("Bad params");
+        return RECORDER_ERROR_PARAMS;
+    }
+
+    if ((mkdir(params->directory, 0755) < 0) && (errno != EEXIST)) {
+        Loge("Failed to create \"%s\" - %s", params->directory, strerror(errno));
+        return RECORDER_ERROR_PARAMS;
+    }
+
+    if ((stat(params->directory, &st) < 0) || !S_ISDIR(st.st_mode)
+        || (access(params->directory, W_OK) < 0)) {
+        Loge("\"%s\" is not a writable directory", params->directory);
+        return RECORDER_ERROR_PARAMS;
+    }
+
+    ASSERT((*obj = calloc(1, sizeof(struct recorder_s))));
+
+    struct recorder_private_data_s *pData;
+    ASSERT((pData = calloc(1, sizeof(struct recorder_private_data_s))));
+
+    pData->params = *params;
+    pData->fd     = -1;
+
+    if ((pData->params.maxSegmentSize == 0)
+        || (pData->params.maxSegmentSize > RECORDER_MAX_SEGMENT_SIZE)) {
+        pData->params.maxSegmentSize = RECORDER_MAX_SEGMENT_SIZE;
+    }
+
+    if (pData->params.bufferSize == 0) {
+        pData->params.bufferSize = RECORDER_DEFAULT_BUFFER_SIZE;
+    }
+    pData->params.bufferSize = (pData->params.bufferSize + IO_ALIGNMENT - 1)
+                               & ~(size_t)(IO_ALIGNMENT - 1);
+
+    if (pData->params.nbBuffers == 0) {
+        pData->params.nbBuffers = RECORDER_DEFAULT_NB_BUFFERS;
+    }
+
+    if (pData->params.fps == 0) {
+        pData->params.fps = DEFAULT_FPS;
+    }
+
+    if ((Ring_Init(&pData->freeRing, pData->params.nbBuffers) != RING_ERROR_NONE)
+        || (Ring_Init(&pData->fullRing, pData->params.nbBuffers) != RING_ERROR_NONE)) {
+        Loge("Ring_Init() failed");
+        goto ring_exit;
+    }
+
+    ASSERT((pData->buffers = calloc(pData->params.nbBuffers, sizeof(struct recorder_buffer_s))));
+
+    uint32_t index;
+    for (index = 0; index < pData->params.nbBuffers; index++) {
+        if (posix_memalign((void**)&pData->buffers[index].data, IO_ALIGNMENT,
+                           pData->params.bufferSize) != 0) {
+            Loge("Failed to allocate %lu bytes", pData->params.bufferSize);
+            goto buffers_exit;
+        }
+        (void)pData->freeRing->push(pData->freeRing, &pData->buffers[index]);
+    }
+
+    if (pthread_mutex_init(&pData->statsLock, NULL) != 0) {
+        Loge("pthread_mutex_init() failed");
+        goto buffers_exit;
+    }
+
+    if (sem_init(&pData->fullSem, 0, 0) != 0) {
+        Loge("sem_init() failed");
+        goto sem_exit;
+    }
+
+    if (Task_Init(&pData->writerTask) != TASK_ERROR_NONE) {
+        Loge("Task_Init() failed");
+        goto task_exit;
+    }
+
+    struct task_params_s *taskParams = &pData->taskParams;
+
+    snprintf(taskParams->name, sizeof(taskParams->name), "%s-%.16s", WRITER_TASK_NAME,
+             params->name);
+    taskParams->priority = params->priority;
+    taskParams->fct      = writerFct_f;
+    taskParams->fctData  = pData;
+    taskParams->userData = NULL;
+    taskParams->atExit   = NULL;
+
+    if (pData->writerTask->create(pData->writerTask, taskParams) != TASK_ERROR_NONE) {
+        Loge("Failed to create writer task");
+        goto create_exit;
+    }
+
+    (void)pData->writerTask->start(pData->writerTask, taskParams);
+
+    Logd("%s : recording %ux%u frames to \"%s\" - %u buffers of %lu bytes%s", params->name,
+            params->width, params->height, params->directory, pData->params.nbBuffers,
+            pData->params.bufferSize, (params->directIo ? " (O_DIRECT)" : ""));
+
+    (*obj)->record   = record_f;
+    (*obj)->getStats = getStats_f;
+
+    (*obj)->pData = (void*)pData;
+
+    return RECORDER_ERROR_NONE;
+
+create_exit:
+    (void)Task_UnInit(&pData->writerTask);
+
+task_exit:
+    (void)sem_destroy(&pData->fullSem);
+
+sem_exit:
+    (void)pthread_mutex_destroy(&pData->statsLock);
+
+buffers_exit:
+    for (index = 0; index < pData->params.nbBuffers; index++) {
+        free(pData->buffers[index].data);
+    }
+    free(pData->buffers);
+
+ring_exit:
+    if (pData->fullRing) {
+        (void)Ring_UnInit(&pData->fullRing);
+    }
+
+    if (pData->freeRing) {
+        (void)Ring_UnInit(&pData->freeRing);
+    }
+
+    free(pData);
+    free(*obj);
+    *obj = NULL;
+
+    return RECORDER_ERROR_INIT;
+}
+
+/*!
+ *
+ */
+enum recorder_error_e Recorder_UnInit(struct recorder_s **obj)
+{
+    ASSERT(obj && *obj && (*obj)->pData);
+
+    struct recorder_private_data_s *pData = (struct recorder_private_data_s*)((*obj)->pData);
+
+    if (pData->segment) {
+        closeSegment_f(pData);
+    }
+
+    /* Pending buffers are written before the task leaves */
+    pData->quit = 1;
+    sem_post(&pData->fullSem);
+
+    (void)pData->writerTask->stop(pData->writerTask, &pData->taskParams);
+    (void)pData->writerTask->destroy(pData->writerTask, &pData->taskParams);
+    (void)Task_UnInit(&pData->writerTask);
+
+    if (pData->writing) {
+        finishSegment_f(pData);
+    }
+
+    (void)sem_destroy(&pData->fullSem);
+    (void)pthread_mutex_destroy(&pData->statsLock);
+
+    uint32_t index;
+    for (index = 0; index < pData->params.nbBuffers; index++) {
+        free(pData->buffers[index].data);
+    }
+    free(pData->buffers);
+
+    (void)Ring_UnInit(&pData->fullRing);
+    (void)Ring_UnInit(&pData->freeRing);
+
+    free(pData);
+    free(*obj);
+    *obj = NULL;
+
+    return RECORDER_ERROR_NONE;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////// PUBLIC FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+static enum recorder_error_e record_f(struct recorder_s *obj, struct video_buffer_s *videoBuffer)
+{
+    ASSERT(obj && obj->pData && videoBuffer);
+
+    struct recorder_private_data_s *pData = (struct recorder_private_data_s*)(obj->pData);
+    uint8_t isAvi                         = (pData->params.container == RECORDER_CONTAINER_AVI);
+    uint8_t chunkHeader[AVI_CHUNK_HEADER];
+    uint32_t nbPlanes, nbFree, index;
+    size_t frameSize, chunkSize, needed, available;
+
+    nbPlanes  = (videoBuffer->nbPlanes > 1 ? videoBuffer->nbPlanes : 0);
+    frameSize = (nbPlanes > 0 ? 0 : videoBuffer->length);
+
+    for (index = 0; index < nbPlanes; index++) {
+        frameSize += videoBuffer->planes[index].length;
+    }
+
+    if ((frameSize == 0) || (frameSize > UINT32_MAX - AVI_CHUNK_HEADER)) {
+        Loge("Bad frame size %lu", frameSize);
+        return RECORDER_ERROR_PARAMS;
+    }
+
+    /* AVI chunks are word aligned */
+    chunkSize = (isAvi ? AVI_CHUNK_HEADER + frameSize + (frameSize & 1) : frameSize);
+
+    if (pData->segment && needsRotation_f(pData, chunkSize, videoBuffer->captureTime_us)) {
+        closeSegment_f(pData);
+    }
+
+    (void)pData->freeRing->getNbElements(pData->freeRing, &nbFree);
+
+    needed    = chunkSize + ((!pData->segment && isAvi) ? AVI_HEADER_SIZE : 0);
+    available = (pData->fill ? pData->params.bufferSize - pData->fill->length : 0)
+                + nbFree * pData->params.bufferSize;
+
+    if (needed > available) {
+        if (pData->segment) {
+            pData->segment->nbDroppedFrames++;
+        }
+
+        (void)pthread_mutex_lock(&pData->statsLock);
+        pData->stats.nbDroppedFrames++;
+        (void)pthread_mutex_unlock(&pData->statsLock);
+
+        return RECORDER_ERROR_FULL;
+    }
+
+    if (!pData->segment) {
+        openSegment_f(pData, videoBuffer->captureTime_us);
+    }
+
+    /* AVI offsets point to the chunk header and are relative to the "movi" fourcc */
+    addIndexEntry_f(pData->segment,
+                    (isAvi ? pData->segment->size - AVI_MOVI_OFFSET - 8 : pData->segment->size),
+                    (uint32_t)frameSize, videoBuffer->captureTime_us);
+
+    if (isAvi) {
+        putFourcc_f(chunkHeader, "00dc");
+        put32_f(chunkHeader + 4, (uint32_t)frameSize);
+        append_f(pData, chunkHeader, sizeof(chunkHeader));
+    }
+
+    if (nbPlanes == 0) {
+        append_f(pData, videoBuffer->data, videoBuffer->length);
+    }
+
+    for (index = 0; index < nbPlanes; index++) {
+        append_f(pData, videoBuffer->planes[index].data, videoBuffer->planes[index].length);
+    }
+
+    if (isAvi && (frameSize & 1)) {
+        append_f(pData, "", 1);
+    }
+
+    pData->segment->lastCaptureTime_us = videoBuffer->captureTime_us;
+
+    (void)pthread_mutex_lock(&pData->statsLock);
+    pData->stats.nbRecordedFrames++;
+    (void)pthread_mutex_unlock(&pData->statsLock);
+
+    return RECORDER_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+static enum recorder_error_e getStats_f(struct recorder_s *obj, struct recorder_stats_s *stats)
+{
+    ASSERT(obj && obj->pData && stats);
+
+    struct recorder_private_data_s *pData = (struct recorder_private_data_s*)(obj->pData);
+
+    (void)pthread_mutex_lock(&pData->statsLock);
+    *stats = pData->stats;
+    (void)pthread_mutex_unlock(&pData->statsLock);
+
+    return RECORDER_ERROR_NONE;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////// PRIVATE FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ * A segment always holds at least one frame
+ */
+static uint8_t needsRotation_f(struct recorder_private_data_s *pData, size_t chunkSize,
+                               uint64_t captureTime_us)
+{
+    ASSERT(pData && pData->segment);
+
+    struct recorder_segment_s *segment = pData->segment;
+    uint64_t size                      = segment->size + chunkSize;
+
+    if (segment->nbEntries == 0) {
+        return 0;
+    }
+
+    if (pData->params.container == RECORDER_CONTAINER_AVI) {
+        size += AVI_CHUNK_HEADER + (uint64_t)(segment->nbEntries + 1) * AVI_INDEX_ENTRY_SIZE;
+    }
+
+    if (size > pData->params.maxSegmentSize) {
+        return 1;
+    }
+
+    return ((pData->params.maxSegmentDuration_s > 0)
+            && (captureTime_us >= segment->firstCaptureTime_us)
+            && (captureTime_us - segment->firstCaptureTime_us
+                                >= (uint64_t)pData->params.maxSegmentDuration_s * 1000000));
+}
+
+/*!
+ *
+ */
+static void openSegment_f(struct recorder_private_data_s *pData, uint64_t captureTime_us)
+{
+    ASSERT(pData && !pData->segment && !pData->fill);
+
+    struct recorder_segment_s *segment;
+    char date[sizeof("YYYYMMDD-HHMMSS")] = "";
+    time_t now                           = time(NULL);
+    struct tm tm;
+
+    ASSERT((segment = calloc(1, sizeof(struct recorder_segment_s))));
+    ASSERT((segment->entries = malloc(INDEX_INITIAL_SIZE * sizeof(struct recorder_index_entry_s))));
+
+    segment->maxEntries          = INDEX_INITIAL_SIZE;
+    segment->number              = pData->nbSegments++;
+    segment->firstCaptureTime_us = captureTime_us;
+
+    if (localtime_r(&now, &tm)) {
+        (void)strftime(date, sizeof(date), "%Y%m%d-%H%M%S", &tm);
+    }
+
+    snprintf(segment->path, sizeof(segment->path), "%s/%.64s-%s-%04u.%s",
+             pData->params.directory, pData->params.name, date, segment->number,
+             (pData->params.container == RECORDER_CONTAINER_AVI ? "avi" : "raw"));
+
+    pData->segment = segment;
+
+    if (pData->params.container == RECORDER_CONTAINER_AVI) {
+        uint8_t header[AVI_HEADER_SIZE];
+
+        buildAviHeader_f(&pData->params, segment, header);
+        append_f(pData, header, sizeof(header));
+    }
+
+    (void)pthread_mutex_lock(&pData->statsLock);
+    pData->stats.nbSegments++;
+    (void)pthread_mutex_unlock(&pData->statsLock);
+}
+
+/*!
+ * The segment is released by the writer task once written. If all its buffers have already been
+ * handed over, an empty one tells the writer that it can be closed. Without any free buffer, this
+ * is only done when the first buffer of the next segment is written
+ */
+static void closeSegment_f(struct recorder_private_data_s *pData)
+{
+    ASSERT(pData && pData->segment);
+
+    void *element;
+
+    if (!pData->fill && (pData->freeRing->pop(pData->freeRing, &element) == RING_ERROR_NONE)) {
+        pData->fill          = (struct recorder_buffer_s*)element;
+        pData->fill->length  = 0;
+        pData->fill->segment = pData->segment;
+    }
+
+    if (pData->fill) {
+        pData->fill->isLast = 1;
+
+        (void)pData->fullRing->push(pData->fullRing, pData->fill);
+        sem_post(&pData->fullSem);
+        pData->fill = NULL;
+    }
+
+    pData->segment = NULL;
+}
+
+/*!
+ * Caller has checked that enough buffers are free
+ */
+static void append_f(struct recorder_private_data_s *pData, const void *data, size_t size)
+{
+    ASSERT(pData && pData->segment && data);
+
+    const uint8_t *src = (const uint8_t*)data;
+    size_t chunk;
+    void *element;
+
+    pData->segment->size += size;
+
+    while (size > 0) {
+        if (!pData->fill) {
+            ASSERT(pData->freeRing->pop(pData->freeRing, &element) == RING_ERROR_NONE);
+
+            pData->fill          = (struct recorder_buffer_s*)element;
+            pData->fill->length  = 0;
+            pData->fill->segment = pData->segment;
+            pData->fill->isLast  = 0;
+        }
+
+        chunk = pData->params.bufferSize - pData->fill->length;
+        chunk = (chunk > size ? size : chunk);
+
+        memcpy(pData->fill->data + pData->fill->length, src, chunk);
+        pData->fill->length += chunk;
+        src                 += chunk;
+        size                -= chunk;
+
+        if (pData->fill->length == pData->params.bufferSize) {
+            (void)pData->fullRing->push(pData->fullRing, pData->fill);
+            sem_post(&pData->fullSem);
+            pData->fill = NULL;
+        }
+    }
+}
+
+/*!
+ *
+ */
+static void addIndexEntry_f(struct recorder_segment_s *segment, uint64_t offset, uint32_t size,
+                            uint64_t captureTime_us)
+{
+    ASSERT(segment);
+
+    if (segment->nbEntries == segment->maxEntries) {
+        segment->maxEntries *= 2;
+        ASSERT((segment->entries = realloc(segment->entries,
+                                           segment->maxEntries
+                                           * sizeof(struct recorder_index_entry_s))));
+    }
+
+    struct recorder_index_entry_s *entry = &segment->entries[segment->nbEntries++];
+
+    entry->offset         = offset;
+    entry->size           = size;
+    entry->captureTime_us = captureTime_us;
+}
+
+/*!
+ *
+ */
+static void writerFct_f(struct task_params_s *params)
+{
+    ASSERT(params && params->fctData);
+
+    struct recorder_private_data_s *pData = (struct recorder_private_data_s*)params->fctData;
+    void *element;
+
+    if (!pData->quit) {
+        sem_wait(&pData->fullSem);
+    }
+
+    while (pData->fullRing->pop(pData->fullRing, &element) == RING_ERROR_NONE) {
+        writeBuffer_f(pData, (struct recorder_buffer_s*)element);
+        (void)pData->freeRing->push(pData->freeRing, element);
+    }
+
+    if (pData->quit && pData->writing) {
+        finishSegment_f(pData);
+    }
+}
+
+/*!
+ * Only the last buffer of a segment can be partially filled
+ */
+static void writeBuffer_f(struct recorder_private_data_s *pData,
+                          struct recorder_buffer_s *buffer)
+{
+    ASSERT(pData && buffer && buffer->segment);
+
+    if (buffer->segment != pData->writing) {
+        if (pData->writing) {
+            finishSegment_f(pData);
+        }
+        openFile_f(pData, buffer->segment);
+    }
+
+    if (!pData->writeFailed && (buffer->length > 0)) {
+        if ((buffer->length % IO_ALIGNMENT) != 0) {
+            disableDirectIo_f(pData);
+        }
+
+        if (writeAll(pData->fd, buffer->data, buffer->length)) {
+            (void)pthread_mutex_lock(&pData->statsLock);
+            pData->stats.nbWrittenBytes += buffer->length;
+            (void)pthread_mutex_unlock(&pData->statsLock);
+        }
+        else {
+            Loge("Failed to write \"%s\" - %s", pData->writing->path, strerror(errno));
+            pData->writeFailed = 1;
+
+            (void)pthread_mutex_lock(&pData->statsLock);
+            pData->stats.nbWriteErrors++;
+            (void)pthread_mutex_unlock(&pData->statsLock);
+        }
+    }
+
+    if (buffer->isLast) {
+        finishSegment_f(pData);
+    }
+}
+
+/*!
+ *
+ */
+static void openFile_f(struct recorder_private_data_s *pData, struct recorder_segment_s *segment)
+{
+    ASSERT(pData && segment && (pData->fd == -1));
+
+    int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+
+    pData->writing     = segment;
+    pData->writeFailed = 0;
+
+    if (pData->params.directIo) {
+        pData->fd = open(segment->path, flags | O_DIRECT, 0644);
+
+        if ((pData->fd < 0) && (errno == EINVAL)) {
+            Logw("O_DIRECT not supported by \"%s\"", pData->params.directory);
+            pData->params.directIo = 0;
+        }
+    }
+
+    if (!pData->params.directIo) {
+        pData->fd = open(segment->path, flags, 0644);
+    }
+
+    if (pData->fd < 0) {
+        Loge("Failed to create \"%s\" - %s", segment->path, strerror(errno));
+        pData->writeFailed = 1;
+
+        (void)pthread_mutex_lock(&pData->statsLock);
+        pData->stats.nbWriteErrors++;
+        (void)pthread_mutex_unlock(&pData->statsLock);
+        return;
+    }
+
+    Logd("Recording to \"%s\"", segment->path);
+}
+
+/*!
+ * Write index then release segment
+ */
+static void finishSegment_f(struct recorder_private_data_s *pData)
+{
+    ASSERT(pData && pData->writing);
+
+    struct recorder_segment_s *segment = pData->writing;
+    uint8_t isIndexed                  = 0;
+
+    if (!pData->writeFailed) {
+        disableDirectIo_f(pData);
+
+        isIndexed = (pData->params.container == RECORDER_CONTAINER_AVI)
+                    ? writeAviIndex_f(pData, segment) : writeRawIndex_f(segment);
+
+        if (!isIndexed) {
+            Loge("Failed to index \"%s\" - %s", segment->path, strerror(errno));
+
+            (void)pthread_mutex_lock(&pData->statsLock);
+            pData->stats.nbWriteErrors++;
+            (void)pthread_mutex_unlock(&pData->statsLock);
+        }
+    }
+
+    if (pData->fd != -1) {
+        close(pData->fd);
+        pData->fd = -1;
+    }
+
+    if (segment->nbDroppedFrames > 0) {
+        Logw("\"%s\" closed - %u frame(s), %u dropped", segment->path, segment->nbEntries,
+                segment->nbDroppedFrames);
+    }
+    else {
+        Logd("\"%s\" closed - %u frame(s), %lu bytes", segment->path, segment->nbEntries,
+                segment->size);
+    }
+
+    free(segment->entries);
+    free(segment);
+
+    pData->writing = NULL;
+}
+
+/*!
+ * Append idx1 chunk then rewrite headers now that sizes and frame rate are known
+ */
+static uint8_t writeAviIndex_f(struct recorder_private_data_s *pData,
+                               struct recorder_segment_s *segment)
+{
+    ASSERT(pData && segment);
+
+    size_t size     = AVI_CHUNK_HEADER + (size_t)segment->nbEntries * AVI_INDEX_ENTRY_SIZE;
+    uint8_t *index  = NULL;
+    uint8_t *entry  = NULL;
+    uint8_t header[AVI_HEADER_SIZE];
+    uint8_t ret     = 0;
+    uint32_t i;
+
+    ASSERT((index = malloc(size)));
+
+    putFourcc_f(index, "idx1");
+    put32_f(index + 4, (uint32_t)(size - AVI_CHUNK_HEADER));
+
+    for (i = 0, entry = index + AVI_CHUNK_HEADER; i < segment->nbEntries; i++) {
+        putFourcc_f(entry, "00dc");
+        put32_f(entry + 4, AVIIF_KEYFRAME);
+        put32_f(entry + 8, (uint32_t)segment->entries[i].offset);
+        put32_f(entry + 12, segment->entries[i].size);
+        entry += AVI_INDEX_ENTRY_SIZE;
+    }
+
+    if (writeAll(pData->fd, index, size)) {
+        buildAviHeader_f(&pData->params, segment, header);
+        ret = (pwrite(pData->fd, header, sizeof(header), 0) == (ssize_t)sizeof(header));
+    }
+
+    free(index);
+
+    return ret;
+}
+
+/*!
+ * One "offset size captureTime_us" line per frame
+ */
+static uint8_t writeRawIndex_f(struct recorder_segment_s *segment)
+{
+    ASSERT(segment);
+
+    char path[SEGMENT_PATH_SIZE + sizeof(".idx")];
+    FILE *file;
+    uint32_t i;
+
+    snprintf(path, sizeof(path), "%s.idx", segment->path);
+
+    if (!(file = fopen(path, "we"))) {
+        return 0;
+    }
+
+    for (i = 0; i < segment->nbEntries; i++) {
+        fprintf(file, "%lu %u %lu\n", segment->entries[i].offset, segment->entries[i].size,
+                segment->entries[i].captureTime_us);
+    }
+
+    return (fclose(file) == 0);
+}
+
+/*!
+ * Unaligned tail and index are written through the page cache
+ */
+static void disableDirectIo_f(struct recorder_private_data_s *pData)
+{
+    ASSERT(pData);
+
+    int flags;
+
+    if (!pData->params.directIo || (pData->fd == -1)) {
+        return;
+    }
+
+    if (((flags = fcntl(pData->fd, F_GETFL)) != -1) && (flags & O_DIRECT)) {
+        (void)fcntl(pData->fd, F_SETFL, flags & ~O_DIRECT);
+    }
+}
+
+/*!
+ * RIFF AVI 1.0 with a single video stream. Frame rate is the measured one when the segment holds
+ * more than one frame
+ */
+static void buildAviHeader_f(struct recorder_params_s *params,
+                             struct recorder_segment_s *segment, uint8_t *header)
+{
+    ASSERT(params && segment && header);
+
+    uint32_t usPerFrame = 1000000 / params->fps;
+    uint64_t moviSize   = (segment->size > AVI_HEADER_SIZE ? segment->size - AVI_HEADER_SIZE : 0);
+    uint64_t riffSize   = AVI_HEADER_SIZE + moviSize + AVI_CHUNK_HEADER
+                          + (uint64_t)segment->nbEntries * AVI_INDEX_ENTRY_SIZE - 8;
+    uint32_t compression;
+    uint16_t bitCount;
+
+    if ((segment->nbEntries > 1) && (segment->lastCaptureTime_us > segment->firstCaptureTime_us)) {
+        usPerFrame = (uint32_t)((segment->lastCaptureTime_us - segment->firstCaptureTime_us)
+                                / (segment->nbEntries - 1));
+        usPerFrame = (usPerFrame > 0 ? usPerFrame : 1);
+    }
+
+    getAviFormat_f(params->pixelformat, &compression, &bitCount);
+
+    memset(header, 0, AVI_HEADER_SIZE);
+
+    putFourcc_f(header, "RIFF");
+    put32_f(header + 4, (uint32_t)riffSize);
+    putFourcc_f(header + 8, "AVI ");
+
+    /* Main header */
+    putFourcc_f(header + AVI_HDRL_OFFSET, "LIST");
+    put32_f(header + AVI_HDRL_OFFSET + 4, AVI_MOVI_OFFSET - AVI_HDRL_OFFSET - 8);
+    putFourcc_f(header + AVI_HDRL_OFFSET + 8, "hdrl");
+    putFourcc_f(header + 24, "avih");
+    put32_f(header + 28, 56);
+    put32_f(header + 32, usPerFrame);
+    put32_f(header + 44, AVIF_HASINDEX);
+    put32_f(header + 48, segment->nbEntries);
+    put32_f(header + 56, 1);
+    put32_f(header + 64, params->width);
+    put32_f(header + 68, params->height);
+
+    /* Stream header */
+    putFourcc_f(header + AVI_STRL_OFFSET, "LIST");
+    put32_f(header + AVI_STRL_OFFSET + 4, AVI_MOVI_OFFSET - AVI_STRL_OFFSET - 8);
+    putFourcc_f(header + AVI_STRL_OFFSET + 8, "strl");
+    putFourcc_f(header + 100, "strh");
+    put32_f(header + 104, 56);
+    putFourcc_f(header + 108, "vids");
+    put32_f(header + 112, compression);
+    put32_f(header + 128, usPerFrame);
+    put32_f(header + 132, 1000000);
+    put32_f(header + 140, segment->nbEntries);
+    put32_f(header + 148, UINT32_MAX);
+    put16_f(header + 160, (uint16_t)params->width);
+    put16_f(header + 162, (uint16_t)params->height);
+
+    /* Stream format i.e BITMAPINFOHEADER */
+    putFourcc_f(header + 164, "strf");
+    put32_f(header + 168, 40);
+    put32_f(header + 172, 40);
+    put32_f(header + 176, params->width);
+    put32_f(header + 180, params->height);
+    put16_f(header + 184, 1);
+    put16_f(header + 186, bitCount);
+    put32_f(header + 188, compression);
+    put32_f(header + 192, params->width * params->height * bitCount / 8);
+
+    putFourcc_f(header + AVI_MOVI_OFFSET, "LIST");
+    put32_f(header + AVI_MOVI_OFFSET + 4, (uint32_t)(moviSize + 4));
+    putFourcc_f(header + AVI_MOVI_OFFSET + 8, "movi");
+}
+
+/*!
+ * V4L2 and AVI fourccs only differ for a few formats
+ */
+static void getAviFormat_f(uint32_t pixelformat, uint32_t *compression, uint16_t *bitCount)
+{
+    ASSERT(compression && bitCount);
+
+    switch (pixelformat) {
+        case V4L2_PIX_FMT_MJPEG:
+        case V4L2_PIX_FMT_JPEG:
+            *compression = v4l2_fourcc('M', 'J', 'P', 'G');
+            *bitCount    = 24;
+            break;
+
+        case V4L2_PIX_FMT_YUYV:
+            *compression = v4l2_fourcc('Y', 'U', 'Y', '2');
+            *bitCount    = 16;
+            break;
+
+        case V4L2_PIX_FMT_NV12:
+        case V4L2_PIX_FMT_NV12M:
+            *compression = v4l2_fourcc('N', 'V', '1', '2');
+            *bitCount    = 12;
+            break;
+
+        case V4L2_PIX_FMT_YUV420:
+            *compression = v4l2_fourcc('I', '4', '2', '0');
+            *bitCount    = 12;
+            break;
+
+        default:
+            *compression = pixelformat;
+            *bitCount    = 16;
+            break;
+    }
+}
+
+/*!
+ *
+ */
+static void put16_f(uint8_t *dst, uint16_t value)
+{
+    dst[0] = (uint8_t)value;
+    dst[1] = (uint8_t)(value >> 8);
+}
+
+/*!
+ *
+ */
+static void put32_f(uint8_t *dst, uint32_t value)
+{
+    dst[0] = (uint8_t)value;
+    dst[1] = (uint8_t)(value >> 8);
+    dst[2] = (uint8_t)(value >> 16);
+    dst[3] = (uint8_t)(value >> 24);
+}
+
+/*!
+ *
+ */
+static void putFourcc_f(uint8_t *dst, const char *fourcc)
+{
+    memcpy(dst, fourcc, 4);
+}
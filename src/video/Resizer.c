@@ -0,0 +1,473 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/*!
+* \file Resizer.c
+* \brief Resize captured frames to a smaller resolution
+* \author Boubacar DIENE
+*
+* Raw frames are directly given to the scaler. MJPEG frames are first decoded by libjpeg at the
+* smallest scale (N/8) that is not below the requested size so that most of the downscaling is
+* done in the DCT domain. The scaler then gives the exact size before encoding
+*/
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include <setjmp.h>
+#include <stdio.h>
+
+#include <jpeglib.h>
+
+#include "utils/JpegError.h"
+#include "utils/Log.h"
+
+#include "video/Encoder.h"
+#include "video/Resizer.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#undef  TAG
+#define TAG "Resizer"
+
+/* libjpeg scales by N / 8 */
+#define DCT_SCALE_DENOM 8
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+struct resizer_private_data_s {
+    struct resizer_params_s       params;
+
+    struct scaler_s               *scaler;
+    struct encoder_s              *encoder;
+
+    struct converter_frame_s      dst;
+    uint8_t                       *dstData;
+    size_t                        dstSize;
+
+    /* MJPEG only */
+    struct jpeg_decompress_struct dinfo;
+    struct jpeg_error_s           jerr;
+    struct converter_frame_s      decoded;
+    uint8_t                       *decodedData;
+    size_t                        decodedCapacity;
+    uint8_t                       *scanline;
+    size_t                        scanlineCapacity;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PUBLIC FUNCTIONS PROTOTYPES //////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static enum resizer_error_e resize_f(struct resizer_s *obj, struct video_buffer_s *in,
+                                     struct buffer_s *out);
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PRIVATE FUNCTIONS PROTOTYPES /////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static enum converter_format_e getFormat_f(uint32_t pixelformat);
+
+static enum resizer_error_e getRawFrame_f(struct resizer_private_data_s *pData,
+                                          struct video_buffer_s *in,
+                                          struct converter_frame_s *frame);
+static enum resizer_error_e decodeJpeg_f(struct resizer_private_data_s *pData,
+                                         struct video_buffer_s *in);
+static void packYuyvRow_f(const uint8_t *ycc, uint8_t *yuyv, uint32_t width);
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+enum resizer_error_e Resizer_Init(struct resizer_s **obj, struct resizer_params_s *params)
+{
+    ASSERT(obj && params);
+
+    enum converter_format_e format = getFormat_f(params->pixelformat);
+
+    if ((format == CONVERTER_FORMAT_MAX) || (params->filter >= SCALER_FILTER_MAX)
+        || (params->srcWidth == 0) || (params->srcHeight == 0)
+        || (params->dstWidth == 0) || (params->dstHeight == 0) || ((params->dstWidth % 2) != 0)
+        || (params->srcWidth > params->dstWidth * SCALER_MAX_RATIO)
+        || (params->srcHeight > params->dstHeight * SCALER_MAX_RATIO)
+        || (params->jpegQuality > 100)) {
+        Loge("Bad params");
+        return RESIZER_ERROR_PARAMS;
+    }
+
+    ASSERT((*obj = calloc(1, sizeof(struct resizer_s))));
+
+    struct resizer_private_data_s *pData;
+    ASSERT((pData = calloc(1, sizeof(struct resizer_private_data_s))));
+
+    pData->params = *params;
+
+    if (Scaler_Init(&pData->scaler, CONVERTER_KERNEL_AUTO) != SCALER_ERROR_NONE) {
+        Loge("Scaler_Init() failed");
+        goto scaler_exit;
+    }
+
+    struct converter_s *converter = NULL;
+    if (Converter_Init(&converter, CONVERTER_KERNEL_SCALAR) != CONVERTER_ERROR_NONE) {
+        Loge("Converter_Init() failed");
+        goto converter_exit;
+    }
+
+    (void)converter->getFrameSize(converter, format, params->dstWidth, params->dstHeight,
+                                  &pData->dstSize);
+    ASSERT((pData->dstData = malloc(pData->dstSize)));
+    (void)converter->setFrame(converter, format, params->dstWidth, params->dstHeight,
+                              pData->dstData, &pData->dst);
+
+    (void)Converter_UnInit(&converter);
+
+    if ((params->pixelformat == V4L2_PIX_FMT_MJPEG) || (params->jpegQuality > 0)) {
+        struct encoder_params_s encoderParams;
+
+        memset(&encoderParams, 0, sizeof(encoderParams));
+        memcpy(encoderParams.name, params->name, sizeof(encoderParams.name));
+        encoderParams.priority = params->priority;
+        encoderParams.width    = params->dstWidth;
+        encoderParams.height   = params->dstHeight;
+        encoderParams.quality  = params->jpegQuality;
+        encoderParams.nbSlices = 1;
+
+        if (Encoder_Init(&pData->encoder, &encoderParams) != ENCODER_ERROR_NONE) {
+            Loge("Encoder_Init() failed");
+            goto encoder_exit;
+        }
+    }
+
+    if (params->pixelformat == V4L2_PIX_FMT_MJPEG) {
+        pData->dinfo.err = JpegError_Init(&pData->jerr, 0);
+
+        if (setjmp(pData->jerr.jmpBuf)) {
+            goto jpeg_exit;
+        }
+
+        jpeg_create_decompress(&pData->dinfo);
+    }
+
+    Logd("%s : %ux%u -> %ux%u (%s output)", params->name, params->srcWidth, params->srcHeight,
+            params->dstWidth, params->dstHeight, (pData->encoder ? "JPEG" : "raw"));
+
+    (*obj)->resize = resize_f;
+    (*obj)->pData  = (void*)pData;
+
+    return RESIZER_ERROR_NONE;
+
+jpeg_exit:
+    (void)Encoder_UnInit(&pData->encoder);
+
+encoder_exit:
+    free(pData->dstData);
+
+converter_exit:
+    (void)Scaler_UnInit(&pData->scaler);
+
+scaler_exit:
+    free(pData);
+    free(*obj);
+    *obj = NULL;
+
+    return RESIZER_ERROR_INIT;
+}
+
+/*!
+ *
+ */
+enum resizer_error_e Resizer_UnInit(struct resizer_s **obj)
+{
+    ASSERT(obj && *obj && (*obj)->pData);
+
+    struct resizer_private_data_s *pData = (struct resizer_private_data_s*)((*obj)->pData);
+
+    if (pData->params.pixelformat == V4L2_PIX_FMT_MJPEG) {
+        jpeg_destroy_decompress(&pData->dinfo);
+    }
+
+    if (pData->encoder) {
+        (void)Encoder_UnInit(&pData->encoder);
+    }
+
+    (void)Scaler_UnInit(&pData->scaler);
+
+    free(pData->scanline);
+    free(pData->decodedData);
+    free(pData->dstData);
+    free(pData);
+    free(*obj);
+    *obj = NULL;
+
+    return RESIZER_ERROR_NONE;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////// PUBLIC FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+static enum resizer_error_e resize_f(struct resizer_s *obj, struct video_buffer_s *in,
+                                     struct buffer_s *out)
+{
+    ASSERT(obj && obj->pData && in && out);
+
+    struct resizer_private_data_s *pData = (struct resizer_private_data_s*)(obj->pData);
+    struct converter_frame_s src         = {0};
+    struct converter_frame_s *frame      = &pData->dst;
+
+    if (pData->params.pixelformat == V4L2_PIX_FMT_MJPEG) {
+        if (decodeJpeg_f(pData, in) != RESIZER_ERROR_NONE) {
+            return RESIZER_ERROR_RESIZE;
+        }
+
+        if ((pData->decoded.width == frame->width) && (pData->decoded.height == frame->height)) {
+            frame = &pData->decoded;
+        }
+        else if (pData->scaler->scale(pData->scaler, &pData->decoded, frame,
+                                      pData->params.filter) != SCALER_ERROR_NONE) {
+            return RESIZER_ERROR_RESIZE;
+        }
+    }
+    else {
+        if (getRawFrame_f(pData, in, &src) != RESIZER_ERROR_NONE) {
+            return RESIZER_ERROR_RESIZE;
+        }
+
+        if (pData->scaler->scale(pData->scaler, &src, frame,
+                                 pData->params.filter) != SCALER_ERROR_NONE) {
+            return RESIZER_ERROR_RESIZE;
+        }
+    }
+
+    if (!pData->encoder) {
+        out->data   = pData->dstData;
+        out->length = pData->dstSize;
+
+        return RESIZER_ERROR_NONE;
+    }
+
+    if (pData->encoder->encode(pData->encoder, frame, out) != ENCODER_ERROR_NONE) {
+        return RESIZER_ERROR_RESIZE;
+    }
+
+    return RESIZER_ERROR_NONE;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////// PRIVATE FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ * Format of resized frames before encoding
+ */
+static enum converter_format_e getFormat_f(uint32_t pixelformat)
+{
+    switch (pixelformat) {
+        case V4L2_PIX_FMT_MJPEG:
+            return CONVERTER_FORMAT_YUYV;
+
+        case V4L2_PIX_FMT_YUYV:
+            return CONVERTER_FORMAT_YUYV;
+
+        case V4L2_PIX_FMT_YVYU:
+            return CONVERTER_FORMAT_YVYU;
+
+        case V4L2_PIX_FMT_UYVY:
+            return CONVERTER_FORMAT_UYVY;
+
+        case V4L2_PIX_FMT_NV12:
+        case V4L2_PIX_FMT_NV12M:
+            return CONVERTER_FORMAT_NV12;
+
+        default:
+            return CONVERTER_FORMAT_MAX;
+    }
+}
+
+/*!
+ * Describe a raw captured frame. Rows are expected to be contiguous
+ */
+static enum resizer_error_e getRawFrame_f(struct resizer_private_data_s *pData,
+                                          struct video_buffer_s *in,
+                                          struct converter_frame_s *frame)
+{
+    ASSERT(pData && in && frame);
+
+    uint32_t width  = pData->params.srcWidth;
+    uint32_t height = pData->params.srcHeight;
+    size_t size     = 0;
+
+    frame->format = pData->dst.format;
+    frame->width  = width;
+    frame->height = height;
+
+    /* Lines may be padded by the driver */
+    uint32_t bytesPerLine[2] = { in->planes[0].bytesPerLine, in->planes[1].bytesPerLine };
+
+    switch (pData->params.pixelformat) {
+        case V4L2_PIX_FMT_YUYV:
+        case V4L2_PIX_FMT_YVYU:
+        case V4L2_PIX_FMT_UYVY:
+            frame->planes[0]  = in->data;
+            frame->strides[0] = (bytesPerLine[0] > 0 ? bytesPerLine[0] : width * 2);
+            size              = (size_t)frame->strides[0] * height;
+            break;
+
+        case V4L2_PIX_FMT_NV12:
+            frame->strides[0] = (bytesPerLine[0] > 0 ? bytesPerLine[0] : width);
+            frame->strides[1] = frame->strides[0];
+            frame->planes[0]  = in->data;
+            frame->planes[1]  = (uint8_t*)in->data + (size_t)frame->strides[0] * height;
+            size              = (size_t)frame->strides[0] * height * 3 / 2;
+            break;
+
+        default:
+            if (in->nbPlanes < 2) {
+                Loge("NV12M frame with %u plane(s)", in->nbPlanes);
+                return RESIZER_ERROR_PARAMS;
+            }
+            frame->planes[0]  = in->planes[0].data;
+            frame->planes[1]  = in->planes[1].data;
+            frame->strides[0] = (bytesPerLine[0] > 0 ? bytesPerLine[0] : width);
+            frame->strides[1] = (bytesPerLine[1] > 0 ? bytesPerLine[1] : width);
+            size              = (size_t)frame->strides[0] * height;
+            break;
+    }
+
+    if (in->length < size) {
+        Logw("Truncated frame (%lu / %lu bytes)", (unsigned long)in->length, (unsigned long)size);
+        return RESIZER_ERROR_PARAMS;
+    }
+
+    return RESIZER_ERROR_NONE;
+}
+
+/*!
+ * Decode to pData->decoded (YUYV) at the smallest DCT scale giving at least the requested size
+ */
+static enum resizer_error_e decodeJpeg_f(struct resizer_private_data_s *pData,
+                                         struct video_buffer_s *in)
+{
+    ASSERT(pData && in);
+
+    struct jpeg_decompress_struct *dinfo = &pData->dinfo;
+    struct converter_frame_s *decoded    = &pData->decoded;
+    JSAMPROW rows[1];
+    uint32_t num, width, row;
+    size_t size;
+
+    if (setjmp(pData->jerr.jmpBuf)) {
+        jpeg_abort_decompress(dinfo);
+        return RESIZER_ERROR_RESIZE;
+    }
+
+    jpeg_mem_src(dinfo, (unsigned char*)in->data, (unsigned long)in->length);
+    (void)jpeg_read_header(dinfo, TRUE);
+
+    dinfo->out_color_space     = JCS_YCbCr;
+    dinfo->dct_method          = JDCT_IFAST;
+    dinfo->do_fancy_upsampling = FALSE;
+    dinfo->scale_denom         = DCT_SCALE_DENOM;
+
+    for (num = 1; num <= DCT_SCALE_DENOM; num++) {
+        dinfo->scale_num = num;
+        jpeg_calc_output_dimensions(dinfo);
+
+        if ((dinfo->output_width >= pData->params.dstWidth)
+            && (dinfo->output_height >= pData->params.dstHeight)) {
+            break;
+        }
+    }
+
+    (void)jpeg_start_decompress(dinfo);
+
+    if ((dinfo->output_width < 2) || (dinfo->output_components != 3)) {
+        Loge("Unexpected %ux%u frame with %d components", dinfo->output_width,
+                dinfo->output_height, dinfo->output_components);
+        jpeg_abort_decompress(dinfo);
+        return RESIZER_ERROR_RESIZE;
+    }
+
+    /* YUYV needs an even width */
+    width = dinfo->output_width & ~1u;
+    size  = (size_t)width * 2 * dinfo->output_height;
+
+    if (size > pData->decodedCapacity) {
+        free(pData->decodedData);
+        ASSERT((pData->decodedData = malloc(size)));
+        pData->decodedCapacity = size;
+    }
+
+    if ((size_t)dinfo->output_width * 3 > pData->scanlineCapacity) {
+        free(pData->scanline);
+        pData->scanlineCapacity = (size_t)dinfo->output_width * 3;
+        ASSERT((pData->scanline = malloc(pData->scanlineCapacity)));
+    }
+
+    decoded->format     = CONVERTER_FORMAT_YUYV;
+    decoded->width      = width;
+    decoded->height     = dinfo->output_height;
+    decoded->planes[0]  = pData->decodedData;
+    decoded->strides[0] = width * 2;
+
+    rows[0] = pData->scanline;
+    while (dinfo->output_scanline < dinfo->output_height) {
+        row = dinfo->output_scanline;
+        (void)jpeg_read_scanlines(dinfo, rows, 1);
+        packYuyvRow_f(pData->scanline, decoded->planes[0] + (size_t)row * decoded->strides[0],
+                      width);
+    }
+
+    (void)jpeg_finish_decompress(dinfo);
+
+    return RESIZER_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+static void packYuyvRow_f(const uint8_t *ycc, uint8_t *yuyv, uint32_t width)
+{
+    ASSERT(ycc && yuyv);
+
+    uint32_t x;
+
+    for (x = 0; x < width; x += 2, ycc += 6, yuyv += 4) {
+        yuyv[0] = ycc[0];
+        yuyv[1] = (uint8_t)((ycc[1] + ycc[4] + 1) / 2);
+        yuyv[2] = ycc[3];
+        yuyv[3] = (uint8_t)((ycc[2] + ycc[5] + 1) / 2);
+    }
+}
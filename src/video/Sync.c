@@ -0,0 +1,582 @@
+//////////////////////////////////////////////////////////////////////////////////////////////////
+//                                                                                              //
+//              Copyright © 2016, 2018 Boubacar DIENE                                           //
+//                                                                                              //
+//              This file is part of mmstreamer project.                                        //
+//                                                                                              //
+//              mmstreamer is free software: you can redistribute it and/or modify              //
+//              it under the terms of the GNU General Public License as published by            //
+//              the Free Software Foundation, either version 2 of the License, or               //
+//              (at your option) any later version.                                             //
+//                                                                                              //
+//              mmstreamer is distributed in the hope that it will be useful,                   //
+//              but WITHOUT ANY WARRANTY; without even the implied warranty of                  //
+//              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   //
+//              GNU General Public License for more details.                                    //
+//                                                                                              //
+//              You should have received a copy of the GNU General Public License               //
+//              along with mmstreamer. If not, see <http://www.gnu.org/licenses/>               //
+//              or write to the Free Software Foundation, Inc., 51 Franklin Street,             //
+//              51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.                   //
+//                                                                                              //
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*!
+* \file Sync.c
+* \brief Match frames of several devices by capture time
+* \author Boubacar DIENE
+*
+* Each member keeps up to SYNC_MAX_PENDING_FRAMES frames in capture order. As long as every member
+* has a pending frame, the oldest heads are compared: they form a set if they are all within
+* tolerance of each other. Otherwise the oldest head is dropped since frames still to come from
+* the other members can only be newer than their current heads
+*/
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#include <pthread.h>
+
+#include "utils/List.h"
+#include "utils/Log.h"
+
+#include "video/Sync.h"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// MACROS ////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+#undef  TAG
+#define TAG "Sync"
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+struct sync_member_s {
+    uint8_t               isUsed;
+    char                  name[MAX_NAME_SIZE];
+
+    struct video_buffer_s *pending[SYNC_MAX_PENDING_FRAMES];
+    uint32_t              first;
+    uint32_t              nbPending;
+};
+
+struct sync_private_data_s {
+    struct sync_params_s      params;
+
+    /* Protected by lock */
+    pthread_mutex_t           lock;
+    struct sync_member_s      members[VIDEO_MAX_SYNC_MEMBERS];
+    struct video_sync_stats_s stats;
+
+    struct list_s             *listenersList;
+};
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PUBLIC FUNCTIONS PROTOTYPES //////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static enum sync_error_e join_f(struct sync_s *obj, const char *memberName, uint32_t *memberOut);
+static enum sync_error_e leave_f(struct sync_s *obj, uint32_t member, uint32_t *nbMembersOut);
+static enum sync_error_e push_f(struct sync_s *obj, uint32_t member,
+                                struct video_buffer_s *videoBuffer);
+
+static enum sync_error_e addListener_f(struct sync_s *obj, struct video_sync_listener_s *listener);
+static enum sync_error_e removeListener_f(struct sync_s *obj,
+                                          struct video_sync_listener_s *listener);
+
+static enum sync_error_e getStats_f(struct sync_s *obj, struct video_sync_stats_s *stats);
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////// PRIVATE FUNCTIONS PROTOTYPES /////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+static struct video_buffer_s *popFrame_f(struct sync_member_s *member);
+static void dropFrame_f(struct sync_private_data_s *pData, struct sync_member_s *member);
+static void match_f(struct sync_private_data_s *pData);
+static void deliverSet_f(struct sync_private_data_s *pData, struct video_frame_set_s *frameSet);
+
+static uint8_t compareListenerCb(struct list_s *obj, void *elementToCheck, void *userData);
+static void releaseListenerCb(struct list_s *obj, void *element);
+
+/* -------------------------------------------------------------------------------------------- */
+/* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+enum sync_error_e Sync_Init(struct sync_s **obj, struct sync_params_s *params)
+{
+    ASSERT(obj && params);
+
+    if (!params->onReleaseCb) {
+        Loge("Bad params");
+        return SYNC_ERROR_PARAMS;
+    }
+
+    ASSERT((*obj = calloc(1, sizeof(struct sync_s))));
+
+    struct sync_private_data_s *pData;
+    ASSERT((pData = calloc(1, sizeof(struct sync_private_data_s))));
+
+    pData->params = *params;
+
+    if (pthread_mutex_init(&pData->lock, NULL) != 0) {
+        Loge("pthread_mutex_init() failed");
+        goto lock_exit;
+    }
+
+    struct list_callbacks_s listCallbacks = {0};
+    listCallbacks.compareCb = compareListenerCb;
+    listCallbacks.releaseCb = releaseListenerCb;
+    listCallbacks.browseCb  = NULL;
+
+    if (List_Init(&pData->listenersList, &listCallbacks) != LIST_ERROR_NONE) {
+        Loge("List_Init() failed");
+        goto list_exit;
+    }
+
+    (*obj)->join           = join_f;
+    (*obj)->leave          = leave_f;
+    (*obj)->push           = push_f;
+    (*obj)->addListener    = addListener_f;
+    (*obj)->removeListener = removeListener_f;
+    (*obj)->getStats       = getStats_f;
+
+    (*obj)->pData = pData;
+
+    return SYNC_ERROR_NONE;
+
+list_exit:
+    (void)pthread_mutex_destroy(&pData->lock);
+
+lock_exit:
+    free(pData);
+    free(*obj);
+    *obj = NULL;
+
+    return SYNC_ERROR_INIT;
+}
+
+/*!
+ *
+ */
+enum sync_error_e Sync_UnInit(struct sync_s **obj)
+{
+    ASSERT(obj && *obj && (*obj)->pData);
+
+    struct sync_private_data_s *pData = (struct sync_private_data_s*)((*obj)->pData);
+    enum sync_error_e ret             = SYNC_ERROR_NONE;
+
+    Logd("%s : %lu set(s) / %lu unmatched frame(s) / max skew = %lu us", pData->params.name,
+            pData->stats.nbFrameSets, pData->stats.nbUnmatchedFrames, pData->stats.maxSkew_us);
+
+    if (pData->stats.nbMembers > 0) {
+        Logw("%s : %u member(s) still in group", pData->params.name, pData->stats.nbMembers);
+    }
+
+    if (pData->listenersList->lock(pData->listenersList) == LIST_ERROR_NONE) {
+        (void)pData->listenersList->removeAll(pData->listenersList);
+        (void)pData->listenersList->unlock(pData->listenersList);
+    }
+
+    if (List_UnInit(&pData->listenersList) != LIST_ERROR_NONE) {
+        Loge("List_UnInit() failed");
+        ret = SYNC_ERROR_UNINIT;
+    }
+
+    if (pthread_mutex_destroy(&pData->lock) != 0) {
+        Loge("pthread_mutex_destroy() failed");
+        ret = SYNC_ERROR_UNINIT;
+    }
+
+    free(pData);
+    free(*obj);
+    *obj = NULL;
+
+    return ret;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ////////////////////////////// PUBLIC FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ *
+ */
+static enum sync_error_e join_f(struct sync_s *obj, const char *memberName, uint32_t *memberOut)
+{
+    ASSERT(obj && obj->pData && memberName && memberOut);
+
+    struct sync_private_data_s *pData = (struct sync_private_data_s*)(obj->pData);
+    enum sync_error_e ret             = SYNC_ERROR_FULL;
+    uint32_t index;
+
+    if (pthread_mutex_lock(&pData->lock) != 0) {
+        Loge("pthread_mutex_lock() failed");
+        return SYNC_ERROR_LOCK;
+    }
+
+    for (index = 0; index < VIDEO_MAX_SYNC_MEMBERS; index++) {
+        struct sync_member_s *member = &pData->members[index];
+
+        if (member->isUsed) {
+            continue;
+        }
+
+        memset(member, 0, sizeof(struct sync_member_s));
+        snprintf(member->name, sizeof(member->name), "%s", memberName);
+        member->isUsed = 1;
+
+        pData->stats.nbMembers++;
+        *memberOut = index;
+
+        ret = SYNC_ERROR_NONE;
+        break;
+    }
+
+    (void)pthread_mutex_unlock(&pData->lock);
+
+    if (ret != SYNC_ERROR_NONE) {
+        Loge("%s : no room left for %s", pData->params.name, memberName);
+    }
+
+    return ret;
+}
+
+/*!
+ *
+ */
+static enum sync_error_e leave_f(struct sync_s *obj, uint32_t member, uint32_t *nbMembersOut)
+{
+    ASSERT(obj && obj->pData && nbMembersOut);
+
+    struct sync_private_data_s *pData = (struct sync_private_data_s*)(obj->pData);
+
+    if ((member >= VIDEO_MAX_SYNC_MEMBERS) || !pData->members[member].isUsed) {
+        Loge("Bad params");
+        return SYNC_ERROR_PARAMS;
+    }
+
+    if (pthread_mutex_lock(&pData->lock) != 0) {
+        Loge("pthread_mutex_lock() failed");
+        return SYNC_ERROR_LOCK;
+    }
+
+    while (pData->members[member].nbPending > 0) {
+        pData->params.onReleaseCb(popFrame_f(&pData->members[member]), pData->params.userData);
+    }
+
+    pData->members[member].isUsed = 0;
+    pData->stats.nbMembers--;
+
+    /* Remaining members may now be complete */
+    match_f(pData);
+
+    *nbMembersOut = pData->stats.nbMembers;
+
+    (void)pthread_mutex_unlock(&pData->lock);
+
+    return SYNC_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+static enum sync_error_e push_f(struct sync_s *obj, uint32_t member,
+                                struct video_buffer_s *videoBuffer)
+{
+    ASSERT(obj && obj->pData && videoBuffer);
+
+    struct sync_private_data_s *pData = (struct sync_private_data_s*)(obj->pData);
+
+    if ((member >= VIDEO_MAX_SYNC_MEMBERS) || !pData->members[member].isUsed) {
+        Loge("Bad params");
+        return SYNC_ERROR_PARAMS;
+    }
+
+    if (pthread_mutex_lock(&pData->lock) != 0) {
+        Loge("pthread_mutex_lock() failed");
+        return SYNC_ERROR_LOCK;
+    }
+
+    struct sync_member_s *m = &pData->members[member];
+
+    /* Others are late or stopped: their frames would not match the oldest one anyway */
+    if (m->nbPending == SYNC_MAX_PENDING_FRAMES) {
+        dropFrame_f(pData, m);
+    }
+
+    m->pending[(m->first + m->nbPending) % SYNC_MAX_PENDING_FRAMES] = videoBuffer;
+    m->nbPending++;
+
+    match_f(pData);
+
+    (void)pthread_mutex_unlock(&pData->lock);
+
+    return SYNC_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+static enum sync_error_e addListener_f(struct sync_s *obj, struct video_sync_listener_s *listener)
+{
+    ASSERT(obj && obj->pData && listener);
+
+    struct sync_private_data_s *pData = (struct sync_private_data_s*)(obj->pData);
+    struct list_s *list               = pData->listenersList;
+
+    if (!listener->onFrameSetAvailableCb) {
+        Loge("Bad params");
+        return SYNC_ERROR_PARAMS;
+    }
+
+    struct video_sync_listener_s *copy;
+    ASSERT((copy = calloc(1, sizeof(struct video_sync_listener_s))));
+    memcpy(copy, listener, sizeof(struct video_sync_listener_s));
+
+    /* Delivery holds lock so that listener is not added while a set is being given */
+    if (pthread_mutex_lock(&pData->lock) != 0) {
+        Loge("pthread_mutex_lock() failed");
+        free(copy);
+        return SYNC_ERROR_LOCK;
+    }
+
+    if (list->lock(list) != LIST_ERROR_NONE) {
+        Loge("Failed to lock list");
+        (void)pthread_mutex_unlock(&pData->lock);
+        free(copy);
+        return SYNC_ERROR_LOCK;
+    }
+
+    (void)list->add(list, (void*)copy);
+    (void)list->unlock(list);
+
+    (void)pthread_mutex_unlock(&pData->lock);
+
+    return SYNC_ERROR_NONE;
+}
+
+/*!
+ *
+ */
+static enum sync_error_e removeListener_f(struct sync_s *obj,
+                                          struct video_sync_listener_s *listener)
+{
+    ASSERT(obj && obj->pData && listener);
+
+    struct sync_private_data_s *pData = (struct sync_private_data_s*)(obj->pData);
+    struct list_s *list               = pData->listenersList;
+    enum sync_error_e ret             = SYNC_ERROR_NONE;
+
+    if (pthread_mutex_lock(&pData->lock) != 0) {
+        Loge("pthread_mutex_lock() failed");
+        return SYNC_ERROR_LOCK;
+    }
+
+    if (list->lock(list) != LIST_ERROR_NONE) {
+        Loge("Failed to lock list");
+        (void)pthread_mutex_unlock(&pData->lock);
+        return SYNC_ERROR_LOCK;
+    }
+
+    if (list->remove(list, (void*)listener->name) != LIST_ERROR_NONE) {
+        Loge("Failed to remove listener %s", listener->name);
+        ret = SYNC_ERROR_LIST;
+    }
+
+    (void)list->unlock(list);
+    (void)pthread_mutex_unlock(&pData->lock);
+
+    return ret;
+}
+
+/*!
+ *
+ */
+static enum sync_error_e getStats_f(struct sync_s *obj, struct video_sync_stats_s *stats)
+{
+    ASSERT(obj && obj->pData && stats);
+
+    struct sync_private_data_s *pData = (struct sync_private_data_s*)(obj->pData);
+
+    if (pthread_mutex_lock(&pData->lock) != 0) {
+        Loge("pthread_mutex_lock() failed");
+        return SYNC_ERROR_LOCK;
+    }
+
+    memcpy(stats, &pData->stats, sizeof(struct video_sync_stats_s));
+
+    (void)pthread_mutex_unlock(&pData->lock);
+
+    return SYNC_ERROR_NONE;
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/* ///////////////////////////// PRIVATE FUNCTIONS IMPLEMENTATION ///////////////////////////// */
+/* -------------------------------------------------------------------------------------------- */
+
+/*!
+ * Remove member's oldest pending frame. lock must be held
+ */
+static struct video_buffer_s *popFrame_f(struct sync_member_s *member)
+{
+    ASSERT(member && (member->nbPending > 0));
+
+    struct video_buffer_s *videoBuffer = member->pending[member->first];
+
+    member->first = (member->first + 1) % SYNC_MAX_PENDING_FRAMES;
+    member->nbPending--;
+
+    return videoBuffer;
+}
+
+/*!
+ * Give member's oldest pending frame back as unmatched. lock must be held
+ */
+static void dropFrame_f(struct sync_private_data_s *pData, struct sync_member_s *member)
+{
+    ASSERT(pData && member);
+
+    pData->stats.nbUnmatchedFrames++;
+    pData->params.onReleaseCb(popFrame_f(member), pData->params.userData);
+}
+
+/*!
+ * Deliver sets as long as every member has a pending frame. lock must be held
+ */
+static void match_f(struct sync_private_data_s *pData)
+{
+    ASSERT(pData);
+
+    struct video_frame_set_s frameSet;
+    struct sync_member_s *member = NULL;
+    struct sync_member_s *oldest = NULL;
+    uint64_t captureTime_us, min_us, max_us;
+    uint32_t index;
+
+    while (1) {
+        oldest = NULL;
+        min_us = UINT64_MAX;
+        max_us = 0;
+
+        for (index = 0; index < VIDEO_MAX_SYNC_MEMBERS; index++) {
+            member = &pData->members[index];
+
+            if (!member->isUsed) {
+                continue;
+            }
+
+            if (member->nbPending == 0) {
+                return;
+            }
+
+            captureTime_us = member->pending[member->first]->captureTime_us;
+
+            if (captureTime_us < min_us) {
+                min_us = captureTime_us;
+                oldest = member;
+            }
+
+            if (captureTime_us > max_us) {
+                max_us = captureTime_us;
+            }
+        }
+
+        if (!oldest) {
+            return;
+        }
+
+        if (max_us - min_us > pData->params.tolerance_us) {
+            dropFrame_f(pData, oldest);
+            continue;
+        }
+
+        memset(&frameSet, 0, sizeof(struct video_frame_set_s));
+        snprintf(frameSet.syncGroup, sizeof(frameSet.syncGroup), "%s", pData->params.name);
+        frameSet.skew_us = max_us - min_us;
+
+        for (index = 0; index < VIDEO_MAX_SYNC_MEMBERS; index++) {
+            member = &pData->members[index];
+
+            if (!member->isUsed) {
+                continue;
+            }
+
+            snprintf(frameSet.names[frameSet.nbBuffers], MAX_NAME_SIZE, "%s", member->name);
+            frameSet.buffers[frameSet.nbBuffers] = popFrame_f(member);
+            frameSet.nbBuffers++;
+        }
+
+        pData->stats.nbFrameSets++;
+        pData->stats.lastSkew_us = frameSet.skew_us;
+
+        if (frameSet.skew_us > pData->stats.maxSkew_us) {
+            pData->stats.maxSkew_us = frameSet.skew_us;
+        }
+
+        deliverSet_f(pData, &frameSet);
+
+        for (index = 0; index < frameSet.nbBuffers; index++) {
+            pData->params.onReleaseCb(frameSet.buffers[index], pData->params.userData);
+        }
+    }
+}
+
+/*!
+ * IMPORTANT: Sets must be handled very quickly since devices wait for each other
+ */
+static void deliverSet_f(struct sync_private_data_s *pData, struct video_frame_set_s *frameSet)
+{
+    ASSERT(pData && frameSet);
+
+    struct list_s *list                    = pData->listenersList;
+    struct video_sync_listener_s *listener = NULL;
+    uint32_t nbListeners                   = 0;
+
+    if (list->lock(list) != LIST_ERROR_NONE) {
+        Loge("Failed to lock list");
+        return;
+    }
+
+    if (list->getNbElements(list, &nbListeners) == LIST_ERROR_NONE) {
+        while (nbListeners > 0) {
+            nbListeners--;
+
+            if (list->getElement(list, (void*)&listener) != LIST_ERROR_NONE) {
+                break;
+            }
+
+            listener->onFrameSetAvailableCb(frameSet, listener->userData);
+        }
+    }
+
+    (void)list->unlock(list);
+}
+
+/*!
+ *
+ */
+static uint8_t compareListenerCb(struct list_s *obj, void *elementToCheck, void *userData)
+{
+    ASSERT(obj && elementToCheck && userData);
+
+    struct video_sync_listener_s *listener = (struct video_sync_listener_s*)elementToCheck;
+    char *nameOfElementToRemove            = (char*)userData;
+
+    return (!strcmp(nameOfElementToRemove, listener->name));
+}
+
+/*!
+ *
+ */
+static void releaseListenerCb(struct list_s *obj, void *element)
+{
+    ASSERT(obj && element);
+
+    free(element);
+}
@@ -32,6 +32,7 @@
 /* -------------------------------------------------------------------------------------------- */
 
 #include <fcntl.h>
+#include <linux/dma-heap.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 
@@ -45,6 +46,8 @@
 #undef  TAG
 #define TAG "v4l2"
 
+#define V4L2_DMA_HEAP_PATH "/dev/dma_heap/system"
+
 /* -------------------------------------------------------------------------------------------- */
 /* /////////////////////////////// PUBLIC FUNCTIONS PROTOTYPES //////////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
@@ -71,7 +74,11 @@ static enum v4l2_error_e awaitData_f(struct v4l2_s *obj, int32_t timeout_ms);
 static enum v4l2_error_e stopAwaitingData_f(struct v4l2_s *obj);
 
 static enum v4l2_error_e queueBuffer_f(struct v4l2_s *obj, uint32_t index);
-static enum v4l2_error_e dequeueBuffer_f(struct v4l2_s *obj);
+static enum v4l2_error_e dequeueBuffer_f(struct v4l2_s *obj,
+                                         struct v4l2_dequeued_buffer_s *bufferOut);
+
+static enum v4l2_error_e disconnectDevice_f(struct v4l2_s *obj);
+static enum v4l2_error_e reconnectDevice_f(struct v4l2_s *obj);
 
 /* -------------------------------------------------------------------------------------------- */
 /* /////////////////////////////// PRIVATE FUNCTIONS PROTOTYPES /////////////////////////////// */
@@ -79,6 +86,10 @@ static enum v4l2_error_e dequeueBuffer_f(struct v4l2_s *obj);
 
 static enum v4l2_error_e v4l2Ioctl_f(int32_t fd, uint64_t req, void *args);
 
+static int32_t exportBuffer_f(struct v4l2_s *obj, uint32_t index, uint32_t plane);
+static int32_t allocateDmabuf_f(int32_t heapFd, size_t length);
+static size_t getPlaneSize_f(struct v4l2_s *obj, uint32_t plane);
+
 /* -------------------------------------------------------------------------------------------- */
 /* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
@@ -112,8 +123,13 @@ enum v4l2_error_e V4l2_Init(struct v4l2_s **obj)
     
     (*obj)->queueBuffer      = queueBuffer_f;
     (*obj)->dequeueBuffer    = dequeueBuffer_f;
+
+    (*obj)->disconnectDevice = disconnectDevice_f;
+    (*obj)->reconnectDevice  = reconnectDevice_f;
     
-    (*obj)->deviceFd = -1;
+    (*obj)->deviceFd                = -1;
+    (*obj)->quitFd[V4L2_PIPE_READ]  = -1;
+    (*obj)->quitFd[V4L2_PIPE_WRITE] = -1;
     
     return V4L2_ERROR_NONE;
 }
@@ -222,6 +238,8 @@ static enum v4l2_error_e closeDevice_f(struct v4l2_s *obj)
     if (obj->quitFd[V4L2_PIPE_READ] != -1) {
         close(obj->quitFd[V4L2_PIPE_READ]);
         close(obj->quitFd[V4L2_PIPE_WRITE]);
+        obj->quitFd[V4L2_PIPE_READ]  = -1;
+        obj->quitFd[V4L2_PIPE_WRITE] = -1;
     }
 
     return V4L2_ERROR_NONE;
@@ -243,6 +261,11 @@ static enum v4l2_error_e configureDevice_f(struct v4l2_s *obj,
     
     enum v4l2_error_e ret = V4L2_ERROR_NONE;
 
+    /* Driver may reset selection when format changes */
+    memset(&obj->streamparm, 0, sizeof(struct v4l2_streamparm));
+    memset(&obj->cropSelection, 0, sizeof(struct v4l2_selection));
+    memset(&obj->composeSelection, 0, sizeof(struct v4l2_selection));
+
     /* Set format */
     obj->format.type = params->type;
     if ((ret = v4l2Ioctl_f(obj->deviceFd, VIDIOC_G_FMT, &obj->format)) != V4L2_ERROR_NONE) {
@@ -250,15 +273,35 @@ static enum v4l2_error_e configureDevice_f(struct v4l2_s *obj,
         goto exit;
     }
 
-    obj->format.fmt.pix.width       = params->width;
-    obj->format.fmt.pix.height      = params->height;
-    obj->format.fmt.pix.pixelformat = params->pixelformat;
-    obj->format.fmt.pix.colorspace  = params->colorspace;
+    obj->isMplane = V4L2_TYPE_IS_MULTIPLANAR(params->type);
+
+    if (obj->isMplane) {
+        obj->format.fmt.pix_mp.width       = params->width;
+        obj->format.fmt.pix_mp.height      = params->height;
+        obj->format.fmt.pix_mp.pixelformat = params->pixelformat;
+        obj->format.fmt.pix_mp.colorspace  = params->colorspace;
+    }
+    else {
+        obj->format.fmt.pix.width       = params->width;
+        obj->format.fmt.pix.height      = params->height;
+        obj->format.fmt.pix.pixelformat = params->pixelformat;
+        obj->format.fmt.pix.colorspace  = params->colorspace;
+    }
 
     if ((ret = v4l2Ioctl_f(obj->deviceFd, VIDIOC_S_FMT, &obj->format)) != V4L2_ERROR_NONE) {
         Loge("Failed to set video format");
         goto exit;
     }
+
+    if (obj->isMplane) {
+        obj->width  = obj->format.fmt.pix_mp.width;
+        obj->height = obj->format.fmt.pix_mp.height;
+        Logd("Multi-planar format with %u plane(s)", obj->format.fmt.pix_mp.num_planes);
+    }
+    else {
+        obj->width  = obj->format.fmt.pix.width;
+        obj->height = obj->format.fmt.pix.height;
+    }
     
     /* Set framerate */
     struct v4l2_streamparm streamparm = {0};
@@ -287,6 +330,8 @@ static enum v4l2_error_e configureDevice_f(struct v4l2_s *obj,
 
         Logd("New framerate : %d fps / Requested : %d fps",
                 streamparm.parm.output.timeperframe.denominator, params->desiredFps);
+
+        memcpy(&obj->streamparm, &streamparm, sizeof(struct v4l2_streamparm));
     }
     else {
         Loge("Your driver does not allow to update framerate");
@@ -370,6 +415,8 @@ static enum v4l2_error_e setCroppingArea_f(struct v4l2_s *obj,
         Loge("Failed to set V4L2_SEL_TGT_CROP_ACTIVE");
         return ret;
     }
+
+    memcpy(&obj->cropSelection, &sel, sizeof(struct v4l2_selection));
 	
     cropRectInOut->left   = r.left;
     cropRectInOut->top    = r.top;
@@ -458,6 +505,8 @@ static enum v4l2_error_e setComposingArea_f(struct v4l2_s *obj,
         Loge("Failed to set V4L2_SEL_TGT_COMPOSE_ACTIVE");
         return ret;
     }
+
+    memcpy(&obj->composeSelection, &sel, sizeof(struct v4l2_selection));
 	
     composeRectInOut->left   = r.left;
     composeRectInOut->top    = r.top;
@@ -486,8 +535,10 @@ static enum v4l2_error_e requestBuffers_f(struct v4l2_s *obj,
     
     enum v4l2_error_e ret = V4L2_ERROR_NONE;
 
-    struct v4l2_requestbuffers req = {0};
-    struct v4l2_buffer buf         = {0};
+    struct v4l2_requestbuffers req             = {0};
+    struct v4l2_buffer buf                     = {0};
+    struct v4l2_plane planes[VIDEO_MAX_PLANES] = {{0}};
+    int32_t heapFd                             = -1;
 
     obj->memory        = params->memory;
     obj->maxBufferSize = 0;
@@ -510,55 +561,123 @@ static enum v4l2_error_e requestBuffers_f(struct v4l2_s *obj,
     obj->nbBuffers = req.count;
     ASSERT((obj->map = calloc(obj->nbBuffers, sizeof(struct v4l2_mapping_buffer_s))));
 
-    uint32_t i;
+    uint32_t i, p;
+    for (i = 0; i < obj->nbBuffers; i++) {
+        for (p = 0; p < VIDEO_MAX_PLANES; p++) {
+            obj->map[i].planes[p].dmabufFd = -1;
+        }
+    }
+
+    if ((obj->memory == V4L2_MEMORY_DMABUF)
+        && ((heapFd = open(V4L2_DMA_HEAP_PATH, O_RDWR | O_CLOEXEC)) < 0)) {
+        Loge("Failed to open \"%s\" - %s", V4L2_DMA_HEAP_PATH, strerror(errno));
+        ret = V4L2_ERROR_MEMORY;
+        goto exit;
+    }
+
     for (i = 0; i < obj->nbBuffers; i++) {
         buf.type   = req.type;
         buf.memory = req.memory;
         buf.index  = i;
 
+        if (obj->isMplane) {
+            buf.m.planes = planes;
+            buf.length   = VIDEO_MAX_PLANES;
+        }
+
         if (v4l2Ioctl_f(obj->deviceFd, VIDIOC_QUERYBUF, &buf) != V4L2_ERROR_NONE) {
             Loge("Failed to query buffer");
             ret = V4L2_ERROR_IO;
             goto exit;
         }
 
-        obj->map[i].index  = buf.index;
-        obj->map[i].length = buf.length;
-        obj->map[i].offset = buf.m.offset;
-        
-        switch (params->memory) {
-            case V4L2_MEMORY_MMAP:
-                obj->map[i].start = mmap(NULL /* start anywhere */,
-                                          buf.length,
-                                          PROT_READ | PROT_WRITE,
-                                          MAP_SHARED,
-                                          obj->deviceFd, buf.m.offset);
-
-                if (obj->map[i].start == MAP_FAILED) {
-                    Loge("mmap() failed");
-                    ret = V4L2_ERROR_MEMORY;
-                    goto exit;
-                }
-                break;
-                
-            case V4L2_MEMORY_USERPTR:
-                ASSERT((obj->map[i].start = calloc(1, buf.length)));
-                break;
-                
-            default:
-                ;
+        obj->map[i].index    = buf.index;
+        obj->map[i].nbPlanes = (obj->isMplane ? buf.length : 1);
+
+        size_t bufferSize = 0;
+
+        for (p = 0; p < obj->map[i].nbPlanes; p++) {
+            struct v4l2_mapping_plane_s *plane = &obj->map[i].planes[p];
+
+            if (obj->isMplane) {
+                plane->length = planes[p].length;
+                plane->offset = planes[p].m.mem_offset;
+            }
+            else {
+                plane->length = buf.length;
+                plane->offset = buf.m.offset;
+            }
+
+            switch (params->memory) {
+                case V4L2_MEMORY_MMAP:
+                    plane->start = mmap(NULL /* start anywhere */,
+                                        plane->length,
+                                        PROT_READ | PROT_WRITE,
+                                        MAP_SHARED,
+                                        obj->deviceFd, plane->offset);
+
+                    if (plane->start == MAP_FAILED) {
+                        Loge("mmap() failed");
+                        plane->start = NULL;
+                        ret = V4L2_ERROR_MEMORY;
+                        goto exit;
+                    }
+
+                    /* Not fatal: buffers are still usable from this process */
+                    plane->dmabufFd = exportBuffer_f(obj, i, p);
+                    break;
+
+                case V4L2_MEMORY_USERPTR:
+                    ASSERT((plane->start = calloc(1, plane->length)));
+                    break;
+
+                case V4L2_MEMORY_DMABUF:
+                    if (plane->length < getPlaneSize_f(obj, p)) {
+                        plane->length = getPlaneSize_f(obj, p);
+                    }
+
+                    if ((plane->dmabufFd = allocateDmabuf_f(heapFd, plane->length)) < 0) {
+                        ret = V4L2_ERROR_MEMORY;
+                        goto exit;
+                    }
+
+                    plane->start = mmap(NULL, plane->length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                                        plane->dmabufFd, 0);
+
+                    if (plane->start == MAP_FAILED) {
+                        Loge("mmap() failed on dma-buf");
+                        plane->start = NULL;
+                        ret = V4L2_ERROR_MEMORY;
+                        goto exit;
+                    }
+                    break;
+
+                default:
+                    ;
+            }
+
+            bufferSize += plane->length;
         }
         
-        if (obj->maxBufferSize < buf.length) {
-            obj->maxBufferSize = buf.length;
+        if (obj->maxBufferSize < bufferSize) {
+            obj->maxBufferSize = bufferSize;
         }
 
         memset(&buf, 0, sizeof(struct v4l2_buffer));
+        memset(planes, 0, sizeof(planes));
+    }
+
+    if (heapFd != -1) {
+        close(heapFd);
     }
     
     return V4L2_ERROR_NONE;
 
 exit:
+    if (heapFd != -1) {
+        close(heapFd);
+    }
+
     releaseBuffers_f(obj);
     
     return ret;
@@ -573,37 +692,48 @@ exit:
  */
 static enum v4l2_error_e releaseBuffers_f(struct v4l2_s *obj)
 {
-    ASSERT(obj && (obj->deviceFd != -1));
+    ASSERT(obj);
 
     if (obj->map) {
-        uint32_t i;
-
-        switch (obj->memory) {
-            case V4L2_MEMORY_MMAP:
-                for (i = 0; i < obj->nbBuffers; i++) {
-                    if (obj->map[i].start
-                        && munmap(obj->map[i].start, obj->map[i].length) < 0) {
-                        Loge("munmap() failed");
-                    }
+        uint32_t i, p;
+        struct v4l2_mapping_plane_s *plane;
+
+        for (i = 0; i < obj->nbBuffers; i++) {
+            for (p = 0; p < VIDEO_MAX_PLANES; p++) {
+                plane = &obj->map[i].planes[p];
+
+                switch (obj->memory) {
+                    case V4L2_MEMORY_MMAP:
+                    case V4L2_MEMORY_DMABUF:
+                        if (plane->start && munmap(plane->start, plane->length) < 0) {
+                            Loge("munmap() failed");
+                        }
+                        if (plane->dmabufFd != -1) {
+                            close(plane->dmabufFd);
+                        }
+                        break;
+
+                    case V4L2_MEMORY_USERPTR:
+                        if (plane->start) {
+                            free(plane->start);
+                        }
+                        break;
+
+                    default:
+                        ;
                 }
-                break;
-
-            case V4L2_MEMORY_USERPTR:
-                for (i = 0; i < obj->nbBuffers; i++) {
-                    if (obj->map[i].start) {
-                        free(obj->map[i].start);
-                    }
-                }
-                break;
-                
-            default:
-                ;
+            }
         }
 
         free(obj->map);
         obj->map = NULL;
     }
 
+    /* Buffers of a disconnected device are freed by the driver */
+    if (obj->deviceFd == -1) {
+        return V4L2_ERROR_NONE;
+    }
+
     struct v4l2_requestbuffers req = {0};
     req.type   = obj->format.type;
     req.memory = obj->memory;
@@ -668,8 +798,9 @@ static enum v4l2_error_e awaitData_f(struct v4l2_s *obj, int32_t timeout_ms)
     int32_t selectRetval;
     int32_t maxFd;
     fd_set fds;
-    struct timeval *tv    = NULL;
-    enum v4l2_error_e ret = V4L2_ERROR_NONE;
+    struct timeval timeout = {0};
+    struct timeval *tv     = NULL;
+    enum v4l2_error_e ret  = V4L2_ERROR_NONE;
 
     FD_ZERO(&fds);
     FD_SET(obj->deviceFd, &fds);
@@ -678,16 +809,12 @@ static enum v4l2_error_e awaitData_f(struct v4l2_s *obj, int32_t timeout_ms)
     maxFd = (obj->deviceFd > obj->quitFd[V4L2_PIPE_READ] ? obj->deviceFd : obj->quitFd[V4L2_PIPE_READ]);
 
     if (timeout_ms > 0) {
-        ASSERT((tv = calloc(1, sizeof(struct timeval))));
-        tv->tv_sec  = 0;
-        tv->tv_usec = timeout_ms * 1000;
+        timeout.tv_sec  = timeout_ms / 1000;
+        timeout.tv_usec = (timeout_ms % 1000) * 1000;
+        tv              = &timeout;
     }
 
     selectRetval = select(maxFd + 1, &fds, NULL, NULL, tv);
-    
-    if (tv) {
-        free(tv);
-    }
 
     if (selectRetval == -1) { /* Interrupted */
         goto exit;
@@ -735,51 +862,91 @@ static enum v4l2_error_e queueBuffer_f(struct v4l2_s *obj, uint32_t index)
 {
     ASSERT(obj && (obj->deviceFd != -1));
     
-    struct v4l2_buffer buffer = {0};
+    struct v4l2_buffer buffer                  = {0};
+    struct v4l2_plane planes[VIDEO_MAX_PLANES] = {{0}};
+    struct v4l2_mapping_buffer_s *map          = &obj->map[index];
 
     buffer.type   = obj->format.type;
     buffer.memory = obj->memory;
     buffer.index  = index;
 
-    if (buffer.memory == V4L2_MEMORY_USERPTR) {
-        buffer.m.userptr = (uint64_t)obj->map[index].start;
-        buffer.length    = (uint32_t)obj->map[index].length;
+    if (obj->isMplane) {
+        uint32_t p;
+        for (p = 0; p < map->nbPlanes; p++) {
+            planes[p].length = (uint32_t)map->planes[p].length;
+
+            if (buffer.memory == V4L2_MEMORY_USERPTR) {
+                planes[p].m.userptr = (uint64_t)map->planes[p].start;
+            }
+            else if (buffer.memory == V4L2_MEMORY_DMABUF) {
+                planes[p].m.fd = map->planes[p].dmabufFd;
+            }
+        }
+
+        buffer.m.planes = planes;
+        buffer.length   = map->nbPlanes;
+    }
+    else if (buffer.memory == V4L2_MEMORY_USERPTR) {
+        buffer.m.userptr = (uint64_t)map->planes[0].start;
+        buffer.length    = (uint32_t)map->planes[0].length;
+    }
+    else if (buffer.memory == V4L2_MEMORY_DMABUF) {
+        buffer.m.fd   = map->planes[0].dmabufFd;
+        buffer.length = (uint32_t)map->planes[0].length;
     }
 
     return v4l2Ioctl_f(obj->deviceFd, VIDIOC_QBUF, &buffer);
 }
 
 /*!
- * \fn static enum v4l2_error_e dequeueBuffer_f(struct v4l2_s *obj)
+ * \fn static enum v4l2_error_e dequeueBuffer_f(struct v4l2_s *obj,
+ *                                              struct v4l2_dequeued_buffer_s *bufferOut)
  * \brief Dequeue video buffer
  * \param[in] obj
+ * \param[out] bufferOut : Index in obj->map of the buffer filled by the driver, size of the
+ *                         payload, timestamp and sequence number
  * \return V4L2_ERROR_NONE on success
  * \return V4L2_ERROR_INIT on error
  */
-static enum v4l2_error_e dequeueBuffer_f(struct v4l2_s *obj)
+static enum v4l2_error_e dequeueBuffer_f(struct v4l2_s *obj,
+                                         struct v4l2_dequeued_buffer_s *bufferOut)
 {
-    ASSERT(obj && (obj->deviceFd != -1));
+    ASSERT(obj && (obj->deviceFd != -1) && bufferOut);
     
-    struct v4l2_buffer buffer = {0};
+    struct v4l2_buffer buffer                  = {0};
+    struct v4l2_plane planes[VIDEO_MAX_PLANES] = {{0}};
 
     buffer.type   = obj->format.type;
     buffer.memory = obj->memory;
 
+    if (obj->isMplane) {
+        buffer.m.planes = planes;
+        buffer.length   = VIDEO_MAX_PLANES;
+    }
+
     if (v4l2Ioctl_f(obj->deviceFd, VIDIOC_DQBUF, &buffer) != V4L2_ERROR_NONE) {
+        /* Logging may overwrite errno */
+        int32_t error = errno;
         Loge("Failed to dequeue buffer");
-        return V4L2_ERROR_IO;
+        return (error == ENODEV ? V4L2_ERROR_DISCONNECTED : V4L2_ERROR_IO);
     }
 
     uint32_t i = 0;
     switch (buffer.memory) {
         case V4L2_MEMORY_MMAP:
+        case V4L2_MEMORY_DMABUF:
             i = buffer.index;
             break;
             
         case V4L2_MEMORY_USERPTR:
+            if (obj->isMplane) {
+                i = buffer.index;
+                break;
+            }
+
             for (i = 0; i < obj->nbBuffers; i++) {
-                if ((buffer.m.userptr == (uint64_t)obj->map[i].start)
-                    && (buffer.length == obj->map[i].length)) {
+                if ((buffer.m.userptr == (uint64_t)obj->map[i].planes[0].start)
+                    && (buffer.length == obj->map[i].planes[0].length)) {
                     break;
                 }
             }
@@ -791,9 +958,196 @@ static enum v4l2_error_e dequeueBuffer_f(struct v4l2_s *obj)
     
     ASSERT(i < obj->nbBuffers);
 
+    bufferOut->index       = i;
+    bufferOut->timestamp   = buffer.timestamp;
+    bufferOut->sequence    = buffer.sequence;
+    bufferOut->isMonotonic = ((buffer.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK)
+                                 == V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC);
+
+    uint32_t p, bytesused;
+    for (p = 0; p < obj->map[i].nbPlanes; p++) {
+        bytesused = (obj->isMplane ? planes[p].bytesused : buffer.bytesused);
+
+        /* Some drivers do not set bytesused */
+        if ((bytesused > 0) && (bytesused <= obj->map[i].planes[p].length)) {
+            bufferOut->bytesused[p] = bytesused;
+        }
+        else {
+            bufferOut->bytesused[p] = obj->map[i].planes[p].length;
+        }
+    }
+
     return V4L2_ERROR_NONE;
 }
 
+/*!
+ * \fn static enum v4l2_error_e disconnectDevice_f(struct v4l2_s *obj)
+ * \brief Close a device which has gone away but keep what is needed to reconnect to it quickly
+ * \param[in] obj
+ * \return V4L2_ERROR_NONE on success
+ */
+static enum v4l2_error_e disconnectDevice_f(struct v4l2_s *obj)
+{
+    ASSERT(obj);
+
+    if (obj->deviceFd == -1) {
+        return V4L2_ERROR_NONE;
+    }
+
+    /* Expected to fail if device has been unplugged. Mappings stay valid until munmap() */
+    (void)ioctl(obj->deviceFd, VIDIOC_STREAMOFF, &obj->format.type);
+
+    close(obj->deviceFd);
+    obj->deviceFd = -1;
+
+    return V4L2_ERROR_NONE;
+}
+
+/*!
+ * \fn static enum v4l2_error_e reconnectDevice_f(struct v4l2_s *obj)
+ * \brief Reopen device then restore the configuration and buffers negotiated when it was started
+ * \param[in] obj
+ * \return V4L2_ERROR_NONE on success
+ * \return V4L2_ERROR_UNKNOWN_DEVICE if device is not back yet
+ * \return V4L2_ERROR_BAD_CAPS if device came back with another geometry
+ */
+static enum v4l2_error_e reconnectDevice_f(struct v4l2_s *obj)
+{
+    ASSERT(obj && (obj->deviceFd == -1) && obj->map);
+
+    enum v4l2_error_e ret                      = V4L2_ERROR_NONE;
+    struct v4l2_format format                  = obj->format;
+    struct v4l2_requestbuffers req             = {0};
+    struct v4l2_buffer buf                     = {0};
+    struct v4l2_plane planes[VIDEO_MAX_PLANES] = {{0}};
+    struct v4l2_mapping_plane_s *plane         = NULL;
+    void *start                                = NULL;
+
+    if (access(obj->path, F_OK) != 0) {
+        return V4L2_ERROR_UNKNOWN_DEVICE;
+    }
+
+    /* Node may be created before its permissions are set */
+    if ((obj->deviceFd = open(obj->path, O_RDWR)) < 0) {
+        Logd("Failed to open \"%s\" - %s", obj->path, strerror(errno));
+        return V4L2_ERROR_UNKNOWN_DEVICE;
+    }
+
+    if (v4l2Ioctl_f(obj->deviceFd, VIDIOC_S_FMT, &format) != V4L2_ERROR_NONE) {
+        Loge("Failed to restore video format");
+        ret = V4L2_ERROR_IO;
+        goto exit;
+    }
+
+    if (obj->isMplane ? ((format.fmt.pix_mp.width != obj->format.fmt.pix_mp.width)
+                         || (format.fmt.pix_mp.height != obj->format.fmt.pix_mp.height)
+                         || (format.fmt.pix_mp.pixelformat != obj->format.fmt.pix_mp.pixelformat)
+                         || (format.fmt.pix_mp.num_planes != obj->format.fmt.pix_mp.num_planes))
+                      : ((format.fmt.pix.width != obj->format.fmt.pix.width)
+                         || (format.fmt.pix.height != obj->format.fmt.pix.height)
+                         || (format.fmt.pix.pixelformat != obj->format.fmt.pix.pixelformat))) {
+        Loge("\"%s\" came back with another format", obj->path);
+        ret = V4L2_ERROR_BAD_CAPS;
+        goto exit;
+    }
+
+    /* Not fatal: geometry is checked below */
+    if ((obj->streamparm.type != 0)
+        && (v4l2Ioctl_f(obj->deviceFd, VIDIOC_S_PARM, &obj->streamparm) != V4L2_ERROR_NONE)) {
+        Logw("Failed to restore framerate");
+    }
+
+    if ((obj->cropSelection.type != 0)
+        && (v4l2Ioctl_f(obj->deviceFd, VIDIOC_S_SELECTION, &obj->cropSelection)
+                != V4L2_ERROR_NONE)) {
+        Logw("Failed to restore cropping area");
+    }
+
+    if ((obj->composeSelection.type != 0)
+        && (v4l2Ioctl_f(obj->deviceFd, VIDIOC_S_SELECTION, &obj->composeSelection)
+                != V4L2_ERROR_NONE)) {
+        Logw("Failed to restore composing area");
+    }
+
+    req.count  = obj->nbBuffers;
+    req.type   = obj->format.type;
+    req.memory = obj->memory;
+
+    if (v4l2Ioctl_f(obj->deviceFd, VIDIOC_REQBUFS, &req) != V4L2_ERROR_NONE) {
+        Loge("Failed to request buffers");
+        ret = V4L2_ERROR_IO;
+        goto exit;
+    }
+
+    if (req.count != obj->nbBuffers) {
+        Loge("Got %u buffers instead of %u", req.count, obj->nbBuffers);
+        ret = V4L2_ERROR_BAD_CAPS;
+        goto exit;
+    }
+
+    /* USERPTR and DMABUF buffers belong to us and are given again to the driver when queued */
+    if (obj->memory != V4L2_MEMORY_MMAP) {
+        return V4L2_ERROR_NONE;
+    }
+
+    uint32_t i, p;
+    for (i = 0; i < obj->nbBuffers; i++) {
+        buf.type   = req.type;
+        buf.memory = req.memory;
+        buf.index  = i;
+
+        if (obj->isMplane) {
+            buf.m.planes = planes;
+            buf.length   = VIDEO_MAX_PLANES;
+        }
+
+        if (v4l2Ioctl_f(obj->deviceFd, VIDIOC_QUERYBUF, &buf) != V4L2_ERROR_NONE) {
+            Loge("Failed to query buffer");
+            ret = V4L2_ERROR_IO;
+            goto exit;
+        }
+
+        for (p = 0; p < obj->map[i].nbPlanes; p++) {
+            plane = &obj->map[i].planes[p];
+
+            if ((obj->isMplane ? planes[p].length : buf.length) != plane->length) {
+                Loge("Size of buffer %u changed", i);
+                ret = V4L2_ERROR_BAD_CAPS;
+                goto exit;
+            }
+
+            plane->offset = (obj->isMplane ? planes[p].m.mem_offset : buf.m.offset);
+
+            /* Same address so that frames still held by listeners remain readable */
+            start = mmap(plane->start, plane->length, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_FIXED, obj->deviceFd, plane->offset);
+
+            if (start == MAP_FAILED) {
+                Loge("mmap() failed - %s", strerror(errno));
+                ret = V4L2_ERROR_MEMORY;
+                goto exit;
+            }
+
+            if (plane->dmabufFd != -1) {
+                close(plane->dmabufFd);
+                plane->dmabufFd = exportBuffer_f(obj, i, p);
+            }
+        }
+
+        memset(&buf, 0, sizeof(struct v4l2_buffer));
+        memset(planes, 0, sizeof(planes));
+    }
+
+    return V4L2_ERROR_NONE;
+
+exit:
+    /* Mappings already restored keep pointing to valid memory */
+    close(obj->deviceFd);
+    obj->deviceFd = -1;
+
+    return ret;
+}
+
 /* -------------------------------------------------------------------------------------------- */
 /* ///////////////////////////// PRIVATE FUNCTIONS IMPLEMENTATION ///////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
@@ -811,9 +1165,71 @@ static enum v4l2_error_e v4l2Ioctl_f(int32_t fd, uint64_t req, void *args)
     while ((-1 == ret) && (EINTR == errno));
     
     if (ret == -1) {
-        Loge("ioctl() failed - %s", strerror(errno));
+        /* Kept for callers e.g. to detect an unplugged device */
+        int32_t error = errno;
+        Loge("ioctl() failed - %s", strerror(error));
+        errno = error;
         return V4L2_ERROR_IO;
     }
     
     return V4L2_ERROR_NONE;
 }
+
+/*!
+ * Export buffer as a dma-buf so that it can be shared without copy. Returns -1 on error
+ */
+static int32_t exportBuffer_f(struct v4l2_s *obj, uint32_t index, uint32_t plane)
+{
+    ASSERT(obj && (obj->deviceFd != -1));
+
+    struct v4l2_exportbuffer expbuf = {0};
+
+    expbuf.type  = obj->format.type;
+    expbuf.index = index;
+    expbuf.plane = plane;
+    expbuf.flags = O_RDWR | O_CLOEXEC;
+
+    if (v4l2Ioctl_f(obj->deviceFd, VIDIOC_EXPBUF, &expbuf) != V4L2_ERROR_NONE) {
+        Logd("Plane %u of buffer %u of \"%s\" cannot be exported as dma-buf",
+              plane, index, obj->path);
+        return -1;
+    }
+
+    return expbuf.fd;
+}
+
+/*!
+ * Allocate a dma-buf from heapFd to be imported by the driver. Returns -1 on error
+ */
+static int32_t allocateDmabuf_f(int32_t heapFd, size_t length)
+{
+    ASSERT(heapFd != -1);
+
+    struct dma_heap_allocation_data data = {0};
+
+    data.len      = length;
+    data.fd_flags = O_RDWR | O_CLOEXEC;
+
+    while (ioctl(heapFd, DMA_HEAP_IOCTL_ALLOC, &data) < 0) {
+        if (errno != EINTR) {
+            Loge("Failed to allocate dma-buf of %lu bytes - %s", length, strerror(errno));
+            return -1;
+        }
+    }
+
+    return (int32_t)data.fd;
+}
+
+/*!
+ * Size of a plane as negotiated with the driver
+ */
+static size_t getPlaneSize_f(struct v4l2_s *obj, uint32_t plane)
+{
+    ASSERT(obj);
+
+    if (obj->isMplane) {
+        return obj->format.fmt.pix_mp.plane_fmt[plane].sizeimage;
+    }
+
+    return obj->format.fmt.pix.sizeimage;
+}
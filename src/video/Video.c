@@ -31,14 +31,23 @@
 /* ////////////////////////////////////////// HEADERS ///////////////////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
 
+#include <poll.h>
 #include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
 #include <sys/types.h>
 #include <time.h>
 
 #include "utils/List.h"
 #include "utils/Log.h"
+#include "utils/Reactor.h"
+#include "utils/Ring.h"
 #include "utils/Task.h"
 
+#include "video/Clip.h"
+#include "video/FileSource.h"
+#include "video/Sync.h"
 #include "video/Video.h"
 
 /* -------------------------------------------------------------------------------------------- */
@@ -50,11 +59,29 @@
 
 #define FRAMES_HANLDER_TASK_NAME "video-framesHandlerTask"
 #define NOTIFICATION_TASK_NAME   "video-notificationTask"
+#define CAPTURE_REACTOR_NAME     "video-capture"
+#define DELIVERY_TASK_NAME       "video-delivery"
+#define HOTPLUG_TASK_NAME        "video-hotplugTask"
+
+/* Consecutive failures after which device is reopened even if still present */
+#define MAX_DEQUEUE_ERRORS       10
+
+/* Device is also probed periodically in case its directory cannot be watched */
+#define HOTPLUG_RETRY_MS         WAIT_TIME_1S
+
+/* Used if neither syncTolerance_us nor desiredFps is set */
+#define DEFAULT_SYNC_TOLERANCE_US 10000
 
 /* -------------------------------------------------------------------------------------------- */
 /* ////////////////////////////////////////// TYPES /////////////////////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
 
+struct video_frame_s {
+    uint32_t               refCount;
+    struct video_buffer_s  buffer;
+    struct video_context_s *ctx;
+};
+
 struct video_context_s {
     volatile uint8_t      quit;
 
@@ -62,25 +89,95 @@ struct video_context_s {
     struct task_s         *videoTask;
 
     pthread_mutex_t       framesHandlerLock;
+    pthread_cond_t        framesHandlerCond;
     struct task_params_s  framesHandlerParams;
 
+    struct video_frame_s  *frames;
+    uint32_t              nbQueuedBuffers;
+
+    /* Shared capture threads (NULL if device has its own tasks) */
+    struct reactor_s      *reactor;
+    int32_t               notificationFd;
+    uint8_t               captureSuspended;
+
+    struct ring_s         *framesRing;
+    sem_t                 framesRingSem;
+
     sem_t                 notificationSem;
     pthread_mutex_t       notificationLock;
     struct task_params_s  notificationParams;
 
-    pthread_mutex_t       bufferLock;
-
     struct video_params_s params;
 
-    volatile uint64_t     nbFramesLost;
+    volatile uint64_t     nbCapturedFrames;
+    volatile uint64_t     nbNotifiedFrames;
+    volatile uint64_t     nbDroppedFrames;
+    volatile uint64_t     nbLostFrames;
+    uint32_t              lastSequence;
+
+    volatile uint64_t     lastDequeueLatency_us;
+    volatile uint64_t     lastNotifyLatency_us;
+    volatile uint64_t     maxNotifyLatency_us;
 
     struct v4l2_s         *v4l2;
 
     struct video_area_s   finalVideoArea;
+
+    /* Change detection - NULL if disabled */
+    struct motion_s          *motion;
+    struct converter_frame_s motionFrame; /* Layout of captured frames */
+    uint8_t                  isMoving;
+    uint64_t                 nextKeepAlive_us;
+    volatile uint64_t        nbStillFrames;
+
+    /* Pre-event clip - NULL if disabled */
+    struct clip_s            *clip;
+
+    /* Hot-plug recovery - Not used by file sources */
+    uint8_t                  isDisconnected; /* Protected by framesHandlerLock */
+    uint32_t                 nbDequeueErrors;
+    sem_t                    hotplugSem;
+    struct task_params_s     hotplugParams;
+    volatile uint64_t        nbReconnections;
+    volatile uint64_t        lastReconnectDuration_us;
+
+    /* Sync group - NULL if not synchronized */
+    struct sync_s            *sync;
+    uint32_t                 syncMember;
+};
+
+struct video_listener_context_s {
+    struct video_listener_s listener;
+    struct video_context_s  *ctx;
+
+    /* Last frame given to listener */
+    struct video_frame_s    *lastFrame;
+
+    /* Decimation */
+    uint64_t                nbSeenFrames;
+    uint64_t                minInterval_us;
+    uint64_t                nextDelivery_us;
+
+    /* Asynchronous delivery */
+    volatile uint8_t        quit;
+    struct ring_s           *queue;
+    sem_t                   queueSem;
+    struct task_params_s    deliveryParams;
+
+    uint64_t                nbDroppedFrames;
+};
+
+struct video_sync_group_s {
+    char          name[MAX_NAME_SIZE];
+    struct sync_s *sync;
 };
 
 struct video_private_data_s {
-    struct list_s *videosList;
+    struct list_s    *videosList;
+    struct reactor_s *reactor;
+
+    /* Groups exist as long as one of their devices is started */
+    struct list_s    *syncGroupsList;
 };
 
 /* -------------------------------------------------------------------------------------------- */
@@ -92,10 +189,25 @@ static enum video_error_e registerListener_f(struct video_s *obj, struct video_p
 static enum video_error_e unregisterListener_f(struct video_s *obj, struct video_params_s *params,
                                                struct video_listener_s *listener);
 
+static enum video_error_e registerSyncListener_f(struct video_s *obj, const char *syncGroup,
+                                                 struct video_sync_listener_s *listener);
+static enum video_error_e unregisterSyncListener_f(struct video_s *obj, const char *syncGroup,
+                                                   struct video_sync_listener_s *listener);
+static enum video_error_e getSyncStats_f(struct video_s *obj, const char *syncGroup,
+                                         struct video_sync_stats_s *stats);
+
 static enum video_error_e getFinalVideoArea_f(struct video_s *obj, struct video_params_s *params,
                                               struct video_area_s *videoArea);
 static enum video_error_e getMaxBufferSize_f(struct video_s *obj, struct video_params_s *params,
                                              size_t *size);
+static enum video_error_e getStats_f(struct video_s *obj, struct video_params_s *params,
+                                     struct video_stats_s *stats);
+
+static enum video_error_e retainBuffer_f(struct video_s *obj, struct video_buffer_s *videoBuffer);
+static enum video_error_e releaseBuffer_f(struct video_s *obj, struct video_buffer_s *videoBuffer);
+
+static enum video_error_e dumpClip_f(struct video_s *obj, struct video_params_s *params,
+                                     const char *pathPrefix, uint32_t postEvent_s);
 
 static enum video_error_e startDeviceCapture_f(struct video_s *obj, struct video_params_s *params);
 static enum video_error_e stopDeviceCapture_f(struct video_s *obj, struct video_params_s *params);
@@ -104,18 +216,55 @@ static enum video_error_e stopDeviceCapture_f(struct video_s *obj, struct video_
 /* /////////////////////////////// PRIVATE FUNCTIONS PROTOTYPES /////////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
 
-static enum video_error_e lockBuffer_f(struct video_s *obj, struct video_context_s *ctx);
-static enum video_error_e unlockBuffer_f(struct video_s *obj, struct video_context_s *ctx);
+static enum video_error_e retainFrame_f(struct video_frame_s *frame);
+static enum video_error_e releaseFrame_f(struct video_frame_s *frame);
 
 static enum video_error_e initVideoContext_f(struct video_context_s **ctx,
                                              struct video_params_s *params);
 static enum video_error_e uninitVideoContext_f(struct video_context_s **ctx);
 static enum video_error_e getVideoContext_f(struct video_s *obj, char *videoName,
                                             struct video_context_s **ctxOut);
+static uint8_t isFileSource_f(const char *path);
+
+static enum video_error_e initListenerContext_f(struct video_listener_context_s **listenerCtx,
+                                                struct video_context_s *ctx,
+                                                struct video_listener_s *listener);
+static void uninitListenerContext_f(struct video_listener_context_s **listenerCtx);
+
+static uint32_t getBytesPerLine_f(struct video_context_s *ctx, uint32_t plane);
+
+static void initChangeDetection_f(struct video_context_s *ctx);
+static uint8_t isFrameChanged_f(struct video_context_s *ctx, struct video_frame_s *frame);
+static void initClip_f(struct video_context_s *ctx);
+
+static void joinSyncGroup_f(struct video_s *obj, struct video_context_s *ctx);
+static void leaveSyncGroup_f(struct video_s *obj, struct video_context_s *ctx);
+static struct video_sync_group_s *getSyncGroup_f(struct list_s *list, const char *name);
+
+static void captureFrame_f(struct video_context_s *ctx);
+static void notifyListeners_f(struct video_context_s *ctx);
+static uint8_t isFrameWanted_f(struct video_listener_context_s *listenerCtx);
+static void queueFrame_f(struct video_listener_context_s *listenerCtx,
+                         struct video_frame_s *frame);
+static void deliverFrame_f(struct video_listener_context_s *listenerCtx,
+                           struct video_frame_s *frame);
+static void signalNotification_f(struct video_context_s *ctx);
+static void updateCaptureState_f(struct video_context_s *ctx);
+
+static void onDeviceLost_f(struct video_context_s *ctx);
+static void recoverDevice_f(struct video_context_s *ctx);
+static enum video_error_e restartCapture_f(struct video_context_s *ctx);
+static int32_t watchDevice_f(struct video_context_s *ctx);
+static void waitDevice_f(struct video_context_s *ctx, int32_t watchFd);
 
 static void framesHandlerFct_f(struct task_params_s *params);
 static void notificationFct_f(struct task_params_s *params);
-static void framesHandlerAtExit_f(struct task_params_s *params);
+static void deliveryFct_f(struct task_params_s *params);
+static void hotplugFct_f(struct task_params_s *params);
+
+static void onCaptureEventCb(struct reactor_s *obj, int32_t fd, uint32_t events, void *userData);
+static void onNotificationEventCb(struct reactor_s *obj, int32_t fd, uint32_t events,
+                                  void *userData);
 
 static uint8_t compareVideoCb(struct list_s *obj, void *elementToCheck, void *userData);
 static void releaseVideoCb(struct list_s *obj, void *element);
@@ -123,6 +272,10 @@ static void releaseVideoCb(struct list_s *obj, void *element);
 static uint8_t compareListenerCb(struct list_s *obj, void *elementToCheck, void *userData);
 static void releaseListenerCb(struct list_s *obj, void *element);
 
+static uint8_t compareSyncGroupCb(struct list_s *obj, void *elementToCheck, void *userData);
+static void releaseSyncGroupCb(struct list_s *obj, void *element);
+static void onSyncReleaseCb(struct video_buffer_s *videoBuffer, void *userData);
+
 /* -------------------------------------------------------------------------------------------- */
 /* /////////////////////////////////////// INITIALIZER //////////////////////////////////////// */
 /* -------------------------------------------------------------------------------------------- */
@@ -130,9 +283,9 @@ static void releaseListenerCb(struct list_s *obj, void *element);
 /*!
  *
  */
-enum video_error_e Video_Init(struct video_s **obj)
+enum video_error_e Video_Init(struct video_s **obj, struct video_init_params_s *params)
 {
-    ASSERT(obj && (*obj = calloc(1, sizeof(struct video_s))));
+    ASSERT(obj && params && (*obj = calloc(1, sizeof(struct video_s))));
 
     struct video_private_data_s *pData;
     ASSERT((pData = calloc(1, sizeof(struct video_private_data_s))));
@@ -147,17 +300,53 @@ enum video_error_e Video_Init(struct video_s **obj)
         goto exit;
     }
 
-    (*obj)->registerListener   = registerListener_f;
-    (*obj)->unregisterListener = unregisterListener_f;
-    (*obj)->getFinalVideoArea  = getFinalVideoArea_f;
-    (*obj)->getMaxBufferSize   = getMaxBufferSize_f;
-    (*obj)->startDeviceCapture = startDeviceCapture_f;
-    (*obj)->stopDeviceCapture  = stopDeviceCapture_f;
+    listCallbacks.compareCb = compareSyncGroupCb;
+    listCallbacks.releaseCb = releaseSyncGroupCb;
+
+    if (List_Init(&pData->syncGroupsList, &listCallbacks) != LIST_ERROR_NONE) {
+        Loge("List_Init() failed");
+        goto syncGroups_exit;
+    }
+
+    if (params->nbCaptureThreads > 0) {
+        struct reactor_params_s reactorParams = {0};
+        strcpy(reactorParams.name, CAPTURE_REACTOR_NAME);
+        reactorParams.priority   = PRIORITY_DEFAULT;
+        reactorParams.nbThreads  = params->nbCaptureThreads;
+        reactorParams.pinThreads = params->pinCaptureThreads;
+
+        if (Reactor_Init(&pData->reactor, &reactorParams) != REACTOR_ERROR_NONE) {
+            Loge("Reactor_Init() failed");
+            goto reactor_exit;
+        }
+
+        Logd("%u capture thread(s) shared by all devices", params->nbCaptureThreads);
+    }
+
+    (*obj)->registerListener       = registerListener_f;
+    (*obj)->unregisterListener     = unregisterListener_f;
+    (*obj)->registerSyncListener   = registerSyncListener_f;
+    (*obj)->unregisterSyncListener = unregisterSyncListener_f;
+    (*obj)->getSyncStats           = getSyncStats_f;
+    (*obj)->getFinalVideoArea      = getFinalVideoArea_f;
+    (*obj)->getMaxBufferSize       = getMaxBufferSize_f;
+    (*obj)->getStats               = getStats_f;
+    (*obj)->retainBuffer           = retainBuffer_f;
+    (*obj)->releaseBuffer          = releaseBuffer_f;
+    (*obj)->dumpClip               = dumpClip_f;
+    (*obj)->startDeviceCapture     = startDeviceCapture_f;
+    (*obj)->stopDeviceCapture      = stopDeviceCapture_f;
 
     (*obj)->pData = pData;
 
     return VIDEO_ERROR_NONE;
 
+reactor_exit:
+    (void)List_UnInit(&pData->syncGroupsList);
+
+syncGroups_exit:
+    (void)List_UnInit(&pData->videosList);
+
 exit:
     free(pData);
     free(*obj);
@@ -176,6 +365,11 @@ enum video_error_e Video_UnInit(struct video_s **obj)
     struct video_private_data_s *pData = (*obj)->pData;
 
     (void)List_UnInit(&pData->videosList);
+    (void)List_UnInit(&pData->syncGroupsList);
+
+    if (pData->reactor) {
+        (void)Reactor_UnInit(&pData->reactor);
+    }
 
     free(pData);
 
@@ -218,20 +412,21 @@ static enum video_error_e registerListener_f(struct video_s *obj, struct video_p
         goto exit;
     }
 
+    struct video_listener_context_s *listenerCtx = NULL;
+
+    if ((ret = initListenerContext_f(&listenerCtx, ctx, listener)) != VIDEO_ERROR_NONE) {
+        Loge("Failed to init %s's context", listener->name);
+        goto exit;
+    }
+
     if (list->lock(list) != LIST_ERROR_NONE) {
         Loge("Failed to lock list");
+        uninitListenerContext_f(&listenerCtx);
         ret = VIDEO_ERROR_LOCK;
         goto exit;
     }
 
-    struct video_listener_s *newListener;
-    ASSERT((newListener = calloc(1, sizeof(struct video_listener_s))));
-
-    strncpy(newListener->name, listener->name, sizeof(newListener->name));
-    newListener->onVideoBufferAvailableCb = listener->onVideoBufferAvailableCb;
-    newListener->userData                 = listener->userData;
-
-    list->add(list, (void*)newListener);
+    list->add(list, (void*)listenerCtx);
 
     (void)list->unlock(list);
 
@@ -286,6 +481,116 @@ exit:
     return ret;
 }
 
+/*!
+ *
+ */
+static enum video_error_e registerSyncListener_f(struct video_s *obj, const char *syncGroup,
+                                                 struct video_sync_listener_s *listener)
+{
+    ASSERT(obj && obj->pData && syncGroup);
+
+    if (!listener || !listener->onFrameSetAvailableCb) {
+        Loge("Bad params");
+        return VIDEO_ERROR_PARAMS;
+    }
+
+    struct video_private_data_s *pData = (struct video_private_data_s*)(obj->pData);
+    struct video_sync_group_s *group   = NULL;
+    enum video_error_e ret             = VIDEO_ERROR_NONE;
+
+    if (pData->syncGroupsList->lock(pData->syncGroupsList) != LIST_ERROR_NONE) {
+        Loge("Failed to lock syncGroupsList");
+        return VIDEO_ERROR_LOCK;
+    }
+
+    if (!(group = getSyncGroup_f(pData->syncGroupsList, syncGroup))) {
+        Loge("No device started in sync group %s", syncGroup);
+        ret = VIDEO_ERROR_LIST;
+        goto exit;
+    }
+
+    if (group->sync->addListener(group->sync, listener) != SYNC_ERROR_NONE) {
+        Loge("Failed to add %s to sync group %s", listener->name, syncGroup);
+        ret = VIDEO_ERROR_SYNC;
+    }
+
+exit:
+    (void)pData->syncGroupsList->unlock(pData->syncGroupsList);
+
+    return ret;
+}
+
+/*!
+ *
+ */
+static enum video_error_e unregisterSyncListener_f(struct video_s *obj, const char *syncGroup,
+                                                   struct video_sync_listener_s *listener)
+{
+    ASSERT(obj && obj->pData && syncGroup);
+
+    if (!listener) {
+        Loge("Bad params");
+        return VIDEO_ERROR_PARAMS;
+    }
+
+    struct video_private_data_s *pData = (struct video_private_data_s*)(obj->pData);
+    struct video_sync_group_s *group   = NULL;
+    enum video_error_e ret             = VIDEO_ERROR_NONE;
+
+    if (pData->syncGroupsList->lock(pData->syncGroupsList) != LIST_ERROR_NONE) {
+        Loge("Failed to lock syncGroupsList");
+        return VIDEO_ERROR_LOCK;
+    }
+
+    /* Listeners are dropped with the group when its last device is stopped */
+    if (!(group = getSyncGroup_f(pData->syncGroupsList, syncGroup))) {
+        ret = VIDEO_ERROR_LIST;
+        goto exit;
+    }
+
+    if (group->sync->removeListener(group->sync, listener) != SYNC_ERROR_NONE) {
+        ret = VIDEO_ERROR_SYNC;
+    }
+
+exit:
+    (void)pData->syncGroupsList->unlock(pData->syncGroupsList);
+
+    return ret;
+}
+
+/*!
+ *
+ */
+static enum video_error_e getSyncStats_f(struct video_s *obj, const char *syncGroup,
+                                         struct video_sync_stats_s *stats)
+{
+    ASSERT(obj && obj->pData && syncGroup && stats);
+
+    struct video_private_data_s *pData = (struct video_private_data_s*)(obj->pData);
+    struct video_sync_group_s *group   = NULL;
+    enum video_error_e ret             = VIDEO_ERROR_NONE;
+
+    if (pData->syncGroupsList->lock(pData->syncGroupsList) != LIST_ERROR_NONE) {
+        Loge("Failed to lock syncGroupsList");
+        return VIDEO_ERROR_LOCK;
+    }
+
+    if (!(group = getSyncGroup_f(pData->syncGroupsList, syncGroup))) {
+        Loge("No device started in sync group %s", syncGroup);
+        ret = VIDEO_ERROR_LIST;
+        goto exit;
+    }
+
+    if (group->sync->getStats(group->sync, stats) != SYNC_ERROR_NONE) {
+        ret = VIDEO_ERROR_SYNC;
+    }
+
+exit:
+    (void)pData->syncGroupsList->unlock(pData->syncGroupsList);
+
+    return ret;
+}
+
 /*!
  *
  */
@@ -340,6 +645,100 @@ exit:
     return ret;
 }
 
+/*!
+ *
+ */
+static enum video_error_e getStats_f(struct video_s *obj, struct video_params_s *params,
+                                     struct video_stats_s *stats)
+{
+    ASSERT(obj && obj->pData && params && stats);
+
+    struct video_context_s *ctx = NULL;
+    enum video_error_e ret      = VIDEO_ERROR_NONE;
+
+    if ((ret = getVideoContext_f(obj, params->name, &ctx)) != VIDEO_ERROR_NONE) {
+        Loge("Failed to retrieve %s's context", params->name);
+        goto exit;
+    }
+
+    stats->nbCapturedFrames = ctx->nbCapturedFrames;
+    stats->nbNotifiedFrames = ctx->nbNotifiedFrames;
+    stats->nbDroppedFrames  = ctx->nbDroppedFrames;
+    stats->nbLostFrames     = ctx->nbLostFrames;
+    stats->nbStillFrames    = ctx->nbStillFrames;
+    stats->nbReconnections  = ctx->nbReconnections;
+
+    stats->lastDequeueLatency_us = ctx->lastDequeueLatency_us;
+    stats->lastNotifyLatency_us  = ctx->lastNotifyLatency_us;
+    stats->maxNotifyLatency_us   = ctx->maxNotifyLatency_us;
+
+    stats->lastReconnectDuration_us = ctx->lastReconnectDuration_us;
+
+exit:
+    return ret;
+}
+
+/*!
+ *
+ */
+static enum video_error_e retainBuffer_f(struct video_s *obj, struct video_buffer_s *videoBuffer)
+{
+    ASSERT(obj && obj->pData && videoBuffer);
+
+    if (!videoBuffer->reserved) {
+        Loge("Bad params");
+        return VIDEO_ERROR_PARAMS;
+    }
+
+    return retainFrame_f((struct video_frame_s*)videoBuffer->reserved);
+}
+
+/*!
+ *
+ */
+static enum video_error_e releaseBuffer_f(struct video_s *obj, struct video_buffer_s *videoBuffer)
+{
+    ASSERT(obj && obj->pData && videoBuffer);
+
+    if (!videoBuffer->reserved) {
+        Loge("Bad params");
+        return VIDEO_ERROR_PARAMS;
+    }
+
+    return releaseFrame_f((struct video_frame_s*)videoBuffer->reserved);
+}
+
+/*!
+ *
+ */
+static enum video_error_e dumpClip_f(struct video_s *obj, struct video_params_s *params,
+                                     const char *pathPrefix, uint32_t postEvent_s)
+{
+    ASSERT(obj && obj->pData && params && pathPrefix);
+
+    struct video_context_s *ctx = NULL;
+    enum video_error_e ret      = VIDEO_ERROR_NONE;
+
+    if ((ret = getVideoContext_f(obj, params->name, &ctx)) != VIDEO_ERROR_NONE) {
+        Loge("Failed to retrieve %s's context", params->name);
+        goto exit;
+    }
+
+    if (!ctx->clip) {
+        Loge("%s : no pre-event clip - Check clipPreEvent_s", params->name);
+        ret = VIDEO_ERROR_CLIP;
+        goto exit;
+    }
+
+    if (ctx->clip->dump(ctx->clip, pathPrefix, postEvent_s) != CLIP_ERROR_NONE) {
+        Loge("%s : failed to dump clip", params->name);
+        ret = VIDEO_ERROR_CLIP;
+    }
+
+exit:
+    return ret;
+}
+
 /*!
  *
  */
@@ -395,8 +794,8 @@ static enum video_error_e startDeviceCapture_f(struct video_s *obj, struct video
         goto configure_exit;
     }
 
-    ctx->finalVideoArea.width  = (uint32_t)ctx->v4l2->format.fmt.pix.width;
-    ctx->finalVideoArea.height = (uint32_t)ctx->v4l2->format.fmt.pix.height;
+    ctx->finalVideoArea.width  = ctx->v4l2->width;
+    ctx->finalVideoArea.height = ctx->v4l2->height;
 
     uint8_t selectionApiSupported              = 0;
     struct v4l2_selection_params_s cropRect    = {0};
@@ -428,8 +827,8 @@ static enum video_error_e startDeviceCapture_f(struct video_s *obj, struct video
         configureDeviceParams.height = params->composingArea.height;
 
         if (ctx->v4l2->configureDevice(ctx->v4l2, &configureDeviceParams) == V4L2_ERROR_NONE) {
-            ctx->finalVideoArea.width  = ctx->v4l2->format.fmt.pix.width;
-            ctx->finalVideoArea.height = ctx->v4l2->format.fmt.pix.height;
+            ctx->finalVideoArea.width  = ctx->v4l2->width;
+            ctx->finalVideoArea.height = ctx->v4l2->height;
         }
     }
 
@@ -438,24 +837,139 @@ static enum video_error_e startDeviceCapture_f(struct video_s *obj, struct video
     requestBuffersParams.count  = params->count;
     requestBuffersParams.memory = params->memory;
 
+    /* Frames waiting for the other members of the sync group must not starve the driver */
+    if ((params->syncGroup[0] != '\0') && (requestBuffersParams.count <= SYNC_MAX_PENDING_FRAMES)) {
+        Logw("count = %u too low for sync group %s - Using %u",
+                params->count, params->syncGroup, SYNC_MAX_PENDING_FRAMES + 1);
+        requestBuffersParams.count = SYNC_MAX_PENDING_FRAMES + 1;
+    }
+
     if (ctx->v4l2->requestBuffers(ctx->v4l2, &requestBuffersParams) != V4L2_ERROR_NONE) {
         Loge("requestBuffers() failed");
         goto reqBuf_exit;
     }
 
+    /* Wrap buffers so that listeners can access them without any copy */
+    ASSERT((ctx->frames = calloc(ctx->v4l2->nbBuffers, sizeof(struct video_frame_s))));
+
+    uint32_t index, plane;
+    struct video_buffer_s *buffer;
+    struct v4l2_mapping_buffer_s *map;
+
+    for (index = 0; index < ctx->v4l2->nbBuffers; index++) {
+        buffer = &ctx->frames[index].buffer;
+        map    = &ctx->v4l2->map[index];
+
+        for (plane = 0; plane < map->nbPlanes; plane++) {
+            buffer->planes[plane].data         = map->planes[plane].start;
+            buffer->planes[plane].length       = map->planes[plane].length;
+            buffer->planes[plane].dmabufFd     = map->planes[plane].dmabufFd;
+            buffer->planes[plane].bytesPerLine = getBytesPerLine_f(ctx, plane);
+        }
+
+        ctx->frames[index].ctx = ctx;
+        buffer->index          = map->index;
+        buffer->offset         = map->planes[0].offset;
+        buffer->data           = map->planes[0].start;
+        buffer->length         = map->planes[0].length;
+        buffer->dmabufFd       = map->planes[0].dmabufFd;
+        buffer->nbPlanes       = map->nbPlanes;
+        buffer->reserved       = &ctx->frames[index];
+    }
+
+    /* Create ring of frames waiting to be notified. At least one buffer must stay queued */
+    uint32_t nbSlots = (params->nbSlots > 0 ? params->nbSlots : 1);
+
+    if ((ctx->v4l2->nbBuffers > 1) && (nbSlots >= ctx->v4l2->nbBuffers)) {
+        Logw("nbSlots = %u too high - Using %u", nbSlots, ctx->v4l2->nbBuffers - 1);
+        nbSlots = ctx->v4l2->nbBuffers - 1;
+    }
+
+    if (Ring_Init(&ctx->framesRing, nbSlots) != RING_ERROR_NONE) {
+        Loge("Ring_Init() failed");
+        goto start_exit;
+    }
+
+    ctx->params.nbSlots = nbSlots;
+
+    if (params->motionThreshold > 0) {
+        initChangeDetection_f(ctx);
+    }
+
+    if (params->clipPreEvent_s > 0) {
+        initClip_f(ctx);
+    }
+
+    /* Queue all buffers so that the driver always has room to fill while frames are handled */
+    for (index = 0; index < ctx->v4l2->nbBuffers; index++) {
+        if (ctx->v4l2->queueBuffer(ctx->v4l2, index) != V4L2_ERROR_NONE) {
+            Loge("queueBuffer() failed - index %u", index);
+            goto start_exit;
+        }
+    }
+
+    ctx->nbQueuedBuffers = ctx->v4l2->nbBuffers;
+
     /* Start capture */
     if (ctx->v4l2->startCapture(ctx->v4l2) != V4L2_ERROR_NONE) {
         Loge("startCapture() failed");
         goto start_exit;
     }
 
+    /* Reopen device with the same settings if it goes away */
+    if (!isFileSource_f(params->path)) {
+        strcpy(ctx->hotplugParams.name, HOTPLUG_TASK_NAME);
+        ctx->hotplugParams.priority = params->priority;
+        ctx->hotplugParams.fct      = hotplugFct_f;
+        ctx->hotplugParams.fctData  = obj;
+        ctx->hotplugParams.userData = ctx;
+        ctx->hotplugParams.atExit   = NULL;
+
+        if (ctx->videoTask->create(ctx->videoTask, &ctx->hotplugParams) != TASK_ERROR_NONE) {
+            Loge("Failed to create hotplug task");
+            goto hotplugCreate_exit;
+        }
+
+        (void)ctx->videoTask->start(ctx->videoTask, &ctx->hotplugParams);
+    }
+
+    /* Frames are also matched with the ones of the other devices of the group */
+    if (params->syncGroup[0] != '\0') {
+        joinSyncGroup_f(obj, ctx);
+    }
+
+    /* Hand device over to shared capture threads */
+    if (pData->reactor) {
+        ctx->reactor = pData->reactor;
+
+        if ((ctx->notificationFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) < 0) {
+            Loge("eventfd() failed - %s", strerror(errno));
+            goto framesCreate_exit;
+        }
+
+        if (ctx->reactor->add(ctx->reactor, ctx->notificationFd,
+                              onNotificationEventCb, ctx) != REACTOR_ERROR_NONE) {
+            Loge("Failed to watch notification eventfd");
+            goto notificationFd_exit;
+        }
+
+        if (ctx->reactor->add(ctx->reactor, ctx->v4l2->deviceFd,
+                              onCaptureEventCb, ctx) != REACTOR_ERROR_NONE) {
+            Loge("Failed to watch %s", params->path);
+            (void)ctx->reactor->remove(ctx->reactor, ctx->notificationFd);
+            goto notificationFd_exit;
+        }
+
+        return VIDEO_ERROR_NONE;
+    }
+
     /* Start tasks */
     strcpy(ctx->framesHandlerParams.name, FRAMES_HANLDER_TASK_NAME);
     ctx->framesHandlerParams.priority = params->priority;
     ctx->framesHandlerParams.fct      = framesHandlerFct_f;
     ctx->framesHandlerParams.fctData  = obj;
     ctx->framesHandlerParams.userData = ctx;
-    ctx->framesHandlerParams.atExit   = framesHandlerAtExit_f;
+    ctx->framesHandlerParams.atExit   = NULL;
 
     if (ctx->videoTask->create(ctx->videoTask, &ctx->framesHandlerParams) != TASK_ERROR_NONE) {
         Loge("Failed to create framesHandler task");
@@ -482,10 +996,33 @@ static enum video_error_e startDeviceCapture_f(struct video_s *obj, struct video
 notificationCreate_exit:
     (void)ctx->videoTask->destroy(ctx->videoTask, &ctx->framesHandlerParams);
 
+notificationFd_exit:
+    if (ctx->notificationFd != -1) {
+        close(ctx->notificationFd);
+        ctx->notificationFd = -1;
+    }
+
 framesCreate_exit:
+    leaveSyncGroup_f(obj, ctx);
+
+    if (ctx->hotplugParams.fct) {
+        ctx->quit = 1;
+        sem_post(&ctx->hotplugSem);
+        (void)ctx->videoTask->stop(ctx->videoTask, &ctx->hotplugParams);
+        (void)ctx->videoTask->destroy(ctx->videoTask, &ctx->hotplugParams);
+    }
+
+hotplugCreate_exit:
     (void)ctx->v4l2->stopCapture(ctx->v4l2);
     
 start_exit:
+    if (ctx->framesRing) {
+        (void)Ring_UnInit(&ctx->framesRing);
+    }
+
+    free(ctx->frames);
+    ctx->frames = NULL;
+
     (void)ctx->v4l2->releaseBuffers(ctx->v4l2);
 
 reqBuf_exit:
@@ -534,17 +1071,74 @@ static enum video_error_e stopDeviceCapture_f(struct video_s *obj, struct video_
     /* Stop tasks */
     ctx->quit = 1;
 
+    /* Also wakes up hotplug task if device is being waited for */
     (void)ctx->v4l2->stopAwaitingData(ctx->v4l2);
-    sem_post(&ctx->notificationSem);
 
-    (void)ctx->videoTask->stop(ctx->videoTask, &ctx->framesHandlerParams);
-    (void)ctx->videoTask->stop(ctx->videoTask, &ctx->notificationParams);
+    if (ctx->hotplugParams.fct) {
+        sem_post(&ctx->hotplugSem);
+        (void)ctx->videoTask->stop(ctx->videoTask, &ctx->hotplugParams);
+        (void)ctx->videoTask->destroy(ctx->videoTask, &ctx->hotplugParams);
+    }
+
+    if (ctx->reactor) {
+        /* Already removed if device has been unplugged */
+        if (ctx->v4l2->deviceFd != -1) {
+            (void)ctx->reactor->remove(ctx->reactor, ctx->v4l2->deviceFd);
+        }
+        (void)ctx->reactor->remove(ctx->reactor, ctx->notificationFd);
 
-    (void)ctx->videoTask->destroy(ctx->videoTask, &ctx->framesHandlerParams);
-    (void)ctx->videoTask->destroy(ctx->videoTask, &ctx->notificationParams);
+        close(ctx->notificationFd);
+        ctx->notificationFd = -1;
+    }
+    else {
+        sem_post(&ctx->notificationSem);
+        sem_post(&ctx->framesRingSem);
+
+        (void)pthread_mutex_lock(&ctx->framesHandlerLock);
+        (void)pthread_cond_broadcast(&ctx->framesHandlerCond);
+        (void)pthread_mutex_unlock(&ctx->framesHandlerLock);
+
+        (void)ctx->videoTask->stop(ctx->videoTask, &ctx->framesHandlerParams);
+        (void)ctx->videoTask->stop(ctx->videoTask, &ctx->notificationParams);
+
+        (void)ctx->videoTask->destroy(ctx->videoTask, &ctx->framesHandlerParams);
+        (void)ctx->videoTask->destroy(ctx->videoTask, &ctx->notificationParams);
+    }
+
+    /* Frames waiting for the other devices of the group are released here */
+    leaveSyncGroup_f(obj, ctx);
+
+    /* Drop frames still held by listeners or not notified yet */
+    if (ctx->listenersList->lock(ctx->listenersList) == LIST_ERROR_NONE) {
+        (void)ctx->listenersList->removeAll(ctx->listenersList);
+        (void)ctx->listenersList->unlock(ctx->listenersList);
+    }
+
+    void *element = NULL;
+    while (ctx->framesRing->pop(ctx->framesRing, &element) == RING_ERROR_NONE) {
+        (void)releaseFrame_f((struct video_frame_s*)element);
+    }
+
+    Logd("%s : captured = %lu / notified = %lu / dropped = %lu / lost by driver = %lu"
+            " / still = %lu", params->name, ctx->nbCapturedFrames, ctx->nbNotifiedFrames,
+            ctx->nbDroppedFrames, ctx->nbLostFrames, ctx->nbStillFrames);
+    Logd("%s : capture -> notification latency = %lu us (max %lu us)", params->name,
+            ctx->lastNotifyLatency_us, ctx->maxNotifyLatency_us);
+
+    if (ctx->nbReconnections > 0) {
+        Logd("%s : reconnected %lu time(s) - Last restart took %lu us", params->name,
+                ctx->nbReconnections, ctx->lastReconnectDuration_us);
+    }
+
+    if (ctx->isDisconnected) {
+        Logw("%s is still disconnected", params->path);
+    }
+    else if (ctx->nbQueuedBuffers != ctx->v4l2->nbBuffers) {
+        Logw("%u buffer(s) still retained", ctx->v4l2->nbBuffers - ctx->nbQueuedBuffers);
+    }
 
     /* Stop capture */
-    if (ctx->v4l2->stopCapture(ctx->v4l2) != V4L2_ERROR_NONE) {
+    if (!ctx->isDisconnected && (ctx->v4l2->stopCapture(ctx->v4l2) != V4L2_ERROR_NONE)) {
         Loge("stopCapture() failed");
         ret = VIDEO_ERROR_STOP;
     }
@@ -555,6 +1149,11 @@ static enum video_error_e stopDeviceCapture_f(struct video_s *obj, struct video_
         ret = VIDEO_ERROR_STOP;
     }
 
+    (void)Ring_UnInit(&ctx->framesRing);
+
+    free(ctx->frames);
+    ctx->frames = NULL;
+
     /* Close device */
     if (ctx->v4l2->closeDevice(ctx->v4l2) != V4L2_ERROR_NONE) {
         Loge("closeDevice() failed");
@@ -582,31 +1181,66 @@ exit:
 /*!
  *
  */
-static enum video_error_e lockBuffer_f(struct video_s *obj, struct video_context_s *ctx)
+static enum video_error_e retainFrame_f(struct video_frame_s *frame)
 {
-    ASSERT(obj && obj->pData && ctx);
+    ASSERT(frame && frame->ctx);
 
-    if (pthread_mutex_lock(&ctx->bufferLock) != 0) {
+    struct video_context_s *ctx = frame->ctx;
+
+    if (pthread_mutex_lock(&ctx->framesHandlerLock) != 0) {
         Loge("pthread_mutex_lock() failed");
         return VIDEO_ERROR_LOCK;
     }
-    
-    return VIDEO_ERROR_NONE;
-}
+
+    frame->refCount++;
+
+    (void)pthread_mutex_unlock(&ctx->framesHandlerLock);
+
+    return VIDEO_ERROR_NONE;
+}
 
 /*!
- *
+ * Queue buffer again when its last reference is dropped
  */
-static enum video_error_e unlockBuffer_f(struct video_s *obj, struct video_context_s *ctx)
+static enum video_error_e releaseFrame_f(struct video_frame_s *frame)
 {
-    ASSERT(obj && obj->pData && ctx);
+    ASSERT(frame && frame->ctx);
+
+    struct video_context_s *ctx = frame->ctx;
+    enum video_error_e ret      = VIDEO_ERROR_NONE;
 
-    if (pthread_mutex_unlock(&ctx->bufferLock) != 0) {
-        Loge("pthread_mutex_unlock() failed");
+    if (pthread_mutex_lock(&ctx->framesHandlerLock) != 0) {
+        Loge("pthread_mutex_lock() failed");
         return VIDEO_ERROR_LOCK;
     }
 
-    return VIDEO_ERROR_NONE;
+    if (frame->refCount == 0) {
+        Loge("Buffer %u is not retained", frame->buffer.index);
+        ret = VIDEO_ERROR_PARAMS;
+        goto exit;
+    }
+
+    if (--frame->refCount == 0) {
+        /* Queued again once device is back */
+        if (ctx->isDisconnected) {
+            goto exit;
+        }
+
+        if (ctx->v4l2->queueBuffer(ctx->v4l2, frame->buffer.index) != V4L2_ERROR_NONE) {
+            Loge("queueBuffer() failed - index %u", frame->buffer.index);
+            goto exit;
+        }
+
+        ctx->nbQueuedBuffers++;
+        (void)pthread_cond_signal(&ctx->framesHandlerCond);
+
+        updateCaptureState_f(ctx);
+    }
+
+exit:
+    (void)pthread_mutex_unlock(&ctx->framesHandlerLock);
+
+    return ret;
 }
 
 /*!
@@ -620,6 +1254,8 @@ static enum video_error_e initVideoContext_f(struct video_context_s **ctx,
 
     memcpy(&(*ctx)->params, params, sizeof(struct video_params_s));
 
+    (*ctx)->notificationFd = -1;
+
     struct list_callbacks_s listCallbacks = {0};
     listCallbacks.compareCb = compareListenerCb;
     listCallbacks.releaseCb = releaseListenerCb;
@@ -640,6 +1276,16 @@ static enum video_error_e initVideoContext_f(struct video_context_s **ctx,
         goto framesHandlerLock_exit;
     }
 
+    if (pthread_cond_init(&(*ctx)->framesHandlerCond, NULL) != 0) {
+        Loge("pthread_cond_init() failed");
+        goto framesHandlerCond_exit;
+    }
+
+    if (sem_init(&(*ctx)->framesRingSem, 0, 0) != 0) {
+        Loge("sem_init() failed");
+        goto framesRingSem_exit;
+    }
+
     if (sem_init(&(*ctx)->notificationSem, 0, 0) != 0) {
         Loge("sem_init() failed");
         goto notificationSem_exit;
@@ -650,12 +1296,18 @@ static enum video_error_e initVideoContext_f(struct video_context_s **ctx,
         goto notificationLock_exit;
     }
 
-    if (pthread_mutex_init(&(*ctx)->bufferLock, NULL) != 0) {
-        Loge("pthread_mutex_init() failed");
-        goto bufferLock_exit;
+    if (sem_init(&(*ctx)->hotplugSem, 0, 0) != 0) {
+        Loge("sem_init() failed");
+        goto hotplugSem_exit;
     }
 
-    if (V4l2_Init(&(*ctx)->v4l2) != V4L2_ERROR_NONE) {
+    if (isFileSource_f(params->path)) {
+        if (FileSource_Init(&(*ctx)->v4l2) != V4L2_ERROR_NONE) {
+            Loge("FileSource_Init() failed");
+            goto v4l2_exit;
+        }
+    }
+    else if (V4l2_Init(&(*ctx)->v4l2) != V4L2_ERROR_NONE) {
         Loge("V4l2_Init() failed");
         goto v4l2_exit;
     }
@@ -663,15 +1315,21 @@ static enum video_error_e initVideoContext_f(struct video_context_s **ctx,
     return VIDEO_ERROR_NONE;
 
 v4l2_exit:
-    (void)pthread_mutex_destroy(&(*ctx)->bufferLock);
+    (void)sem_destroy(&(*ctx)->hotplugSem);
 
-bufferLock_exit:
+hotplugSem_exit:
     (void)pthread_mutex_destroy(&(*ctx)->notificationLock);
 
 notificationLock_exit:
     (void)sem_destroy(&(*ctx)->notificationSem);
 
 notificationSem_exit:
+    (void)sem_destroy(&(*ctx)->framesRingSem);
+
+framesRingSem_exit:
+    (void)pthread_cond_destroy(&(*ctx)->framesHandlerCond);
+
+framesHandlerCond_exit:
     (void)pthread_mutex_destroy(&(*ctx)->framesHandlerLock);
 
 framesHandlerLock_exit:
@@ -698,13 +1356,29 @@ static enum video_error_e uninitVideoContext_f(struct video_context_s **ctx)
 
     enum video_error_e ret = VIDEO_ERROR_NONE;
 
-    if (V4l2_UnInit(&(*ctx)->v4l2) != V4L2_ERROR_NONE) {
+    if ((*ctx)->motion && (Motion_UnInit(&(*ctx)->motion) != MOTION_ERROR_NONE)) {
+        Loge("Motion_UnInit() failed");
+        ret = VIDEO_ERROR_UNINIT;
+    }
+
+    if ((*ctx)->clip && (Clip_UnInit(&(*ctx)->clip) != CLIP_ERROR_NONE)) {
+        Loge("Clip_UnInit() failed");
+        ret = VIDEO_ERROR_UNINIT;
+    }
+
+    if (isFileSource_f((*ctx)->params.path)) {
+        if (FileSource_UnInit(&(*ctx)->v4l2) != V4L2_ERROR_NONE) {
+            Loge("FileSource_UnInit() failed");
+            ret = VIDEO_ERROR_UNINIT;
+        }
+    }
+    else if (V4l2_UnInit(&(*ctx)->v4l2) != V4L2_ERROR_NONE) {
         Loge("V4l2_UnInit() failed");
         ret = VIDEO_ERROR_UNINIT;
     }
 
-    if (pthread_mutex_destroy(&(*ctx)->bufferLock) != 0) {
-        Loge("pthread_mutex_destroy() failed");
+    if (sem_destroy(&(*ctx)->hotplugSem) != 0) {
+        Loge("sem_destroy() failed");
         ret = VIDEO_ERROR_UNINIT;
     }
 
@@ -718,6 +1392,16 @@ static enum video_error_e uninitVideoContext_f(struct video_context_s **ctx)
         ret = VIDEO_ERROR_UNINIT;
     }
 
+    if (sem_destroy(&(*ctx)->framesRingSem) != 0) {
+        Loge("sem_destroy() failed");
+        ret = VIDEO_ERROR_UNINIT;
+    }
+
+    if (pthread_cond_destroy(&(*ctx)->framesHandlerCond) != 0) {
+        Loge("pthread_cond_destroy() failed");
+        ret = VIDEO_ERROR_UNINIT;
+    }
+
     if (pthread_mutex_destroy(&(*ctx)->framesHandlerLock) != 0) {
         Loge("pthread_mutex_destroy() failed");
         ret = VIDEO_ERROR_UNINIT;
@@ -795,188 +1479,1184 @@ exit:
 }
 
 /*!
- * Capture video frames and wake up notification task
+ * Files are replayed and patterns generated through the same interface as v4l2 devices
  */
-static void framesHandlerFct_f(struct task_params_s *params)
+static uint8_t isFileSource_f(const char *path)
 {
-    ASSERT(params && params->fctData && params->userData);
-    
-    struct video_s *video       = (struct video_s*)params->fctData;
-    struct video_context_s *ctx = (struct video_context_s*)params->userData;
-    
-    uint32_t i;
-    int32_t timeout_ms = -1;
-    
-    switch (ctx->params.awaitMode) {
-        case VIDEO_AWAIT_MODE_BLOCKING:
-            break;
-            
-        case VIDEO_AWAIT_MODE_NON_BLOCKING:
-            timeout_ms = (int32_t)WAIT_TIME_2S;
-            break;
-            
-        default:
-            ;
+    ASSERT(path);
+
+    return (strncmp(path, FILE_SOURCE_SCHEME, strlen(FILE_SOURCE_SCHEME)) == 0)
+           || (strncmp(path, PATTERN_SOURCE_SCHEME, strlen(PATTERN_SOURCE_SCHEME)) == 0);
+}
+
+/*!
+ *
+ */
+static enum video_error_e initListenerContext_f(struct video_listener_context_s **listenerCtx,
+                                                struct video_context_s *ctx,
+                                                struct video_listener_s *listener)
+{
+    ASSERT(listenerCtx && ctx && listener);
+    ASSERT((*listenerCtx = calloc(1, sizeof(struct video_listener_context_s))));
+
+    strncpy((*listenerCtx)->listener.name, listener->name, sizeof((*listenerCtx)->listener.name));
+    (*listenerCtx)->listener.onVideoBufferAvailableCb = listener->onVideoBufferAvailableCb;
+    (*listenerCtx)->listener.userData                 = listener->userData;
+    (*listenerCtx)->listener.maxFps                   = listener->maxFps;
+    (*listenerCtx)->listener.everyNthFrame            = listener->everyNthFrame;
+    (*listenerCtx)->listener.delivery                 = listener->delivery;
+    (*listenerCtx)->listener.queueSize                = listener->queueSize;
+
+    (*listenerCtx)->ctx = ctx;
+
+    if (listener->maxFps > 0) {
+        (*listenerCtx)->minInterval_us = 1000000 / listener->maxFps;
     }
-    
-    for (i = 0; i < ctx->v4l2->nbBuffers; i++) {
-        /* Queue buffer */
-        ctx->v4l2->queueBuffer(ctx->v4l2, i);
 
-        /* Await data */
-        while (!ctx->quit) {
-            if (ctx->v4l2->awaitData(ctx->v4l2, timeout_ms) == V4L2_ERROR_NONE) {
-                break;
-            }
-        }
+    if (listener->delivery == VIDEO_DELIVERY_SYNC) {
+        return VIDEO_ERROR_NONE;
+    }
 
-        if (ctx->quit) {
-            break;
-        }
+    uint32_t queueSize = (listener->queueSize > 0 ? listener->queueSize : 1);
 
-        /* Dequeue buffer */
-        ctx->v4l2->dequeueBuffer(ctx->v4l2);
-            
-        /* Fill in listener's buffer */
-        (void)lockBuffer_f(video, ctx);
-        
-        if (!(video->buffer.data)) {
-            ASSERT((video->buffer.data = calloc(1, ctx->v4l2->maxBufferSize)));
-        }
-        
-        video->buffer.index  = ctx->v4l2->map[i].index;
-        video->buffer.length = ctx->v4l2->map[i].length;
-        video->buffer.offset = ctx->v4l2->map[i].offset;
-        
-        memcpy(video->buffer.data, ctx->v4l2->map[i].start, ctx->v4l2->map[i].length);
-        
-        ctx->nbFramesLost++;
-            
-        (void)unlockBuffer_f(video, ctx);
-        
-        /* Notify listeners */
-        sem_post(&ctx->notificationSem);
+    if (Ring_Init(&(*listenerCtx)->queue, queueSize) != RING_ERROR_NONE) {
+        Loge("Ring_Init() failed");
+        goto ring_exit;
+    }
+
+    if (sem_init(&(*listenerCtx)->queueSem, 0, 0) != 0) {
+        Loge("sem_init() failed");
+        goto sem_exit;
+    }
+
+    struct task_params_s *deliveryParams = &(*listenerCtx)->deliveryParams;
+
+    snprintf(deliveryParams->name, sizeof(deliveryParams->name), "%s-%.32s",
+             DELIVERY_TASK_NAME, listener->name);
+    deliveryParams->priority = ctx->params.priority;
+    deliveryParams->fct      = deliveryFct_f;
+    deliveryParams->fctData  = ctx;
+    deliveryParams->userData = *listenerCtx;
+    deliveryParams->atExit   = NULL;
+
+    if (ctx->videoTask->create(ctx->videoTask, deliveryParams) != TASK_ERROR_NONE) {
+        Loge("Failed to create delivery task");
+        goto task_exit;
     }
+
+    (void)ctx->videoTask->start(ctx->videoTask, deliveryParams);
+
+    return VIDEO_ERROR_NONE;
+
+task_exit:
+    (void)sem_destroy(&(*listenerCtx)->queueSem);
+
+sem_exit:
+    (void)Ring_UnInit(&(*listenerCtx)->queue);
+
+ring_exit:
+    free(*listenerCtx);
+    *listenerCtx = NULL;
+
+    return VIDEO_ERROR_INIT;
 }
 
 /*!
- * Wait for new video frames then notify listeners
+ * Stop delivery task and drop all frames still referenced by listener
  */
-static void notificationFct_f(struct task_params_s *params)
+static void uninitListenerContext_f(struct video_listener_context_s **listenerCtx)
 {
-    ASSERT(params && params->fctData && params->userData);
-    
-    struct video_s *video       = (struct video_s*)params->fctData;
-    struct video_context_s *ctx = (struct video_context_s*)params->userData;
-    
-    if (ctx->quit) {
-        return;
-    }
-    
-    sem_wait(&ctx->notificationSem);
-    
-    if (ctx->quit) {
-        return;
+    ASSERT(listenerCtx && *listenerCtx);
+
+    struct video_context_s *ctx = (*listenerCtx)->ctx;
+    void *element               = NULL;
+
+    if ((*listenerCtx)->queue) {
+        (*listenerCtx)->quit = 1;
+        sem_post(&(*listenerCtx)->queueSem);
+
+        (void)ctx->videoTask->stop(ctx->videoTask, &(*listenerCtx)->deliveryParams);
+        (void)ctx->videoTask->destroy(ctx->videoTask, &(*listenerCtx)->deliveryParams);
+
+        while ((*listenerCtx)->queue->pop((*listenerCtx)->queue, &element) == RING_ERROR_NONE) {
+            (void)releaseFrame_f((struct video_frame_s*)element);
+        }
+
+        if ((*listenerCtx)->nbDroppedFrames > 0) {
+            Logd("%s : %lu frame(s) dropped by delivery queue", (*listenerCtx)->listener.name,
+                    (*listenerCtx)->nbDroppedFrames);
+        }
+
+        (void)Ring_UnInit(&(*listenerCtx)->queue);
+        (void)sem_destroy(&(*listenerCtx)->queueSem);
     }
-    
-    struct list_s *list = ctx->listenersList;
 
-    (void)lockBuffer_f(video, ctx);
-    
-    if (list->lock(list) != LIST_ERROR_NONE) {
-        Loge("Failed to lock list");
-        goto exit;
+    if ((*listenerCtx)->lastFrame) {
+        (void)releaseFrame_f((*listenerCtx)->lastFrame);
+        (*listenerCtx)->lastFrame = NULL;
     }
-    
-    uint32_t nbClients;
-    if (list->getNbElements(list, &nbClients) == LIST_ERROR_NONE) {
-        struct video_listener_s *listener = NULL;
-        while (nbClients > 0) {
-            nbClients--;
-            
-            if (list->getElement(list, (void*)&listener) != LIST_ERROR_NONE) {
-                break;
-            }
-            
-            /* IMPORTANT: Buffer must be handled very quickly so no heavy operation please!! */
-            listener->onVideoBufferAvailableCb(&video->buffer, listener->userData);
-        }
+
+    free(*listenerCtx);
+    *listenerCtx = NULL;
+}
+
+/*!
+ *
+ */
+static uint32_t getBytesPerLine_f(struct video_context_s *ctx, uint32_t plane)
+{
+    ASSERT(ctx && ctx->v4l2);
+
+    if (ctx->v4l2->isMplane) {
+        return ctx->v4l2->format.fmt.pix_mp.plane_fmt[plane].bytesperline;
     }
-    
-    (void)list->unlock(list);
-    
-    ctx->nbFramesLost--;
 
-exit:
-    (void)unlockBuffer_f(video, ctx);
+    return (plane == 0) ? ctx->v4l2->format.fmt.pix.bytesperline : 0;
 }
 
 /*!
- * Called when stopping framesHandler task
+ * Only the first plane is used so NV12M is handled as NV12. Change detection is disabled if the
+ * pixel format is not supported
  */
-static void framesHandlerAtExit_f(struct task_params_s *params)
+static void initChangeDetection_f(struct video_context_s *ctx)
 {
-    ASSERT(params && params->fctData && params->userData);
-    
-    struct video_s *video       = (struct video_s*)params->fctData;
-    struct video_context_s *ctx = (struct video_context_s*)params->userData;
-    
-    /* Release buffer */
-    (void)lockBuffer_f(video, ctx);
-    
-    if (video->buffer.data) {
-        free(video->buffer.data);
-        video->buffer.data = NULL;
+    ASSERT(ctx && ctx->v4l2);
+
+    struct converter_frame_s *frame = &ctx->motionFrame;
+    uint32_t bytesPerPixel          = 2;
+    uint32_t bytesPerLine           = getBytesPerLine_f(ctx, 0);
+
+    switch (ctx->params.pixelformat) {
+        case V4L2_PIX_FMT_YUYV:
+            frame->format = CONVERTER_FORMAT_YUYV;
+            break;
+
+        case V4L2_PIX_FMT_YVYU:
+            frame->format = CONVERTER_FORMAT_YVYU;
+            break;
+
+        case V4L2_PIX_FMT_UYVY:
+            frame->format = CONVERTER_FORMAT_UYVY;
+            break;
+
+        case V4L2_PIX_FMT_NV12:
+        case V4L2_PIX_FMT_NV12M:
+            frame->format = CONVERTER_FORMAT_NV12;
+            bytesPerPixel = 1;
+            break;
+
+        case V4L2_PIX_FMT_YUV420:
+            frame->format = CONVERTER_FORMAT_I420;
+            bytesPerPixel = 1;
+            break;
+
+        default:
+            Logw("%s : change detection not supported with this pixel format", ctx->params.name);
+            return;
     }
-    
-    (void)unlockBuffer_f(video, ctx);
+
+    frame->width      = ctx->v4l2->width;
+    frame->height     = ctx->v4l2->height;
+    frame->strides[0] = (bytesPerLine > 0 ? bytesPerLine : frame->width * bytesPerPixel);
+
+    if (Motion_Init(&ctx->motion, CONVERTER_KERNEL_AUTO,
+                    ctx->params.motionGridStep) != MOTION_ERROR_NONE) {
+        Loge("%s : Motion_Init() failed - Change detection disabled", ctx->params.name);
+        ctx->motion = NULL;
+        return;
+    }
+
+    /* Nothing to report until the scene stops changing */
+    ctx->isMoving         = 1;
+    ctx->nextKeepAlive_us = 0;
 }
 
 /*!
- *
+ * Compare frame with the last changed one. Controllers are told when the scene starts or stops
+ * changing. Unchanged frames are only kept to regularly show that the device is still alive
  */
-static uint8_t compareVideoCb(struct list_s *obj, void *elementToCheck, void *userData)
+static uint8_t isFrameChanged_f(struct video_context_s *ctx, struct video_frame_s *frame)
 {
-    ASSERT(obj && elementToCheck && userData);
+    ASSERT(ctx && ctx->motion && frame);
 
-    struct video_context_s *ctx = (struct video_context_s*)elementToCheck;
-    char *nameOfElementToRemove = (char*)userData;
+    struct converter_frame_s *motionFrame = &ctx->motionFrame;
+    uint64_t now_us                       = getMonotonicTime_us();
+    uint32_t score                        = MOTION_MAX_SCORE;
+    uint8_t isMoving;
 
-    return (!strcmp(nameOfElementToRemove, ctx->params.name));
+    /* Truncated frames are given to listeners as usual */
+    if (frame->buffer.length < (size_t)motionFrame->strides[0] * motionFrame->height) {
+        frame->buffer.motionScore = 0;
+        return 1;
+    }
+
+    motionFrame->planes[0] = (uint8_t*)frame->buffer.data;
+
+    (void)ctx->motion->getScore(ctx->motion, motionFrame, &score);
+
+    frame->buffer.motionScore = score;
+    isMoving                  = (score >= ctx->params.motionThreshold);
+
+    if ((isMoving != ctx->isMoving) && ctx->params.onMotionCb) {
+        ctx->params.onMotionCb(ctx->params.name, score, isMoving, ctx->params.userData);
+    }
+    ctx->isMoving = isMoving;
+
+    if (isMoving) {
+        /* Slow changes are detected too as they add up until the threshold is reached */
+        (void)ctx->motion->setReference(ctx->motion, motionFrame);
+    }
+    else if ((ctx->params.keepAliveInterval_ms == 0) || (now_us < ctx->nextKeepAlive_us)) {
+        return 0;
+    }
+
+    ctx->nextKeepAlive_us = now_us + (uint64_t)ctx->params.keepAliveInterval_ms * 1000;
+
+    return 1;
 }
 
 /*!
- *
+ * Clip is disabled if its memory cannot be allocated
  */
-static void releaseVideoCb(struct list_s *obj, void *element)
+static void initClip_f(struct video_context_s *ctx)
 {
-    ASSERT(obj && element);
+    ASSERT(ctx);
 
-    struct video_context_s **ctx = (struct video_context_s**)&element;
+    struct clip_params_s clipParams;
+    memset(&clipParams, 0, sizeof(clipParams));
 
-    (void)uninitVideoContext_f(ctx);
+    snprintf(clipParams.name, sizeof(clipParams.name), "%s", ctx->params.name);
+    clipParams.priority    = ctx->params.priority;
+    clipParams.pixelformat = ctx->params.pixelformat;
+    clipParams.preEvent_s  = ctx->params.clipPreEvent_s;
+    clipParams.postEvent_s = ctx->params.clipPostEvent_s;
+    clipParams.memorySize  = ctx->params.clipMemorySize;
+
+    if (Clip_Init(&ctx->clip, &clipParams) != CLIP_ERROR_NONE) {
+        Loge("%s : Clip_Init() failed - Pre-event clip disabled", ctx->params.name);
+        ctx->clip = NULL;
+    }
 }
 
 /*!
- *
+ * Add device to its sync group, creating the group if needed. Device is captured without
+ * synchronization on error
  */
-static uint8_t compareListenerCb(struct list_s *obj, void *elementToCheck, void *userData)
+static void joinSyncGroup_f(struct video_s *obj, struct video_context_s *ctx)
 {
-    ASSERT(obj && elementToCheck && userData);
-    
-    struct video_listener_s *listener  = (struct video_listener_s*)elementToCheck;
-    char *nameOfElementToRemove = (char*)userData;
-        
-    return (strncmp(listener->name, nameOfElementToRemove, strlen(listener->name)) == 0);
+    ASSERT(obj && obj->pData && ctx);
+
+    struct video_private_data_s *pData = (struct video_private_data_s*)(obj->pData);
+    struct list_s *list                = pData->syncGroupsList;
+    struct video_sync_group_s *group   = NULL;
+    struct video_params_s *params      = &ctx->params;
+
+    /* Driver may have granted fewer buffers than requested */
+    if (ctx->v4l2->nbBuffers <= SYNC_MAX_PENDING_FRAMES) {
+        Loge("%s has %u buffers but more than %u are needed to join sync group %s",
+                params->name, ctx->v4l2->nbBuffers, SYNC_MAX_PENDING_FRAMES, params->syncGroup);
+        return;
+    }
+
+    if (list->lock(list) != LIST_ERROR_NONE) {
+        Loge("Failed to lock syncGroupsList");
+        return;
+    }
+
+    if (!(group = getSyncGroup_f(list, params->syncGroup))) {
+        struct sync_params_s syncParams = {0};
+        snprintf(syncParams.name, sizeof(syncParams.name), "%s", params->syncGroup);
+        syncParams.onReleaseCb = onSyncReleaseCb;
+        syncParams.userData    = NULL;
+
+        if (params->syncTolerance_us > 0) {
+            syncParams.tolerance_us = params->syncTolerance_us;
+        }
+        else if (params->desiredFps > 0) {
+            syncParams.tolerance_us = 500000 / params->desiredFps;
+        }
+        else {
+            syncParams.tolerance_us = DEFAULT_SYNC_TOLERANCE_US;
+        }
+
+        ASSERT((group = calloc(1, sizeof(struct video_sync_group_s))));
+        snprintf(group->name, sizeof(group->name), "%s", params->syncGroup);
+
+        if (Sync_Init(&group->sync, &syncParams) != SYNC_ERROR_NONE) {
+            Loge("Sync_Init() failed");
+            free(group);
+            goto exit;
+        }
+
+        list->add(list, (void*)group);
+
+        Logd("Sync group %s created - tolerance = %lu us", group->name, syncParams.tolerance_us);
+    }
+
+    if (group->sync->join(group->sync, params->name, &ctx->syncMember) != SYNC_ERROR_NONE) {
+        Loge("%s cannot join sync group %s", params->name, params->syncGroup);
+        goto exit;
+    }
+
+    ctx->sync = group->sync;
+
+exit:
+    (void)list->unlock(list);
 }
 
 /*!
- *
+ * Drop device's frames waiting for the other members. Group is destroyed with its last member
  */
-static void releaseListenerCb(struct list_s *obj, void *element)
+static void leaveSyncGroup_f(struct video_s *obj, struct video_context_s *ctx)
 {
-    ASSERT(obj && element);
-    
-    struct video_listener_s *listener = (struct video_listener_s*)element;
-    free(listener);
+    ASSERT(obj && obj->pData && ctx);
+
+    struct video_private_data_s *pData = (struct video_private_data_s*)(obj->pData);
+    struct list_s *list                = pData->syncGroupsList;
+    uint32_t nbMembers                 = 1;
+
+    if (!ctx->sync) {
+        return;
+    }
+
+    if (list->lock(list) != LIST_ERROR_NONE) {
+        Loge("Failed to lock syncGroupsList");
+        return;
+    }
+
+    if (ctx->sync->leave(ctx->sync, ctx->syncMember, &nbMembers) != SYNC_ERROR_NONE) {
+        Loge("%s failed to leave sync group %s", ctx->params.name, ctx->params.syncGroup);
+    }
+    else if (nbMembers == 0) {
+        list->remove(list, (void*)ctx->params.syncGroup);
+    }
+
+    ctx->sync = NULL;
+
+    (void)list->unlock(list);
+}
+
+/*!
+ * syncGroupsList must be locked
+ */
+static struct video_sync_group_s *getSyncGroup_f(struct list_s *list, const char *name)
+{
+    ASSERT(list && name);
+
+    struct video_sync_group_s *group = NULL;
+    uint32_t nbElements              = 0;
+
+    if (list->getNbElements(list, &nbElements) != LIST_ERROR_NONE) {
+        return NULL;
+    }
+
+    while (nbElements > 0) {
+        if (list->getElement(list, (void**)&group) != LIST_ERROR_NONE) {
+            return NULL;
+        }
+
+        if (!strcmp(group->name, name)) {
+            return group;
+        }
+
+        nbElements--;
+    }
+
+    return NULL;
+}
+
+/*!
+ * Dequeue a filled buffer and hand it over to the notification task
+ */
+static void captureFrame_f(struct video_context_s *ctx)
+{
+    ASSERT(ctx);
+
+    struct v4l2_dequeued_buffer_s dequeued = {0};
+    enum v4l2_error_e ret                  = V4L2_ERROR_NONE;
+
+    if ((ret = ctx->v4l2->dequeueBuffer(ctx->v4l2, &dequeued)) != V4L2_ERROR_NONE) {
+        if ((ret == V4L2_ERROR_DISCONNECTED) || (++ctx->nbDequeueErrors >= MAX_DEQUEUE_ERRORS)) {
+            onDeviceLost_f(ctx);
+        }
+        return;
+    }
+
+    ctx->nbDequeueErrors = 0;
+
+    struct video_frame_s *frame = &ctx->frames[dequeued.index];
+    void *oldest                = NULL;
+    uint64_t now_us             = getMonotonicTime_us();
+
+    uint32_t plane;
+    for (plane = 0; plane < frame->buffer.nbPlanes; plane++) {
+        frame->buffer.planes[plane].length = dequeued.bytesused[plane];
+    }
+
+    frame->buffer.length         = dequeued.bytesused[0];
+    frame->buffer.timestamp      = dequeued.timestamp;
+    frame->buffer.sequence       = dequeued.sequence;
+    frame->buffer.dequeueTime_us = now_us;
+    frame->buffer.notifyTime_us  = 0;
+
+    /* Driver's timestamp can only be compared to our stamps if taken from the same clock */
+    if (dequeued.isMonotonic) {
+        frame->buffer.captureTime_us = (uint64_t)dequeued.timestamp.tv_sec * 1000000
+                                       + (uint64_t)dequeued.timestamp.tv_usec;
+    }
+    else {
+        frame->buffer.captureTime_us = now_us;
+    }
+
+    if (frame->buffer.captureTime_us <= now_us) {
+        ctx->lastDequeueLatency_us = now_us - frame->buffer.captureTime_us;
+    }
+
+    /* Frames lost by the driver e.g. because no buffer was queued */
+    if ((ctx->nbCapturedFrames > 0) && (dequeued.sequence != ctx->lastSequence + 1)
+        && (dequeued.sequence > ctx->lastSequence)) {
+        Logw("%s : %u frame(s) lost by driver", ctx->params.name,
+                dequeued.sequence - ctx->lastSequence - 1);
+        ctx->nbLostFrames += dequeued.sequence - ctx->lastSequence - 1;
+    }
+    ctx->lastSequence = dequeued.sequence;
+
+    (void)pthread_mutex_lock(&ctx->framesHandlerLock);
+    ctx->nbQueuedBuffers--;
+    frame->refCount = 1;
+    (void)pthread_mutex_unlock(&ctx->framesHandlerLock);
+
+    ctx->nbCapturedFrames++;
+        
+    /* Hand frame over to notification task */
+    while (ctx->framesRing->push(ctx->framesRing, frame) == RING_ERROR_FULL) {
+        switch (ctx->params.overflowPolicy) {
+            case VIDEO_OVERFLOW_POLICY_DROP_NEWEST:
+                ctx->nbDroppedFrames++;
+                (void)releaseFrame_f(frame);
+                return;
+
+            case VIDEO_OVERFLOW_POLICY_BLOCK:
+                /* Shared capture threads must not block : capture is suspended instead */
+                if (ctx->quit || ctx->reactor) {
+                    ctx->nbDroppedFrames++;
+                    (void)releaseFrame_f(frame);
+                    return;
+                }
+                sem_wait(&ctx->framesRingSem);
+                break;
+
+            case VIDEO_OVERFLOW_POLICY_DROP_OLDEST:
+            default:
+                /* Notification task may have popped it in the meantime */
+                if (ctx->framesRing->pop(ctx->framesRing, &oldest) == RING_ERROR_NONE) {
+                    ctx->nbDroppedFrames++;
+                    (void)releaseFrame_f((struct video_frame_s*)oldest);
+                }
+                break;
+        }
+    }
+
+    if (ctx->reactor) {
+        (void)pthread_mutex_lock(&ctx->framesHandlerLock);
+        updateCaptureState_f(ctx);
+        (void)pthread_mutex_unlock(&ctx->framesHandlerLock);
+    }
+
+    signalNotification_f(ctx);
+}
+
+/*!
+ * Notify listeners about the oldest frame waiting in ring
+ */
+static void notifyListeners_f(struct video_context_s *ctx)
+{
+    ASSERT(ctx);
+
+    struct list_s *list         = ctx->listenersList;
+    struct video_frame_s *frame = NULL;
+    void *element               = NULL;
+
+    /* Nothing to do if frame has been dropped by the frames handler */
+    if (ctx->framesRing->pop(ctx->framesRing, &element) != RING_ERROR_NONE) {
+        return;
+    }
+    
+    if (ctx->params.overflowPolicy == VIDEO_OVERFLOW_POLICY_BLOCK) {
+        if (ctx->reactor) {
+            (void)pthread_mutex_lock(&ctx->framesHandlerLock);
+            updateCaptureState_f(ctx);
+            (void)pthread_mutex_unlock(&ctx->framesHandlerLock);
+        }
+        else {
+            sem_post(&ctx->framesRingSem);
+        }
+    }
+    
+    frame = (struct video_frame_s*)element;
+
+    /* Still frames are kept too so that clips are not choppy */
+    if (ctx->clip) {
+        (void)ctx->clip->push(ctx->clip, &frame->buffer);
+    }
+
+    /* Held by the sync group until matched or dropped */
+    if (ctx->sync && (retainFrame_f(frame) == VIDEO_ERROR_NONE)) {
+        if (ctx->sync->push(ctx->sync, ctx->syncMember, &frame->buffer) != SYNC_ERROR_NONE) {
+            (void)releaseFrame_f(frame);
+        }
+    }
+
+    if (ctx->motion && !isFrameChanged_f(ctx, frame)) {
+        ctx->nbStillFrames++;
+        goto exit;
+    }
+    
+    ctx->nbNotifiedFrames++;
+
+    frame->buffer.notifyTime_us = getMonotonicTime_us();
+
+    if (frame->buffer.captureTime_us <= frame->buffer.notifyTime_us) {
+        ctx->lastNotifyLatency_us = frame->buffer.notifyTime_us - frame->buffer.captureTime_us;
+
+        if (ctx->lastNotifyLatency_us > ctx->maxNotifyLatency_us) {
+            ctx->maxNotifyLatency_us = ctx->lastNotifyLatency_us;
+        }
+    }
+    
+    if (list->lock(list) != LIST_ERROR_NONE) {
+        Loge("Failed to lock list");
+        goto exit;
+    }
+    
+    uint32_t nbClients;
+    if (list->getNbElements(list, &nbClients) == LIST_ERROR_NONE) {
+        struct video_listener_context_s *listenerCtx = NULL;
+        while (nbClients > 0) {
+            nbClients--;
+            
+            if (list->getElement(list, (void*)&listenerCtx) != LIST_ERROR_NONE) {
+                break;
+            }
+
+            if (!isFrameWanted_f(listenerCtx)) {
+                continue;
+            }
+            
+            (void)retainFrame_f(frame);
+
+            if (listenerCtx->queue) {
+                queueFrame_f(listenerCtx, frame);
+            }
+            else {
+                /* IMPORTANT: Buffer must be handled very quickly so no heavy operation please!! */
+                deliverFrame_f(listenerCtx, frame);
+            }
+        }
+    }
+    
+    (void)list->unlock(list);
+
+exit:
+    (void)releaseFrame_f(frame);
+}
+
+/*!
+ * Tell whether the current frame has to be given to listener according to its maxFps and
+ * everyNthFrame settings
+ */
+static uint8_t isFrameWanted_f(struct video_listener_context_s *listenerCtx)
+{
+    ASSERT(listenerCtx);
+
+    struct video_listener_s *listener = &listenerCtx->listener;
+
+    if ((listener->everyNthFrame > 1)
+        && ((listenerCtx->nbSeenFrames++ % listener->everyNthFrame) != 0)) {
+        return 0;
+    }
+
+    if (listenerCtx->minInterval_us == 0) {
+        return 1;
+    }
+
+    uint64_t now_us = getMonotonicTime_us();
+
+    if (now_us < listenerCtx->nextDelivery_us) {
+        return 0;
+    }
+
+    /* Keep the requested rate on average but do not try to catch up after a long pause */
+    listenerCtx->nextDelivery_us += listenerCtx->minInterval_us;
+
+    if (listenerCtx->nextDelivery_us <= now_us) {
+        listenerCtx->nextDelivery_us = now_us + listenerCtx->minInterval_us;
+    }
+
+    return 1;
+}
+
+/*!
+ * Hand a retained frame over to listener's own task. A slow listener only loses its own frames
+ */
+static void queueFrame_f(struct video_listener_context_s *listenerCtx,
+                         struct video_frame_s *frame)
+{
+    ASSERT(listenerCtx && listenerCtx->queue && frame);
+
+    void *oldest = NULL;
+
+    while (listenerCtx->queue->push(listenerCtx->queue, frame) == RING_ERROR_FULL) {
+        if (listenerCtx->listener.delivery != VIDEO_DELIVERY_ASYNC_LATEST) {
+            listenerCtx->nbDroppedFrames++;
+            (void)releaseFrame_f(frame);
+            return;
+        }
+
+        /* Delivery task may have popped it in the meantime */
+        if (listenerCtx->queue->pop(listenerCtx->queue, &oldest) == RING_ERROR_NONE) {
+            listenerCtx->nbDroppedFrames++;
+            (void)releaseFrame_f((struct video_frame_s*)oldest);
+        }
+    }
+
+    sem_post(&listenerCtx->queueSem);
+}
+
+/*!
+ * Give frame to listener then drop the one it received previously
+ */
+static void deliverFrame_f(struct video_listener_context_s *listenerCtx,
+                           struct video_frame_s *frame)
+{
+    ASSERT(listenerCtx && frame);
+
+    struct video_listener_s *listener = &listenerCtx->listener;
+
+    listener->onVideoBufferAvailableCb(&frame->buffer, listener->userData);
+
+    /* Each listener keeps a reference to the last frame it received */
+    if (listenerCtx->lastFrame) {
+        (void)releaseFrame_f(listenerCtx->lastFrame);
+    }
+    listenerCtx->lastFrame = frame;
+}
+
+/*!
+ *
+ */
+static void signalNotification_f(struct video_context_s *ctx)
+{
+    ASSERT(ctx);
+
+    if (!ctx->reactor) {
+        sem_post(&ctx->notificationSem);
+        return;
+    }
+
+    uint64_t value = 1;
+    if (write(ctx->notificationFd, &value, sizeof(value)) < 0) {
+        Loge("Failed to signal new frame - %s", strerror(errno));
+    }
+}
+
+/*!
+ * Shared capture threads only watch device when a buffer can be dequeued and handed over to the
+ * notification task without blocking. framesHandlerLock must be held
+ */
+static void updateCaptureState_f(struct video_context_s *ctx)
+{
+    ASSERT(ctx);
+
+    if (!ctx->reactor || ctx->quit || ctx->isDisconnected) {
+        return;
+    }
+
+    uint8_t canCapture = (ctx->nbQueuedBuffers > 0);
+
+    if (canCapture && (ctx->params.overflowPolicy == VIDEO_OVERFLOW_POLICY_BLOCK)) {
+        uint32_t nbElements = 0;
+        (void)ctx->framesRing->getNbElements(ctx->framesRing, &nbElements);
+
+        canCapture = (nbElements < ctx->params.nbSlots);
+    }
+
+    if (canCapture && ctx->captureSuspended) {
+        if (ctx->reactor->resume(ctx->reactor, ctx->v4l2->deviceFd) == REACTOR_ERROR_NONE) {
+            ctx->captureSuspended = 0;
+        }
+    }
+    else if (!canCapture && !ctx->captureSuspended) {
+        if (ctx->reactor->suspend(ctx->reactor, ctx->v4l2->deviceFd) == REACTOR_ERROR_NONE) {
+            ctx->captureSuspended = 1;
+        }
+    }
+}
+
+/*!
+ * Called from capture context when device stops delivering frames e.g. because it has been
+ * unplugged. Listeners stay registered while the hotplug task reopens it
+ */
+static void onDeviceLost_f(struct video_context_s *ctx)
+{
+    ASSERT(ctx);
+
+    /* Files and patterns keep the previous behaviour */
+    if (!ctx->hotplugParams.fct) {
+        return;
+    }
+
+    (void)pthread_mutex_lock(&ctx->framesHandlerLock);
+
+    if (ctx->quit || ctx->isDisconnected) {
+        (void)pthread_mutex_unlock(&ctx->framesHandlerLock);
+        return;
+    }
+
+    ctx->isDisconnected = 1;
+
+    if (ctx->reactor && !ctx->captureSuspended
+        && (ctx->reactor->suspend(ctx->reactor, ctx->v4l2->deviceFd) == REACTOR_ERROR_NONE)) {
+        ctx->captureSuspended = 1;
+    }
+
+    (void)pthread_mutex_unlock(&ctx->framesHandlerLock);
+
+    Logw("%s : %s lost - Waiting for it to come back", ctx->params.name, ctx->params.path);
+
+    sem_post(&ctx->hotplugSem);
+}
+
+/*!
+ * Close device then reopen it as soon as its node reappears
+ */
+static void recoverDevice_f(struct video_context_s *ctx)
+{
+    ASSERT(ctx);
+
+    int32_t watchFd = -1;
+
+    /* Shared capture threads must not watch a closed fd */
+    if (ctx->reactor) {
+        (void)ctx->reactor->remove(ctx->reactor, ctx->v4l2->deviceFd);
+    }
+
+    (void)ctx->v4l2->disconnectDevice(ctx->v4l2);
+
+    /* Watch before first attempt so that a quick replug is not missed */
+    watchFd = watchDevice_f(ctx);
+
+    while (!ctx->quit) {
+        uint64_t start_us = getMonotonicTime_us();
+
+        if ((ctx->v4l2->reconnectDevice(ctx->v4l2) == V4L2_ERROR_NONE) && !ctx->quit) {
+            if (restartCapture_f(ctx) == VIDEO_ERROR_NONE) {
+                ctx->lastReconnectDuration_us = getMonotonicTime_us() - start_us;
+                ctx->nbReconnections++;
+
+                Logi("%s : %s is back - Capture restarted in %lu us", ctx->params.name,
+                        ctx->params.path, ctx->lastReconnectDuration_us);
+                break;
+            }
+
+            (void)ctx->v4l2->disconnectDevice(ctx->v4l2);
+        }
+
+        waitDevice_f(ctx, watchFd);
+    }
+
+    if (watchFd != -1) {
+        close(watchFd);
+    }
+}
+
+/*!
+ * Give all buffers not held by listeners to the reconnected device then restart capture
+ */
+static enum video_error_e restartCapture_f(struct video_context_s *ctx)
+{
+    ASSERT(ctx);
+
+    enum video_error_e ret = VIDEO_ERROR_NONE;
+    uint32_t nbQueued      = 0;
+    uint32_t index, plane;
+
+    /* Held so that buffers released meanwhile are neither lost nor queued twice */
+    (void)pthread_mutex_lock(&ctx->framesHandlerLock);
+
+    for (index = 0; index < ctx->v4l2->nbBuffers; index++) {
+        struct video_buffer_s *buffer     = &ctx->frames[index].buffer;
+        struct v4l2_mapping_buffer_s *map = &ctx->v4l2->map[index];
+
+        /* MMAP buffers are mapped at the same addresses but exported again */
+        for (plane = 0; plane < map->nbPlanes; plane++) {
+            buffer->planes[plane].dmabufFd = map->planes[plane].dmabufFd;
+        }
+        buffer->dmabufFd = map->planes[0].dmabufFd;
+
+        if (ctx->frames[index].refCount > 0) {
+            continue;
+        }
+
+        if (ctx->v4l2->queueBuffer(ctx->v4l2, index) != V4L2_ERROR_NONE) {
+            Loge("queueBuffer() failed - index %u", index);
+            ret = VIDEO_ERROR_START;
+            goto exit;
+        }
+        nbQueued++;
+    }
+
+    if (ctx->v4l2->startCapture(ctx->v4l2) != V4L2_ERROR_NONE) {
+        Loge("startCapture() failed");
+        ret = VIDEO_ERROR_START;
+        goto exit;
+    }
+
+    ctx->nbQueuedBuffers  = nbQueued;
+    ctx->nbDequeueErrors  = 0;
+    ctx->isDisconnected   = 0;
+    ctx->captureSuspended = 0;
+
+    if (ctx->reactor) {
+        if (ctx->reactor->add(ctx->reactor, ctx->v4l2->deviceFd,
+                              onCaptureEventCb, ctx) != REACTOR_ERROR_NONE) {
+            Loge("Failed to watch %s", ctx->params.path);
+            ctx->isDisconnected = 1;
+            ret = VIDEO_ERROR_START;
+            goto exit;
+        }
+
+        updateCaptureState_f(ctx);
+    }
+    else {
+        (void)pthread_cond_broadcast(&ctx->framesHandlerCond);
+    }
+
+exit:
+    (void)pthread_mutex_unlock(&ctx->framesHandlerLock);
+
+    return ret;
+}
+
+/*!
+ * Return an inotify fd reporting changes in device's directory or -1 if it cannot be watched
+ */
+static int32_t watchDevice_f(struct video_context_s *ctx)
+{
+    ASSERT(ctx);
+
+    char directory[MAX_PATH_SIZE];
+    char *slash = NULL;
+    int32_t fd  = -1;
+
+    snprintf(directory, sizeof(directory), "%s", ctx->params.path);
+
+    if (!(slash = strrchr(directory, '/'))) {
+        snprintf(directory, sizeof(directory), ".");
+    }
+    else {
+        *(slash == directory ? slash + 1 : slash) = '\0';
+    }
+
+    if ((fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) < 0) {
+        Logw("inotify_init1() failed - %s", strerror(errno));
+        return -1;
+    }
+
+    /* udev creates node (or link) then sets its permissions */
+    if (inotify_add_watch(fd, directory, IN_CREATE | IN_ATTRIB | IN_MOVED_TO) < 0) {
+        Logw("Failed to watch \"%s\" - %s", directory, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+/*!
+ * Wait for a change in device's directory, stopDeviceCapture() or HOTPLUG_RETRY_MS
+ */
+static void waitDevice_f(struct video_context_s *ctx, int32_t watchFd)
+{
+    ASSERT(ctx);
+
+    struct pollfd fds[2] = {
+        { .fd = ctx->v4l2->quitFd[V4L2_PIPE_READ], .events = POLLIN },
+        { .fd = watchFd,                           .events = POLLIN }
+    };
+    char events[sizeof(struct inotify_event) + MAX_PATH_SIZE];
+
+    if (poll(fds, (watchFd != -1 ? 2 : 1), HOTPLUG_RETRY_MS) <= 0) {
+        return;
+    }
+
+    /* Which file changed does not matter: device is probed anyway */
+    if ((watchFd != -1) && (fds[1].revents & POLLIN)) {
+        while (read(watchFd, events, sizeof(events)) > 0);
+    }
+}
+
+/*!
+ * Capture video frames and wake up notification task
+ */
+static void framesHandlerFct_f(struct task_params_s *params)
+{
+    ASSERT(params && params->fctData && params->userData);
+    
+    struct video_context_s *ctx = (struct video_context_s*)params->userData;
+    int32_t timeout_ms          = -1;
+    
+    switch (ctx->params.awaitMode) {
+        case VIDEO_AWAIT_MODE_BLOCKING:
+            break;
+            
+        case VIDEO_AWAIT_MODE_NON_BLOCKING:
+            timeout_ms = (int32_t)WAIT_TIME_2S;
+            break;
+            
+        default:
+            ;
+    }
+    
+    /* Wait until the driver owns at least one buffer */
+    (void)pthread_mutex_lock(&ctx->framesHandlerLock);
+    while (!ctx->quit && ((ctx->nbQueuedBuffers == 0) || ctx->isDisconnected)) {
+        (void)pthread_cond_wait(&ctx->framesHandlerCond, &ctx->framesHandlerLock);
+    }
+    (void)pthread_mutex_unlock(&ctx->framesHandlerLock);
+
+    /* Await data */
+    while (!ctx->quit) {
+        if (ctx->v4l2->awaitData(ctx->v4l2, timeout_ms) == V4L2_ERROR_NONE) {
+            break;
+        }
+    }
+
+    if (ctx->quit) {
+        return;
+    }
+
+    captureFrame_f(ctx);
+}
+
+/*!
+ * Wait for new video frames then notify listeners
+ */
+static void notificationFct_f(struct task_params_s *params)
+{
+    ASSERT(params && params->fctData && params->userData);
+    
+    struct video_context_s *ctx = (struct video_context_s*)params->userData;
+    
+    if (ctx->quit) {
+        return;
+    }
+    
+    sem_wait(&ctx->notificationSem);
+    
+    if (ctx->quit) {
+        return;
+    }
+    
+    notifyListeners_f(ctx);
+}
+
+/*!
+ * Give frames queued for one listener to its callback
+ */
+static void deliveryFct_f(struct task_params_s *params)
+{
+    ASSERT(params && params->fctData && params->userData);
+
+    struct video_listener_context_s *listenerCtx = params->userData;
+    void *element                                = NULL;
+
+    if (listenerCtx->quit) {
+        return;
+    }
+
+    sem_wait(&listenerCtx->queueSem);
+
+    if (listenerCtx->quit) {
+        return;
+    }
+
+    /* Frame may have been replaced by a newer one */
+    if (listenerCtx->queue->pop(listenerCtx->queue, &element) != RING_ERROR_NONE) {
+        return;
+    }
+
+    deliverFrame_f(listenerCtx, (struct video_frame_s*)element);
+}
+
+/*!
+ * Reopen device each time it is lost
+ */
+static void hotplugFct_f(struct task_params_s *params)
+{
+    ASSERT(params && params->fctData && params->userData);
+
+    struct video_context_s *ctx = (struct video_context_s*)params->userData;
+
+    if (ctx->quit) {
+        return;
+    }
+
+    sem_wait(&ctx->hotplugSem);
+
+    if (ctx->quit || !ctx->isDisconnected) {
+        return;
+    }
+
+    recoverDevice_f(ctx);
+}
+
+/*!
+ * Called from a shared capture thread when device is readable
+ */
+static void onCaptureEventCb(struct reactor_s *obj, int32_t fd, uint32_t events, void *userData)
+{
+    ASSERT(obj && userData);
+
+    struct video_context_s *ctx = (struct video_context_s*)userData;
+
+    if (ctx->quit) {
+        return;
+    }
+
+    /* Drivers report an error while no buffer is queued */
+    (void)pthread_mutex_lock(&ctx->framesHandlerLock);
+    uint8_t canCapture = (ctx->nbQueuedBuffers > 0) && !ctx->isDisconnected;
+    uint8_t isLost     = 0;
+    updateCaptureState_f(ctx);
+
+    /* EPOLLHUP once device is unplugged */
+    if (canCapture && (events & (EPOLLERR | EPOLLHUP))) {
+        Loge("Error reported by %s - Capture suspended", ctx->params.path);
+
+        if (obj->suspend(obj, fd) == REACTOR_ERROR_NONE) {
+            ctx->captureSuspended = 1;
+        }
+        canCapture = 0;
+        isLost     = 1;
+    }
+    (void)pthread_mutex_unlock(&ctx->framesHandlerLock);
+
+    if (isLost) {
+        onDeviceLost_f(ctx);
+    }
+    else if (canCapture) {
+        captureFrame_f(ctx);
+    }
+}
+
+/*!
+ * Called from a shared capture thread when frames are waiting in ring
+ */
+static void onNotificationEventCb(struct reactor_s *obj, int32_t fd, uint32_t events,
+                                  void *userData)
+{
+    ASSERT(obj && userData);
+
+    struct video_context_s *ctx = (struct video_context_s*)userData;
+    uint64_t nbFrames           = 0;
+
+    (void)events;
+
+    if (read(fd, &nbFrames, sizeof(nbFrames)) < 0) {
+        return;
+    }
+
+    while (!ctx->quit && (nbFrames-- > 0)) {
+        notifyListeners_f(ctx);
+    }
+}
+
+/*!
+ *
+ */
+static uint8_t compareVideoCb(struct list_s *obj, void *elementToCheck, void *userData)
+{
+    ASSERT(obj && elementToCheck && userData);
+
+    struct video_context_s *ctx = (struct video_context_s*)elementToCheck;
+    char *nameOfElementToRemove = (char*)userData;
+
+    return (!strcmp(nameOfElementToRemove, ctx->params.name));
+}
+
+/*!
+ *
+ */
+static void releaseVideoCb(struct list_s *obj, void *element)
+{
+    ASSERT(obj && element);
+
+    struct video_context_s **ctx = (struct video_context_s**)&element;
+
+    (void)uninitVideoContext_f(ctx);
+}
+
+/*!
+ *
+ */
+static uint8_t compareListenerCb(struct list_s *obj, void *elementToCheck, void *userData)
+{
+    ASSERT(obj && elementToCheck && userData);
+    
+    struct video_listener_context_s *listenerCtx = (struct video_listener_context_s*)elementToCheck;
+    char *nameOfElementToRemove                  = (char*)userData;
+    struct video_listener_s *listener            = &listenerCtx->listener;
+        
+    return (strncmp(listener->name, nameOfElementToRemove, strlen(listener->name)) == 0);
+}
+
+/*!
+ *
+ */
+static void releaseListenerCb(struct list_s *obj, void *element)
+{
+    ASSERT(obj && element);
+    
+    struct video_listener_context_s *listenerCtx = (struct video_listener_context_s*)element;
+
+    uninitListenerContext_f(&listenerCtx);
+}
+
+/*!
+ *
+ */
+static uint8_t compareSyncGroupCb(struct list_s *obj, void *elementToCheck, void *userData)
+{
+    ASSERT(obj && elementToCheck && userData);
+
+    struct video_sync_group_s *group = (struct video_sync_group_s*)elementToCheck;
+    char *nameOfElementToRemove      = (char*)userData;
+
+    return (!strcmp(nameOfElementToRemove, group->name));
+}
+
+/*!
+ *
+ */
+static void releaseSyncGroupCb(struct list_s *obj, void *element)
+{
+    ASSERT(obj && element);
+
+    struct video_sync_group_s *group = (struct video_sync_group_s*)element;
+
+    (void)Sync_UnInit(&group->sync);
+    free(group);
+}
+
+/*!
+ * Frames are retained before being pushed to a sync group
+ */
+static void onSyncReleaseCb(struct video_buffer_s *videoBuffer, void *userData)
+{
+    ASSERT(videoBuffer && videoBuffer->reserved);
+
+    (void)userData;
+
+    (void)releaseFrame_f((struct video_frame_s*)videoBuffer->reserved);
 }
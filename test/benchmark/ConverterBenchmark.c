@@ -0,0 +1,96 @@
+/**
+ * Converter throughput on a 1080p frame for each kernel supported by the running cpu
+ *
+ * Usage: make benchmark && ./out/benchmark/ConverterBenchmark [nbIterations]
+ */
+
+#include "utils/Converter.h"
+
+#define WIDTH          1920
+#define HEIGHT         1080
+#define NB_ITERATIONS  100
+
+static const char *gKernels[] = {
+    [CONVERTER_KERNEL_AUTO]   = "auto",
+    [CONVERTER_KERNEL_SCALAR] = "scalar",
+    [CONVERTER_KERNEL_SSE2]   = "sse2",
+    [CONVERTER_KERNEL_AVX2]   = "avx2",
+    [CONVERTER_KERNEL_NEON]   = "neon"
+};
+
+static const char *gFormats[] = {
+    [CONVERTER_FORMAT_YUYV]     = "YUYV",
+    [CONVERTER_FORMAT_YVYU]     = "YVYU",
+    [CONVERTER_FORMAT_UYVY]     = "UYVY",
+    [CONVERTER_FORMAT_NV12]     = "NV12",
+    [CONVERTER_FORMAT_I420]     = "I420",
+    [CONVERTER_FORMAT_RGB24]    = "RGB24",
+    [CONVERTER_FORMAT_ARGB8888] = "ARGB8888"
+};
+
+static uint8_t *allocFrame(struct converter_s *obj, enum converter_format_e format,
+                           struct converter_frame_s *frame)
+{
+    size_t size   = 0;
+    uint8_t *data = NULL;
+
+    (void)obj->getFrameSize(obj, format, WIDTH, HEIGHT, &size);
+    ASSERT((data = malloc(size)));
+    memset(data, 0x80, size);
+    (void)obj->setFrame(obj, format, WIDTH, HEIGHT, data, frame);
+
+    return data;
+}
+
+int main(int argc, char **argv)
+{
+    struct converter_s *obj = NULL;
+    struct converter_frame_s src, dst;
+    enum converter_kernel_e kernel;
+    enum converter_format_e in, to;
+    uint64_t start_us, elapsed_us;
+    uint32_t nbIterations = NB_ITERATIONS;
+    uint32_t i;
+
+    if (argc > 1) {
+        nbIterations = (uint32_t)strtoul(argv[1], NULL, 10);
+        nbIterations = (nbIterations > 0 ? nbIterations : NB_ITERATIONS);
+    }
+
+    printf("%-8s %-8s %-8s %10s\n", "kernel", "from", "to", "Mpixel/s");
+
+    for (kernel = CONVERTER_KERNEL_SCALAR; kernel < CONVERTER_KERNEL_MAX; kernel++) {
+        if (Converter_Init(&obj, kernel) != CONVERTER_ERROR_NONE) {
+            continue;
+        }
+
+        for (in = CONVERTER_FORMAT_YUYV; in <= CONVERTER_FORMAT_I420; in++) {
+            uint8_t *srcData = allocFrame(obj, in, &src);
+
+            for (to = CONVERTER_FORMAT_YUYV; to < CONVERTER_FORMAT_MAX; to++) {
+                if (in == to) {
+                    continue;
+                }
+
+                uint8_t *dstData = allocFrame(obj, to, &dst);
+
+                start_us = getMonotonicTime_us();
+                for (i = 0; i < nbIterations; i++) {
+                    (void)obj->convert(obj, &src, &dst);
+                }
+                elapsed_us = getMonotonicTime_us() - start_us;
+
+                printf("%-8s %-8s %-8s %10.1f\n", gKernels[kernel], gFormats[in], gFormats[to],
+                       (double)WIDTH * HEIGHT * nbIterations / (double)(elapsed_us ? elapsed_us : 1));
+
+                free(dstData);
+            }
+
+            free(srcData);
+        }
+
+        (void)Converter_UnInit(&obj);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,223 @@
+#include "unity.h"
+#include "exception_test_helpers.h"
+#include "utils/Converter.h"
+
+/* Not a multiple of any SIMD width so that remaining pixels are also covered */
+#define WIDTH  70
+#define HEIGHT 5
+
+static struct converter_s *converterObj = NULL;
+
+static uint8_t *allocFrame(struct converter_s *obj, enum converter_format_e format,
+                           struct converter_frame_s *frame)
+{
+    size_t size    = 0;
+    uint8_t *data  = NULL;
+
+    TEST_ASSERT_EQUAL(obj->getFrameSize(obj, format, WIDTH, HEIGHT, &size), CONVERTER_ERROR_NONE);
+    TEST_ASSERT_NOT_NULL((data = calloc(1, size)));
+    TEST_ASSERT_EQUAL(obj->setFrame(obj, format, WIDTH, HEIGHT, data, frame),
+                      CONVERTER_ERROR_NONE);
+
+    return data;
+}
+
+static void fillFrame(struct converter_s *obj, enum converter_format_e format, uint8_t *data)
+{
+    size_t size   = 0;
+    uint32_t seed = 0x12345678;
+
+    (void)obj->getFrameSize(obj, format, WIDTH, HEIGHT, &size);
+
+    for (size_t i = 0; i < size; ++i) {
+        seed    = seed * 1103515245 + 12345;
+        data[i] = (uint8_t)(seed >> 16);
+    }
+}
+
+void setUp(void)
+{
+    (void)Converter_Init(&converterObj, CONVERTER_KERNEL_SCALAR);
+}
+
+void tearDown(void)
+{
+    (void)Converter_UnInit(&converterObj);
+}
+
+/**
+ * Requirement:
+ * - getFrameSize() and setFrame() must "assert" when "obj" or the output parameter is NULL
+ */
+void test_Converter_SetFrame_Null_Parameter(void)
+{
+    size_t size                    = 0;
+    uint8_t data[16]               = {0};
+    struct converter_frame_s frame = {0};
+
+    TEST_ASSERT_EXPECTED(converterObj->getFrameSize(NULL, CONVERTER_FORMAT_NV12, 2, 2, &size));
+    TEST_ASSERT_EXPECTED(converterObj->getFrameSize(converterObj, CONVERTER_FORMAT_NV12, 2, 2,
+                                                    NULL));
+    TEST_ASSERT_EXPECTED(converterObj->setFrame(NULL, CONVERTER_FORMAT_NV12, 2, 2, data, &frame));
+    TEST_ASSERT_EXPECTED(converterObj->setFrame(converterObj, CONVERTER_FORMAT_NV12, 2, 2, data,
+                                                NULL));
+}
+
+/**
+ * Requirement:
+ * - getFrameSize() must return the size of a contiguous frame
+ * - setFrame() must return CONVERTER_ERROR_PARAMS when width is odd or a dimension is 0
+ */
+void test_Converter_SetFrame(void)
+{
+    size_t size                    = 0;
+    uint8_t data[16]               = {0};
+    struct converter_frame_s frame = {0};
+
+    (void)converterObj->getFrameSize(converterObj, CONVERTER_FORMAT_YUYV, 4, 3, &size);
+    TEST_ASSERT_EQUAL(size, 24);
+    (void)converterObj->getFrameSize(converterObj, CONVERTER_FORMAT_NV12, 4, 3, &size);
+    TEST_ASSERT_EQUAL(size, 20);
+    (void)converterObj->getFrameSize(converterObj, CONVERTER_FORMAT_I420, 4, 3, &size);
+    TEST_ASSERT_EQUAL(size, 20);
+    (void)converterObj->getFrameSize(converterObj, CONVERTER_FORMAT_RGB24, 4, 3, &size);
+    TEST_ASSERT_EQUAL(size, 36);
+    (void)converterObj->getFrameSize(converterObj, CONVERTER_FORMAT_ARGB8888, 4, 3, &size);
+    TEST_ASSERT_EQUAL(size, 48);
+
+    TEST_ASSERT_EQUAL(converterObj->setFrame(converterObj, CONVERTER_FORMAT_I420, 4, 3, data,
+                                             &frame), CONVERTER_ERROR_NONE);
+    TEST_ASSERT_EQUAL_PTR(frame.planes[1], data + 12);
+    TEST_ASSERT_EQUAL_PTR(frame.planes[2], data + 16);
+    TEST_ASSERT_EQUAL(frame.strides[1], 2);
+
+    TEST_ASSERT_EQUAL(converterObj->setFrame(converterObj, CONVERTER_FORMAT_YUYV, 3, 2, data,
+                                             &frame), CONVERTER_ERROR_PARAMS);
+    TEST_ASSERT_EQUAL(converterObj->setFrame(converterObj, CONVERTER_FORMAT_YUYV, 0, 2, data,
+                                             &frame), CONVERTER_ERROR_PARAMS);
+    TEST_ASSERT_EQUAL(converterObj->setFrame(converterObj, CONVERTER_FORMAT_YUYV, 2, 2, NULL,
+                                             &frame), CONVERTER_ERROR_PARAMS);
+}
+
+/**
+ * Requirement:
+ * - convert() must refuse frames with different dimensions and RGB sources
+ */
+void test_Converter_Convert_Invalid_Frames(void)
+{
+    uint8_t data[64]             = {0};
+    struct converter_frame_s src = {0};
+    struct converter_frame_s dst = {0};
+
+    (void)converterObj->setFrame(converterObj, CONVERTER_FORMAT_YUYV, 4, 2, data, &src);
+    (void)converterObj->setFrame(converterObj, CONVERTER_FORMAT_RGB24, 2, 2, data, &dst);
+    TEST_ASSERT_EQUAL(converterObj->convert(converterObj, &src, &dst), CONVERTER_ERROR_PARAMS);
+    TEST_ASSERT_EQUAL(converterObj->convert(converterObj, NULL, &dst), CONVERTER_ERROR_PARAMS);
+
+    (void)converterObj->setFrame(converterObj, CONVERTER_FORMAT_RGB24, 4, 2, data, &src);
+    (void)converterObj->setFrame(converterObj, CONVERTER_FORMAT_YUYV, 4, 2, data, &dst);
+    TEST_ASSERT_EQUAL(converterObj->convert(converterObj, &src, &dst), CONVERTER_ERROR_FORMAT);
+}
+
+/**
+ * Requirement:
+ * - convert() must map limited range white and black to full range RGB
+ */
+void test_Converter_Convert_Known_Values(void)
+{
+    uint8_t yuyv[8]              = {235, 128, 235, 128, 16, 128, 16, 128};
+    uint8_t rgb[12]              = {0};
+    uint8_t white[6]             = {255, 255, 255, 255, 255, 255};
+    uint8_t black[6]             = {0};
+    uint32_t argb[4]             = {0};
+    struct converter_frame_s src = {0};
+    struct converter_frame_s dst = {0};
+
+    (void)converterObj->setFrame(converterObj, CONVERTER_FORMAT_YUYV, 2, 2, yuyv, &src);
+
+    (void)converterObj->setFrame(converterObj, CONVERTER_FORMAT_RGB24, 2, 2, rgb, &dst);
+    TEST_ASSERT_EQUAL(converterObj->convert(converterObj, &src, &dst), CONVERTER_ERROR_NONE);
+    TEST_ASSERT_EQUAL_MEMORY(white, rgb, sizeof(white));
+    TEST_ASSERT_EQUAL_MEMORY(black, rgb + 6, sizeof(black));
+
+    (void)converterObj->setFrame(converterObj, CONVERTER_FORMAT_ARGB8888, 2, 2, argb, &dst);
+    TEST_ASSERT_EQUAL(converterObj->convert(converterObj, &src, &dst), CONVERTER_ERROR_NONE);
+    TEST_ASSERT_EQUAL_UINT32(argb[0], 0xFFFFFFFF);
+    TEST_ASSERT_EQUAL_UINT32(argb[3], 0xFF000000);
+}
+
+/**
+ * Requirement:
+ * - Converting between YUV layouts must keep luma and (subsampled) chroma unchanged
+ */
+void test_Converter_Convert_Yuv_Round_Trip(void)
+{
+    struct converter_frame_s src  = {0};
+    struct converter_frame_s tmp  = {0};
+    struct converter_frame_s back = {0};
+    enum converter_format_e format;
+
+    uint8_t *srcData  = allocFrame(converterObj, CONVERTER_FORMAT_I420, &src);
+    uint8_t *backData = allocFrame(converterObj, CONVERTER_FORMAT_I420, &back);
+    size_t size       = 0;
+
+    fillFrame(converterObj, CONVERTER_FORMAT_I420, srcData);
+    (void)converterObj->getFrameSize(converterObj, CONVERTER_FORMAT_I420, WIDTH, HEIGHT, &size);
+
+    for (format = CONVERTER_FORMAT_YUYV; format <= CONVERTER_FORMAT_I420; ++format) {
+        uint8_t *tmpData = allocFrame(converterObj, format, &tmp);
+
+        TEST_ASSERT_EQUAL(converterObj->convert(converterObj, &src, &tmp), CONVERTER_ERROR_NONE);
+        TEST_ASSERT_EQUAL(converterObj->convert(converterObj, &tmp, &back), CONVERTER_ERROR_NONE);
+        TEST_ASSERT_EQUAL_MEMORY(srcData, backData, size);
+
+        free(tmpData);
+    }
+
+    free(srcData);
+    free(backData);
+}
+
+/**
+ * Requirement:
+ * - All kernels supported by the running cpu must give exactly the same results as the scalar
+ *   one for every pair of formats
+ */
+void test_Converter_Convert_Kernels_Bit_Exact(void)
+{
+    struct converter_s *simdObj = NULL;
+    struct converter_frame_s src, ref, out;
+    enum converter_format_e in, to;
+    enum converter_kernel_e kernel;
+    size_t size;
+
+    for (kernel = CONVERTER_KERNEL_SSE2; kernel < CONVERTER_KERNEL_MAX; ++kernel) {
+        if (Converter_Init(&simdObj, kernel) != CONVERTER_ERROR_NONE) {
+            continue;
+        }
+
+        for (in = CONVERTER_FORMAT_YUYV; in <= CONVERTER_FORMAT_I420; ++in) {
+            uint8_t *srcData = allocFrame(converterObj, in, &src);
+            fillFrame(converterObj, in, srcData);
+
+            for (to = CONVERTER_FORMAT_YUYV; to < CONVERTER_FORMAT_MAX; ++to) {
+                uint8_t *refData = allocFrame(converterObj, to, &ref);
+                uint8_t *outData = allocFrame(converterObj, to, &out);
+
+                TEST_ASSERT_EQUAL(converterObj->convert(converterObj, &src, &ref),
+                                  CONVERTER_ERROR_NONE);
+                TEST_ASSERT_EQUAL(simdObj->convert(simdObj, &src, &out), CONVERTER_ERROR_NONE);
+
+                (void)converterObj->getFrameSize(converterObj, to, WIDTH, HEIGHT, &size);
+                TEST_ASSERT_EQUAL_MEMORY(refData, outData, size);
+
+                free(refData);
+                free(outData);
+            }
+
+            free(srcData);
+        }
+
+        (void)Converter_UnInit(&simdObj);
+    }
+}
@@ -0,0 +1,96 @@
+#include "unity.h"
+#include "exception_test_helpers.h"
+#include "utils/Converter.h"
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/**
+ * Requirement:
+ * - Converter_Init() must "assert" when "obj" is NULL
+ */
+void test_Converter_Init_Null_Parameter(void)
+{
+    TEST_ASSERT_EXPECTED(Converter_Init(NULL, CONVERTER_KERNEL_AUTO));
+}
+
+/**
+ * Requirement:
+ * - Converter_Init() must return CONVERTER_ERROR_PARAMS when "kernel" is not valid
+ */
+void test_Converter_Init_Invalid_Kernel(void)
+{
+    struct converter_s *obj    = NULL;
+    enum converter_error_e ret = CONVERTER_ERROR_NONE;
+
+    ret = Converter_Init(&obj, CONVERTER_KERNEL_MAX);
+    TEST_ASSERT_EQUAL(ret, CONVERTER_ERROR_PARAMS);
+    TEST_ASSERT_NULL(obj);
+}
+
+/**
+ * Requirement:
+ * - Converter_UnInit() must "assert" when its input parameter is NULL
+ */
+void test_Converter_UnInit_Null_Parameter(void)
+{
+    TEST_ASSERT_EXPECTED(Converter_UnInit(NULL));
+}
+
+/**
+ * Requirement:
+ * - Converter_UnInit() must "crash" when its input parameter has not been obtained
+ *   using Converter_Init()
+ */
+void test_Converter_UnInit_Bad_Memory_Access(void)
+{
+    struct converter_s _obj = {0};
+    struct converter_s *obj = &_obj;
+
+    TEST_BAD_MEMORY_ACCESS_EXPECTED(Converter_UnInit(&obj));
+}
+
+/**
+ * Requirement:
+ * - Converter_Init() must always accept the scalar kernel
+ * - Converter_UnInit() must release resources allocated by Converter_Init() without error
+ */
+void test_Converter_Init_UnInit_Valid_Input_Parameters(void)
+{
+    struct converter_s *obj         = NULL;
+    enum converter_kernel_e kernel  = CONVERTER_KERNEL_AUTO;
+    enum converter_error_e ret      = CONVERTER_ERROR_NONE;
+
+    ret = Converter_Init(&obj, CONVERTER_KERNEL_SCALAR);
+    TEST_ASSERT_EQUAL(ret, CONVERTER_ERROR_NONE);
+    TEST_ASSERT_NOT_NULL(obj);
+
+    ret = obj->getKernel(obj, &kernel);
+    TEST_ASSERT_EQUAL(ret, CONVERTER_ERROR_NONE);
+    TEST_ASSERT_EQUAL(kernel, CONVERTER_KERNEL_SCALAR);
+
+    ret = Converter_UnInit(&obj);
+    TEST_ASSERT_EQUAL(ret, CONVERTER_ERROR_NONE);
+    TEST_ASSERT_NULL(obj);
+}
+
+/**
+ * Requirement:
+ * - Converter_Init() must select an actual kernel when CONVERTER_KERNEL_AUTO is requested
+ */
+void test_Converter_Init_Auto_Kernel(void)
+{
+    struct converter_s *obj         = NULL;
+    enum converter_kernel_e kernel  = CONVERTER_KERNEL_AUTO;
+    enum converter_error_e ret      = CONVERTER_ERROR_NONE;
+
+    ret = Converter_Init(&obj, CONVERTER_KERNEL_AUTO);
+    TEST_ASSERT_EQUAL(ret, CONVERTER_ERROR_NONE);
+
+    ret = obj->getKernel(obj, &kernel);
+    TEST_ASSERT_EQUAL(ret, CONVERTER_ERROR_NONE);
+    TEST_ASSERT_TRUE((kernel > CONVERTER_KERNEL_AUTO) && (kernel < CONVERTER_KERNEL_MAX));
+
+    (void)Converter_UnInit(&obj);
+}
@@ -0,0 +1,59 @@
+#include "unity.h"
+#include "exception_test_helpers.h"
+#include "utils/JpegError.h"
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/**
+ * Requirement:
+ * - JpegError_Init() must "assert" when "err" is NULL
+ */
+void test_JpegError_Init_Null_Parameter(void)
+{
+    TEST_ASSERT_EXPECTED(JpegError_Init(NULL, 0));
+}
+
+/**
+ * Requirement:
+ * - JpegError_Init() must return the manager embedded in "err"
+ */
+void test_JpegError_Init_Valid_Input_Parameters(void)
+{
+    struct jpeg_error_s err;
+
+    TEST_ASSERT_EQUAL_PTR(&err.mgr, JpegError_Init(&err, 1));
+    TEST_ASSERT_EQUAL(1, err.isQuiet);
+    TEST_ASSERT_NOT_NULL(err.mgr.error_exit);
+    TEST_ASSERT_NOT_NULL(err.mgr.output_message);
+}
+
+/**
+ * Requirement:
+ * - libjpeg's errors must longjmp() to jmpBuf instead of exiting the process
+ */
+void test_JpegError_Corrupted_Data(void)
+{
+    static unsigned char data[] = { 0xFF, 0xD8, 0xFF, 0x00, 0x12, 0x34, 0x56, 0x78 };
+
+    struct jpeg_decompress_struct cinfo;
+    struct jpeg_error_s err;
+    volatile int nbErrors = 0;
+
+    memset(&cinfo, 0, sizeof(struct jpeg_decompress_struct));
+    cinfo.err = JpegError_Init(&err, 1);
+
+    if (setjmp(err.jmpBuf)) {
+        nbErrors++;
+    }
+    else {
+        jpeg_create_decompress(&cinfo);
+        jpeg_mem_src(&cinfo, data, sizeof(data));
+        (void)jpeg_read_header(&cinfo, TRUE);
+    }
+
+    jpeg_destroy_decompress(&cinfo);
+
+    TEST_ASSERT_EQUAL(1, nbErrors);
+}
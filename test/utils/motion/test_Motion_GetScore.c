@@ -0,0 +1,184 @@
+#include "unity.h"
+#include "exception_test_helpers.h"
+#include "utils/Motion.h"
+
+/* Not a multiple of any SIMD width so that remaining bytes are also covered */
+#define WIDTH  70
+#define HEIGHT 21
+
+static struct converter_s *converterObj = NULL;
+static struct motion_s *motionObj       = NULL;
+
+static uint8_t *allocFrame(enum converter_format_e format, struct converter_frame_s *frame)
+{
+    size_t size   = 0;
+    uint8_t *data = NULL;
+
+    TEST_ASSERT_EQUAL(converterObj->getFrameSize(converterObj, format, WIDTH, HEIGHT, &size),
+                      CONVERTER_ERROR_NONE);
+    TEST_ASSERT_NOT_NULL((data = calloc(1, size)));
+    TEST_ASSERT_EQUAL(converterObj->setFrame(converterObj, format, WIDTH, HEIGHT, data, frame),
+                      CONVERTER_ERROR_NONE);
+
+    return data;
+}
+
+static size_t fillFrame(enum converter_format_e format, uint8_t *data, uint32_t seed)
+{
+    size_t size = 0;
+
+    (void)converterObj->getFrameSize(converterObj, format, WIDTH, HEIGHT, &size);
+
+    for (size_t i = 0; i < size; ++i) {
+        seed    = seed * 1103515245 + 12345;
+        data[i] = (uint8_t)(seed >> 16);
+    }
+
+    return size;
+}
+
+void setUp(void)
+{
+    (void)Converter_Init(&converterObj, CONVERTER_KERNEL_SCALAR);
+    (void)Motion_Init(&motionObj, CONVERTER_KERNEL_SCALAR, 1);
+}
+
+void tearDown(void)
+{
+    (void)Motion_UnInit(&motionObj);
+    (void)Converter_UnInit(&converterObj);
+}
+
+/**
+ * Requirement:
+ * - getScore() and setReference() must refuse NULL and RGB frames
+ * - getScore() must return MOTION_MAX_SCORE while there is no compatible reference
+ */
+void test_Motion_GetScore_Invalid_Frames(void)
+{
+    struct converter_frame_s frame = {0};
+    uint32_t score                 = 0;
+    uint8_t *data                  = allocFrame(CONVERTER_FORMAT_RGB24, &frame);
+
+    TEST_ASSERT_EQUAL(motionObj->getScore(motionObj, NULL, &score), MOTION_ERROR_PARAMS);
+    TEST_ASSERT_EQUAL(motionObj->setReference(motionObj, NULL), MOTION_ERROR_PARAMS);
+    TEST_ASSERT_EQUAL(motionObj->getScore(motionObj, &frame, &score), MOTION_ERROR_FORMAT);
+    TEST_ASSERT_EQUAL(motionObj->setReference(motionObj, &frame), MOTION_ERROR_FORMAT);
+    free(data);
+
+    data = allocFrame(CONVERTER_FORMAT_NV12, &frame);
+    TEST_ASSERT_EQUAL(motionObj->getScore(motionObj, &frame, &score), MOTION_ERROR_NONE);
+    TEST_ASSERT_EQUAL(score, MOTION_MAX_SCORE);
+
+    TEST_ASSERT_EQUAL(motionObj->setReference(motionObj, &frame), MOTION_ERROR_NONE);
+    frame.format = CONVERTER_FORMAT_I420;
+    TEST_ASSERT_EQUAL(motionObj->getScore(motionObj, &frame, &score), MOTION_ERROR_NONE);
+    TEST_ASSERT_EQUAL(score, MOTION_MAX_SCORE);
+    free(data);
+}
+
+/**
+ * Requirement:
+ * - An unchanged frame must get a score of 0 and an inverted one MOTION_MAX_SCORE
+ * - Chroma of packed formats must be ignored
+ */
+void test_Motion_GetScore_Known_Values(void)
+{
+    struct converter_frame_s frame = {0};
+    uint32_t score                 = 0;
+    uint8_t *data                  = allocFrame(CONVERTER_FORMAT_UYVY, &frame);
+    size_t size                    = fillFrame(CONVERTER_FORMAT_UYVY, data, 0x12345678);
+    size_t i;
+
+    for (i = 1; i < size; i += 2) {
+        data[i] = 0;
+    }
+
+    TEST_ASSERT_EQUAL(motionObj->setReference(motionObj, &frame), MOTION_ERROR_NONE);
+    TEST_ASSERT_EQUAL(motionObj->getScore(motionObj, &frame, &score), MOTION_ERROR_NONE);
+    TEST_ASSERT_EQUAL(score, 0);
+
+    for (i = 0; i < size; i += 2) {
+        data[i] = (uint8_t)~data[i];
+    }
+    TEST_ASSERT_EQUAL(motionObj->getScore(motionObj, &frame, &score), MOTION_ERROR_NONE);
+    TEST_ASSERT_EQUAL(score, 0);
+
+    for (i = 1; i < size; i += 2) {
+        data[i] = 255;
+    }
+    TEST_ASSERT_EQUAL(motionObj->getScore(motionObj, &frame, &score), MOTION_ERROR_NONE);
+    TEST_ASSERT_EQUAL(score, MOTION_MAX_SCORE);
+
+    free(data);
+}
+
+/**
+ * Requirement:
+ * - Only one row out of gridStep must be compared
+ */
+void test_Motion_GetScore_Grid_Step(void)
+{
+    struct motion_s *gridObj       = NULL;
+    struct converter_frame_s frame = {0};
+    uint32_t score                 = 0;
+    uint8_t *data                  = allocFrame(CONVERTER_FORMAT_NV12, &frame);
+
+    TEST_ASSERT_EQUAL(Motion_Init(&gridObj, CONVERTER_KERNEL_SCALAR, 4), MOTION_ERROR_NONE);
+    TEST_ASSERT_EQUAL(gridObj->setReference(gridObj, &frame), MOTION_ERROR_NONE);
+
+    /* Rows 1 to 3 are not sampled */
+    memset(data + WIDTH, 255, 3 * WIDTH);
+    TEST_ASSERT_EQUAL(gridObj->getScore(gridObj, &frame, &score), MOTION_ERROR_NONE);
+    TEST_ASSERT_EQUAL(score, 0);
+
+    /* 1 sampled row out of 6 */
+    memset(data + 4 * WIDTH, 255, WIDTH);
+    TEST_ASSERT_EQUAL(gridObj->getScore(gridObj, &frame, &score), MOTION_ERROR_NONE);
+    TEST_ASSERT_EQUAL(score, MOTION_MAX_SCORE / 6);
+
+    (void)Motion_UnInit(&gridObj);
+    free(data);
+}
+
+/**
+ * Requirement:
+ * - All kernels supported by the running cpu must give exactly the same scores as the scalar
+ *   one for every YUV format
+ */
+void test_Motion_GetScore_Kernels_Bit_Exact(void)
+{
+    struct motion_s *simdObj = NULL;
+    struct converter_frame_s reference, frame;
+    enum converter_format_e format;
+    enum converter_kernel_e kernel;
+    uint32_t expected, score;
+
+    for (kernel = CONVERTER_KERNEL_SSE2; kernel < CONVERTER_KERNEL_MAX; ++kernel) {
+        if (Motion_Init(&simdObj, kernel, 1) != MOTION_ERROR_NONE) {
+            continue;
+        }
+
+        for (format = CONVERTER_FORMAT_YUYV; format <= CONVERTER_FORMAT_I420; ++format) {
+            uint8_t *referenceData = allocFrame(format, &reference);
+            uint8_t *frameData     = allocFrame(format, &frame);
+
+            (void)fillFrame(format, referenceData, 0x12345678);
+            (void)fillFrame(format, frameData, 0x87654321);
+
+            (void)motionObj->setReference(motionObj, &reference);
+            (void)simdObj->setReference(simdObj, &reference);
+
+            TEST_ASSERT_EQUAL(motionObj->getScore(motionObj, &frame, &expected),
+                              MOTION_ERROR_NONE);
+            TEST_ASSERT_EQUAL(simdObj->getScore(simdObj, &frame, &score), MOTION_ERROR_NONE);
+            TEST_ASSERT_EQUAL(score, expected);
+            TEST_ASSERT_TRUE((expected > 0) && (expected < MOTION_MAX_SCORE));
+
+            free(referenceData);
+            free(frameData);
+        }
+
+        (void)Motion_UnInit(&simdObj);
+    }
+}
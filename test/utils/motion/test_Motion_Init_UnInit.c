@@ -0,0 +1,96 @@
+#include "unity.h"
+#include "exception_test_helpers.h"
+#include "utils/Motion.h"
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/**
+ * Requirement:
+ * - Motion_Init() must "assert" when "obj" is NULL
+ */
+void test_Motion_Init_Null_Parameter(void)
+{
+    TEST_ASSERT_EXPECTED(Motion_Init(NULL, CONVERTER_KERNEL_AUTO, 0));
+}
+
+/**
+ * Requirement:
+ * - Motion_Init() must return MOTION_ERROR_PARAMS when "kernel" is not valid
+ */
+void test_Motion_Init_Invalid_Kernel(void)
+{
+    struct motion_s *obj    = NULL;
+    enum motion_error_e ret = MOTION_ERROR_NONE;
+
+    ret = Motion_Init(&obj, CONVERTER_KERNEL_MAX, 0);
+    TEST_ASSERT_EQUAL(ret, MOTION_ERROR_PARAMS);
+    TEST_ASSERT_NULL(obj);
+}
+
+/**
+ * Requirement:
+ * - Motion_UnInit() must "assert" when its input parameter is NULL
+ */
+void test_Motion_UnInit_Null_Parameter(void)
+{
+    TEST_ASSERT_EXPECTED(Motion_UnInit(NULL));
+}
+
+/**
+ * Requirement:
+ * - Motion_UnInit() must "crash" when its input parameter has not been obtained
+ *   using Motion_Init()
+ */
+void test_Motion_UnInit_Bad_Memory_Access(void)
+{
+    struct motion_s _obj = {0};
+    struct motion_s *obj = &_obj;
+
+    TEST_BAD_MEMORY_ACCESS_EXPECTED(Motion_UnInit(&obj));
+}
+
+/**
+ * Requirement:
+ * - Motion_Init() must always accept the scalar kernel
+ * - Motion_UnInit() must release resources allocated by Motion_Init() without error
+ */
+void test_Motion_Init_UnInit_Valid_Input_Parameters(void)
+{
+    struct motion_s *obj           = NULL;
+    enum converter_kernel_e kernel = CONVERTER_KERNEL_AUTO;
+    enum motion_error_e ret        = MOTION_ERROR_NONE;
+
+    ret = Motion_Init(&obj, CONVERTER_KERNEL_SCALAR, 0);
+    TEST_ASSERT_EQUAL(ret, MOTION_ERROR_NONE);
+    TEST_ASSERT_NOT_NULL(obj);
+
+    ret = obj->getKernel(obj, &kernel);
+    TEST_ASSERT_EQUAL(ret, MOTION_ERROR_NONE);
+    TEST_ASSERT_EQUAL(kernel, CONVERTER_KERNEL_SCALAR);
+
+    ret = Motion_UnInit(&obj);
+    TEST_ASSERT_EQUAL(ret, MOTION_ERROR_NONE);
+    TEST_ASSERT_NULL(obj);
+}
+
+/**
+ * Requirement:
+ * - Motion_Init() must select an actual kernel when CONVERTER_KERNEL_AUTO is requested
+ */
+void test_Motion_Init_Auto_Kernel(void)
+{
+    struct motion_s *obj           = NULL;
+    enum converter_kernel_e kernel = CONVERTER_KERNEL_AUTO;
+    enum motion_error_e ret        = MOTION_ERROR_NONE;
+
+    ret = Motion_Init(&obj, CONVERTER_KERNEL_AUTO, 0);
+    TEST_ASSERT_EQUAL(ret, MOTION_ERROR_NONE);
+
+    ret = obj->getKernel(obj, &kernel);
+    TEST_ASSERT_EQUAL(ret, MOTION_ERROR_NONE);
+    TEST_ASSERT_TRUE((kernel > CONVERTER_KERNEL_AUTO) && (kernel < CONVERTER_KERNEL_MAX));
+
+    (void)Motion_UnInit(&obj);
+}
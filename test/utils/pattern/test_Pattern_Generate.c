@@ -0,0 +1,151 @@
+#include "unity.h"
+#include "exception_test_helpers.h"
+#include "utils/Pattern.h"
+
+/* Stamp needs 2 rows of blocks */
+#define WIDTH  480
+#define HEIGHT 21
+
+static struct converter_s *converterObj = NULL;
+static struct pattern_s *barsObj        = NULL;
+static struct pattern_s *noiseObj       = NULL;
+
+static uint8_t *allocFrame(enum converter_format_e format, uint32_t width, uint32_t height,
+                           struct converter_frame_s *frame)
+{
+    size_t size   = 0;
+    uint8_t *data = NULL;
+
+    TEST_ASSERT_EQUAL(converterObj->getFrameSize(converterObj, format, width, height, &size),
+                      CONVERTER_ERROR_NONE);
+    TEST_ASSERT_NOT_NULL((data = calloc(1, size)));
+    TEST_ASSERT_EQUAL(converterObj->setFrame(converterObj, format, width, height, data, frame),
+                      CONVERTER_ERROR_NONE);
+
+    return data;
+}
+
+void setUp(void)
+{
+    (void)Converter_Init(&converterObj, CONVERTER_KERNEL_SCALAR);
+    (void)Pattern_Init(&barsObj, PATTERN_TYPE_BARS);
+    (void)Pattern_Init(&noiseObj, PATTERN_TYPE_NOISE);
+}
+
+void tearDown(void)
+{
+    (void)Pattern_UnInit(&noiseObj);
+    (void)Pattern_UnInit(&barsObj);
+    (void)Converter_UnInit(&converterObj);
+}
+
+/**
+ * Requirement:
+ * - generate() and readStamp() must refuse NULL and malformed frames
+ * - readStamp() must return PATTERN_ERROR_NOT_FOUND on frames not stamped
+ */
+void test_Pattern_Generate_Invalid_Frames(void)
+{
+    struct converter_frame_s frame = {0};
+    struct pattern_stamp_s stamp   = {0};
+    uint8_t *data                  = allocFrame(CONVERTER_FORMAT_NV12, WIDTH, HEIGHT, &frame);
+
+    TEST_ASSERT_EQUAL(barsObj->generate(barsObj, NULL, &stamp), PATTERN_ERROR_PARAMS);
+    TEST_ASSERT_EQUAL(barsObj->generate(barsObj, &frame, NULL), PATTERN_ERROR_PARAMS);
+    TEST_ASSERT_EQUAL(barsObj->readStamp(barsObj, NULL, &stamp), PATTERN_ERROR_PARAMS);
+
+    TEST_ASSERT_EQUAL(barsObj->readStamp(barsObj, &frame, &stamp), PATTERN_ERROR_NOT_FOUND);
+
+    frame.planes[1] = NULL;
+    TEST_ASSERT_EQUAL(barsObj->generate(barsObj, &frame, &stamp), PATTERN_ERROR_PARAMS);
+
+    frame.format = CONVERTER_FORMAT_MAX;
+    TEST_ASSERT_EQUAL(barsObj->generate(barsObj, &frame, &stamp), PATTERN_ERROR_FORMAT);
+
+    free(data);
+}
+
+/**
+ * Requirement:
+ * - Stamps must be read back unchanged from every format and every pattern
+ */
+void test_Pattern_Generate_Stamp_Round_Trip(void)
+{
+    struct converter_frame_s frame;
+    struct pattern_stamp_s stamp = { 0xDEADBEEF, 0x0123456789ABCDEFULL };
+    struct pattern_stamp_s read;
+    enum converter_format_e format;
+
+    for (format = CONVERTER_FORMAT_YUYV; format < CONVERTER_FORMAT_MAX; ++format) {
+        uint8_t *data = allocFrame(format, WIDTH, HEIGHT, &frame);
+
+        TEST_ASSERT_EQUAL(barsObj->generate(barsObj, &frame, &stamp), PATTERN_ERROR_NONE);
+        memset(&read, 0, sizeof(read));
+        TEST_ASSERT_EQUAL(barsObj->readStamp(barsObj, &frame, &read), PATTERN_ERROR_NONE);
+        TEST_ASSERT_EQUAL_HEX32(stamp.counter, read.counter);
+        TEST_ASSERT_TRUE(stamp.timestamp_us == read.timestamp_us);
+
+        stamp.counter++;
+
+        TEST_ASSERT_EQUAL(noiseObj->generate(noiseObj, &frame, &stamp), PATTERN_ERROR_NONE);
+        memset(&read, 0, sizeof(read));
+        TEST_ASSERT_EQUAL(noiseObj->readStamp(noiseObj, &frame, &read), PATTERN_ERROR_NONE);
+        TEST_ASSERT_EQUAL_HEX32(stamp.counter, read.counter);
+        TEST_ASSERT_TRUE(stamp.timestamp_us == read.timestamp_us);
+
+        free(data);
+    }
+}
+
+/**
+ * Requirement:
+ * - Frames too small to hold a stamp must still be generated but not stamped
+ */
+void test_Pattern_Generate_Frame_Too_Small(void)
+{
+    struct converter_frame_s frame;
+    struct pattern_stamp_s stamp = { 1, 2 };
+    uint8_t *data                = allocFrame(CONVERTER_FORMAT_I420, WIDTH, 8, &frame);
+
+    TEST_ASSERT_EQUAL(barsObj->generate(barsObj, &frame, &stamp), PATTERN_ERROR_NONE);
+    TEST_ASSERT_EQUAL(barsObj->readStamp(barsObj, &frame, &stamp), PATTERN_ERROR_NOT_FOUND);
+
+    free(data);
+}
+
+/**
+ * Requirement:
+ * - Bars must move from a frame to the next one
+ * - Rows below the stamp must all be the same
+ * - Noise must differ from a frame to the next one
+ */
+void test_Pattern_Generate_Content(void)
+{
+    struct converter_frame_s frame;
+    struct pattern_stamp_s stamp = { 0, 0 };
+    uint8_t *data                = allocFrame(CONVERTER_FORMAT_YUYV, WIDTH, HEIGHT, &frame);
+    uint8_t *copy                = NULL;
+    size_t rowSize               = frame.strides[0];
+    uint32_t row;
+
+    TEST_ASSERT_NOT_NULL((copy = malloc(rowSize)));
+
+    TEST_ASSERT_EQUAL(barsObj->generate(barsObj, &frame, &stamp), PATTERN_ERROR_NONE);
+    memcpy(copy, data + (HEIGHT - 1) * rowSize, rowSize);
+
+    for (row = 2 * PATTERN_STAMP_BLOCK_SIZE; row < HEIGHT; row++) {
+        TEST_ASSERT_EQUAL_MEMORY(copy, data + row * rowSize, rowSize);
+    }
+
+    stamp.counter++;
+    TEST_ASSERT_EQUAL(barsObj->generate(barsObj, &frame, &stamp), PATTERN_ERROR_NONE);
+    TEST_ASSERT_TRUE(memcmp(copy, data + (HEIGHT - 1) * rowSize, rowSize) != 0);
+
+    TEST_ASSERT_EQUAL(noiseObj->generate(noiseObj, &frame, &stamp), PATTERN_ERROR_NONE);
+    memcpy(copy, data + (HEIGHT - 1) * rowSize, rowSize);
+    TEST_ASSERT_EQUAL(noiseObj->generate(noiseObj, &frame, &stamp), PATTERN_ERROR_NONE);
+    TEST_ASSERT_TRUE(memcmp(copy, data + (HEIGHT - 1) * rowSize, rowSize) != 0);
+
+    free(copy);
+    free(data);
+}
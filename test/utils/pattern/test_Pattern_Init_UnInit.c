@@ -0,0 +1,73 @@
+#include "unity.h"
+#include "exception_test_helpers.h"
+#include "utils/Pattern.h"
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/**
+ * Requirement:
+ * - Pattern_Init() must "assert" when "obj" is NULL
+ */
+void test_Pattern_Init_Null_Parameter(void)
+{
+    TEST_ASSERT_EXPECTED(Pattern_Init(NULL, PATTERN_TYPE_BARS));
+}
+
+/**
+ * Requirement:
+ * - Pattern_Init() must return PATTERN_ERROR_PARAMS when "type" is not valid
+ */
+void test_Pattern_Init_Invalid_Type(void)
+{
+    struct pattern_s *obj    = NULL;
+    enum pattern_error_e ret = PATTERN_ERROR_NONE;
+
+    ret = Pattern_Init(&obj, PATTERN_TYPE_MAX);
+    TEST_ASSERT_EQUAL(ret, PATTERN_ERROR_PARAMS);
+    TEST_ASSERT_NULL(obj);
+}
+
+/**
+ * Requirement:
+ * - Pattern_UnInit() must "assert" when its input parameter is NULL
+ */
+void test_Pattern_UnInit_Null_Parameter(void)
+{
+    TEST_ASSERT_EXPECTED(Pattern_UnInit(NULL));
+}
+
+/**
+ * Requirement:
+ * - Pattern_UnInit() must "crash" when its input parameter has not been obtained
+ *   using Pattern_Init()
+ */
+void test_Pattern_UnInit_Bad_Memory_Access(void)
+{
+    struct pattern_s _obj = {0};
+    struct pattern_s *obj = &_obj;
+
+    TEST_BAD_MEMORY_ACCESS_EXPECTED(Pattern_UnInit(&obj));
+}
+
+/**
+ * Requirement:
+ * - Pattern_UnInit() must release resources allocated by Pattern_Init() without error
+ */
+void test_Pattern_Init_UnInit_Valid_Input_Parameters(void)
+{
+    struct pattern_s *obj    = NULL;
+    enum pattern_error_e ret = PATTERN_ERROR_NONE;
+    enum pattern_type_e type;
+
+    for (type = PATTERN_TYPE_BARS; type < PATTERN_TYPE_MAX; ++type) {
+        ret = Pattern_Init(&obj, type);
+        TEST_ASSERT_EQUAL(ret, PATTERN_ERROR_NONE);
+        TEST_ASSERT_NOT_NULL(obj);
+
+        ret = Pattern_UnInit(&obj);
+        TEST_ASSERT_EQUAL(ret, PATTERN_ERROR_NONE);
+        TEST_ASSERT_NULL(obj);
+    }
+}
@@ -0,0 +1,151 @@
+#include <semaphore.h>
+#include <sys/eventfd.h>
+#include <time.h>
+
+#include "unity.h"
+#include "exception_test_helpers.h"
+#include "utils/Reactor.h"
+
+static struct reactor_s *gReactor = NULL;
+static sem_t gEventSem;
+static uint32_t gNbEvents         = 0;
+
+static void onEventCb(struct reactor_s *obj, int32_t fd, uint32_t events, void *userData)
+{
+    (void)obj;
+    (void)events;
+    (void)userData;
+
+    uint64_t value;
+    if (read(fd, &value, sizeof(value)) == sizeof(value)) {
+        gNbEvents++;
+        sem_post(&gEventSem);
+    }
+}
+
+static uint8_t waitEvent(uint32_t timeout_ms)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+
+    ts.tv_sec  += timeout_ms / 1000;
+    ts.tv_nsec += (long)(timeout_ms % 1000) * 1000000;
+    if (ts.tv_nsec >= 1000000000) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000;
+    }
+
+    return (sem_timedwait(&gEventSem, &ts) == 0);
+}
+
+static void notify(int32_t fd)
+{
+    uint64_t value = 1;
+    TEST_ASSERT_EQUAL(write(fd, &value, sizeof(value)), sizeof(value));
+}
+
+void setUp(void)
+{
+    struct reactor_params_s params = {0};
+
+    strcpy(params.name, "test-reactor");
+    params.priority  = PRIORITY_DEFAULT;
+    params.nbThreads = 2;
+
+    gNbEvents = 0;
+    sem_init(&gEventSem, 0, 0);
+    Reactor_Init(&gReactor, &params);
+}
+
+void tearDown(void)
+{
+    Reactor_UnInit(&gReactor);
+    sem_destroy(&gEventSem);
+}
+
+/**
+ * Requirement:
+ * - add() must "assert" when "obj" is NULL
+ * - add() must return REACTOR_ERROR_PARAMS when fd is invalid, when no callback is given or when
+ *   fd is already watched
+ */
+void test_Reactor_Add_Bad_Parameters(void)
+{
+    int32_t fd = eventfd(0, EFD_NONBLOCK);
+
+    TEST_ASSERT_EXPECTED(gReactor->add(NULL, fd, onEventCb, NULL));
+    TEST_ASSERT_EQUAL(gReactor->add(gReactor, -1, onEventCb, NULL), REACTOR_ERROR_PARAMS);
+    TEST_ASSERT_EQUAL(gReactor->add(gReactor, fd, NULL, NULL), REACTOR_ERROR_PARAMS);
+
+    TEST_ASSERT_EQUAL(gReactor->add(gReactor, fd, onEventCb, NULL), REACTOR_ERROR_NONE);
+    TEST_ASSERT_EQUAL(gReactor->add(gReactor, fd, onEventCb, NULL), REACTOR_ERROR_PARAMS);
+    TEST_ASSERT_EQUAL(gReactor->remove(gReactor, fd), REACTOR_ERROR_NONE);
+
+    close(fd);
+}
+
+/**
+ * Requirement:
+ * - remove(), suspend() and resume() must return REACTOR_ERROR_PARAMS when fd is not watched
+ */
+void test_Reactor_Unknown_Fd(void)
+{
+    TEST_ASSERT_EQUAL(gReactor->remove(gReactor, 1234), REACTOR_ERROR_PARAMS);
+    TEST_ASSERT_EQUAL(gReactor->suspend(gReactor, 1234), REACTOR_ERROR_PARAMS);
+    TEST_ASSERT_EQUAL(gReactor->resume(gReactor, 1234), REACTOR_ERROR_PARAMS);
+}
+
+/**
+ * Requirement:
+ * - Callback must be called each time a watched fd becomes readable
+ * - Callback must not be called anymore once fd is removed
+ */
+void test_Reactor_Add_Remove(void)
+{
+    int32_t fd1 = eventfd(0, EFD_NONBLOCK);
+    int32_t fd2 = eventfd(0, EFD_NONBLOCK);
+
+    TEST_ASSERT_EQUAL(gReactor->add(gReactor, fd1, onEventCb, NULL), REACTOR_ERROR_NONE);
+    TEST_ASSERT_EQUAL(gReactor->add(gReactor, fd2, onEventCb, NULL), REACTOR_ERROR_NONE);
+
+    notify(fd1);
+    TEST_ASSERT_TRUE(waitEvent(1000));
+
+    notify(fd2);
+    TEST_ASSERT_TRUE(waitEvent(1000));
+
+    TEST_ASSERT_EQUAL(gReactor->remove(gReactor, fd1), REACTOR_ERROR_NONE);
+
+    notify(fd1);
+    TEST_ASSERT_FALSE(waitEvent(100));
+    TEST_ASSERT_EQUAL(gNbEvents, 2);
+
+    TEST_ASSERT_EQUAL(gReactor->remove(gReactor, fd2), REACTOR_ERROR_NONE);
+
+    close(fd1);
+    close(fd2);
+}
+
+/**
+ * Requirement:
+ * - Callback must not be called while fd is suspended
+ * - Pending events must be delivered once fd is resumed
+ */
+void test_Reactor_Suspend_Resume(void)
+{
+    int32_t fd = eventfd(0, EFD_NONBLOCK);
+
+    TEST_ASSERT_EQUAL(gReactor->add(gReactor, fd, onEventCb, NULL), REACTOR_ERROR_NONE);
+    TEST_ASSERT_EQUAL(gReactor->suspend(gReactor, fd), REACTOR_ERROR_NONE);
+
+    notify(fd);
+    TEST_ASSERT_FALSE(waitEvent(100));
+
+    TEST_ASSERT_EQUAL(gReactor->resume(gReactor, fd), REACTOR_ERROR_NONE);
+    TEST_ASSERT_TRUE(waitEvent(1000));
+    TEST_ASSERT_EQUAL(gNbEvents, 1);
+
+    TEST_ASSERT_EQUAL(gReactor->remove(gReactor, fd), REACTOR_ERROR_NONE);
+
+    close(fd);
+}
@@ -0,0 +1,82 @@
+#include "unity.h"
+#include "exception_test_helpers.h"
+#include "utils/Reactor.h"
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/**
+ * Requirement:
+ * - Reactor_Init() must "assert" when "obj" or "params" is NULL
+ */
+void test_Reactor_Init_Null_Parameters(void)
+{
+    struct reactor_s *obj          = NULL;
+    struct reactor_params_s params = {0};
+
+    TEST_ASSERT_EXPECTED(Reactor_Init(NULL, &params));
+    TEST_ASSERT_EXPECTED(Reactor_Init(&obj, NULL));
+}
+
+/**
+ * Requirement:
+ * - Reactor_Init() must return REACTOR_ERROR_PARAMS when "nbThreads" is 0
+ */
+void test_Reactor_Init_No_Thread(void)
+{
+    struct reactor_s *obj          = NULL;
+    struct reactor_params_s params = {0};
+    enum reactor_error_e ret       = REACTOR_ERROR_NONE;
+
+    ret = Reactor_Init(&obj, &params);
+    TEST_ASSERT_EQUAL(ret, REACTOR_ERROR_PARAMS);
+    TEST_ASSERT_NULL(obj);
+}
+
+/**
+ * Requirement:
+ * - Reactor_UnInit() must "assert" when its input parameter is NULL
+ */
+void test_Reactor_UnInit_Null_Parameter(void)
+{
+    TEST_ASSERT_EXPECTED(Reactor_UnInit(NULL));
+}
+
+/**
+ * Requirement:
+ * - Reactor_UnInit() must "crash" when its input parameter has not been obtained
+ *   using Reactor_Init()
+ */
+void test_Reactor_UnInit_Bad_Memory_Access(void)
+{
+    struct reactor_s _obj = {0};
+    struct reactor_s *obj = &_obj;
+
+    TEST_BAD_MEMORY_ACCESS_EXPECTED(Reactor_UnInit(&obj));
+}
+
+/**
+ * Requirement:
+ * - Reactor_Init() must initialize "obj" without error when called as expected
+ * - Reactor_UnInit() must stop threads and release resources allocated by Reactor_Init() without
+ *   error
+ */
+void test_Reactor_Init_UnInit_Valid_Input_Parameters(void)
+{
+    struct reactor_s *obj          = NULL;
+    struct reactor_params_s params = {0};
+    enum reactor_error_e ret       = REACTOR_ERROR_NONE;
+
+    strcpy(params.name, "test-reactor");
+    params.priority  = PRIORITY_DEFAULT;
+    params.nbThreads = 2;
+
+    ret = Reactor_Init(&obj, &params);
+    TEST_ASSERT_EQUAL(ret, REACTOR_ERROR_NONE);
+    TEST_ASSERT_NOT_NULL(obj);
+
+    ret = Reactor_UnInit(&obj);
+    TEST_ASSERT_EQUAL(ret, REACTOR_ERROR_NONE);
+    TEST_ASSERT_NULL(obj);
+}
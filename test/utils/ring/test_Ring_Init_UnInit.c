@@ -0,0 +1,71 @@
+#include "unity.h"
+#include "exception_test_helpers.h"
+#include "utils/Ring.h"
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/**
+ * Requirement:
+ * - Ring_Init() must "assert" when "obj" is NULL
+ */
+void test_Ring_Init_Null_Parameter(void)
+{
+    TEST_ASSERT_EXPECTED(Ring_Init(NULL, 1));
+}
+
+/**
+ * Requirement:
+ * - Ring_Init() must return RING_ERROR_PARAMS when "nbSlots" is 0
+ */
+void test_Ring_Init_No_Slot(void)
+{
+    struct ring_s *obj    = NULL;
+    enum ring_error_e ret = RING_ERROR_NONE;
+
+    ret = Ring_Init(&obj, 0);
+    TEST_ASSERT_EQUAL(ret, RING_ERROR_PARAMS);
+    TEST_ASSERT_NULL(obj);
+}
+
+/**
+ * Requirement:
+ * - Ring_UnInit() must "assert" when its input parameter is NULL
+ */
+void test_Ring_UnInit_Null_Parameter(void)
+{
+    TEST_ASSERT_EXPECTED(Ring_UnInit(NULL));
+}
+
+/**
+ * Requirement:
+ * - Ring_UnInit() must "crash" when its input parameter has not been obtained
+ *   using Ring_Init()
+ */
+void test_Ring_UnInit_Bad_Memory_Access(void)
+{
+    struct ring_s _obj = {0};
+    struct ring_s *obj = &_obj;
+
+    TEST_BAD_MEMORY_ACCESS_EXPECTED(Ring_UnInit(&obj));
+}
+
+/**
+ * Requirement:
+ * - Ring_Init() must initialize "obj" without error when called as expected
+ * - Ring_UnInit() must release resources allocated by Ring_Init() without error
+ */
+void test_Ring_Init_UnInit_Valid_Input_Parameters(void)
+{
+    struct ring_s *obj    = NULL;
+    enum ring_error_e ret = RING_ERROR_NONE;
+
+    ret = Ring_Init(&obj, 4);
+    TEST_ASSERT_EQUAL(ret, RING_ERROR_NONE);
+    TEST_ASSERT_NOT_NULL(obj);
+
+    ret = Ring_UnInit(&obj);
+    TEST_ASSERT_EQUAL(ret, RING_ERROR_NONE);
+    TEST_ASSERT_NULL(obj);
+}
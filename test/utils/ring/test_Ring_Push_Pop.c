@@ -0,0 +1,132 @@
+#include "unity.h"
+#include "exception_test_helpers.h"
+#include "utils/Ring.h"
+
+#define NB_SLOTS 3
+
+static struct ring_s *ringObj = NULL;
+static uint32_t elements[]    = {1, 2, 3, 4};
+
+void setUp(void)
+{
+    (void)Ring_Init(&ringObj, NB_SLOTS);
+}
+
+void tearDown(void)
+{
+    (void)Ring_UnInit(&ringObj);
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/*                                             PUSH                                             */
+/* -------------------------------------------------------------------------------------------- */
+
+/**
+ * Requirement:
+ * - push() must "assert" when at least one of its input parameters is NULL
+ */
+void test_Ring_Push_Null_Parameter(void)
+{
+    TEST_ASSERT_EXPECTED(ringObj->push(ringObj, NULL));
+    TEST_ASSERT_EXPECTED(ringObj->push(NULL, &elements[0]));
+}
+
+/**
+ * Requirement:
+ * - push() must return RING_ERROR_FULL once all slots are used and leave the ring unchanged
+ */
+void test_Ring_Push_Full(void)
+{
+    uint32_t nbElements   = 0;
+    enum ring_error_e ret = RING_ERROR_NONE;
+
+    for (uint32_t i = 0; i < NB_SLOTS; ++i) {
+        ret = ringObj->push(ringObj, &elements[i]);
+        TEST_ASSERT_EQUAL(ret, RING_ERROR_NONE);
+    }
+
+    ret = ringObj->push(ringObj, &elements[NB_SLOTS]);
+    TEST_ASSERT_EQUAL(ret, RING_ERROR_FULL);
+
+    ret = ringObj->getNbElements(ringObj, &nbElements);
+    TEST_ASSERT_EQUAL(ret, RING_ERROR_NONE);
+    TEST_ASSERT_EQUAL_UINT32(NB_SLOTS, nbElements);
+}
+
+/* -------------------------------------------------------------------------------------------- */
+/*                                              POP                                             */
+/* -------------------------------------------------------------------------------------------- */
+
+/**
+ * Requirement:
+ * - pop() must "assert" when at least one of its input parameters is NULL
+ */
+void test_Ring_Pop_Null_Parameter(void)
+{
+    void *element = NULL;
+    TEST_ASSERT_EXPECTED(ringObj->pop(ringObj, NULL));
+    TEST_ASSERT_EXPECTED(ringObj->pop(NULL, &element));
+}
+
+/**
+ * Requirement:
+ * - pop() must return RING_ERROR_EMPTY when there is no element in the ring
+ */
+void test_Ring_Pop_Empty(void)
+{
+    void *element         = NULL;
+    enum ring_error_e ret = RING_ERROR_NONE;
+
+    ret = ringObj->pop(ringObj, &element);
+    TEST_ASSERT_EQUAL(ret, RING_ERROR_EMPTY);
+    TEST_ASSERT_NULL(element);
+}
+
+/**
+ * Requirement:
+ * - pop() must return elements in the order they were pushed, including after the
+ *   indexes wrapped around the end of the ring
+ */
+void test_Ring_Pop_Fifo_Order(void)
+{
+    void *element         = NULL;
+    enum ring_error_e ret = RING_ERROR_NONE;
+
+    for (uint32_t round = 0; round < 2; ++round) {
+        for (uint32_t i = 0; i < SIZEOF_ARRAY(elements); ++i) {
+            ret = ringObj->push(ringObj, &elements[i]);
+            TEST_ASSERT_EQUAL(ret, RING_ERROR_NONE);
+
+            ret = ringObj->pop(ringObj, &element);
+            TEST_ASSERT_EQUAL(ret, RING_ERROR_NONE);
+            TEST_ASSERT_EQUAL_UINT32(elements[i], *((uint32_t*)element));
+        }
+    }
+}
+
+/**
+ * Requirement:
+ * - Popping the oldest element of a full ring must free exactly one slot (drop-oldest policy)
+ */
+void test_Ring_Pop_Drop_Oldest(void)
+{
+    void *element         = NULL;
+    enum ring_error_e ret = RING_ERROR_NONE;
+
+    for (uint32_t i = 0; i < NB_SLOTS; ++i) {
+        (void)ringObj->push(ringObj, &elements[i]);
+    }
+
+    ret = ringObj->pop(ringObj, &element);
+    TEST_ASSERT_EQUAL(ret, RING_ERROR_NONE);
+    TEST_ASSERT_EQUAL_UINT32(elements[0], *((uint32_t*)element));
+
+    ret = ringObj->push(ringObj, &elements[NB_SLOTS]);
+    TEST_ASSERT_EQUAL(ret, RING_ERROR_NONE);
+
+    for (uint32_t i = 1; i <= NB_SLOTS; ++i) {
+        ret = ringObj->pop(ringObj, &element);
+        TEST_ASSERT_EQUAL(ret, RING_ERROR_NONE);
+        TEST_ASSERT_EQUAL_UINT32(elements[i], *((uint32_t*)element));
+    }
+}
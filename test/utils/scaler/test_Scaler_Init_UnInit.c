@@ -0,0 +1,96 @@
+#include "unity.h"
+#include "exception_test_helpers.h"
+#include "utils/Scaler.h"
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/**
+ * Requirement:
+ * - Scaler_Init() must "assert" when "obj" is NULL
+ */
+void test_Scaler_Init_Null_Parameter(void)
+{
+    TEST_ASSERT_EXPECTED(Scaler_Init(NULL, CONVERTER_KERNEL_AUTO));
+}
+
+/**
+ * Requirement:
+ * - Scaler_Init() must return SCALER_ERROR_PARAMS when "kernel" is not valid
+ */
+void test_Scaler_Init_Invalid_Kernel(void)
+{
+    struct scaler_s *obj    = NULL;
+    enum scaler_error_e ret = SCALER_ERROR_NONE;
+
+    ret = Scaler_Init(&obj, CONVERTER_KERNEL_MAX);
+    TEST_ASSERT_EQUAL(ret, SCALER_ERROR_PARAMS);
+    TEST_ASSERT_NULL(obj);
+}
+
+/**
+ * Requirement:
+ * - Scaler_UnInit() must "assert" when its input parameter is NULL
+ */
+void test_Scaler_UnInit_Null_Parameter(void)
+{
+    TEST_ASSERT_EXPECTED(Scaler_UnInit(NULL));
+}
+
+/**
+ * Requirement:
+ * - Scaler_UnInit() must "crash" when its input parameter has not been obtained
+ *   using Scaler_Init()
+ */
+void test_Scaler_UnInit_Bad_Memory_Access(void)
+{
+    struct scaler_s _obj = {0};
+    struct scaler_s *obj = &_obj;
+
+    TEST_BAD_MEMORY_ACCESS_EXPECTED(Scaler_UnInit(&obj));
+}
+
+/**
+ * Requirement:
+ * - Scaler_Init() must always accept the scalar kernel
+ * - Scaler_UnInit() must release resources allocated by Scaler_Init() without error
+ */
+void test_Scaler_Init_UnInit_Valid_Input_Parameters(void)
+{
+    struct scaler_s *obj           = NULL;
+    enum converter_kernel_e kernel = CONVERTER_KERNEL_AUTO;
+    enum scaler_error_e ret        = SCALER_ERROR_NONE;
+
+    ret = Scaler_Init(&obj, CONVERTER_KERNEL_SCALAR);
+    TEST_ASSERT_EQUAL(ret, SCALER_ERROR_NONE);
+    TEST_ASSERT_NOT_NULL(obj);
+
+    ret = obj->getKernel(obj, &kernel);
+    TEST_ASSERT_EQUAL(ret, SCALER_ERROR_NONE);
+    TEST_ASSERT_EQUAL(kernel, CONVERTER_KERNEL_SCALAR);
+
+    ret = Scaler_UnInit(&obj);
+    TEST_ASSERT_EQUAL(ret, SCALER_ERROR_NONE);
+    TEST_ASSERT_NULL(obj);
+}
+
+/**
+ * Requirement:
+ * - Scaler_Init() must select an actual kernel when CONVERTER_KERNEL_AUTO is requested
+ */
+void test_Scaler_Init_Auto_Kernel(void)
+{
+    struct scaler_s *obj           = NULL;
+    enum converter_kernel_e kernel = CONVERTER_KERNEL_AUTO;
+    enum scaler_error_e ret        = SCALER_ERROR_NONE;
+
+    ret = Scaler_Init(&obj, CONVERTER_KERNEL_AUTO);
+    TEST_ASSERT_EQUAL(ret, SCALER_ERROR_NONE);
+
+    ret = obj->getKernel(obj, &kernel);
+    TEST_ASSERT_EQUAL(ret, SCALER_ERROR_NONE);
+    TEST_ASSERT_TRUE((kernel > CONVERTER_KERNEL_AUTO) && (kernel < CONVERTER_KERNEL_MAX));
+
+    (void)Scaler_UnInit(&obj);
+}
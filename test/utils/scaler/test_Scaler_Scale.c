@@ -0,0 +1,219 @@
+#include "unity.h"
+#include "exception_test_helpers.h"
+#include "utils/Scaler.h"
+
+/* Not a multiple of any SIMD width so that remaining bytes are also covered */
+#define SRC_WIDTH  86
+#define SRC_HEIGHT 23
+
+static struct converter_s *converterObj = NULL;
+static struct scaler_s *scalerObj       = NULL;
+
+static uint8_t *allocFrame(enum converter_format_e format, uint32_t width, uint32_t height,
+                           struct converter_frame_s *frame)
+{
+    size_t size   = 0;
+    uint8_t *data = NULL;
+
+    TEST_ASSERT_EQUAL(converterObj->getFrameSize(converterObj, format, width, height, &size),
+                      CONVERTER_ERROR_NONE);
+    TEST_ASSERT_NOT_NULL((data = calloc(1, size)));
+    TEST_ASSERT_EQUAL(converterObj->setFrame(converterObj, format, width, height, data, frame),
+                      CONVERTER_ERROR_NONE);
+
+    return data;
+}
+
+static size_t fillFrame(enum converter_format_e format, uint32_t width, uint32_t height,
+                        uint8_t *data, uint8_t value)
+{
+    size_t size   = 0;
+    uint32_t seed = 0x12345678;
+
+    (void)converterObj->getFrameSize(converterObj, format, width, height, &size);
+
+    for (size_t i = 0; i < size; ++i) {
+        seed    = seed * 1103515245 + 12345;
+        data[i] = (value ? value : (uint8_t)(seed >> 16));
+    }
+
+    return size;
+}
+
+void setUp(void)
+{
+    (void)Converter_Init(&converterObj, CONVERTER_KERNEL_SCALAR);
+    (void)Scaler_Init(&scalerObj, CONVERTER_KERNEL_SCALAR);
+}
+
+void tearDown(void)
+{
+    (void)Scaler_UnInit(&scalerObj);
+    (void)Converter_UnInit(&converterObj);
+}
+
+/**
+ * Requirement:
+ * - scale() must refuse different formats, RGB frames, bad filters and too high ratios
+ */
+void test_Scaler_Scale_Invalid_Frames(void)
+{
+    uint8_t data[256]            = {0};
+    struct converter_frame_s src = {0};
+    struct converter_frame_s dst = {0};
+
+    TEST_ASSERT_EXPECTED(scalerObj->scale(NULL, &src, &dst, SCALER_FILTER_BOX));
+
+    (void)converterObj->setFrame(converterObj, CONVERTER_FORMAT_YUYV, 4, 2, data, &src);
+    (void)converterObj->setFrame(converterObj, CONVERTER_FORMAT_NV12, 2, 2, data, &dst);
+    TEST_ASSERT_EQUAL(scalerObj->scale(scalerObj, &src, &dst, SCALER_FILTER_BOX),
+                      SCALER_ERROR_FORMAT);
+    TEST_ASSERT_EQUAL(scalerObj->scale(scalerObj, NULL, &dst, SCALER_FILTER_BOX),
+                      SCALER_ERROR_PARAMS);
+
+    (void)converterObj->setFrame(converterObj, CONVERTER_FORMAT_YUYV, 2, 2, data, &dst);
+    TEST_ASSERT_EQUAL(scalerObj->scale(scalerObj, &src, &dst, SCALER_FILTER_MAX),
+                      SCALER_ERROR_PARAMS);
+
+    (void)converterObj->setFrame(converterObj, CONVERTER_FORMAT_RGB24, 4, 2, data, &src);
+    (void)converterObj->setFrame(converterObj, CONVERTER_FORMAT_RGB24, 2, 2, data, &dst);
+    TEST_ASSERT_EQUAL(scalerObj->scale(scalerObj, &src, &dst, SCALER_FILTER_BOX),
+                      SCALER_ERROR_PARAMS);
+
+    (void)converterObj->setFrame(converterObj, CONVERTER_FORMAT_I420, 2 * SCALER_MAX_RATIO + 2, 1,
+                                 data, &src);
+    (void)converterObj->setFrame(converterObj, CONVERTER_FORMAT_I420, 2, 1, data, &dst);
+    TEST_ASSERT_EQUAL(scalerObj->scale(scalerObj, &src, &dst, SCALER_FILTER_BOX),
+                      SCALER_ERROR_PARAMS);
+}
+
+/**
+ * Requirement:
+ * - Scaling to the same dimensions must give the source frame back whatever the filter
+ * - A uniform frame must remain uniform
+ */
+void test_Scaler_Scale_Identity_And_Uniform(void)
+{
+    struct converter_frame_s src, dst;
+    enum converter_format_e format;
+    enum scaler_filter_e filter;
+    uint8_t *srcData, *dstData, *expected;
+    size_t size;
+
+    for (format = CONVERTER_FORMAT_YUYV; format <= CONVERTER_FORMAT_I420; ++format) {
+        for (filter = SCALER_FILTER_BOX; filter < SCALER_FILTER_MAX; ++filter) {
+            srcData = allocFrame(format, SRC_WIDTH, SRC_HEIGHT, &src);
+            dstData = allocFrame(format, SRC_WIDTH, SRC_HEIGHT, &dst);
+            size    = fillFrame(format, SRC_WIDTH, SRC_HEIGHT, srcData, 0);
+
+            TEST_ASSERT_EQUAL(scalerObj->scale(scalerObj, &src, &dst, filter), SCALER_ERROR_NONE);
+            TEST_ASSERT_EQUAL_MEMORY(srcData, dstData, size);
+
+            free(dstData);
+
+            (void)fillFrame(format, SRC_WIDTH, SRC_HEIGHT, srcData, 0x5A);
+            dstData  = allocFrame(format, 30, 7, &dst);
+            size     = fillFrame(format, 30, 7, dstData, 0);
+            expected = malloc(size);
+            TEST_ASSERT_NOT_NULL(expected);
+            memset(expected, 0x5A, size);
+
+            TEST_ASSERT_EQUAL(scalerObj->scale(scalerObj, &src, &dst, filter), SCALER_ERROR_NONE);
+            TEST_ASSERT_EQUAL_MEMORY(expected, dstData, size);
+
+            free(expected);
+            free(dstData);
+            free(srcData);
+        }
+    }
+}
+
+/**
+ * Requirement:
+ * - Halving with the box filter must average 2x2 blocks of each component
+ */
+void test_Scaler_Scale_Box_Known_Values(void)
+{
+    uint8_t y[4 * 2]               = { 10, 20, 30, 40,
+                                       50, 60, 70, 81 };
+    uint8_t uv[4 * 1]              = { 100, 200, 110, 211 };
+    uint8_t yOut[2]                = {0};
+    uint8_t uvOut[2]               = {0};
+    uint8_t expectedY[2]           = { 35, 56 };
+    uint8_t expectedUv[2]          = { 105, 206 };
+    struct converter_frame_s src   = {0};
+    struct converter_frame_s dst   = {0};
+
+    src.format     = CONVERTER_FORMAT_NV12;
+    src.width      = 4;
+    src.height     = 2;
+    src.planes[0]  = y;
+    src.planes[1]  = uv;
+    src.strides[0] = 4;
+    src.strides[1] = 4;
+
+    dst.format     = CONVERTER_FORMAT_NV12;
+    dst.width      = 2;
+    dst.height     = 1;
+    dst.planes[0]  = yOut;
+    dst.planes[1]  = uvOut;
+    dst.strides[0] = 2;
+    dst.strides[1] = 2;
+
+    TEST_ASSERT_EQUAL(scalerObj->scale(scalerObj, &src, &dst, SCALER_FILTER_BOX),
+                      SCALER_ERROR_NONE);
+    TEST_ASSERT_EQUAL_MEMORY(expectedY, yOut, sizeof(expectedY));
+    TEST_ASSERT_EQUAL_MEMORY(expectedUv, uvOut, sizeof(expectedUv));
+}
+
+/**
+ * Requirement:
+ * - All kernels supported by the running cpu must give exactly the same results as the scalar
+ *   one for every format, filter and ratio
+ */
+void test_Scaler_Scale_Kernels_Bit_Exact(void)
+{
+    static const uint32_t sizes[][2] = { { 42, 11 }, { 20, 3 }, { 64, 17 }, { 130, 40 } };
+
+    struct scaler_s *simdObj = NULL;
+    struct converter_frame_s src, ref, out;
+    enum converter_format_e format;
+    enum converter_kernel_e kernel;
+    enum scaler_filter_e filter;
+    uint32_t i;
+    size_t size;
+
+    for (kernel = CONVERTER_KERNEL_SSE2; kernel < CONVERTER_KERNEL_MAX; ++kernel) {
+        if (Scaler_Init(&simdObj, kernel) != SCALER_ERROR_NONE) {
+            continue;
+        }
+
+        for (format = CONVERTER_FORMAT_YUYV; format <= CONVERTER_FORMAT_I420; ++format) {
+            uint8_t *srcData = allocFrame(format, SRC_WIDTH, SRC_HEIGHT, &src);
+            (void)fillFrame(format, SRC_WIDTH, SRC_HEIGHT, srcData, 0);
+
+            for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+                for (filter = SCALER_FILTER_BOX; filter < SCALER_FILTER_MAX; ++filter) {
+                    uint8_t *refData = allocFrame(format, sizes[i][0], sizes[i][1], &ref);
+                    uint8_t *outData = allocFrame(format, sizes[i][0], sizes[i][1], &out);
+
+                    TEST_ASSERT_EQUAL(scalerObj->scale(scalerObj, &src, &ref, filter),
+                                      SCALER_ERROR_NONE);
+                    TEST_ASSERT_EQUAL(simdObj->scale(simdObj, &src, &out, filter),
+                                      SCALER_ERROR_NONE);
+
+                    (void)converterObj->getFrameSize(converterObj, format, sizes[i][0],
+                                                     sizes[i][1], &size);
+                    TEST_ASSERT_EQUAL_MEMORY(refData, outData, size);
+
+                    free(refData);
+                    free(outData);
+                }
+            }
+
+            free(srcData);
+        }
+
+        (void)Scaler_UnInit(&simdObj);
+    }
+}